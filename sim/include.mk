@@ -13,10 +13,16 @@ LIB_IICMB__iicmb_int_pkg             = $(LIB_IICMB)/iicmb_int_pkg/_primary.dat
 LIB_IICMB__iicmb_int_pkg__body       = $(LIB_IICMB)/iicmb_int_pkg/body.dat
 LIB_IICMB__wishbone                  = $(LIB_IICMB)/wishbone/_primary.dat
 LIB_IICMB__wishbone__rtl             = $(LIB_IICMB)/wishbone/rtl.dat
+LIB_IICMB__wishbone_pl               = $(LIB_IICMB)/wishbone_pl/_primary.dat
+LIB_IICMB__wishbone_pl__rtl          = $(LIB_IICMB)/wishbone_pl/rtl.dat
 LIB_IICMB__avalon_mm                 = $(LIB_IICMB)/avalon_mm/_primary.dat
 LIB_IICMB__avalon_mm__rtl            = $(LIB_IICMB)/avalon_mm/rtl.dat
+LIB_IICMB__axi4lite                  = $(LIB_IICMB)/axi4lite/_primary.dat
+LIB_IICMB__axi4lite__rtl             = $(LIB_IICMB)/axi4lite/rtl.dat
 LIB_IICMB__sequencer                 = $(LIB_IICMB)/sequencer/_primary.dat
 LIB_IICMB__sequencer__rtl            = $(LIB_IICMB)/sequencer/rtl.dat
+LIB_IICMB__poller                    = $(LIB_IICMB)/poller/_primary.dat
+LIB_IICMB__poller__rtl               = $(LIB_IICMB)/poller/rtl.dat
 LIB_IICMB__regblock                  = $(LIB_IICMB)/regblock/_primary.dat
 LIB_IICMB__regblock__rtl             = $(LIB_IICMB)/regblock/rtl.dat
 LIB_IICMB__mbyte                     = $(LIB_IICMB)/mbyte/_primary.dat
@@ -33,10 +39,16 @@ LIB_IICMB__conditioner_mux           = $(LIB_IICMB)/conditioner_mux/_primary.dat
 LIB_IICMB__conditioner_mux__str      = $(LIB_IICMB)/conditioner_mux/str.dat
 LIB_IICMB__iicmb_m                   = $(LIB_IICMB)/iicmb_m/_primary.dat
 LIB_IICMB__iicmb_m__str              = $(LIB_IICMB)/iicmb_m/str.dat
+LIB_IICMB__engine_mux                = $(LIB_IICMB)/engine_mux/_primary.dat
+LIB_IICMB__engine_mux__str           = $(LIB_IICMB)/engine_mux/str.dat
+LIB_IICMB__dma                       = $(LIB_IICMB)/dma/_primary.dat
+LIB_IICMB__dma__rtl                  = $(LIB_IICMB)/dma/rtl.dat
 LIB_IICMB__iicmb_m_wb                = $(LIB_IICMB)/iicmb_m_wb/_primary.dat
 LIB_IICMB__iicmb_m_wb__str           = $(LIB_IICMB)/iicmb_m_wb/str.dat
 LIB_IICMB__iicmb_m_av                = $(LIB_IICMB)/iicmb_m_av/_primary.dat
 LIB_IICMB__iicmb_m_av__str           = $(LIB_IICMB)/iicmb_m_av/str.dat
+LIB_IICMB__iicmb_m_axi               = $(LIB_IICMB)/iicmb_m_axi/_primary.dat
+LIB_IICMB__iicmb_m_axi__str          = $(LIB_IICMB)/iicmb_m_axi/str.dat
 LIB_IICMB__iicmb_m_sq                = $(LIB_IICMB)/iicmb_m_sq/_primary.dat
 LIB_IICMB__iicmb_m_sq__str           = $(LIB_IICMB)/iicmb_m_sq/str.dat
 
@@ -46,6 +58,8 @@ LIB_IICMB_TB__test                   = $(LIB_IICMB_TB)/test/_primary.dat
 LIB_IICMB_TB__test__body             = $(LIB_IICMB_TB)/test/body.dat
 LIB_IICMB_TB__wire_mdl               = $(LIB_IICMB_TB)/wire_mdl/_primary.dat
 LIB_IICMB_TB__wire_mdl__beh          = $(LIB_IICMB_TB)/wire_mdl/beh.dat
+LIB_IICMB_TB__i2c_slave_mdl          = $(LIB_IICMB_TB)/i2c_slave_mdl/_primary.dat
+LIB_IICMB_TB__i2c_slave_mdl__beh     = $(LIB_IICMB_TB)/i2c_slave_mdl/beh.dat
 LIB_IICMB_TB__iicmb_m_tb             = $(LIB_IICMB_TB)/iicmb_m_tb/_primary.dat
 LIB_IICMB_TB__iicmb_m_tb__beh        = $(LIB_IICMB_TB)/iicmb_m_tb/beh.dat
 LIB_IICMB_TB__iicmb_m_wb_tb          = $(LIB_IICMB_TB)/iicmb_m_wb_tb/_primary.dat
@@ -54,6 +68,12 @@ LIB_IICMB_TB__iicmb_m_sq_tb          = $(LIB_IICMB_TB)/iicmb_m_sq_tb/_primary.da
 LIB_IICMB_TB__iicmb_m_sq_tb__beh     = $(LIB_IICMB_TB)/iicmb_m_sq_tb/beh.dat
 LIB_IICMB_TB__iicmb_m_sq_arb_tb      = $(LIB_IICMB_TB)/iicmb_m_sq_arb_tb/_primary.dat
 LIB_IICMB_TB__iicmb_m_sq_arb_tb__beh = $(LIB_IICMB_TB)/iicmb_m_sq_arb_tb/beh.dat
+LIB_IICMB_TB__iicmb_m_dma_tb         = $(LIB_IICMB_TB)/iicmb_m_dma_tb/_primary.dat
+LIB_IICMB_TB__iicmb_m_dma_tb__beh    = $(LIB_IICMB_TB)/iicmb_m_dma_tb/beh.dat
+LIB_IICMB_TB__iicmb_m_wb_pl_tb       = $(LIB_IICMB_TB)/iicmb_m_wb_pl_tb/_primary.dat
+LIB_IICMB_TB__iicmb_m_wb_pl_tb__beh  = $(LIB_IICMB_TB)/iicmb_m_wb_pl_tb/beh.dat
+LIB_IICMB_TB__iicmb_m_axi_tb         = $(LIB_IICMB_TB)/iicmb_m_axi_tb/_primary.dat
+LIB_IICMB_TB__iicmb_m_axi_tb__beh    = $(LIB_IICMB_TB)/iicmb_m_axi_tb/beh.dat
 
 
 $(LIB_IICMB) :
@@ -74,16 +94,25 @@ $(LIB_IICMB__regblock) $(LIB_IICMB__regblock__rtl) : $(IICMB_DIR)/src/regblock.v
 $(LIB_IICMB__avalon_mm) $(LIB_IICMB__avalon_mm__rtl) : $(IICMB_DIR)/src/avalon_mm.vhd | $(LIB_IICMB)
 	$(VCOM) -work $(LIB_IICMB) -2002 -O0 -quiet -explicit -check_synthesis $<
 
+$(LIB_IICMB__axi4lite) $(LIB_IICMB__axi4lite__rtl) : $(IICMB_DIR)/src/axi4lite.vhd | $(LIB_IICMB)
+	$(VCOM) -work $(LIB_IICMB) -2002 -O0 -quiet -explicit -check_synthesis $<
+
 $(LIB_IICMB__sequencer) $(LIB_IICMB__sequencer__rtl) : $(IICMB_DIR)/src/sequencer.vhd $(LIB_IICMB__iicmb_pkg) | $(LIB_IICMB)
 	$(VCOM) -work $(LIB_IICMB) -2002 -O0 -quiet -explicit -check_synthesis $<
 
+$(LIB_IICMB__poller) $(LIB_IICMB__poller__rtl) : $(IICMB_DIR)/src/poller.vhd $(LIB_IICMB__iicmb_pkg) | $(LIB_IICMB)
+	$(VCOM) -work $(LIB_IICMB) -2002 -O0 -quiet -explicit -check_synthesis $<
+
 $(LIB_IICMB__wishbone) $(LIB_IICMB__wishbone__rtl) : $(IICMB_DIR)/src/wishbone.vhd | $(LIB_IICMB)
 	$(VCOM) -work $(LIB_IICMB) -2002 -O0 -quiet -explicit -check_synthesis $<
 
+$(LIB_IICMB__wishbone_pl) $(LIB_IICMB__wishbone_pl__rtl) : $(IICMB_DIR)/src/wishbone_pl.vhd | $(LIB_IICMB)
+	$(VCOM) -work $(LIB_IICMB) -2002 -O0 -quiet -explicit -check_synthesis $<
+
 $(LIB_IICMB__mbyte) $(LIB_IICMB__mbyte__rtl) : $(IICMB_DIR)/src/mbyte.vhd $(LIB_IICMB__iicmb_pkg) $(LIB_IICMB__iicmb_int_pkg) | $(LIB_IICMB)
 	$(VCOM) -work $(LIB_IICMB) -2002 -O0 -quiet -explicit -check_synthesis $<
 
-$(LIB_IICMB__mbit) $(LIB_IICMB__mbit__rtl) : $(IICMB_DIR)/src/mbit.vhd $(LIB_IICMB__iicmb_int_pkg) | $(LIB_IICMB)
+$(LIB_IICMB__mbit) $(LIB_IICMB__mbit__rtl) : $(IICMB_DIR)/src/mbit.vhd $(LIB_IICMB__iicmb_pkg) $(LIB_IICMB__iicmb_int_pkg) | $(LIB_IICMB)
 	$(VCOM) -work $(LIB_IICMB) -2002 -O0 -quiet -explicit -check_synthesis $<
 
 $(LIB_IICMB__bus_state) $(LIB_IICMB__bus_state__rtl) : $(IICMB_DIR)/src/bus_state.vhd | $(LIB_IICMB)
@@ -95,19 +124,28 @@ $(LIB_IICMB__filter) $(LIB_IICMB__filter__rtl) : $(IICMB_DIR)/src/filter.vhd | $
 $(LIB_IICMB__conditioner) $(LIB_IICMB__conditioner__str) : $(IICMB_DIR)/src/conditioner.vhd | $(LIB_IICMB)
 	$(VCOM) -work $(LIB_IICMB) -2002 -O0 -quiet -explicit -check_synthesis $<
 
-$(LIB_IICMB__conditioner_mux) $(LIB_IICMB__conditioner_mux__str) : $(IICMB_DIR)/src/conditioner_mux.vhd | $(LIB_IICMB)
+$(LIB_IICMB__conditioner_mux) $(LIB_IICMB__conditioner_mux__str) : $(IICMB_DIR)/src/conditioner_mux.vhd $(LIB_IICMB__iicmb_pkg) | $(LIB_IICMB)
 	$(VCOM) -work $(LIB_IICMB) -2002 -O0 -quiet -explicit -check_synthesis $<
 
 $(LIB_IICMB__iicmb_m) $(LIB_IICMB__iicmb_m__str) : $(IICMB_DIR)/src/iicmb_m.vhd $(LIB_IICMB__iicmb_pkg) $(LIB_IICMB__iicmb_int_pkg) | $(LIB_IICMB)
 	$(VCOM) -work $(LIB_IICMB) -2002 -O0 -quiet -explicit -check_synthesis $<
 
-$(LIB_IICMB__iicmb_m_wb) $(LIB_IICMB__iicmb_m_wb__str) : $(IICMB_DIR)/src/iicmb_m_wb.vhd | $(LIB_IICMB)
+$(LIB_IICMB__engine_mux) $(LIB_IICMB__engine_mux__str) : $(IICMB_DIR)/src/engine_mux.vhd $(LIB_IICMB__iicmb_pkg) | $(LIB_IICMB)
+	$(VCOM) -work $(LIB_IICMB) -2002 -O0 -quiet -explicit -check_synthesis $<
+
+$(LIB_IICMB__dma) $(LIB_IICMB__dma__rtl) : $(IICMB_DIR)/src/dma.vhd $(LIB_IICMB__iicmb_pkg) | $(LIB_IICMB)
+	$(VCOM) -work $(LIB_IICMB) -2002 -O0 -quiet -explicit -check_synthesis $<
+
+$(LIB_IICMB__iicmb_m_wb) $(LIB_IICMB__iicmb_m_wb__str) : $(IICMB_DIR)/src/iicmb_m_wb.vhd $(LIB_IICMB__iicmb_pkg) | $(LIB_IICMB)
 	$(VCOM) -work $(LIB_IICMB) -2002 -O0 -quiet -explicit -check_synthesis $<
 
-$(LIB_IICMB__iicmb_m_av) $(LIB_IICMB__iicmb_m_av__str) : $(IICMB_DIR)/src/iicmb_m_av.vhd | $(LIB_IICMB)
+$(LIB_IICMB__iicmb_m_av) $(LIB_IICMB__iicmb_m_av__str) : $(IICMB_DIR)/src/iicmb_m_av.vhd $(LIB_IICMB__iicmb_pkg) | $(LIB_IICMB)
 	$(VCOM) -work $(LIB_IICMB) -2002 -O0 -quiet -explicit -check_synthesis $<
 
-$(LIB_IICMB__iicmb_m_sq) $(LIB_IICMB__iicmb_m_sq__str) : $(IICMB_DIR)/src/iicmb_m_sq.vhd | $(LIB_IICMB)
+$(LIB_IICMB__iicmb_m_axi) $(LIB_IICMB__iicmb_m_axi__str) : $(IICMB_DIR)/src/iicmb_m_axi.vhd $(LIB_IICMB__iicmb_pkg) | $(LIB_IICMB)
+	$(VCOM) -work $(LIB_IICMB) -2002 -O0 -quiet -explicit -check_synthesis $<
+
+$(LIB_IICMB__iicmb_m_sq) $(LIB_IICMB__iicmb_m_sq__str) : $(IICMB_DIR)/src/iicmb_m_sq.vhd $(LIB_IICMB__iicmb_pkg) | $(LIB_IICMB)
 	$(VCOM) -work $(LIB_IICMB) -2002 -O0 -quiet -explicit -check_synthesis $<
 
 
@@ -121,6 +159,9 @@ $(LIB_IICMB_TB__test) $(LIB_IICMB_TB__test__body) : $(IICMB_DIR)/src_tb/test.vhd
 $(LIB_IICMB_TB__wire_mdl) $(LIB_IICMB_TB__wire_mdl__beh) : $(IICMB_DIR)/src_tb/wire_mdl.vhd | $(LIB_IICMB_TB)
 	$(VCOM) -work $(LIB_IICMB_TB) -2002 -O0 -quiet -explicit $<
 
+$(LIB_IICMB_TB__i2c_slave_mdl) $(LIB_IICMB_TB__i2c_slave_mdl__beh) : $(IICMB_DIR)/src_tb/i2c_slave_mdl.vhd | $(LIB_IICMB_TB)
+	$(VCOM) -work $(LIB_IICMB_TB) -2002 -O0 -quiet -explicit $<
+
 $(LIB_IICMB_TB__iicmb_m_tb) $(LIB_IICMB_TB__iicmb_m_tb__beh) : $(IICMB_DIR)/src_tb/iicmb_m_tb.vhd $(LIB_IICMB__iicmb_pkg) $(LIB_IICMB__test) | $(LIB_IICMB_TB)
 	$(VCOM) -work $(LIB_IICMB_TB) -2002 -O0 -quiet -explicit $<
 
@@ -133,12 +174,24 @@ $(LIB_IICMB_TB__iicmb_m_sq_tb) $(LIB_IICMB_TB__iicmb_m_sq_tb__beh) : $(IICMB_DIR
 $(LIB_IICMB_TB__iicmb_m_sq_arb_tb) $(LIB_IICMB_TB__iicmb_m_sq_arb_tb__beh) : $(IICMB_DIR)/src_tb/iicmb_m_sq_arb_tb.vhd $(LIB_IICMB__iicmb_pkg) $(LIB_IICMB__test) | $(LIB_IICMB_TB)
 	$(VCOM) -work $(LIB_IICMB_TB) -2002 -O0 -quiet -explicit $<
 
+$(LIB_IICMB_TB__iicmb_m_dma_tb) $(LIB_IICMB_TB__iicmb_m_dma_tb__beh) : $(IICMB_DIR)/src_tb/iicmb_m_dma_tb.vhd $(LIB_IICMB__iicmb_pkg) $(LIB_IICMB__test) | $(LIB_IICMB_TB)
+	$(VCOM) -work $(LIB_IICMB_TB) -2002 -O0 -quiet -explicit $<
+
+$(LIB_IICMB_TB__iicmb_m_wb_pl_tb) $(LIB_IICMB_TB__iicmb_m_wb_pl_tb__beh) : $(IICMB_DIR)/src_tb/iicmb_m_wb_pl_tb.vhd $(LIB_IICMB__iicmb_pkg) $(LIB_IICMB__test) | $(LIB_IICMB_TB)
+	$(VCOM) -work $(LIB_IICMB_TB) -2002 -O0 -quiet -explicit $<
+
+$(LIB_IICMB_TB__iicmb_m_axi_tb) $(LIB_IICMB_TB__iicmb_m_axi_tb__beh) : $(IICMB_DIR)/src_tb/iicmb_m_axi_tb.vhd $(LIB_IICMB__iicmb_pkg) $(LIB_IICMB__test) | $(LIB_IICMB_TB)
+	$(VCOM) -work $(LIB_IICMB_TB) -2002 -O0 -quiet -explicit $<
+
 
 
 IICMB_TGTS = \
 	$(LIB_IICMB__avalon_mm)               $(LIB_IICMB__avalon_mm__rtl)               \
+	$(LIB_IICMB__axi4lite)                $(LIB_IICMB__axi4lite__rtl)                \
 	$(LIB_IICMB__sequencer)               $(LIB_IICMB__sequencer__rtl)               \
+	$(LIB_IICMB__poller)                  $(LIB_IICMB__poller__rtl)                  \
 	$(LIB_IICMB__wishbone)                $(LIB_IICMB__wishbone__rtl)                \
+	$(LIB_IICMB__wishbone_pl)             $(LIB_IICMB__wishbone_pl__rtl)             \
 	$(LIB_IICMB__regblock)                $(LIB_IICMB__regblock__rtl)                \
 	$(LIB_IICMB__mbyte)                   $(LIB_IICMB__mbyte__rtl)                   \
 	$(LIB_IICMB__mbit)                    $(LIB_IICMB__mbit__rtl)                    \
@@ -147,8 +200,11 @@ IICMB_TGTS = \
 	$(LIB_IICMB__conditioner)             $(LIB_IICMB__conditioner__str)             \
 	$(LIB_IICMB__conditioner_mux)         $(LIB_IICMB__conditioner_mux__str)         \
 	$(LIB_IICMB__iicmb_m)                 $(LIB_IICMB__iicmb_m__str)                 \
+	$(LIB_IICMB__engine_mux)              $(LIB_IICMB__engine_mux__str)              \
+	$(LIB_IICMB__dma)                     $(LIB_IICMB__dma__rtl)                     \
 	$(LIB_IICMB__iicmb_m_wb)              $(LIB_IICMB__iicmb_m_wb__str)              \
 	$(LIB_IICMB__iicmb_m_av)              $(LIB_IICMB__iicmb_m_av__str)              \
+	$(LIB_IICMB__iicmb_m_axi)             $(LIB_IICMB__iicmb_m_axi__str)             \
 	$(LIB_IICMB__iicmb_m_sq)              $(LIB_IICMB__iicmb_m_sq__str)              \
 
 
@@ -156,10 +212,14 @@ IICMB_TB_TGTS = \
 	$(LIB_IICMB_TB__i2c_slave_model)                                                 \
 	$(LIB_IICMB_TB__test)                 $(LIB_IICMB_TB__test__body)                \
 	$(LIB_IICMB_TB__wire_mdl)             $(LIB_IICMB_TB__wire_mdl__beh)             \
+	$(LIB_IICMB_TB__i2c_slave_mdl)        $(LIB_IICMB_TB__i2c_slave_mdl__beh)        \
 	$(LIB_IICMB_TB__iicmb_m_tb)           $(LIB_IICMB_TB__iicmb_m_tb__beh)           \
 	$(LIB_IICMB_TB__iicmb_m_wb_tb)        $(LIB_IICMB_TB__iicmb_m_wb_tb__beh)        \
 	$(LIB_IICMB_TB__iicmb_m_sq_tb)        $(LIB_IICMB_TB__iicmb_m_sq_tb__beh)        \
 	$(LIB_IICMB_TB__iicmb_m_sq_arb_tb)    $(LIB_IICMB_TB__iicmb_m_sq_arb_tb__beh)    \
+	$(LIB_IICMB_TB__iicmb_m_dma_tb)       $(LIB_IICMB_TB__iicmb_m_dma_tb__beh)       \
+	$(LIB_IICMB_TB__iicmb_m_wb_pl_tb)     $(LIB_IICMB_TB__iicmb_m_wb_pl_tb__beh)     \
+	$(LIB_IICMB_TB__iicmb_m_axi_tb)       $(LIB_IICMB_TB__iicmb_m_axi_tb__beh)       \
 
 
 
@@ -41,6 +41,7 @@
 /* Standard libs */
 #include <stdint.h>     // defines fixed data types: int8_t...
 #include <stddef.h>     // various variable types and macros: size_t, offsetof, NULL, ...
+#include <string.h>     // memcpy, memset
 /* Self */
 #include "iicmb.h"  // related definitions
 
@@ -63,6 +64,120 @@
 
 
 
+/**
+ *  @defgroup IICMB_REG_HOOK
+ *
+ *  register access, redirected to #iicmb_reg_rd/#iicmb_reg_wr
+ *  if IICMB_REG_HOOK is defined, f.e. for the host register model
+ *
+ *  @{
+ */
+#ifdef IICMB_REG_HOOK
+    #define IICMB_REG_RD(self, reg)         iicmb_reg_rd((self)->iicmb, offsetof(t_iicm_reg, reg))
+    #define IICMB_REG_WR(self, reg, val)    iicmb_reg_wr((self)->iicmb, offsetof(t_iicm_reg, reg), (uint8_t) (val))
+    #define IICMB_REG_RD32(self, reg)       iicmb_reg_rd32((self)->iicmb, offsetof(t_iicm_reg, reg))
+    #define IICMB_REG_WR32(self, reg, val)  iicmb_reg_wr32((self)->iicmb, offsetof(t_iicm_reg, reg), (uint32_t) (val))
+#else
+    #define IICMB_REG_RD(self, reg)         ((self)->iicmb->reg)
+    #define IICMB_REG_WR(self, reg, val)    ((self)->iicmb->reg = (uint8_t) (val))
+    #define IICMB_REG_RD32(self, reg)       (*((volatile uint32_t*) &((self)->iicmb->reg)))
+    #define IICMB_REG_WR32(self, reg, val)  (*((volatile uint32_t*) &((self)->iicmb->reg)) = (uint32_t) (val))
+#endif
+/** @} */   // IICMB_REG_HOOK
+
+
+
+/**
+ *  @defgroup IICMB_REG_32
+ *
+ *  fused register access: command with parameter and ISR entry.
+ *  With IICMB_REG_32 one 32-bit store writes DPR and CMDR, the CSR
+ *  lane keeps core and IRQ enabled. One 32-bit load returns CMDR
+ *  and DPR, with FIFOs this pops the first RX FIFO byte.
+ *
+ *  @{
+ */
+#ifdef IICMB_REG_32
+    #define IICMB_REG_CMD(self, cmd, param) IICMB_REG_WR32(self, CSR,                                                       \
+                                                ((uint32_t) (IICMB_CSR_IICM_ENA | IICMB_CSR_IRQ_ENA) << IICMB_REG32_CSR) |  \
+                                                ((uint32_t) (uint8_t) (param) << IICMB_REG32_DPR) |                         \
+                                                ((uint32_t) (cmd) << IICMB_REG32_CMDR))
+    #define IICMB_RX_BYTE(self, first, rx)  ((first) ? (rx) : IICMB_REG_RD(self, DPR))
+#else
+    #define IICMB_REG_CMD(self, cmd, param) do { IICMB_REG_WR(self, DPR, param); IICMB_REG_WR(self, CMDR, cmd); } while (0)
+    #define IICMB_RX_BYTE(self, first, rx)  IICMB_REG_RD(self, DPR)
+#endif
+/** @} */   // IICMB_REG_32
+
+
+
+/**
+ *  @defgroup IICMB_IRQ_CTRL
+ *
+ *  interrupt control of byte commands, bus selection and retry:
+ *  mask of caller plus DON, without coalescing. Every completion
+ *  is needed to issue the next command.
+ *
+ *  @{
+ */
+#define IICMB_IRQ_CMD(self)     (((self)->uint32Icr & 0xFF) | IICMB_IMSK_DON)
+/** @} */   // IICMB_IRQ_CTRL
+
+
+
+/**
+ *  @defgroup IICMB_BARRIER
+ *
+ *  compiler barrier, plain memory accesses stay on their side
+ *  of the volatile accesses shared with the ISR
+ *
+ *  @{
+ */
+#if defined(__GNUC__)
+    #define IICMB_BARRIER()     __asm__ __volatile__ ("" ::: "memory")
+#else
+    #define IICMB_BARRIER()     do { } while (0)
+#endif
+/** @} */   // IICMB_BARRIER
+
+
+
+/**
+ *  @defgroup IICMB_PERF
+ *
+ *  read of a 32-bit performance counter, one load with
+ *  IICMB_REG_32 or four byte loads, low byte first
+ *
+ *  @{
+ */
+#ifdef IICMB_REG_32
+    #define IICMB_PERF_RD(self, reg)    IICMB_REG_RD32(self, reg)
+#else
+    #define IICMB_PERF_RD(self, reg)    ( (uint32_t) IICMB_REG_RD(self, reg[0])         | \
+                                          ((uint32_t) IICMB_REG_RD(self, reg[1]) << 8)  | \
+                                          ((uint32_t) IICMB_REG_RD(self, reg[2]) << 16) | \
+                                          ((uint32_t) IICMB_REG_RD(self, reg[3]) << 24) )
+#endif
+/** @} */   // IICMB_PERF
+
+
+
+/**
+ *  @defgroup IICMB_TRACE
+ *
+ *  records binary trace event, compiled out if IICMB_TRACE_LEN is zero
+ *
+ *  @{
+ */
+#if IICMB_TRACE_LEN > 0
+    #define IICMB_TRACE(self, evt, arg) iicmb_trace_put(self, evt, arg)
+#else
+    #define IICMB_TRACE(self, evt, arg)
+#endif
+/** @} */   // IICMB_TRACE
+
+
+
 /**
  *  @defgroup FALL_THROUGH
  *
@@ -83,6 +198,160 @@
 
 
 
+#if IICMB_TRACE_LEN > 0
+/**
+ *  @brief trace event
+ *
+ *  writes trace entry into the ring and publishes it
+ *
+ *  @param[in,out]  self                driver handle
+ *  @param[in]      evt                 event, #t_iicmb_trace_evt
+ *  @param[in]      arg                 event argument
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static inline void iicmb_trace_put(t_iicmb *self, t_iicmb_trace_evt evt, uint8_t arg)
+{
+    /** Variables **/
+    uint32_t        uint32Head = self->trace.uint32Head;    // next event
+    t_iicmb_trace   *entry = &(self->trace.entry[uint32Head & (IICMB_TRACE_LEN - 1)]);
+
+    /* record */
+    entry->uint32Time = iicmb_trace_time(self->iicmb);
+    entry->uint8Evt = (uint8_t) evt;
+    entry->uint8Fsm = (uint8_t) self->fsm;
+    entry->uint8Arg = arg;
+    entry->uint8Bus = self->uint8BusAct;
+    entry->uint16WrByteIs = self->uint16WrByteIs;
+    entry->uint16RdByteIs = self->uint16RdByteIs;
+    /* publish */
+    self->trace.uint32Head = uint32Head + 1;
+}
+#endif
+
+
+
+#ifdef IICMB_STATS
+/**
+ *  @brief posted statistics reset
+ *
+ *  performs the reset requested by #iicmb_stats_clr, called by
+ *  the ISR before it updates the statistics of a bus. The
+ *  sequence counter is kept and odd while clearing.
+ *
+ *  @param[in,out]  self                driver handle
+ *  @param[in]      bus                 I2C bus number
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static inline void iicmb_stats_reset(t_iicmb *self, uint8_t bus)
+{
+    /** Variables **/
+    t_iicmb_stats   *stats = &(self->stats[bus]);
+    uint32_t        uint32Seq;
+
+    if ( 0 == self->uint8StatsClr[bus] ) {
+        return;
+    }
+    uint32Seq = stats->uint32Seq + 1;
+    stats->uint32Seq = uint32Seq;
+    IICMB_BARRIER();
+    memset(stats, 0, sizeof(t_iicmb_stats));
+    IICMB_BARRIER();
+    stats->uint32Seq = uint32Seq + 1;
+    self->uint8StatsClr[bus] = 0;
+}
+
+
+
+/**
+ *  @brief statistics of finished transfer
+ *
+ *  updates counters and latency histogram of the active bus,
+ *  the sequence counter is odd while updating. With IICMB_PERF
+ *  the hardware counters are snapshot and their increase since
+ *  the end of the previous transfer is added.
+ *
+ *  @param[in,out]  self                driver handle
+ *  @param[in]      xfer                finished transfer
+ *  @param[in]      error               result of transfer
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static inline void iicmb_stats_done(t_iicmb *self, const t_iicmb_xfer *xfer, t_iicmb_ero error)
+{
+    /** Variables **/
+    t_iicmb_stats   *stats = &(self->stats[self->uint8BusAct]);
+    uint32_t        uint32Lat = iicmb_trace_time(self->iicmb) - xfer->uint32Submit;    // wrap safe
+    uint8_t         uint8Bucket = 0;    // floor(log2(latency))
+#ifdef IICMB_PERF
+    uint32_t        uint32Perf[IICMB_PERF_NUM]; // PCMD..PFBY
+    uint8_t         uint8Iter;
+
+    /* hardware counters */
+    IICMB_REG_WR(self, PCR, IICMB_PCR_SNAP);
+    uint32Perf[0] = IICMB_PERF_RD(self, PCMD);
+    uint32Perf[1] = IICMB_PERF_RD(self, PLAT);
+    uint32Perf[2] = IICMB_PERF_RD(self, PSTR);
+    uint32Perf[3] = IICMB_PERF_RD(self, PTRN);
+    uint32Perf[4] = IICMB_PERF_RD(self, PFBY);
+    for ( uint8Iter = 0; uint8Iter < IICMB_PERF_NUM; uint8Iter++ ) {
+        uint32_t uint32Last = self->uint32Perf[uint8Iter];
+        self->uint32Perf[uint8Iter] = uint32Perf[uint8Iter];
+        uint32Perf[uint8Iter] -= uint32Last;    // wrap safe
+    }
+#endif
+
+    /* log2 bucket */
+#if defined(__GNUC__)
+    if ( 0 != uint32Lat ) {
+        uint8Bucket = (uint8_t) (31 - __builtin_clz(uint32Lat));
+    }
+#else
+    while ( 0 != (uint32Lat >>= 1) ) {
+        uint8Bucket++;
+    }
+#endif
+    /* posted reset first */
+    iicmb_stats_reset(self, self->uint8BusAct);
+    /* update */
+    stats->uint32Seq++;
+    stats->uint32Xfer++;
+    switch (error) {
+        case IICMB_E_NO:
+            break;
+        case IICMB_E_NOSLAVE:
+            stats->uint32NoSlave++;
+            break;
+        case IICMB_E_ARBLOST:
+            stats->uint32ArbLost++;
+            break;
+        case IICMB_E_ICTF:
+            stats->uint32Ictf++;
+            break;
+        default:
+            stats->uint32Err++;
+            break;
+    }
+    stats->uint32WrByte += self->uint16WrByteIs;
+    stats->uint32RdByte += self->uint16RdByteIs;
+    stats->uint32Lat[uint8Bucket]++;
+#ifdef IICMB_PERF
+    stats->uint32Cmd += uint32Perf[0];
+    stats->uint32CmdClk += uint32Perf[1];
+    stats->uint32StretchClk += uint32Perf[2];
+    stats->uint32TurnClk += uint32Perf[3];
+    stats->uint32ForeignClk += uint32Perf[4];
+#endif
+    stats->uint32Seq++;
+}
+#endif
+
+
+
 /**
  *  @brief startbit
  *
@@ -98,7 +367,7 @@ static inline void iicmb_start_bit(t_iicmb *self)
     /* Function call message */
     iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
     /* set start bit */
-    self->iicmb->CMDR = IICMB_CMD_START;
+    IICMB_REG_WR(self, CMDR, IICMB_CMD_START);
 }
 
 
@@ -118,7 +387,60 @@ static inline void iicmb_stop_bit(t_iicmb *self)
     /* Function call message */
     iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
     /* set stop bit */
-    self->iicmb->CMDR = IICMB_CMD_STOP;
+    IICMB_REG_WR(self, CMDR, IICMB_CMD_STOP);
+}
+
+
+
+/**
+ *  @brief next write byte
+ *
+ *  fetches next byte from the write segments, exhausted
+ *  and empty segments are skipped
+ *
+ *  @param[in,out]  self                driver handle
+ *  @return         uint8_t             byte to write
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static inline uint8_t iicmb_wr_next(t_iicmb *self)
+{
+    /* Function call message */
+    iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* next segment */
+    while ( self->uint16WrSegIs >= self->segWr->uint16Len ) {
+        ++(self->segWr);
+        self->uint16WrSegIs = 0;
+    }
+    ++(self->uint16WrByteIs);
+    return (self->segWr->uint8PtrData)[(self->uint16WrSegIs)++];
+}
+
+
+
+/**
+ *  @brief read byte store
+ *
+ *  stores byte in the read segments, exhausted
+ *  and empty segments are skipped
+ *
+ *  @param[in,out]  self                driver handle
+ *  @param[in]      val                 read byte
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static inline void iicmb_rd_put(t_iicmb *self, uint8_t val)
+{
+    /* Function call message */
+    iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* next segment */
+    while ( self->uint16RdSegIs >= self->segRd->uint16Len ) {
+        ++(self->segRd);
+        self->uint16RdSegIs = 0;
+    }
+    ++(self->uint16RdByteIs);
+    (self->segRd->uint8PtrData)[(self->uint16RdSegIs)++] = val;
 }
 
 
@@ -140,9 +462,9 @@ static int iicmb_enable(t_iicmb *self)
     /* Function call message */
     iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
     /* modify */
-    self->iicmb->CSR |= IICMB_CSR_IICM_ENA; // enable core
+    IICMB_REG_WR(self, CSR, IICMB_REG_RD(self, CSR) | IICMB_CSR_IICM_ENA); // enable core
     /* check */
-    if ( 0 == (self->iicmb->CSR & IICMB_CSR_IICM_ENA) ) {
+    if ( 0 == (IICMB_REG_RD(self, CSR) & IICMB_CSR_IICM_ENA) ) {
         return -1;
     }
     /* normal end */
@@ -168,9 +490,9 @@ static int iicmb_disable(t_iicmb *self)
     /* Function call message */
     iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
     /* modify */
-    self->iicmb->CSR &= (uint8_t) ~IICMB_CSR_IICM_ENA;  // clear core enable
+    IICMB_REG_WR(self, CSR, IICMB_REG_RD(self, CSR) & (uint8_t) ~IICMB_CSR_IICM_ENA);  // clear core enable
     /* check, for bit clear */
-    if ( 0 != (self->iicmb->CSR & IICMB_CSR_IICM_ENA) ) {
+    if ( 0 != (IICMB_REG_RD(self, CSR) & IICMB_CSR_IICM_ENA) ) {
         return -1;  // Error
     }
     /* graceful end */
@@ -200,9 +522,9 @@ static int iicmb_irq_enable(t_iicmb *self)
     /* Function call message */
     iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
     /* modify */
-    self->iicmb->CSR |= IICMB_CSR_IRQ_ENA;  // set IRQ enable bit
+    IICMB_REG_WR(self, CSR, IICMB_REG_RD(self, CSR) | IICMB_CSR_IRQ_ENA);  // set IRQ enable bit
     /* check */
-    if ( 0 == (self->iicmb->CSR & IICMB_CSR_IRQ_ENA) ) {
+    if ( 0 == (IICMB_REG_RD(self, CSR) & IICMB_CSR_IRQ_ENA) ) {
         return -1;
     }
     /* normal end */
@@ -228,9 +550,9 @@ static int iicmb_irq_disable(t_iicmb *self)
     /* Function call message */
     iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
     /* modify */
-    self->iicmb->CSR &= (uint8_t) ~IICMB_CSR_IRQ_ENA;   // clear IRQ enable bit
+    IICMB_REG_WR(self, CSR, IICMB_REG_RD(self, CSR) & (uint8_t) ~IICMB_CSR_IRQ_ENA);   // clear IRQ enable bit
     /* check */
-    if ( 0 != (self->iicmb->CSR & IICMB_CSR_IRQ_ENA) ) {
+    if ( 0 != (IICMB_REG_RD(self, CSR) & IICMB_CSR_IRQ_ENA) ) {
         return -1;
     }
     /* graceful end */
@@ -240,135 +562,769 @@ static int iicmb_irq_disable(t_iicmb *self)
 
 
 /**
- *  @brief Satus decode
+ *  @brief interrupt load
  *
- *  Decodes IICMB last transfer status
+ *  writes IMSK/ICNT/ITIM into the IICMB core if they
+ *  differ from the last written values
  *
  *  @param[in,out]  self                driver handle
- *  @param[in]      cmdReg              read command register value
- *  @return         int                 state
- *  @retval         0                   OKAY
- *  @retval         -1                  FAIL, leave ISR with error
- *  @since          2023-02-25
- *  @author         Andreas Kaeberlein
+ *  @param[in]      icr                 IMSK bits 7..0, ICNT bits 15..8, ITIM bits 31..16
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
  */
-static int iicmb_status_decode(t_iicmb *self, uint8_t cmdReg)
+#ifdef IICMB_IRQ_CTRL
+static void iicmb_irq_load(t_iicmb *self, uint32_t icr)
 {
     /* Function call message */
     iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
-    /* Check for Eros in last transfer */
-    switch (cmdReg & IICMB_RSP) {
-        /* normal: last command done */
-        case IICMB_RSP_DONE:
-            iicmb_printf("  INFO:CMDR: done\n");
-            break;
-        /* normal: last byte nck */
-        case IICMB_RSP_NAK:
-            iicmb_printf("  INFO:CMDR: data NCK\n");
-            break;
-        /* exception: arbitration lost */
-        case IICMB_RSP_ARB_LOST:
-            iicmb_printf("  ERROR:CMDR: arbitration lost\n");
-            self->error = IICMB_E_ARBLOST;  // arbitration lost
-            self->fsm = IICMB_WT_IDLE;
-            return -1;
-        /* exception: IICMB unknown error */
-        case IICMB_RSP_ERR:
-            iicmb_printf("  ERROR:CMDR: IICMB unkown error\n");
-            self->error = IICMB_E_IICMB;    // I2C controller runs into error
-            self->fsm = IICMB_IDLE;
-            return -1;
-        /* all okay */
-        default:
-            iicmb_printf("  ERROR:CMDR: soft FSM unknown error\n");
-            self->error = IICMB_E_UNKNOWN;  // unknown error in IICMB
-            return -1;
+    /* unchanged */
+    if ( icr == self->uint32IcrAct ) {
+        return;
     }
-    /* normal end */
-    return 0;
+#ifdef IICMB_REG_32
+    IICMB_REG_WR32(self, IMSK, icr);
+#else
+    IICMB_REG_WR(self, IMSK, icr);
+    IICMB_REG_WR(self, ICNT, icr >> 8);
+    IICMB_REG_WR(self, ITIM[0], icr >> 16);
+    IICMB_REG_WR(self, ITIM[1], icr >> 24);
+#endif
+    self->uint32IcrAct = icr;
 }
+#endif
 
 
 
+#if IICMB_FIFO_DEPTH > 0
 /**
- *  iicmb_set_bus
- *    set bus number
+ *  @brief FIFO drop
+ *
+ *  clears TX and RX FIFO after a failed write/read command,
+ *  unsent bytes are removed from the write count
+ *
+ *  @param[in,out]  self                driver handle
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
  */
-int iicmb_set_bus(t_iicmb *self, uint8_t num)
+static void iicmb_fifo_drop(t_iicmb *self)
 {
     /* Function call message */
     iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
-    /* set bus number */
-    self->iicmb->DPR = (uint8_t) (num & IICMB_CSR_BUS); // preload data/parameter register
-    self->iicmb->CMDR = IICMB_CMD_SET_BUS;              // set bus id
-    /* check for setting */
-    if ( num != (self->iicmb->CSR & IICMB_CSR_BUS) ) {
-        return -1;
-    }
-    /* graceful end */
-    return 0;
+    /* unsent bytes */
+    self->uint16WrByteIs = (uint16_t) (self->uint16WrByteIs - IICMB_REG_RD(self, FTXL));
+    /* clear */
+    IICMB_REG_WR(self, FCR, IICMB_FCR_TXC | IICMB_FCR_RXC);
 }
 
 
+
 /**
- *  iicmb_init
- *    init sw handle and IICMB core
+ *  @brief FIFO read
+ *
+ *  requests the next chunk of read bytes into the RX FIFO,
+ *  last byte of the transfer is read with NCK
+ *
+ *  @param[in,out]  self                driver handle
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
  */
-int iicmb_init(t_iicmb *self, void* iicmbAdr, uint8_t bus)
+static void iicmb_fifo_read(t_iicmb *self)
 {
     /** Variables **/
-    int ret = 0;    // common return value
+    uint16_t    uint16Num = (uint16_t) (self->uint16RdByteLen - self->uint16RdByteIs);    // pending bytes
 
     /* Function call message */
     iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
-    /* Init driver handle */
-    self->iicmb = (t_iicm_reg*) iicmbAdr;   // register set of IICMB
-    self->fsm = IICMB_IDLE;     // Soft I2C state machine
-    self->uint8WrRd = 0;        // no write/read interaction requested
-    self->error = IICMB_E_NO;   // Driver runs without error
-    self->uint16WrByteLen = 0;  // Total Number of Bytes to transfer
-    self->uint16WrByteIs = 0;   // Number of Bytes processed (Sent/Receive)
-    self->uint8PtrData = NULL;  // Read/Write Buffer Pointer
-    /* init core */
-    ret |= iicmb_disable(self);         // core disable
-    ret |= iicmb_set_bus(self, bus);    // init with bus desired bus number
-    ret |= iicmb_irq_enable(self);      // enable IRQs
-    ret |= iicmb_enable(self);          // enable IICMB
-    /* end */
-    return ret;
+    /* limit to FIFO */
+    if ( IICMB_FIFO_DEPTH < uint16Num ) {
+        uint16Num = IICMB_FIFO_DEPTH;
+    }
+    /* bytes per read command, register keeps value */
+    if ( uint16Num != self->uint8FifoRcnt ) {
+        IICMB_REG_WR(self, FRCNT, uint16Num);
+        self->uint8FifoRcnt = (uint8_t) uint16Num;
+    }
+    /* last chunk ends with NCK */
+    if ( (self->uint16RdByteIs + uint16Num) == self->uint16RdByteLen ) {
+        IICMB_REG_WR(self, CMDR, IICMB_CMD_READ_NAK);
+        return;
+    }
+    IICMB_REG_WR(self, CMDR, IICMB_CMD_READ_ACK);
 }
 
 
+
 /**
- *  iicmb_close
- *    make driver invalid
+ *  @brief message
+ *
+ *  runs the transfer as one message command if write and read
+ *  data fit into the FIFOs, IICMB raises one IRQ at the end
+ *
+ *  @param[in,out]  self                driver handle
+ *  @return         int                 state
+ *  @retval         0                   message issued
+ *  @retval         -1                  transfer too long, use byte commands
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
  */
-int iicmb_close(t_iicmb *self)
+static int iicmb_fifo_msg(t_iicmb *self)
 {
     /* Function call message */
     iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
-    /* Disable IRQ */
-    iicmb_irq_disable(self);    // mask all IRQs
-    iicmb_disable(self);        // core disable
-    /* make handle invalid */
-    self->iicmb = NULL; // invalid register handle
-    /* end */
+    /* complete message in FIFOs? */
+    if ( (IICMB_FIFO_DEPTH < self->uint16WrByteLen) || (IICMB_FIFO_DEPTH < self->uint16RdByteLen) ) {
+        return -1;
+    }
+    /* address, direction and lengths */
+#ifdef IICMB_REG_32
+    if ( 0 == self->uint16RdByteLen ) {
+        IICMB_REG_WR32(self, MADR, (uint32_t) (self->uint8Adr | IICMB_I2C_WR) | ((uint32_t) self->uint16WrByteLen << 8));
+    } else {
+        IICMB_REG_WR32(self, MADR, (uint32_t) (self->uint8Adr | IICMB_I2C_RD) | ((uint32_t) self->uint16RdByteLen << 8) | ((uint32_t) self->uint16WrByteLen << 16));
+    }
+#else
+    if ( 0 == self->uint16RdByteLen ) {
+        IICMB_REG_WR(self, MADR, self->uint8Adr | IICMB_I2C_WR);
+        IICMB_REG_WR(self, MLEN, self->uint16WrByteLen);
+    } else {
+        IICMB_REG_WR(self, MADR, self->uint8Adr | IICMB_I2C_RD);
+        IICMB_REG_WR(self, MLEN, self->uint16RdByteLen);
+    }
+    IICMB_REG_WR(self, MRSW, (0 != self->uint16RdByteLen) ? self->uint16WrByteLen : 0);
+#endif
+#ifdef IICMB_IRQ_CTRL
+    /* interrupt mode of caller */
+    iicmb_irq_load(self, self->uint32Icr);
+#endif
+    /* FSM first, IRQ can follow immediately */
+    self->fsm = IICMB_MSG;
+    /* pure read, no write data */
+    if ( 0 == self->uint16WrByteLen ) {
+        IICMB_REG_WR(self, CMDR, IICMB_CMD_MSG);
+        return 0;
+    }
+    /* write data, last byte with command */
+    while ( self->uint16WrByteIs < (self->uint16WrByteLen - 1) ) {
+        IICMB_REG_WR(self, DPR, iicmb_wr_next(self));
+    }
+    IICMB_REG_CMD(self, IICMB_CMD_MSG, iicmb_wr_next(self));
     return 0;
 }
+#endif
+
 
 
 /**
- *  iicmb_busy_wait
- *    wait for completion of last command with busy wait
+ *  @brief timing load
+ *
+ *  loads the SCL timing of a bus or the High-speed mode
+ *  into the IICMB core, only allowed if no transfer is active
+ *
+ *  @param[in,out]  self                driver handle
+ *  @param[in]      sel                 I2C bus number or IICMB_TSEL_HS
+ *  @param[in]      *timing             timing, NULL for synthesis timing
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
  */
-int iicmb_busy_wait(t_iicmb *self)
+#ifdef IICMB_TIMING
+static void iicmb_timing_load(t_iicmb *self, uint8_t sel, const t_iicmb_timing *timing)
 {
+    /** Variables **/
+    uint8_t     uint8Act = (IICMB_TSEL_HS == sel) ? IICMB_BUS_NUM : sel;   // High-speed is last
+
     /* Function call message */
     iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
-    /* poll until completion */
-    uint8_t uint8Rsp = (uint8_t) ~IICMB_RSP;
+    /* synthesis timing */
+    if ( NULL == timing ) {
+        IICMB_REG_WR(self, TSEL, IICMB_TSEL_DEF | sel);
+        self->timingAct[uint8Act] = NULL;
+        return;
+    }
+    /* user timing, low byte first */
+    IICMB_REG_WR(self, TSEL, sel);
+    IICMB_REG_WR(self, TSCL[0], timing->uint16Scl);
+    IICMB_REG_WR(self, TSCL[1], timing->uint16Scl >> 8);
+    IICMB_REG_WR(self, THIGH[0], timing->uint16High);
+    IICMB_REG_WR(self, THIGH[1], timing->uint16High >> 8);
+    IICMB_REG_WR(self, TSUSTA[0], timing->uint16SuSta);
+    IICMB_REG_WR(self, TSUSTA[1], timing->uint16SuSta >> 8);
+    IICMB_REG_WR(self, THDSTA[0], timing->uint16HdSta);
+    IICMB_REG_WR(self, THDSTA[1], timing->uint16HdSta >> 8);
+    IICMB_REG_WR(self, TSUDAT[0], timing->uint16SuDat);
+    IICMB_REG_WR(self, TSUDAT[1], timing->uint16SuDat >> 8);
+    IICMB_REG_WR(self, TSUSTO[0], timing->uint16SuSto);
+    IICMB_REG_WR(self, TSUSTO[1], timing->uint16SuSto >> 8);
+    IICMB_REG_WR(self, TBUF[0], timing->uint16Buf);
+    IICMB_REG_WR(self, TBUF[1], timing->uint16Buf >> 8);
+    IICMB_REG_WR(self, TVDDAT[0], timing->uint16VdDat);
+    IICMB_REG_WR(self, TVDDAT[1], timing->uint16VdDat >> 8);
+    self->timingAct[uint8Act] = timing;
+}
+#endif
+
+
+
+/**
+ *  @brief transfer start
+ *
+ *  loads the active descriptor of the transfer queue
+ *  and sends the start bit
+ *
+ *  @param[in,out]  self                driver handle
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static void iicmb_xfer_start(t_iicmb *self)
+{
+    /** Variables **/
+    t_iicmb_queue   *queue = &(self->queue[self->uint8BusAct]); // queue of active bus
+    t_iicmb_xfer    *xfer = &(queue->xfer[queue->uint8Tail & (IICMB_QUEUE_LEN - 1)]);   // active descriptor
+
+    /* Function call message */
+    iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* load request */
+    self->uint8Adr = xfer->uint8Adr;
+    self->uint8WrRd = xfer->uint8WrRd;
+    self->uint16WrByteLen = xfer->uint16WrByteLen;
+    self->uint16WrByteIs = 0;
+    self->uint16RdByteLen = xfer->uint16RdByteLen;
+    self->uint16RdByteIs = 0;
+    self->segWr = xfer->segWr;
+    self->uint16WrSegIs = 0;
+    self->segRd = xfer->segRd;
+    self->uint16RdSegIs = 0;
+#ifdef IICMB_TIMING
+    /* bus timing changed, bus is free */
+    if ( xfer->timing != self->timingAct[self->uint8BusAct] ) {
+        iicmb_timing_load(self, self->uint8BusAct, xfer->timing);
+    }
+    /* High-speed mode timing changed, shared by all buses */
+    if ( (0 != xfer->uint8Hscr) && (xfer->timingHs != self->timingAct[IICMB_BUS_NUM]) ) {
+        iicmb_timing_load(self, IICMB_TSEL_HS, xfer->timingHs);
+    }
+    /* master code is sent with the start */
+    if ( xfer->uint8Hscr != self->uint8HscrAct ) {
+        IICMB_REG_WR(self, HSCR, xfer->uint8Hscr);
+        self->uint8HscrAct = xfer->uint8Hscr;
+    }
+#endif
+    IICMB_TRACE(self, IICMB_TRC_START, xfer->uint8Adr);
+#if IICMB_FIFO_DEPTH > 0
+    /* complete message by IICMB */
+    if ( 0 == iicmb_fifo_msg(self) ) {
+        return;
+    }
+#endif
+#ifdef IICMB_IRQ_CTRL
+    /* every command interrupts */
+    iicmb_irq_load(self, IICMB_IRQ_CMD(self));
+#endif
+    /* write or read path */
+    if ( 0 != self->uint16WrByteLen ) {
+        self->fsm = IICMB_WR_ADR_SET;
+    } else {
+        self->fsm = IICMB_RD_ADR_SET;
+    }
+    /* issue request */
+    (void) iicmb_start_bit(self);   // sent start bit, triggers first IRQ
+}
+
+
+
+/**
+ *  @brief transfer backoff
+ *
+ *  issues the IICMB wait command before replay of the active
+ *  transfer, the wait doubles with every attempt
+ *
+ *  @param[in,out]  self                driver handle
+ *  @return         int                 state
+ *  @retval         0                   wait issued, replay on next IRQ
+ *  @retval         -1                  no attempts left
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static int iicmb_xfer_backoff(t_iicmb *self)
+{
+    /** Variables **/
+    t_iicmb_queue   *queue = &(self->queue[self->uint8BusAct]); // queue of active bus
+    t_iicmb_xfer    *xfer = &(queue->xfer[queue->uint8Tail & (IICMB_QUEUE_LEN - 1)]);   // active descriptor
+    uint32_t        uint32Ms;   // backoff
+
+    /* Function call message */
+    iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* attempts left? */
+    if ( xfer->uint8RetryCnt >= xfer->retry.uint8Max ) {
+        return -1;
+    }
+    /* exponential backoff, saturated to max. wait of IICMB */
+    uint32Ms = (uint32_t) xfer->retry.uint8WaitMs << ((xfer->uint8RetryCnt < 8) ? xfer->uint8RetryCnt : 8);
+    if ( 255 < uint32Ms ) {
+        uint32Ms = 255;
+    }
+    xfer->uint8RetryCnt++;
+#ifdef IICMB_STATS
+    iicmb_stats_reset(self, self->uint8BusAct);
+    self->stats[self->uint8BusAct].uint32Retry++;
+#endif
+    IICMB_TRACE(self, IICMB_TRC_RETRY, (uint8_t) uint32Ms);
+#ifdef IICMB_IRQ_CTRL
+    iicmb_irq_load(self, IICMB_IRQ_CMD(self));
+#endif
+    /* FSM first, IRQ can follow immediately */
+    self->fsm = IICMB_BACKOFF;
+    IICMB_REG_CMD(self, IICMB_CMD_WAIT, uint32Ms);
+    return 0;
+}
+
+
+
+/**
+ *  @brief scheduler
+ *
+ *  round-robin over all buses with queued transfers, starting
+ *  behind the last served bus. Inserts bus selection if the
+ *  next transfer runs on another bus.
+ *
+ *  @param[in,out]  self                driver handle
+ *  @return         int                 state
+ *  @retval         0                   next transfer started
+ *  @retval         -1                  all queues empty, IICMB idle
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static int iicmb_xfer_sched(t_iicmb *self)
+{
+    /** Variables **/
+    uint8_t uint8Bus;   // bus candidate
+    uint8_t uint8Iter;  // loop counter
+
+    /* Function call message */
+    iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* search next bus with pending work, last served bus is checked last */
+    for ( uint8Iter = 1; uint8Iter <= IICMB_BUS_NUM; uint8Iter++ ) {
+        uint8Bus = (uint8_t) ((self->uint8BusAct + uint8Iter) % IICMB_BUS_NUM);
+        if ( self->queue[uint8Bus].uint8Head != self->queue[uint8Bus].uint8Tail ) {
+            self->uint8BusAct = uint8Bus;
+            IICMB_TRACE(self, IICMB_TRC_SUBMIT, (uint8_t) (self->queue[uint8Bus].uint8Head - self->queue[uint8Bus].uint8Tail));
+            /* error of transfer only */
+            self->errorPrev = self->error;
+            self->error = IICMB_E_NO;
+            /* same bus, start immediately */
+            if ( uint8Bus == self->uint8BusSel ) {
+                iicmb_xfer_start(self);
+                return 0;
+            }
+            /* select bus, FSM first, IRQ can follow immediately */
+#ifdef IICMB_IRQ_CTRL
+            iicmb_irq_load(self, IICMB_IRQ_CMD(self));
+#endif
+            self->fsm = IICMB_SET_BUS;
+            IICMB_REG_CMD(self, IICMB_CMD_SET_BUS, uint8Bus);
+            return 0;
+        }
+    }
+    /* nothing to do */
+    self->fsm = IICMB_IDLE;
+    return -1;
+}
+
+
+
+/**
+ *  @brief next transfer
+ *
+ *  releases the active descriptor and starts the next
+ *  queued transfer without leaving the ISR
+ *
+ *  @param[in,out]  self                driver handle
+ *  @return         int                 state
+ *  @retval         0                   next transfer started
+ *  @retval         -1                  queue empty, IICMB idle
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static int iicmb_xfer_next(t_iicmb *self)
+{
+    /** Variables **/
+    t_iicmb_queue   *queue = &(self->queue[self->uint8BusAct]); // queue of active bus
+    t_iicmb_xfer    *xfer = &(queue->xfer[queue->uint8Tail & (IICMB_QUEUE_LEN - 1)]);   // active descriptor
+    t_iicmb_cb      cb = xfer->cb;              // completion callback
+    void            *ctx = xfer->ctx;           // user context
+    t_iicmb_ero     error = self->error;        // result of transfer
+
+    /* Function call message */
+    iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    IICMB_TRACE(self, IICMB_TRC_DONE, (uint8_t) error);
+#ifdef IICMB_STATS
+    iicmb_stats_done(self, xfer, error);
+#endif
+    /* keep first error since queue start */
+    if ( IICMB_E_NO != self->errorPrev ) {
+        self->error = self->errorPrev;
+    }
+    /* release active descriptor, callback can submit into the free entry */
+    queue->uint8Tail = (uint8_t) (queue->uint8Tail + 1);
+    /* notify */
+    if ( NULL != cb ) {
+        cb(self, ctx, error, self->uint16WrByteIs, self->uint16RdByteIs);
+    }
+    /* next bus */
+    return iicmb_xfer_sched(self);
+}
+
+
+
+/**
+ *  @brief transfer submit
+ *
+ *  appends request to the transfer queue of the bus, starts
+ *  the transfer if the IICMB is idle. Single segments are
+ *  copied into the descriptor.
+ *
+ *  @param[in,out]  self                driver handle
+ *  @param[in]      bus                 I2C bus number
+ *  @param[in]      adr7                Slave address (7bit)
+ *  @param[in]      *wr                 write segments
+ *  @param[in]      wrNum               number of write segments
+ *  @param[in]      *rd                 read segments
+ *  @param[in]      rdNum               number of read segments
+ *  @param[in]      cb                  completion callback
+ *  @param[in]      *ctx                user context of callback
+ *  @return         int                 state
+ *  @retval         IICMB_EXIT_OK       OK: Transfer request accepted
+ *  @retval         IICMB_EXIT_BUSY     FAIL: Transfer queue full
+ *  @retval         IICMB_EXIT_OCC      FAIL: I2C bus is occupied by another master
+ *  @retval         IICMB_EXIT_ERROR    FAIL: Bus number out of range or too many bytes
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static int iicmb_xfer_submit(t_iicmb *self, uint8_t bus, uint8_t adr7, const t_iicmb_seg *wr, uint8_t wrNum, const t_iicmb_seg *rd, uint8_t rdNum, t_iicmb_cb cb, void *ctx)
+{
+    /** Variables **/
+    t_iicmb_queue   *queue; // queue of requested bus
+    t_iicmb_xfer    *xfer;  // free descriptor
+    uint8_t         uint8Occ = 0;       // bus occupied, start with backoff
+    uint32_t        uint32WrLen = 0;    // total write bytes
+    uint32_t        uint32RdLen = 0;    // total read bytes
+    uint8_t         uint8Iter;          // loop counter
+
+    /* Function call message */
+    iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* check bus */
+    if ( IICMB_BUS_NUM <= bus ) {
+        return IICMB_EXIT_ERROR;
+    }
+    /* total length */
+    for ( uint8Iter = 0; uint8Iter < wrNum; uint8Iter++ ) {
+        uint32WrLen += wr[uint8Iter].uint16Len;
+    }
+    for ( uint8Iter = 0; uint8Iter < rdNum; uint8Iter++ ) {
+        uint32RdLen += rd[uint8Iter].uint16Len;
+    }
+    if ( (UINT16_MAX < uint32WrLen) || (UINT16_MAX < uint32RdLen) ) {
+        return IICMB_EXIT_ERROR;
+    }
+    /* check for empty data set, nothing to wait for */
+    if ( (0 == uint32WrLen) && (0 == uint32RdLen) ) {
+        if ( NULL != cb ) {
+            cb(self, ctx, IICMB_E_NO, 0, 0);
+        }
+        return IICMB_EXIT_OK;
+    }
+    queue = &(self->queue[bus]);
+    /* check for free descriptor */
+    if ( IICMB_QUEUE_LEN <= (uint8_t) (queue->uint8Head - queue->uint8Tail) ) {
+#ifdef IICMB_STATS
+        self->uint32StatsFull[bus]++;
+#endif
+        return IICMB_EXIT_BUSY; // queue full
+    }
+    /* check for bus occupation, only possible for the selected bus if not in IICMBs hand */
+    if ( (IICMB_IDLE == self->fsm) && (bus == self->uint8BusSel) ) {
+        if ( (0 != (IICMB_REG_RD(self, CSR) & IICMB_CSR_BB)) && (0 == (IICMB_REG_RD(self, CSR) & IICMB_CSR_BC)) ) {
+            if ( 0 == self->retry[bus].uint8Max ) {
+#ifdef IICMB_STATS
+                self->uint32StatsOcc[bus]++;
+#endif
+                return IICMB_EXIT_OCC;  // i2c by other master occupied
+            }
+            uint8Occ = 1;   // retry policy waits for the bus
+        }
+    }
+    /* set-up descriptor */
+    xfer = &(queue->xfer[queue->uint8Head & (IICMB_QUEUE_LEN - 1)]);
+    xfer->uint8Adr = (uint8_t) (adr7 << 1); // prepare address for Read/Write bit set
+    xfer->uint8WrRd = (uint8_t) ((0 != uint32WrLen) && (0 != uint32RdLen));
+    xfer->uint16WrByteLen = (uint16_t) uint32WrLen;
+    xfer->uint16RdByteLen = (uint16_t) uint32RdLen;
+    xfer->segWr = wr;
+    if ( 1 == wrNum ) {
+        xfer->segWrOne = *wr;
+        xfer->segWr = &(xfer->segWrOne);
+    }
+    xfer->segRd = rd;
+    if ( 1 == rdNum ) {
+        xfer->segRdOne = *rd;
+        xfer->segRd = &(xfer->segRdOne);
+    }
+    xfer->retry = self->retry[bus];
+    xfer->uint8RetryCnt = 0;
+    xfer->cb = cb;
+    xfer->ctx = ctx;
+#ifdef IICMB_TIMING
+    xfer->timing = self->timing[bus];
+    xfer->timingHs = self->timingHs[bus];
+    xfer->uint8Hscr = self->uint8Hscr[bus];
+#endif
+#ifdef IICMB_STATS
+    xfer->uint32Submit = iicmb_trace_time(self->iicmb);
+#endif
+    /* publish, from here on the ISR can start the transfer */
+    queue->uint8Head = (uint8_t) (queue->uint8Head + 1);
+    /* IICMB idle, start transfer */
+    if ( IICMB_IDLE == self->fsm ) {
+        self->error = IICMB_E_NO;
+        /* occupied bus, queue is empty and bus selected */
+        if ( 0 != uint8Occ ) {
+            self->uint8BusAct = bus;
+            self->errorPrev = IICMB_E_NO;
+            IICMB_TRACE(self, IICMB_TRC_SUBMIT, (uint8_t) (queue->uint8Head - queue->uint8Tail));
+            (void) iicmb_xfer_backoff(self);
+            return IICMB_EXIT_OK;
+        }
+        (void) iicmb_xfer_sched(self);
+    }
+    return IICMB_EXIT_OK;   // normal end
+}
+
+
+
+/**
+ *  @brief Satus decode
+ *
+ *  Decodes IICMB last transfer status
+ *
+ *  @param[in,out]  self                driver handle
+ *  @param[in]      cmdReg              read command register value
+ *  @return         int                 state
+ *  @retval         0                   OKAY
+ *  @retval         -1                  FAIL, leave ISR with error
+ *  @since          2023-02-25
+ *  @author         Andreas Kaeberlein
+ */
+static int iicmb_status_decode(t_iicmb *self, uint8_t cmdReg)
+{
+    /* Function call message */
+    iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* Check for Eros in last transfer */
+    switch (cmdReg & IICMB_RSP) {
+        /* normal: last command done */
+        case IICMB_RSP_DONE:
+            iicmb_printf("  INFO:CMDR: done\n");
+            break;
+        /* normal: last byte nck */
+        case IICMB_RSP_NAK:
+            iicmb_printf("  INFO:CMDR: data NCK\n");
+            break;
+        /* exception: arbitration lost */
+        case IICMB_RSP_ARB_LOST:
+            iicmb_printf("  ERROR:CMDR: arbitration lost\n");
+            IICMB_TRACE(self, IICMB_TRC_ERROR, cmdReg);
+#if IICMB_FIFO_DEPTH > 0
+            iicmb_fifo_drop(self);          // bytes of aborted write/read command
+#endif
+            /* replay after backoff */
+            if ( 0 == iicmb_xfer_backoff(self) ) {
+                return -1;
+            }
+            self->error = IICMB_E_ARBLOST;  // arbitration lost
+            (void) iicmb_xfer_next(self);   // bus released by IICMB, no stop bit required
+            return -1;
+        /* exception: IICMB unknown error */
+        case IICMB_RSP_ERR:
+            iicmb_printf("  ERROR:CMDR: IICMB unkown error\n");
+            IICMB_TRACE(self, IICMB_TRC_ERROR, cmdReg);
+            self->error = IICMB_E_IICMB;    // I2C controller runs into error
+#if IICMB_FIFO_DEPTH > 0
+            iicmb_fifo_drop(self);
+#endif
+            (void) iicmb_xfer_next(self);
+            return -1;
+        /* all okay */
+        default:
+            iicmb_printf("  ERROR:CMDR: soft FSM unknown error\n");
+            IICMB_TRACE(self, IICMB_TRC_ERROR, cmdReg);
+            self->error = IICMB_E_UNKNOWN;  // unknown error in IICMB
+            return -1;
+    }
+    /* normal end */
+    return 0;
+}
+
+
+
+/**
+ *  iicmb_set_bus
+ *    set bus number
+ */
+int iicmb_set_bus(t_iicmb *self, uint8_t num)
+{
+    /* Function call message */
+    iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* check bus */
+    if ( IICMB_BUS_NUM <= num ) {
+        return -1;
+    }
+    /* default bus for transfers */
+    self->uint8BusDef = num;
+    /* transfer active, scheduler selects the bus */
+    if ( IICMB_IDLE != self->fsm ) {
+        return 0;
+    }
+    /* set bus number */
+    IICMB_REG_WR(self, DPR, (uint8_t) (num & IICMB_CSR_BUS)); // preload data/parameter register
+    IICMB_REG_WR(self, CMDR, IICMB_CMD_SET_BUS);              // set bus id
+    /* check for setting */
+    if ( num != (IICMB_REG_RD(self, CSR) & IICMB_CSR_BUS) ) {
+        return -1;
+    }
+    self->uint8BusSel = num;
+    self->uint8BusAct = num;
+    /* graceful end */
+    return 0;
+}
+
+
+/**
+ *  iicmb_init
+ *    init sw handle and IICMB core
+ */
+int iicmb_init(t_iicmb *self, void* iicmbAdr, uint8_t bus)
+{
+    /** Variables **/
+    int     ret = 0;    // common return value
+    uint8_t uint8Bus;   // loop counter
+
+    /* Function call message */
+    iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* Init driver handle */
+    self->iicmb = (t_iicm_reg*) iicmbAdr;   // register set of IICMB
+    self->fsm = IICMB_IDLE;     // Soft I2C state machine
+    self->uint8WrRd = 0;        // no write/read interaction requested
+    self->error = IICMB_E_NO;   // Driver runs without error
+    self->errorPrev = IICMB_E_NO;
+#if IICMB_TRACE_LEN > 0
+    self->trace.uint32Head = 0; // empty trace
+#endif
+#ifdef IICMB_STATS
+    memset(self->stats, 0, sizeof(self->stats));
+    memset((void*) self->uint8StatsClr, 0, sizeof(self->uint8StatsClr));
+    memset(self->uint32StatsOcc, 0, sizeof(self->uint32StatsOcc));
+    memset(self->uint32StatsFull, 0, sizeof(self->uint32StatsFull));
+#endif
+    self->uint16WrByteLen = 0;  // Total Number of Bytes to transfer
+    self->uint16WrByteIs = 0;   // Number of Bytes processed (Sent/Receive)
+    self->segWr = NULL;         // Write segment
+    self->uint16WrSegIs = 0;
+    self->segRd = NULL;         // Read segment
+    self->uint16RdSegIs = 0;
+    for ( uint8Bus = 0; uint8Bus < IICMB_BUS_NUM; uint8Bus++ ) {
+        self->queue[uint8Bus].uint8Head = 0;    // Transfer queue empty
+        self->queue[uint8Bus].uint8Tail = 0;
+        self->retry[uint8Bus].uint8Max = 0;     // no retry
+        self->retry[uint8Bus].uint8WaitMs = 0;
+#ifdef IICMB_TIMING
+        self->timing[uint8Bus] = NULL;          // synthesis timing
+        self->timingHs[uint8Bus] = NULL;
+        self->uint8Hscr[uint8Bus] = 0;          // Fast mode
+        self->timingAct[uint8Bus] = NULL;
+#endif
+    }
+#ifdef IICMB_TIMING
+    self->timingAct[IICMB_BUS_NUM] = NULL;
+    self->uint8HscrAct = 0;
+#endif
+    self->uint8BusDef = bus;    // I2C bus
+    self->uint8BusAct = bus;
+    self->uint8BusSel = bus;
+    /* init core */
+    ret |= iicmb_disable(self);         // core disable, resets IICMB
+    ret |= iicmb_enable(self);          // enable IICMB, commands are ignored while disabled
+#if IICMB_FIFO_DEPTH > 0
+    if ( IICMB_FIFO_DEPTH != IICMB_REG_RD(self, FDEPTH) ) {
+        ret |= -1;  // HDL generic 'g_fifo_depth' does not match
+    }
+    IICMB_REG_WR(self, FCR, IICMB_FCR_TXC | IICMB_FCR_RXC);    // empty FIFOs, FIFO IRQs disabled
+    IICMB_REG_WR(self, FRCNT, 0);       // single byte read
+    self->uint8FifoRcnt = 0;
+#endif
+#ifdef IICMB_TIMING
+    for ( uint8Bus = 0; uint8Bus < IICMB_BUS_NUM; uint8Bus++ ) {
+        iicmb_timing_load(self, uint8Bus, NULL);    // timing registers survive core disable
+    }
+    iicmb_timing_load(self, IICMB_TSEL_HS, NULL);
+    IICMB_REG_WR(self, HSCR, 0);
+#endif
+#ifdef IICMB_IRQ_CTRL
+    self->uint32Icr = IICMB_IMSK_ALL | IICMB_IMSK_EOT;  // registers survive core disable
+    self->uint32IcrAct = 0;
+    iicmb_irq_load(self, IICMB_IMSK_ALL);
+#endif
+#ifdef IICMB_PERF
+    IICMB_REG_WR(self, PCR, IICMB_PCR_CLR);     // counters survive core disable
+    memset(self->uint32Perf, 0, sizeof(self->uint32Perf));
+#endif
+    ret |= iicmb_set_bus(self, bus);    // init with bus desired bus number
+    ret |= iicmb_irq_enable(self);      // enable IRQs, bus selection raises no IRQ
+    /* end */
+    return ret;
+}
+
+
+/**
+ *  iicmb_close
+ *    make driver invalid
+ */
+int iicmb_close(t_iicmb *self)
+{
+    /** Variables **/
+    uint8_t uint8Bus;   // loop counter
+
+    /* Function call message */
+    iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* Disable IRQ */
+    iicmb_irq_disable(self);    // mask all IRQs
+    iicmb_disable(self);        // core disable
+    /* drop queued transfers */
+    self->fsm = IICMB_IDLE;
+    for ( uint8Bus = 0; uint8Bus < IICMB_BUS_NUM; uint8Bus++ ) {
+        self->queue[uint8Bus].uint8Tail = self->queue[uint8Bus].uint8Head;
+    }
+    /* make handle invalid */
+    self->iicmb = NULL; // invalid register handle
+    /* end */
+    return 0;
+}
+
+
+/**
+ *  iicmb_busy_wait
+ *    wait for completion of last command with busy wait
+ */
+int iicmb_busy_wait(t_iicmb *self)
+{
+    /* Function call message */
+    iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* poll until completion */
+    uint8_t uint8Rsp = (uint8_t) ~IICMB_RSP;
     while ( IICMB_RSP_COMPLETED == (uint8Rsp & IICMB_RSP) ) {
-        uint8Rsp = self->iicmb->CMDR;
+        uint8Rsp = IICMB_REG_RD(self, CMDR);
     }
     /* graceful end */
     return 0;
@@ -384,7 +1340,17 @@ void iicmb_fsm(t_iicmb *self)
     /* Function call message */
     iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
     /* read command register */
-    uint8_t uint8CmdReg = self->iicmb->CMDR;    // clears IRQ, and read data
+#ifdef IICMB_REG_32
+    uint32_t uint32Reg = IICMB_REG_RD32(self, CSR);     // clears IRQ, status and read data with one access
+    uint8_t uint8CmdReg = (uint8_t) (uint32Reg >> IICMB_REG32_CMDR);
+    uint8_t uint8RxData = (uint8_t) (uint32Reg >> IICMB_REG32_DPR);
+#else
+    uint8_t uint8CmdReg = IICMB_REG_RD(self, CMDR);    // clears IRQ, and read data
+#endif
+#if IICMB_FIFO_DEPTH > 0
+    uint16_t uint16Iter;    // FIFO bytes
+#endif
+    IICMB_TRACE(self, IICMB_TRC_ISR, uint8CmdReg);
     /* read/write/idle */
     switch (self->fsm) {
         /*
@@ -399,11 +1365,12 @@ void iicmb_fsm(t_iicmb *self)
             if ( 0 != iicmb_status_decode(self, uint8CmdReg) ) {
                 return; // error leave
             }
-            /* check for complete transfer */
-            if ( !((self->uint16WrByteLen == self->uint16WrByteIs) && (self->uint16RdByteLen == self->uint16RdByteIs)) ) {
+            /* check for complete transfer, keep root cause */
+            if ( (IICMB_E_NO == self->error) && !((self->uint16WrByteLen == self->uint16WrByteIs) && (self->uint16RdByteLen == self->uint16RdByteIs)) ) {
                 self->error = IICMB_E_ICTF; // transfer not complete
             }
-            self->fsm = IICMB_IDLE; // transfer done
+            /* transfer done, start next queued transfer */
+            (void) iicmb_xfer_next(self);
             /* leave */
             return;
         /*
@@ -416,8 +1383,7 @@ void iicmb_fsm(t_iicmb *self)
                 return; // error exit
             }
             /* iicm_byte_write */
-            self->iicmb->DPR = (uint8_t) (self->uint8Adr | IICMB_I2C_WR);   // assemble write address
-            self->iicmb->CMDR = IICMB_CMD_WRITE;    // ICMB command
+            IICMB_REG_CMD(self, IICMB_CMD_WRITE, self->uint8Adr | IICMB_I2C_WR);  // assemble write address
             /* Update FSM */
             self->fsm = IICMB_WR_ADR_CHK;   // go one with data transfer
             return; // wait for next IRQ
@@ -444,6 +1410,9 @@ void iicmb_fsm(t_iicmb *self)
             }
             /* last byte succesfull? */
             if ( IICMB_RSP_NAK == (uint8CmdReg & IICMB_RSP) ) {
+#if IICMB_FIFO_DEPTH > 0
+                iicmb_fifo_drop(self);  // bytes behind NCK not sent
+#endif
                 /* prepare IDLE on bus */
                 self->fsm = IICMB_WT_IDLE;
                 (void) iicmb_stop_bit(self);
@@ -463,11 +1432,14 @@ void iicmb_fsm(t_iicmb *self)
                 }
                 return; // leave, trigger with next IRQ
             }
-            /* write next byte to IICMB */
-            self->iicmb->DPR = (self->uint8PtrData)[self->uint16WrByteIs];
-            self->iicmb->CMDR = IICMB_CMD_WRITE;
-            /* data pointer update */
-            ++(self->uint16WrByteIs);
+#if IICMB_FIFO_DEPTH > 0
+            /* fill TX FIFO, one write command sends all bytes, last byte with command */
+            for ( uint16Iter = 1; (uint16Iter < IICMB_FIFO_DEPTH) && (self->uint16WrByteIs < (self->uint16WrByteLen - 1)); uint16Iter++ ) {
+                IICMB_REG_WR(self, DPR, iicmb_wr_next(self));
+            }
+#endif
+            /* write next byte to IICMB, data pointer update */
+            IICMB_REG_CMD(self, IICMB_CMD_WRITE, iicmb_wr_next(self));
             return; // leave, trigger with next IRQ
         /*
          *  READ States
@@ -480,8 +1452,7 @@ void iicmb_fsm(t_iicmb *self)
                 return; // error exit
             }
             /* iicm_byte_write */
-            self->iicmb->DPR = (uint8_t) (self->uint8Adr | IICMB_I2C_RD);  // assemble read address
-            self->iicmb->CMDR = IICMB_CMD_WRITE;    // IICMB command
+            IICMB_REG_CMD(self, IICMB_CMD_WRITE, self->uint8Adr | IICMB_I2C_RD);  // assemble read address
             /* update FSM */
             self->fsm = IICMB_RD_ADR_CHK;   // check slave is responsible
             return; // leave, trigger with next IRQ
@@ -500,19 +1471,34 @@ void iicmb_fsm(t_iicmb *self)
             }
             /* next state read byte */
             self->fsm = IICMB_RD_BYTE;
+#if IICMB_FIFO_DEPTH > 0
+            /* first chunk into RX FIFO */
+            iicmb_fifo_read(self);
+            return; // leave ISR, wait for transfer
+#endif
             /* Request =1Byte */
             if ( 1 == self->uint16RdByteLen ) { // only one byte requested, read NCK
-                self->iicmb->CMDR = IICMB_CMD_READ_NAK;
+                IICMB_REG_WR(self, CMDR, IICMB_CMD_READ_NAK);
                 return; // leave ISR, wait for transfer
             }
-            /* Request >1Byte */
-            self->iicmb->CMDR = IICMB_CMD_READ_ACK;
-            return; // leave ISR, wait for transfer
-        /* Read: Byte Request */
-        case IICMB_RD_BYTE:
+            /* Request >1Byte */
+            IICMB_REG_WR(self, CMDR, IICMB_CMD_READ_ACK);
+            return; // leave ISR, wait for transfer
+        /* Read: Byte Request */
+        case IICMB_RD_BYTE:
+#if IICMB_FIFO_DEPTH > 0
+            /* IICMB encoutered error? */
+            if ( 0 != iicmb_status_decode(self, uint8CmdReg) ) {
+                return; // error exit
+            }
+            /* capture values of read command */
+            for ( uint16Iter = 0; (uint16Iter < IICMB_FIFO_DEPTH) && (self->uint16RdByteIs < self->uint16RdByteLen); uint16Iter++ ) {
+                iicmb_rd_put(self, IICMB_RX_BYTE(self, 0 == uint16Iter, uint8RxData));
+            }
+#else
             /* capture value */
-            (self->uint8PtrData)[self->uint16RdByteIs] = self->iicmb->DPR;
-            ++(self->uint16RdByteIs);
+            iicmb_rd_put(self, IICMB_RX_BYTE(self, 1, uint8RxData));
+#endif
             /* last byte sent */
             if ( self->uint16RdByteIs == self->uint16RdByteLen ) {
                 /* last byte sent */
@@ -520,14 +1506,83 @@ void iicmb_fsm(t_iicmb *self)
                 (void) iicmb_stop_bit(self);
                 return; // leave ISR
             }
+#if IICMB_FIFO_DEPTH > 0
+            /* next chunk */
+            iicmb_fifo_read(self);
+            return; // leave ISR, trigger with next IRQ
+#endif
             /* More Bytes Pending, Read with ACK */
             if ( (self->uint16RdByteIs) < ((self->uint16RdByteLen)-1) ) {
-                self->iicmb->CMDR = IICMB_CMD_READ_ACK;
+                IICMB_REG_WR(self, CMDR, IICMB_CMD_READ_ACK);
                 return; // leave ISR, wait for transfer
             }
             /* Last Byte Pending, Read with NCK */
-            self->iicmb->CMDR = IICMB_CMD_READ_NAK;
+            IICMB_REG_WR(self, CMDR, IICMB_CMD_READ_NAK);
             return; // leave ISR, trigger with next IRQ
+#if IICMB_FIFO_DEPTH > 0
+        /*
+         *  MESSAGE States
+         *    complete transfer by IICMB, stop bit already sent
+         */
+        case IICMB_MSG:
+            /* IICMB encoutered error? */
+            if ( 0 != iicmb_status_decode(self, uint8CmdReg) ) {
+                return; // error exit
+            }
+            /* NCK on slave address or data byte */
+            if ( IICMB_RSP_NAK == (uint8CmdReg & IICMB_RSP) ) {
+                if ( 0 == IICMB_REG_RD(self, MCNT) ) {
+                    self->error = IICMB_E_NOSLAVE;  // NCK on address byte
+                }
+                iicmb_fifo_drop(self);  // bytes behind NCK not sent
+            } else {
+                /* capture read data */
+                while ( self->uint16RdByteIs < self->uint16RdByteLen ) {
+                    iicmb_rd_put(self, IICMB_RX_BYTE(self, 0 == self->uint16RdByteIs, uint8RxData));
+                }
+            }
+            /* check for complete transfer, keep root cause */
+            if ( (IICMB_E_NO == self->error) && !((self->uint16WrByteLen == self->uint16WrByteIs) && (self->uint16RdByteLen == self->uint16RdByteIs)) ) {
+                self->error = IICMB_E_ICTF; // transfer not complete
+            }
+            /* transfer done, start next queued transfer */
+            (void) iicmb_xfer_next(self);
+            return;
+#endif
+        /*
+         *  RETRY States
+         *    backoff done, replay transfer
+         */
+        case IICMB_BACKOFF:
+            /* IICMB encoutered error? */
+            if ( 0 != iicmb_status_decode(self, uint8CmdReg) ) {
+                return; // error exit
+            }
+            /* other master still active */
+            if ( (0 != (IICMB_REG_RD(self, CSR) & IICMB_CSR_BB)) && (0 == (IICMB_REG_RD(self, CSR) & IICMB_CSR_BC)) ) {
+                if ( 0 == iicmb_xfer_backoff(self) ) {
+                    return; // leave, trigger with next IRQ
+                }
+                self->error = IICMB_E_BUSOCC;
+                (void) iicmb_xfer_next(self);
+                return;
+            }
+            /* replay complete transfer */
+            iicmb_xfer_start(self);
+            return; // leave, trigger with next IRQ
+        /*
+         *  BUS States
+         *    switch I2C bus
+         */
+        case IICMB_SET_BUS:
+            /* IICMB encoutered error?, f.e. bus not implemented */
+            if ( 0 != iicmb_status_decode(self, uint8CmdReg) ) {
+                return; // error exit
+            }
+            /* start transfer on selected bus */
+            self->uint8BusSel = self->uint8BusAct;
+            iicmb_xfer_start(self);
+            return; // leave, trigger with next IRQ
         /* something unexpedted */
         default:
             self->error = IICMB_E_FSM;  // non designed path of FSM used
@@ -545,10 +1600,18 @@ void iicmb_fsm(t_iicmb *self)
 int iicmb_busy(t_iicmb *self)
 {
     iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
-    if ( IICMB_IDLE == self->fsm ) {
-        return 0;
+    /** Variables **/
+    uint8_t uint8Bus;   // loop counter
+
+    if ( IICMB_IDLE != self->fsm ) {
+        return -1;
     }
-    return -1;
+    for ( uint8Bus = 0; uint8Bus < IICMB_BUS_NUM; uint8Bus++ ) {
+        if ( self->queue[uint8Bus].uint8Head != self->queue[uint8Bus].uint8Tail ) {
+            return -1;
+        }
+    }
+    return 0;
 }
 
 
@@ -580,7 +1643,7 @@ int iicmb_bus_state(t_iicmb *self)
     if ( IICMB_IDLE != self->fsm ) {    // through IICMB makro skew between 'capture' and 'busy_y' evaluation of iicmb.c driver internal state
         return IICMB_EXIT_BUSY; // IICMB transfer active
     } else {
-        if ( 0 != (self->iicmb->CSR & IICMB_CSR_BB) ) { // I2C Bus is busy
+        if ( 0 != (IICMB_REG_RD(self, CSR) & IICMB_CSR_BB) ) { // I2C Bus is busy
             return IICMB_EXIT_OCC;  // bus occupied
         }
     }
@@ -595,29 +1658,7 @@ int iicmb_bus_state(t_iicmb *self)
  */
 int iicmb_write(t_iicmb *self, uint8_t adr7, void* data, uint16_t len)
 {
-    /* check for empty data set */
-    if ( 0 == len ) {
-        return IICMB_EXIT_OK;
-    }
-    /* check for active transfer */
-    if ( IICMB_IDLE != self->fsm ) {
-        return IICMB_EXIT_BUSY; // iicmb is busy with last request
-    }
-    /* check for bus occupation */
-    if ( (0 != (self->iicmb->CSR & IICMB_CSR_BB)) && (0 == (self->iicmb->CSR & IICMB_CSR_BC)) ) {
-        return IICMB_EXIT_OCC;  // i2c by other master occupied
-    }
-    /* set-up next request */
-    self->error = IICMB_E_NO;
-    self->uint8Adr = (uint8_t) (adr7 << 1); // prepare address for Read/Write bit set
-    self->uint16WrByteLen = len;
-    self->uint16WrByteIs = 0;
-    self->uint8PtrData = (uint8_t*) data;
-    self->uint8WrRd = 0;    // only read is performed
-    self->fsm= IICMB_WR_ADR_SET;
-    /* issue request */
-    (void) iicmb_start_bit(self);   // sent start bit, triggers first IRQ
-    return IICMB_EXIT_OK;   // normal end
+    return iicmb_bus_write(self, self->uint8BusDef, adr7, data, len);
 }
 
 
@@ -628,29 +1669,7 @@ int iicmb_write(t_iicmb *self, uint8_t adr7, void* data, uint16_t len)
  */
 int iicmb_read(t_iicmb *self, uint8_t adr7, void* data, uint16_t len)
 {
-    /* check for empty data set */
-    if ( 0 == len ) {
-        return IICMB_EXIT_OK;
-    }
-    /* check for active transfer */
-    if ( IICMB_IDLE != self->fsm ) {
-        return IICMB_EXIT_BUSY; // iicmb is busy with last request
-    }
-    /* check for bus occupation */
-    if ( (0 != (self->iicmb->CSR & IICMB_CSR_BB)) && (0 == (self->iicmb->CSR & IICMB_CSR_BC)) ) {
-        return IICMB_EXIT_OCC;  // i2c by other master occupied
-    }
-    /* set-up next request */
-    self->error = IICMB_E_NO;
-    self->uint8Adr = (uint8_t) (adr7 << 1);
-    self->uint16RdByteLen = len;
-    self->uint16RdByteIs = 0;
-    self->uint8PtrData = (uint8_t*) data;
-    self->uint8WrRd = 0;    // only read is performed
-    self->fsm = IICMB_RD_ADR_SET;
-    /* issue request */
-    (void) iicmb_start_bit(self);   // sent start bit, triggers first IRQ
-    return IICMB_EXIT_OK;   // normal end
+    return iicmb_bus_read(self, self->uint8BusDef, adr7, data, len);
 }
 
 
@@ -661,34 +1680,439 @@ int iicmb_read(t_iicmb *self, uint8_t adr7, void* data, uint16_t len)
  */
 int iicmb_wr_rd(t_iicmb *self, uint8_t adr7, void* data, uint16_t wrLen, uint16_t rdLen)
 {
+    return iicmb_bus_wr_rd(self, self->uint8BusDef, adr7, data, wrLen, rdLen);
+}
+
+
+
+/**
+ *  iicmb_bus_write
+ *    I2C write on selected bus
+ */
+int iicmb_bus_write(t_iicmb *self, uint8_t bus, uint8_t adr7, void* data, uint16_t len)
+{
+    /** Variables **/
+    t_iicmb_seg seg = { (uint8_t*) data, len };
+
+    /* queue request */
+    return iicmb_xfer_submit(self, bus, adr7, &seg, 1, NULL, 0, NULL, NULL);
+}
+
+
+
+/**
+ *  iicmb_bus_read
+ *    I2C read on selected bus
+ */
+int iicmb_bus_read(t_iicmb *self, uint8_t bus, uint8_t adr7, void* data, uint16_t len)
+{
+    /** Variables **/
+    t_iicmb_seg seg = { (uint8_t*) data, len };
+
+    /* queue request */
+    return iicmb_xfer_submit(self, bus, adr7, NULL, 0, &seg, 1, NULL, NULL);
+}
+
+
+
+/**
+ *  iicmb_bus_wr_rd
+ *    perform I2C write, repeated start condition and I2C read on selected bus
+ */
+int iicmb_bus_wr_rd(t_iicmb *self, uint8_t bus, uint8_t adr7, void* data, uint16_t wrLen, uint16_t rdLen)
+{
+    /** Variables **/
+    t_iicmb_seg segWr = { (uint8_t*) data, wrLen };
+    t_iicmb_seg segRd = { (uint8_t*) data, rdLen }; // read overwrites write data
+
     /* check for empty data set */
     if ( (0 == wrLen) && (0 == rdLen) ) {
         return IICMB_EXIT_OK;
     }
-    /* check for active transfer */
-    if ( IICMB_IDLE != self->fsm ) {
-        return IICMB_EXIT_BUSY; // iicmb is busy with last request
-    }
-    /* check for bus occupation */
-    if ( (0 != (self->iicmb->CSR & IICMB_CSR_BB)) && (0 == (self->iicmb->CSR & IICMB_CSR_BC)) ) {
-        return IICMB_EXIT_OCC;  // i2c by other master occupied
-    }
     /* except only write-read transfers, otherwise use dedicated function */
     if ( !((0 != wrLen) && (0 != rdLen)) ) {
         return IICMB_EXIT_ERROR;
     }
-    /* set-up next request */
-    self->error = IICMB_E_NO;
-    self->uint8Adr = (uint8_t) (adr7 << 1); // define address
-    /* write/read request */
-    self->uint8PtrData = (uint8_t*) data;
-    self->uint16WrByteLen = wrLen;
-    self->uint16WrByteIs = 0;
-    self->uint16RdByteLen = rdLen;
-    self->uint16RdByteIs = 0;
-    self->uint8WrRd = 1;    // read after write is performed
-    self->fsm = IICMB_WR_ADR_SET;
-    /* issue request */
-    (void) iicmb_start_bit(self);   // sent start bit, triggers first IRQ
-    return IICMB_EXIT_OK;   // normal end
+    /* queue request, read after write is performed */
+    return iicmb_xfer_submit(self, bus, adr7, &segWr, 1, &segRd, 1, NULL, NULL);
+}
+
+
+
+/**
+ *  iicmb_xfer
+ *    segment transfer on default bus
+ */
+int iicmb_xfer(t_iicmb *self, uint8_t adr7, const t_iicmb_seg *wr, uint8_t wrNum, const t_iicmb_seg *rd, uint8_t rdNum)
+{
+    return iicmb_bus_xfer(self, self->uint8BusDef, adr7, wr, wrNum, rd, rdNum);
+}
+
+
+
+/**
+ *  iicmb_bus_xfer
+ *    segment transfer on selected bus
+ */
+int iicmb_bus_xfer(t_iicmb *self, uint8_t bus, uint8_t adr7, const t_iicmb_seg *wr, uint8_t wrNum, const t_iicmb_seg *rd, uint8_t rdNum)
+{
+    /* queue request */
+    return iicmb_xfer_submit(self, bus, adr7, wr, wrNum, rd, rdNum, NULL, NULL);
+}
+
+
+
+/**
+ *  iicmb_bus_xfer_cb
+ *    segment transfer on selected bus with completion callback
+ */
+int iicmb_bus_xfer_cb(t_iicmb *self, uint8_t bus, uint8_t adr7, const t_iicmb_seg *wr, uint8_t wrNum, const t_iicmb_seg *rd, uint8_t rdNum, t_iicmb_cb cb, void *ctx)
+{
+    /* queue request */
+    return iicmb_xfer_submit(self, bus, adr7, wr, wrNum, rd, rdNum, cb, ctx);
+}
+
+
+
+/**
+ *  iicmb_set_retry
+ *    retry policy of bus
+ */
+int iicmb_set_retry(t_iicmb *self, uint8_t bus, uint8_t attempts, uint8_t waitMs)
+{
+    /* Function call message */
+    iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* check bus */
+    if ( IICMB_BUS_NUM <= bus ) {
+        return IICMB_EXIT_ERROR;
+    }
+    self->retry[bus].uint8Max = attempts;
+    self->retry[bus].uint8WaitMs = waitMs;
+    return IICMB_EXIT_OK;
+}
+
+
+
+/**
+ *  iicmb_timing_calc
+ *    SCL timing from frequency
+ */
+int iicmb_timing_calc(t_iicmb_timing *timing, uint32_t clkKhz, uint32_t sclKhz)
+{
+    /** Variables **/
+    uint32_t    uint32Scl;  // SCL period in clk cycles
+    uint32_t    uint32High; // SCL high time
+    uint32_t    uint32Low;  // SCL low time
+    uint32_t    uint32Hold; // hold time of start, setup time of stop
+    uint32_t    uint32Vd;   // data valid time
+    uint32_t    uint32Buf;  // bus free time
+    uint32_t    uint32HighPm;   // SCL high in permille of period
+    uint32_t    uint32LowPm;    // SCL low in permille of period
+    uint32_t    uint32BufNs;    // bus free time in ns
+    uint32_t    uint32VdNs;     // data valid time in ns
+
+    /* Function call message */
+    iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* check args */
+    if ( (0 == clkKhz) || (0 == sclKhz) ) {
+        return IICMB_EXIT_ERROR;
+    }
+    /* mode */
+    if ( 100 >= sclKhz ) {          // standard mode
+        uint32HighPm = 401;
+        uint32LowPm = 470;
+        uint32BufNs = 4700;
+        uint32VdNs = 500;
+    } else if ( 400 >= sclKhz ) {   // fast mode
+        uint32HighPm = 241;
+        uint32LowPm = 520;
+        uint32BufNs = 1300;
+        uint32VdNs = 500;
+    } else if ( 1000 >= sclKhz ) {  // fast mode plus
+        uint32HighPm = 261;
+        uint32LowPm = 500;
+        uint32BufNs = 500;
+        uint32VdNs = 200;
+    } else {                        // high-speed mode, stop returns to fast mode
+        uint32HighPm = 250;
+        uint32LowPm = 550;
+        uint32BufNs = 1300;
+        uint32VdNs = 30;
+    }
+    /* same rounding as get_tp() of HDL, integer(x+0.4999) rounds up */
+    uint32Scl = (uint32_t) (((uint64_t) clkKhz * 10000 + (uint64_t) sclKhz * 9999) / ((uint64_t) sclKhz * 10000));
+    uint32High = (uint32_t) (((uint64_t) uint32Scl * uint32HighPm + 500) / 1000);
+    uint32Low = (uint32_t) (((uint64_t) uint32Scl * uint32LowPm + 500) / 1000);
+    uint32Hold = (1000 < sclKhz) ? uint32Low : uint32High;
+    uint32Buf = (uint32_t) (((uint64_t) clkKhz * uint32BufNs + 999900) / 1000000);
+    uint32Vd = (uint32_t) (((uint64_t) clkKhz * uint32VdNs + 999900) / 1000000);
+    /* representable? */
+    if ( (0 == uint32High) || (uint32Low <= uint32Vd) || (0 == uint32Buf) ) {
+        return IICMB_EXIT_ERROR;
+    }
+    if ( (65536 < uint32Scl) || (65536 < uint32Buf) ) {
+        return IICMB_EXIT_ERROR;
+    }
+    timing->uint16Scl = (uint16_t) (uint32Scl - 1);
+    timing->uint16High = (uint16_t) (uint32High - 1);
+    timing->uint16SuSta = (uint16_t) (uint32Low - 1);
+    timing->uint16HdSta = (uint16_t) (uint32Hold - 1);
+    timing->uint16SuDat = (uint16_t) (uint32Low - uint32Vd - 1);
+    timing->uint16SuSto = (uint16_t) (uint32Hold - 1);
+    timing->uint16Buf = (uint16_t) (uint32Buf - 1);
+    timing->uint16VdDat = (uint16_t) (uint32Vd - 1);
+    return IICMB_EXIT_OK;
+}
+
+
+
+/**
+ *  iicmb_set_timing
+ *    SCL timing of bus
+ */
+int iicmb_set_timing(t_iicmb *self, uint8_t bus, const t_iicmb_timing *timing)
+{
+#ifdef IICMB_TIMING
+    /* Function call message */
+    iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* check bus */
+    if ( IICMB_BUS_NUM <= bus ) {
+        return IICMB_EXIT_ERROR;
+    }
+    self->timing[bus] = timing;
+    return IICMB_EXIT_OK;
+#else
+    (void) self;
+    (void) bus;
+    (void) timing;
+    return IICMB_EXIT_ERROR;    // timing registers not compiled
+#endif
+}
+
+
+
+/**
+ *  iicmb_set_hs
+ *    High-speed mode of bus
+ */
+int iicmb_set_hs(t_iicmb *self, uint8_t bus, uint8_t code, const t_iicmb_timing *timing)
+{
+#ifdef IICMB_TIMING
+    /* Function call message */
+    iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* check args */
+    if ( (IICMB_BUS_NUM <= bus) || ((IICMB_HS_OFF != code) && (IICMB_HSCR_MC < code)) ) {
+        return IICMB_EXIT_ERROR;
+    }
+    /* fast mode */
+    if ( IICMB_HS_OFF == code ) {
+        self->uint8Hscr[bus] = 0;
+        self->timingHs[bus] = NULL;
+        return IICMB_EXIT_OK;
+    }
+    self->uint8Hscr[bus] = (uint8_t) (IICMB_HSCR_HSE | code);
+    self->timingHs[bus] = timing;
+    return IICMB_EXIT_OK;
+#else
+    (void) self;
+    (void) bus;
+    (void) code;
+    (void) timing;
+    return IICMB_EXIT_ERROR;    // timing registers not compiled
+#endif
+}
+
+
+
+/**
+ *  iicmb_set_irq
+ *    interrupt mask and coalescing
+ */
+int iicmb_set_irq(t_iicmb *self, uint8_t mask, uint8_t cnt, uint16_t tim)
+{
+#ifdef IICMB_IRQ_CTRL
+    /* Function call message */
+    iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* check args, one command in flight never reaches the count */
+    if ( (0 != (mask & ~(IICMB_IMSK_ALL | IICMB_IMSK_END))) || ((1 < cnt) && (0 == tim)) ) {
+        return IICMB_EXIT_ERROR;
+    }
+    /* applied with next message */
+    self->uint32Icr = (uint32_t) (mask | IICMB_IMSK_EOT) | ((uint32_t) cnt << 8) | ((uint32_t) tim << 16);
+    return IICMB_EXIT_OK;
+#else
+    (void) self;
+    (void) mask;
+    (void) cnt;
+    (void) tim;
+    return IICMB_EXIT_ERROR;    // interrupt control registers not compiled
+#endif
+}
+
+
+
+/**
+ *  iicmb_btrace_arm
+ *    empty and start bus trace of core
+ */
+int iicmb_btrace_arm(t_iicmb *self, uint16_t trg, uint8_t post, uint8_t stretch, uint8_t pre)
+{
+#ifdef IICMB_BUS_TRACE
+    /* Function call message */
+    iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* trace RAM implemented */
+    if ( 0 == IICMB_REG_RD(self, TDEP) ) {
+        return IICMB_EXIT_ERROR;
+    }
+    /* configure stopped trace, then record */
+    IICMB_REG_WR(self, TCR, IICMB_TCR_CLR);
+    IICMB_REG_WR(self, TPOST, post);
+    IICMB_REG_WR(self, TTRG[0], trg);
+    IICMB_REG_WR(self, TTRG[1], trg >> 8);
+    IICMB_REG_WR(self, TSTR, stretch);
+    IICMB_REG_WR(self, TPRE, pre);
+    IICMB_REG_WR(self, TCR, IICMB_TCR_EN);
+    return IICMB_EXIT_OK;
+#else
+    (void) self;
+    (void) trg;
+    (void) post;
+    (void) stretch;
+    (void) pre;
+    return IICMB_EXIT_ERROR;    // bus trace registers not compiled
+#endif
+}
+
+
+
+/**
+ *  iicmb_btrace_read
+ *    freeze bus trace and copy newest entries
+ */
+int iicmb_btrace_read(t_iicmb *self, uint32_t *entry, uint16_t size, uint16_t *len)
+{
+#ifdef IICMB_BUS_TRACE
+    /** Variables **/
+    uint8_t     uint8Tcr;
+    uint16_t    uint16Depth;    // trace RAM entries
+    uint16_t    uint16Ptr;      // next write index
+    uint16_t    uint16Num;      // recorded entries
+    uint16_t    uint16Iter;
+    uint32_t    uint32Entry;
+
+    /* Function call message */
+    iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    *len = 0;
+    /* trace RAM implemented */
+    uint16Depth = (uint16_t) (1u << IICMB_REG_RD(self, TDEP));
+    if ( 1 == uint16Depth ) {
+        return IICMB_EXIT_ERROR;
+    }
+    /* freeze, keeps trigger state */
+    uint8Tcr = IICMB_REG_RD(self, TCR);
+    IICMB_REG_WR(self, TCR, (uint8Tcr & IICMB_TCR_EN) | IICMB_TCR_FRZ);
+    uint16Ptr = (uint16_t) (IICMB_REG_RD(self, TPTR[0]) | (IICMB_REG_RD(self, TPTR[1]) << 8));
+    uint16Num = (0 != (uint8Tcr & IICMB_TCR_WRAP)) ? uint16Depth : uint16Ptr;
+    if ( uint16Num > size ) {
+        uint16Num = size;   // newest only
+    }
+    /* TDAT increments TIDX with its last byte */
+    uint16Iter = (uint16_t) ((uint16Ptr - uint16Num) & (uint16Depth - 1));
+    IICMB_REG_WR(self, TIDX[0], uint16Iter);
+    IICMB_REG_WR(self, TIDX[1], uint16Iter >> 8);
+    for ( uint16Iter = 0; uint16Iter < uint16Num; uint16Iter++ ) {
+#ifdef IICMB_REG_32
+        uint32Entry = IICMB_REG_RD32(self, TDAT);
+#else
+        uint32Entry = IICMB_REG_RD(self, TDAT[0]);
+        uint32Entry |= (uint32_t) IICMB_REG_RD(self, TDAT[1]) << 8;
+        uint32Entry |= (uint32_t) IICMB_REG_RD(self, TDAT[2]) << 16;
+        uint32Entry |= (uint32_t) IICMB_REG_RD(self, TDAT[3]) << 24;
+#endif
+        entry[uint16Iter] = uint32Entry;
+    }
+    *len = uint16Num;
+    return IICMB_EXIT_OK;
+#else
+    (void) self;
+    (void) entry;
+    (void) size;
+    *len = 0;
+    return IICMB_EXIT_ERROR;    // bus trace registers not compiled
+#endif
+}
+
+
+
+/**
+ *  iicmb_stats_get
+ *    consistent snapshot of bus statistics
+ */
+int iicmb_stats_get(t_iicmb *self, uint8_t bus, t_iicmb_stats *stats)
+{
+#ifdef IICMB_STATS
+    /** Variables **/
+    volatile const uint32_t *seq;   // updated by ISR
+    uint32_t    uint32Seq;  // sequence at copy start
+    uint8_t     uint8Clr;   // reset posted, not done by ISR yet
+
+    /* Function call message */
+    iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* check bus */
+    if ( IICMB_BUS_NUM <= bus ) {
+        return IICMB_EXIT_ERROR;
+    }
+    seq = &(self->stats[bus].uint32Seq);
+    /* copy, retry if ISR updated in between */
+    do {
+        uint32Seq = *seq;
+        IICMB_BARRIER();
+        memcpy(stats, &(self->stats[bus]), sizeof(t_iicmb_stats));
+        uint8Clr = self->uint8StatsClr[bus];
+        IICMB_BARRIER();
+    } while ( (0 != (uint32Seq & 1)) || (uint32Seq != *seq) );
+    /* posted reset, nothing recorded since */
+    if ( 0 != uint8Clr ) {
+        memset(stats, 0, sizeof(t_iicmb_stats));
+        stats->uint32Seq = uint32Seq;
+    }
+    /* counted by submit, not part of the ISR reset */
+    stats->uint32Occ = self->uint32StatsOcc[bus];
+    stats->uint32Full = self->uint32StatsFull[bus];
+    return IICMB_EXIT_OK;
+#else
+    (void) self;
+    (void) bus;
+    (void) stats;
+    return IICMB_EXIT_ERROR;    // statistics not compiled
+#endif
+}
+
+
+
+/**
+ *  iicmb_stats_clr
+ *    reset bus statistics
+ */
+int iicmb_stats_clr(t_iicmb *self, uint8_t bus)
+{
+#ifdef IICMB_STATS
+    /* Function call message */
+    iicmb_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    /* check bus */
+    if ( IICMB_BUS_NUM <= bus ) {
+        return IICMB_EXIT_ERROR;
+    }
+    /* counted by submit, same context */
+    self->uint32StatsOcc[bus] = 0;
+    self->uint32StatsFull[bus] = 0;
+    /* post, the ISR clears before its next update */
+    IICMB_BARRIER();
+    self->uint8StatsClr[bus] = 1;
+    return IICMB_EXIT_OK;
+#else
+    (void) self;
+    (void) bus;
+    return IICMB_EXIT_ERROR;    // statistics not compiled
+#endif
 }
@@ -74,6 +74,7 @@
 #define IICMB_CMD_START     (0x04)      /**<  WO    If bus is not captured yet: issue Start Condition; If bus captured: issue Repeated Start Condition */
 #define IICMB_CMD_STOP      (0x05)      /**<  WO    Issue Stop Condition and free selected bus */
 #define IICMB_CMD_SET_BUS   (0x06)      /**<  WO    Connect to the specified bus (select bus) */
+#define IICMB_CMD_MSG       (0x07)      /**<  WO    Complete I2C message defined by MADR/MLEN/MRSW, requires FIFOs */
 
 #define IICMB_RSP           (0xF0)      /**<        Bit Mask for selecting response Bits */
 #define IICMB_RSP_COMPLETED (0x00)      /**<  RO    Command completed. */
@@ -114,6 +115,259 @@
 
 
 
+/**
+ * @defgroup IICMB_QUEUE
+ *
+ * Transfer queue, number of accepted but not finished transfers.
+ * Needs to be a power of two.
+ *
+ * @{
+ */
+#ifndef IICMB_QUEUE_LEN
+    #define IICMB_QUEUE_LEN     (8)     /**<  Transfer descriptors in driver handle */
+#endif
+#if ( (IICMB_QUEUE_LEN < 1) || (IICMB_QUEUE_LEN > 128) || (0 != (IICMB_QUEUE_LEN & (IICMB_QUEUE_LEN - 1))) )
+    #error "IICMB_QUEUE_LEN needs to be a power of two in the range 1..128"
+#endif
+/** @} */
+
+
+
+/**
+ * @defgroup IICMB_BUS
+ *
+ * Number of I2C buses served by the driver handle,
+ * every bus has its own transfer queue.
+ *
+ * @{
+ */
+#ifndef IICMB_BUS_NUM
+    #define IICMB_BUS_NUM       (16)    /**<  I2C buses of IICMB core, 1..16 */
+#endif
+#if ( (IICMB_BUS_NUM < 1) || (IICMB_BUS_NUM > 16) )
+    #error "IICMB_BUS_NUM needs to be in the range 1..16"
+#endif
+/** @} */
+
+
+
+/**
+ * @defgroup IICMB_FIFO
+ *
+ * TX/RX FIFO depth of the register block, needs to match the
+ * HDL generic 'g_fifo_depth'. 0 selects the byte-wise register
+ * block without FIFOs. With FIFOs one write/read command moves
+ * up to IICMB_FIFO_DEPTH bytes per IRQ.
+ *
+ * @{
+ */
+#ifndef IICMB_FIFO_DEPTH
+    #define IICMB_FIFO_DEPTH    (0)     /**<  FIFO depth of IICMB core, 0..255 */
+#endif
+#if ( (IICMB_FIFO_DEPTH < 0) || (IICMB_FIFO_DEPTH > 255) )
+    #error "IICMB_FIFO_DEPTH needs to be in the range 0..255"
+#endif
+/** @} */
+
+
+
+/**
+ * @defgroup IICMB_TRACE
+ *
+ * Binary trace ring in the driver handle, number of #t_iicmb_trace
+ * entries, needs to be a power of two. 0 disables tracing without
+ * any code in the driver. The timestamp of an entry is taken from
+ * #iicmb_trace_time, the ring is decoded on host by test/iicmb_trace_dec.c.
+ *
+ * @{
+ */
+#ifndef IICMB_TRACE_LEN
+    #define IICMB_TRACE_LEN     (0)     /**<  Trace ring entries, 0 disables tracing */
+#endif
+#if ( (IICMB_TRACE_LEN < 0) || (IICMB_TRACE_LEN > 4096) || (0 != (IICMB_TRACE_LEN & (IICMB_TRACE_LEN - 1))) )
+    #error "IICMB_TRACE_LEN needs to be zero or a power of two in the range 1..4096"
+#endif
+/** @} */
+
+
+
+/**
+ * @defgroup IICMB_STATS
+ *
+ * Per bus statistics, maintained if IICMB_STATS is defined. Counts
+ * finished transfers, errors, rejected submits and moved bytes, and
+ * sorts the latency from submit to completion into log2 buckets of
+ * #iicmb_trace_time ticks. Read with #iicmb_stats_get.
+ *
+ * @{
+ */
+#define IICMB_STATS_HIST    (32)        /**<  Latency buckets, bucket n counts latencies 2^n..2^(n+1)-1, bucket 0 includes 0 */
+/** @} */
+
+
+
+/**
+ * @defgroup IICMB_TIMING
+ *
+ * Runtime SCL timing registers of the register block, enabled if
+ * IICMB_TIMING is defined. TSEL selects the I2C bus or the High-speed
+ * mode timing, TSCL..TVDDAT hold the #t_iicmb_timing of the selection
+ * as 16-bit values, low byte first. Writing TSEL with DEF reloads the
+ * synthesis values from the HDL generics 'g_f_scl_x'. HSCR enables the
+ * High-speed mode for the next Start. The registers are only written
+ * by the ISR when no transfer is active, see #iicmb_set_timing and
+ * #iicmb_set_hs.
+ *
+ * @{
+ */
+#define IICMB_TSEL_BUS      (0x0F)      /**<  Bus selection of TSCL..TVDDAT                         R/W */
+#define IICMB_TSEL_HS       (0x10)      /**<  Select High-speed mode timing instead of bus          R/W */
+#define IICMB_TSEL_DEF      (0x80)      /**<  Reload synthesis timing of selection                  WO  */
+
+#define IICMB_HSCR_MC       (0x07)      /**<  Master code 00001XXX                                  R/W */
+#define IICMB_HSCR_HS       (0x40)      /**<  High-speed mode active                                RO  */
+#define IICMB_HSCR_HSE      (0x80)      /**<  Start sends master code and enters High-speed mode    R/W */
+
+#define IICMB_HS_OFF        (0xFF)      /**<  #iicmb_set_hs: Fast mode transfers                        */
+/** @} */
+
+
+
+/**
+ * @defgroup IICMB_IRQ_CTRL
+ *
+ * Interrupt mask and coalescing registers of the register block,
+ * enabled if IICMB_IRQ_CTRL is defined. IMSK selects the interrupt
+ * causes, NAK/AL/ERR interrupt immediately, DON/END are counted:
+ * the interrupt is raised with the ICNT-th command or ITIM clock
+ * cycles after the first one. See #iicmb_set_irq.
+ *
+ * @{
+ */
+#define IICMB_IMSK_DON      (0x01)      /**<  Command completed with Done                           R/W */
+#define IICMB_IMSK_NAK      (0x02)      /**<  Command completed with not-acknowledge                R/W */
+#define IICMB_IMSK_AL       (0x04)      /**<  Command completed with Arbitration Lost               R/W */
+#define IICMB_IMSK_ERR      (0x08)      /**<  Command completed with Error                          R/W */
+#define IICMB_IMSK_FIFO     (0x10)      /**<  FIFO interrupts of FCR                                R/W */
+#define IICMB_IMSK_END      (0x20)      /**<  Stop or Message command completed with Done           R/W */
+
+#define IICMB_IMSK_ALL      (0x1F)      /**<  Every command, reset value of IMSK                        */
+#define IICMB_IMSK_EOT      (IICMB_IMSK_END | IICMB_IMSK_NAK | IICMB_IMSK_AL | IICMB_IMSK_ERR)  /**<  Errors and end of transaction only */
+/** @} */
+
+
+
+/**
+ * @defgroup IICMB_PERF
+ *
+ * Free running performance counters of the register block, enabled
+ * if IICMB_PERF is defined, requires IICMB_STATS. PCMD counts accepted
+ * commands, PLAT..PFBY count system clock cycles: command latency from
+ * CMDR write to response, SCL held low by a slave, software turnaround
+ * from response to next command while the bus is taken, and bus busy
+ * by a foreign master. Writing PCR with SNAP copies all counters at
+ * once into the 32-bit registers. The ISR snapshots them at the end of
+ * every transfer and adds the difference to #t_iicmb_stats.
+ *
+ * @{
+ */
+#define IICMB_PCR_SNAP      (0x01)      /**<  Copy counters into PCMD..PFBY                         WO  */
+#define IICMB_PCR_CLR       (0x02)      /**<  Clear counters                                        WO  */
+
+#define IICMB_PERF_NUM      (5)         /**<  Number of counters PCMD..PFBY                             */
+
+#if defined(IICMB_PERF) && !defined(IICMB_STATS)
+    #error "IICMB_PERF requires IICMB_STATS"
+#endif
+/** @} */
+
+
+
+/**
+ * @defgroup IICMB_BUS_TRACE
+ *
+ * Bus event trace RAM of the register block, enabled if IICMB_BUS_TRACE
+ * is defined, requires HDL generic 'g_trace_depth' > 0. The core records
+ * Start, Stop, bytes with ACK/NAK, arbitration loss, bus switches and
+ * clock stretching, every entry with the clock cycles since the previous
+ * entry divided by TPRE+1. An event in the trigger mask freezes the trace
+ * TPOST entries later. See #iicmb_btrace_arm and #iicmb_btrace_read, the
+ * host decoder is test/iicmb_btrace_dec.c.
+ *
+ * @{
+ */
+#define IICMB_TCR_EN        (0x01)      /**<  Record events                                         R/W */
+#define IICMB_TCR_FRZ       (0x02)      /**<  Frozen by trigger or software, write 0 rearms         R/W */
+#define IICMB_TCR_TRG       (0x04)      /**<  Trigger event recorded                                RO  */
+#define IICMB_TCR_WRAP      (0x08)      /**<  Trace RAM overwritten, oldest entry at TPTR           RO  */
+#define IICMB_TCR_CLR       (0x80)      /**<  Empty trace RAM                                       WO  */
+
+#define IICMB_BTR_START     (0x0)       /**<  Start */
+#define IICMB_BTR_RSTART    (0x1)       /**<  Repeated Start */
+#define IICMB_BTR_STOP      (0x2)       /**<  Stop */
+#define IICMB_BTR_WACK      (0x3)       /**<  Byte written, slave ACK, arg: byte */
+#define IICMB_BTR_WNAK      (0x4)       /**<  Byte written, slave NAK, arg: byte */
+#define IICMB_BTR_RACK      (0x5)       /**<  Byte read, ACK sent, arg: byte */
+#define IICMB_BTR_RNAK      (0x6)       /**<  Byte read, NAK sent, arg: byte */
+#define IICMB_BTR_AL        (0x7)       /**<  Arbitration lost, arg: command code */
+#define IICMB_BTR_ERR       (0x8)       /**<  Command error, arg: command code */
+#define IICMB_BTR_BUS       (0x9)       /**<  Bus switched, arg: bus ID */
+#define IICMB_BTR_STRB      (0xA)       /**<  Clock stretch begin, arg: bit level FSM state */
+#define IICMB_BTR_STRE      (0xB)       /**<  Clock stretch end */
+
+#define IICMB_BTR_MSK(evt)      ((uint16_t) (1u << (evt)))          /**<  Trigger mask bit of event */
+#define IICMB_BTR_EVT(entry)    ((uint8_t) ((entry) >> 28))         /**<  Event of entry */
+#define IICMB_BTR_ARG(entry)    ((uint8_t) ((entry) >> 20))         /**<  Argument of entry */
+#define IICMB_BTR_TIM(entry)    ((uint32_t) (entry) & 0xFFFFF)      /**<  Timestamp of entry */
+#define IICMB_BTR_TIM_MAX       (0xFFFFF)                           /**<  Saturated timestamp, at least this long */
+/** @} */
+
+
+
+/**
+ * @defgroup IICMB_REG_32
+ *
+ * 32-bit register access backend, for the Avalon-MM (iicmb_m_av)
+ * or Wishbone slave. If IICMB_REG_32 is defined the ISR reads
+ * CSR/DPR/CMDR/FSMR with one 32-bit load, and writes parameter
+ * plus command with one 32-bit store. The CSR lane of the store
+ * rewrites the enable bits, the bus is little-endian.
+ *
+ * @{
+ */
+#define IICMB_REG32_CSR     (0)         /**<  Bit position of CSR in 32-bit word */
+#define IICMB_REG32_DPR     (8)         /**<  Bit position of DPR in 32-bit word */
+#define IICMB_REG32_CMDR    (16)        /**<  Bit position of CMDR in 32-bit word */
+#define IICMB_REG32_FSMR    (24)        /**<  Bit position of FSMR in 32-bit word */
+/** @} */
+
+
+
+/**
+ * @defgroup IICMB_FSR register bits
+ *
+ * FIFO Status/Control Register bit definitions
+ *
+ * @{
+ */
+#define IICMB_FSR_TXE       (0x01)      /**<  TX FIFO empty                                         RO  */
+#define IICMB_FSR_TXF       (0x02)      /**<  TX FIFO full                                          RO  */
+#define IICMB_FSR_RXE       (0x04)      /**<  RX FIFO empty                                         RO  */
+#define IICMB_FSR_RXF       (0x08)      /**<  RX FIFO full                                          RO  */
+#define IICMB_FSR_TXT       (0x10)      /**<  TX level below or equal threshold while writing       RO  */
+#define IICMB_FSR_RXT       (0x20)      /**<  RX level above or equal threshold                     RO  */
+#define IICMB_FSR_BST       (0x80)      /**<  Write/Read/Message command in progress                RO  */
+
+#define IICMB_FCR_TXT_IE    (0x01)      /**<  Interrupt on TXT                                      R/W */
+#define IICMB_FCR_RXT_IE    (0x02)      /**<  Interrupt on RXT                                      R/W */
+#define IICMB_FCR_TXE_IE    (0x04)      /**<  Interrupt on TXE                                      R/W */
+#define IICMB_FCR_RXF_IE    (0x08)      /**<  Interrupt on RXF                                      R/W */
+#define IICMB_FCR_TXC       (0x40)      /**<  Clear TX FIFO                                         WO  */
+#define IICMB_FCR_RXC       (0x80)      /**<  Clear RX FIFO                                         WO  */
+/** @} */
+
+
+
 
 /** C++ compatibility **/
 #ifdef __cplusplus
@@ -142,7 +396,10 @@ typedef enum
     IICMB_WR_BYTE,      /**<  Write: Sent Databyte */
     IICMB_RD_ADR_SET,   /**<  Read: Write Slave Address */
     IICMB_RD_ADR_CHK,   /**<  Read: slave responsible? */
-    IICMB_RD_BYTE       /**<  Read: Read byte from slave */
+    IICMB_RD_BYTE,      /**<  Read: Read byte from slave */
+    IICMB_SET_BUS,      /**<  Bus: Wait for selection of next I2C bus */
+    IICMB_MSG,          /**<  Message: Wait for complete I2C message */
+    IICMB_BACKOFF       /**<  Retry: Wait command before replay of transfer */
 } t_iicmb_fsm;
 
 
@@ -171,6 +428,28 @@ typedef enum
 
 
 
+/**
+ *  @typedef t_iicmb_cb
+ *
+ *  @brief  Completion callback
+ *
+ *  Called by #iicmb_fsm when a transfer is finished, the
+ *  descriptor is already released. New transfers can be submitted
+ *  from the callback, they are queued behind the pending ones.
+ *
+ *  @param[in,out]  self    driver handle
+ *  @param[in]      ctx     user context of the transfer
+ *  @param[in]      error   result of the transfer, #t_iicmb_ero
+ *  @param[in]      wrLen   number of bytes written
+ *  @param[in]      rdLen   number of bytes read
+ *  @since  2026-10-16
+ *  @author IICMB contributors
+ */
+struct t_iicmb;
+typedef void (*t_iicmb_cb)(struct t_iicmb *self, void *ctx, t_iicmb_ero error, uint16_t wrLen, uint16_t rdLen);
+
+
+
 /**
  *  @typedef t_iicm_reg
  *
@@ -188,11 +467,343 @@ typedef struct {
     volatile uint8_t        DPR;    /**<  Data/Parameter Register   R/W */
     volatile uint8_t        CMDR;   /**<  Command Register          R/W */
     volatile const uint8_t  FSMR;   /**<  FSM States Register       RO  */
+#if IICMB_FIFO_DEPTH > 0
+    volatile const uint8_t  FTXL;   /**<  TX FIFO Level             RO  */
+    volatile const uint8_t  FRXL;   /**<  RX FIFO Level             RO  */
+    volatile const uint8_t  FSR;    /**<  FIFO Status Register      RO  */
+    volatile const uint8_t  FDEPTH; /**<  FIFO Depth                RO  */
+    volatile uint8_t        FTXT;   /**<  TX FIFO Threshold         R/W */
+    volatile uint8_t        FRXT;   /**<  RX FIFO Threshold         R/W */
+    volatile uint8_t        FRCNT;  /**<  Bytes per Read command    R/W */
+    volatile uint8_t        FCR;    /**<  FIFO Control Register     R/W */
+    volatile uint8_t        MADR;   /**<  Message Slave Address     R/W */
+    volatile uint8_t        MLEN;   /**<  Message Length            R/W */
+    volatile uint8_t        MRSW;   /**<  Message Write Length      R/W */
+    volatile const uint8_t  MCNT;   /**<  Message Transferred Bytes RO  */
+#elif defined(IICMB_TIMING) || defined(IICMB_IRQ_CTRL) || defined(IICMB_PERF) || defined(IICMB_BUS_TRACE)
+    volatile const uint8_t  RSVD0[12];  /**<  FIFO registers, not present   */
+#endif
+#ifdef IICMB_TIMING
+    volatile uint8_t        TSEL;       /**<  Timing Bus Select             R/W */
+    volatile uint8_t        HSCR;       /**<  High-speed Mode Control       R/W */
+    volatile const uint8_t  RSVD1[2];   /**<  Reserved                          */
+    volatile uint8_t        TSCL[2];    /**<  SCL Period                    R/W */
+    volatile uint8_t        THIGH[2];   /**<  SCL High Time                 R/W */
+    volatile uint8_t        TSUSTA[2];  /**<  Repeated Start Setup Time     R/W */
+    volatile uint8_t        THDSTA[2];  /**<  Start Hold Time               R/W */
+    volatile uint8_t        TSUDAT[2];  /**<  Data Setup Time               R/W */
+    volatile uint8_t        TSUSTO[2];  /**<  Stop Setup Time               R/W */
+    volatile uint8_t        TBUF[2];    /**<  Bus Free Time                 R/W */
+    volatile uint8_t        TVDDAT[2];  /**<  Data Valid Time               R/W */
+#elif defined(IICMB_IRQ_CTRL) || defined(IICMB_PERF) || defined(IICMB_BUS_TRACE)
+    volatile const uint8_t  RSVD2[20];  /**<  Timing registers, not present */
+#endif
+#ifdef IICMB_IRQ_CTRL
+    volatile uint8_t        IMSK;       /**<  Interrupt Mask                R/W */
+    volatile uint8_t        ICNT;       /**<  Interrupt Event Count         R/W */
+    volatile uint8_t        ITIM[2];    /**<  Interrupt Timeout             R/W */
+#elif defined(IICMB_PERF) || defined(IICMB_BUS_TRACE)
+    volatile const uint8_t  RSVD3[4];   /**<  Interrupt registers, not present */
+#endif
+#ifdef IICMB_PERF
+    volatile uint8_t        PCR;        /**<  Performance Counter Control   WO  */
+    volatile const uint8_t  RSVD4[3];   /**<  Reserved                          */
+    volatile const uint8_t  PCMD[4];    /**<  Accepted Commands             RO  */
+    volatile const uint8_t  PLAT[4];    /**<  Command Latency Cycles        RO  */
+    volatile const uint8_t  PSTR[4];    /**<  Clock Stretch Cycles          RO  */
+    volatile const uint8_t  PTRN[4];    /**<  Software Turnaround Cycles    RO  */
+    volatile const uint8_t  PFBY[4];    /**<  Foreign Master Busy Cycles    RO  */
+#elif defined(IICMB_BUS_TRACE)
+    volatile const uint8_t  RSVD5[24];  /**<  Performance counters, not present */
+#endif
+#ifdef IICMB_BUS_TRACE
+    volatile uint8_t        TCR;        /**<  Trace Control Register        R/W */
+    volatile uint8_t        TPOST;      /**<  Entries after Trigger         R/W */
+    volatile uint8_t        TTRG[2];    /**<  Trigger Event Mask            R/W */
+    volatile const uint8_t  TPTR[2];    /**<  Next Write Index              RO  */
+    volatile uint8_t        TSTR;       /**<  Stretch Threshold             R/W */
+    volatile uint8_t        TPRE;       /**<  Timestamp Prescaler           R/W */
+    volatile uint8_t        TIDX[2];    /**<  Read Index                    R/W */
+    volatile const uint8_t  TDEP;       /**<  log2 of Trace Depth           RO  */
+    volatile const uint8_t  RSVD6;      /**<  Reserved                          */
+    volatile const uint8_t  TDAT[4];    /**<  Entry at TIDX, increments     RO  */
+#endif
 
 } __attribute__((packed)) t_iicm_reg;
 
 
 
+/**
+ *  @brief register hook
+ *
+ *  If IICMB_REG_HOOK is defined all register accesses of the driver are
+ *  redirected to these functions instead of dereferencing the register
+ *  set. They are provided by the user, f.e. the host register model
+ *  test/iicmb_model.c. The 32-bit functions access all four registers
+ *  of the word at offset at once, only used with IICMB_REG_32.
+ *
+ *  @param[in,out]  reg                 register set, as passed to #iicmb_init
+ *  @param[in]      offset              register offset in #t_iicm_reg
+ *  @param[in]      val                 write value
+ *  @return         uint8_t             read value
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+#ifdef IICMB_REG_HOOK
+    #include <stddef.h>     // size_t
+    uint8_t iicmb_reg_rd(void *reg, size_t offset);
+    void iicmb_reg_wr(void *reg, size_t offset, uint8_t val);
+    uint32_t iicmb_reg_rd32(void *reg, size_t offset);
+    void iicmb_reg_wr32(void *reg, size_t offset, uint32_t val);
+#endif
+
+
+
+/**
+ *  @brief trace timestamp hook
+ *
+ *  If IICMB_TRACE_LEN is non zero or IICMB_STATS is defined the driver
+ *  takes the timestamp of trace entries and latencies from this function.
+ *  Provided by the user, f.e. a free running timer, the host register
+ *  model returns its simulated time in ns.
+ *
+ *  @param[in,out]  reg                 register set, as passed to #iicmb_init
+ *  @return         uint32_t            timestamp
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+#if ( (IICMB_TRACE_LEN > 0) || defined(IICMB_STATS) )
+    uint32_t iicmb_trace_time(void *reg);
+#endif
+
+
+
+/**
+ *  @typedef t_iicmb_stats
+ *
+ *  @brief  Bus statistics
+ *
+ *  Counters of one I2C bus, updated by #iicmb_fsm and the submit
+ *  functions. Transfers with errors count in uint32Xfer too.
+ *  uint32Occ and uint32Full are kept apart from the ISR counters,
+ *  see #iicmb_stats_get.
+ *
+ *  @since  2026-10-16
+ *  @author IICMB contributors
+ */
+typedef struct {
+    volatile uint32_t       uint32Seq;          /**<  Update sequence, odd while the ISR updates */
+    uint32_t                uint32Xfer;         /**<  Finished transfers */
+    uint32_t                uint32NoSlave;      /**<  #IICMB_E_NOSLAVE, NCK on slave address */
+    uint32_t                uint32ArbLost;      /**<  #IICMB_E_ARBLOST */
+    uint32_t                uint32Ictf;         /**<  #IICMB_E_ICTF, f.e. NCK on data byte */
+    uint32_t                uint32Err;          /**<  Other errors */
+    uint32_t                uint32Occ;          /**<  Submit rejected with #IICMB_EXIT_OCC */
+    uint32_t                uint32Full;         /**<  Submit rejected with #IICMB_EXIT_BUSY */
+    uint32_t                uint32Retry;        /**<  Backoffs on arbitration loss or occupied bus */
+    uint32_t                uint32WrByte;       /**<  Written bytes */
+    uint32_t                uint32RdByte;       /**<  Read bytes */
+    uint32_t                uint32Lat[IICMB_STATS_HIST];    /**<  Latency submit to completion, log2 buckets */
+#ifdef IICMB_PERF
+    uint32_t                uint32Cmd;          /**<  Commands executed by the core, PCMD */
+    uint32_t                uint32CmdClk;       /**<  Clock cycles CMDR write to response, PLAT */
+    uint32_t                uint32StretchClk;   /**<  Clock cycles SCL stretched by slaves, PSTR */
+    uint32_t                uint32TurnClk;      /**<  Clock cycles response to next command with bus taken, PTRN */
+    uint32_t                uint32ForeignClk;   /**<  Clock cycles bus busy by foreign master, PFBY */
+#endif
+} t_iicmb_stats;
+
+
+
+/**
+ *  @typedef t_iicmb_trace_evt
+ *
+ *  @brief  Trace events
+ *
+ *  Event type of a trace entry, the meaning of
+ *  #t_iicmb_trace.uint8Arg depends on the event
+ *
+ *  @since  2026-10-16
+ *  @author IICMB contributors
+ */
+typedef enum
+{
+    IICMB_TRC_SUBMIT,   /**<  Transfer taken from queue, arg: queued transfers of the bus */
+    IICMB_TRC_START,    /**<  Transfer started, arg: slave address */
+    IICMB_TRC_ISR,      /**<  ISR entry, arg: CMDR */
+    IICMB_TRC_ERROR,    /**<  IICMB error response, arg: CMDR */
+    IICMB_TRC_DONE,     /**<  Transfer finished, arg: #t_iicmb_ero */
+    IICMB_TRC_RETRY     /**<  Backoff before replay, arg: wait in ms */
+} t_iicmb_trace_evt;
+
+
+
+/**
+ *  @typedef t_iicmb_trace
+ *
+ *  @brief  Trace entry
+ *
+ *  Binary trace record, 12 bytes
+ *
+ *  @since  2026-10-16
+ *  @author IICMB contributors
+ */
+typedef struct {
+    uint32_t                uint32Time;         /**<  Timestamp, #iicmb_trace_time */
+    uint8_t                 uint8Evt;           /**<  Event, #t_iicmb_trace_evt */
+    uint8_t                 uint8Fsm;           /**<  FSM state on event, #t_iicmb_fsm */
+    uint8_t                 uint8Arg;           /**<  Event argument */
+    uint8_t                 uint8Bus;           /**<  Active I2C bus */
+    uint16_t                uint16WrByteIs;     /**<  Written bytes of active transfer */
+    uint16_t                uint16RdByteIs;     /**<  Read bytes of active transfer */
+} t_iicmb_trace;
+
+
+
+/**
+ *  @typedef t_iicmb_trace_ring
+ *
+ *  @brief  Trace ring
+ *
+ *  The driver writes the entry and publishes it by incrementing the
+ *  head afterwards, the oldest entry is overwritten. A reader takes the
+ *  last min(head, IICMB_TRACE_LEN) entries. The ring has a single writer:
+ *  the ISR, or the submit while the driver is idle, before the command
+ *  that triggers the first IRQ. Therefore queueing is not recorded,
+ *  #IICMB_TRC_SUBMIT is recorded when a transfer leaves the queue.
+ *
+ *  @since  2026-10-16
+ *  @author IICMB contributors
+ */
+#if IICMB_TRACE_LEN > 0
+typedef struct {
+    volatile uint32_t       uint32Head;                 /**<  Number of recorded events */
+    t_iicmb_trace           entry[IICMB_TRACE_LEN];     /**<  Ring, entry of event n is n & (IICMB_TRACE_LEN-1) */
+} t_iicmb_trace_ring;
+#endif
+
+
+
+/**
+ *  @typedef t_iicmb_seg
+ *
+ *  @brief  Data segment
+ *
+ *  One buffer of a write or read segment list, see #iicmb_xfer.
+ *  The ISR reads and writes the segments in place.
+ *
+ *  @since  2026-10-16
+ *  @author IICMB contributors
+ */
+typedef struct {
+    uint8_t*                uint8PtrData;       /**<  Data buffer */
+    uint16_t                uint16Len;          /**<  Number of bytes in buffer */
+} t_iicmb_seg;
+
+
+
+/**
+ *  @typedef t_iicmb_retry
+ *
+ *  @brief  Retry policy
+ *
+ *  Replay of a transfer after arbitration loss or on a bus occupied
+ *  by another master. Before every replay the IICMB waits uint8WaitMs,
+ *  doubled with every further attempt, see #iicmb_set_retry.
+ *
+ *  @since  2026-10-16
+ *  @author IICMB contributors
+ */
+typedef struct {
+    uint8_t                 uint8Max;           /**<  Maximum number of replays, 0 disables */
+    uint8_t                 uint8WaitMs;        /**<  Backoff of first replay in ms */
+} t_iicmb_retry;
+
+
+
+/**
+ *  @typedef t_iicmb_timing
+ *
+ *  @brief  SCL timing
+ *
+ *  Timing of one I2C bus in IICMB 'clk' cycles minus one, as
+ *  loaded into the TSCL..TBUF registers. Calculated from the
+ *  SCL frequency with #iicmb_timing_calc, or filled by the user
+ *  for non standard timings.
+ *
+ *  @since  2026-10-16
+ *  @author IICMB contributors
+ */
+typedef struct {
+    uint16_t                uint16Scl;          /**<  SCL period */
+    uint16_t                uint16High;         /**<  SCL high time */
+    uint16_t                uint16SuSta;        /**<  Setup time of repeated Start */
+    uint16_t                uint16HdSta;        /**<  Hold time of Start */
+    uint16_t                uint16SuDat;        /**<  Data setup time */
+    uint16_t                uint16SuSto;        /**<  Setup time of Stop */
+    uint16_t                uint16Buf;          /**<  Bus free time between Stop and Start */
+    uint16_t                uint16VdDat;        /**<  Data valid time after SCL low, SCL low is uint16SuDat + uint16VdDat + 2 */
+} t_iicmb_timing;
+
+
+
+/**
+ *  @typedef t_iicmb_xfer
+ *
+ *  @brief  Transfer descriptor
+ *
+ *  Queued I2C transfer, filled by the submit functions
+ *  and executed by #iicmb_fsm. A single segment is copied
+ *  into the descriptor, segment lists are referenced.
+ *
+ *  @since  2026-10-16
+ *  @author IICMB contributors
+ */
+typedef struct {
+    uint8_t                 uint8Adr;           /**<  I2C slave address, shifted for Read/Write bit */
+    uint8_t                 uint8WrRd;          /**<  Flag: Write/Read Interaction */
+    uint16_t                uint16WrByteLen;    /**<  Total number of bytes to write */
+    uint16_t                uint16RdByteLen;    /**<  Total number of bytes to read */
+    const t_iicmb_seg*      segWr;              /**<  Write segments */
+    const t_iicmb_seg*      segRd;              /**<  Read segments */
+    t_iicmb_seg             segWrOne;           /**<  Storage of single write segment */
+    t_iicmb_seg             segRdOne;           /**<  Storage of single read segment */
+    t_iicmb_retry           retry;              /**<  Retry policy of bus on submit */
+    uint8_t                 uint8RetryCnt;      /**<  Replays done */
+    t_iicmb_cb              cb;                 /**<  Completion callback, NULL if not used */
+    void*                   ctx;                /**<  User context of callback */
+#ifdef IICMB_TIMING
+    const t_iicmb_timing*   timing;             /**<  Timing of bus on submit, NULL for synthesis timing */
+    const t_iicmb_timing*   timingHs;           /**<  High-speed mode timing on submit, NULL for synthesis timing */
+    uint8_t                 uint8Hscr;          /**<  HSCR of bus on submit, 0 for Fast mode */
+#endif
+#ifdef IICMB_STATS
+    uint32_t                uint32Submit;       /**<  Timestamp of submit */
+#endif
+} t_iicmb_xfer;
+
+
+
+/**
+ *  @typedef t_iicmb_queue
+ *
+ *  @brief  Transfer queue
+ *
+ *  Ring of transfer descriptors of one I2C bus. Indices are
+ *  free running, the submit functions are the only writer of
+ *  the head, #iicmb_fsm is the only writer of the tail.
+ *
+ *  @since  2026-10-16
+ *  @author IICMB contributors
+ */
+typedef struct {
+    t_iicmb_xfer            xfer[IICMB_QUEUE_LEN];  /**<  Transfer descriptors */
+    volatile uint8_t        uint8Head;          /**<  Write index */
+    volatile uint8_t        uint8Tail;          /**<  Index of active or next transfer */
+} t_iicmb_queue;
+
+
+
 /**
  *  @typedef t_iicmb
  *
@@ -208,20 +819,56 @@ typedef struct t_iicmb {
     t_iicm_reg*             iicmb;              /**<  pointer to IICMB hardware registers */
     volatile t_iicmb_fsm    fsm;                /**<  Soft I2C state machine @see IICMB_FSM */
     volatile t_iicmb_ero    error;              /**<  Encoutered errors while exec, #t_iicmb_ero */
+    t_iicmb_ero             errorPrev;          /**<  First error of previous transfers, restored when active transfer ends */
     uint8_t                 uint8WrRd;          /**<  Flag: Write/Read Interaction, allows to use first Write, then read part of FSM */
     uint8_t                 uint8Adr;           /**<  I2C slave address */
     uint16_t                uint16WrByteLen;    /**<  Total number of bytes to write */
     volatile uint16_t       uint16WrByteIs;     /**<  Current number of bytes written */
     uint16_t                uint16RdByteLen;    /**<  Total number of bytes to read */
     volatile uint16_t       uint16RdByteIs;     /**<  Current number of bytes readen */
-    uint8_t*                uint8PtrData;       /**<  Read/Write data buffer */
+    const t_iicmb_seg*      segWr;              /**<  Active write segment */
+    uint16_t                uint16WrSegIs;      /**<  Bytes written from active write segment */
+    const t_iicmb_seg*      segRd;              /**<  Active read segment */
+    uint16_t                uint16RdSegIs;      /**<  Bytes read into active read segment */
+    t_iicmb_queue           queue[IICMB_BUS_NUM];   /**<  Transfer queue per I2C bus */
+    uint8_t                 uint8BusDef;        /**<  I2C bus used by #iicmb_write, #iicmb_read and #iicmb_wr_rd */
+    volatile uint8_t        uint8BusAct;        /**<  I2C bus of active transfer, round-robin start point of scheduler */
+    volatile uint8_t        uint8BusSel;        /**<  I2C bus selected in IICMB core */
+    t_iicmb_retry           retry[IICMB_BUS_NUM];   /**<  Retry policy per I2C bus, copied into descriptor on submit */
+#if IICMB_FIFO_DEPTH > 0
+    uint8_t                 uint8FifoRcnt;      /**<  Shadow of FRCNT register */
+#endif
+#ifdef IICMB_TIMING
+    const t_iicmb_timing*   timing[IICMB_BUS_NUM];      /**<  Timing per I2C bus, copied into descriptor on submit */
+    const t_iicmb_timing*   timingHs[IICMB_BUS_NUM];    /**<  High-speed mode timing per I2C bus, copied into descriptor on submit */
+    uint8_t                 uint8Hscr[IICMB_BUS_NUM];   /**<  HSCR per I2C bus, copied into descriptor on submit */
+    const t_iicmb_timing*   timingAct[IICMB_BUS_NUM+1]; /**<  Timing loaded into IICMB core, last is High-speed mode */
+    uint8_t                 uint8HscrAct;       /**<  HSCR written into IICMB core */
+#endif
+#ifdef IICMB_IRQ_CTRL
+    uint32_t                uint32Icr;          /**<  IMSK/ICNT/ITIM of message commands, see #iicmb_set_irq */
+    uint32_t                uint32IcrAct;       /**<  IMSK/ICNT/ITIM written into IICMB core */
+#endif
+#if IICMB_TRACE_LEN > 0
+    t_iicmb_trace_ring      trace;              /**<  Binary trace ring */
+#endif
+#ifdef IICMB_STATS
+    t_iicmb_stats           stats[IICMB_BUS_NUM];   /**<  Statistics per I2C bus */
+    volatile uint8_t        uint8StatsClr[IICMB_BUS_NUM];   /**<  Reset posted by #iicmb_stats_clr, done by the ISR */
+    uint32_t                uint32StatsOcc[IICMB_BUS_NUM];  /**<  Submits rejected with #IICMB_EXIT_OCC, not written by the ISR */
+    uint32_t                uint32StatsFull[IICMB_BUS_NUM]; /**<  Submits rejected with #IICMB_EXIT_BUSY, not written by the ISR */
+#endif
+#ifdef IICMB_PERF
+    uint32_t                uint32Perf[IICMB_PERF_NUM]; /**<  PCMD..PFBY of last snapshot */
+#endif
 } t_iicmb;
 
 
 
 /** @brief set active bus
  *
- *  set active bus number
+ *  set bus number used by #iicmb_write, #iicmb_read and #iicmb_wr_rd,
+ *  if the driver is idle the bus is selected in the IICMB core
  *
  *  @param[in,out]  self                driver handle
  *  @param[in]      num                 active I2C bus number 0..15
@@ -297,7 +944,7 @@ void iicmb_fsm(t_iicmb *self);
 
 /** @brief busy
  *
- *  checks if the FSM is busy
+ *  checks if the FSM is busy or transfers are queued
  *
  *  @param[in,out]  this                storage element
  *  @return         int                 state
@@ -343,7 +990,7 @@ int iicmb_bus_state(t_iicmb *self);
 
 /** @brief write
  *
- *  write to I2C slave
+ *  write to I2C slave, request is queued if IICMB is active
  *
  *  @param[in,out]  self                storage element
  *  @param[in]      adr7                Slave address (7bit)
@@ -351,7 +998,7 @@ int iicmb_bus_state(t_iicmb *self);
  *  @param[in]      len                 size of *data in byte
  *  @return         int                 state
  *  @retval         IICMB_EXIT_OK       OK: Transfer request accepted
- *  @retval         IICMB_EXIT_BUSY     FAIL: Transfer request not accepted, wait for finish before next request
+ *  @retval         IICMB_EXIT_BUSY     FAIL: Transfer request not accepted, transfer queue is full
  *  @retval         IICMB_EXIT_OCC      FAIL: I2C bus is occupied by another master
  *  @since          2022-06-14
  *  @author         Andreas Kaeberlein
@@ -362,7 +1009,7 @@ int iicmb_write(t_iicmb *self, uint8_t adr7, void* data, uint16_t len);
 
 /** @brief read
  *
- *  read from I2C slave
+ *  read from I2C slave, request is queued if IICMB is active
  *
  *  @param[in,out]  self                storage element
  *  @param[in]      adr7                Slave address (7bit)
@@ -370,7 +1017,7 @@ int iicmb_write(t_iicmb *self, uint8_t adr7, void* data, uint16_t len);
  *  @param[in]      len                 size of *data in byte
  *  @return         int                 state
  *  @retval         IICMB_EXIT_OK       OK: Transfer request accepted
- *  @retval         IICMB_EXIT_BUSY     FAIL: Transfer request not accepted, wait for finish before next request
+ *  @retval         IICMB_EXIT_BUSY     FAIL: Transfer request not accepted, transfer queue is full
  *  @retval         IICMB_EXIT_OCC      FAIL: I2C bus is occupied by another master
  *  @since          2022-06-14
  *  @author         Andreas Kaeberlein
@@ -381,7 +1028,8 @@ int iicmb_read(t_iicmb *self, uint8_t adr7, void* data, uint16_t len);
 
 /** @brief write-read
  *
- *  perform I2C write, repeated start condition and I2C read
+ *  perform I2C write, repeated start condition and I2C read,
+ *  request is queued if IICMB is active
  *
  *  @param[in,out]  this                storage element
  *  @param[in]      adr7                Slave address (7bit)
@@ -390,7 +1038,7 @@ int iicmb_read(t_iicmb *self, uint8_t adr7, void* data, uint16_t len);
  *  @param[in]      rdLen               number of bytes to read in *data
  *  @return         int                 state
  *  @retval         IICMB_EXIT_OK       OK: Transfer request accepted
- *  @retval         IICMB_EXIT_BUSY     FAIL: Transfer request not accepted, wait for finish before next request
+ *  @retval         IICMB_EXIT_BUSY     FAIL: Transfer request not accepted, transfer queue is full
  *  @retval         IICMB_EXIT_OCC      FAIL: I2C bus is occupied by another master
  *  @retval         IICMB_EXIT_ERROR    FAIL: RSomething went wrong
  *  @since          2022-06-14
@@ -400,6 +1048,345 @@ int iicmb_wr_rd(t_iicmb *self, uint8_t adr7, void* data, uint16_t wrLen, uint16_
 
 
 
+/** @brief bus write
+ *
+ *  write to I2C slave on selected bus, the
+ *  scheduler inserts the bus switch
+ *
+ *  @param[in,out]  self                storage element
+ *  @param[in]      bus                 I2C bus number 0..IICMB_BUS_NUM-1
+ *  @param[in]      adr7                Slave address (7bit)
+ *  @param[in]      *data               data buffer
+ *  @param[in]      len                 size of *data in byte
+ *  @return         int                 state
+ *  @retval         IICMB_EXIT_OK       OK: Transfer request accepted
+ *  @retval         IICMB_EXIT_BUSY     FAIL: Transfer request not accepted, transfer queue of bus is full
+ *  @retval         IICMB_EXIT_OCC      FAIL: I2C bus is occupied by another master
+ *  @retval         IICMB_EXIT_ERROR    FAIL: Bus number out of range
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+int iicmb_bus_write(t_iicmb *self, uint8_t bus, uint8_t adr7, void* data, uint16_t len);
+
+
+
+/** @brief bus read
+ *
+ *  read from I2C slave on selected bus, the
+ *  scheduler inserts the bus switch
+ *
+ *  @param[in,out]  self                storage element
+ *  @param[in]      bus                 I2C bus number 0..IICMB_BUS_NUM-1
+ *  @param[in]      adr7                Slave address (7bit)
+ *  @param[out]     *data               data buffer
+ *  @param[in]      len                 size of *data in byte
+ *  @return         int                 state
+ *  @retval         IICMB_EXIT_OK       OK: Transfer request accepted
+ *  @retval         IICMB_EXIT_BUSY     FAIL: Transfer request not accepted, transfer queue of bus is full
+ *  @retval         IICMB_EXIT_OCC      FAIL: I2C bus is occupied by another master
+ *  @retval         IICMB_EXIT_ERROR    FAIL: Bus number out of range
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+int iicmb_bus_read(t_iicmb *self, uint8_t bus, uint8_t adr7, void* data, uint16_t len);
+
+
+
+/** @brief bus write-read
+ *
+ *  perform I2C write, repeated start condition and I2C read
+ *  on selected bus, the scheduler inserts the bus switch
+ *
+ *  @param[in,out]  self                storage element
+ *  @param[in]      bus                 I2C bus number 0..IICMB_BUS_NUM-1
+ *  @param[in]      adr7                Slave address (7bit)
+ *  @param[in,out]  *data               data buffer, write data is overwritten by read data
+ *  @param[in]      wrLen               number of bytes to write in *data
+ *  @param[in]      rdLen               number of bytes to read in *data
+ *  @return         int                 state
+ *  @retval         IICMB_EXIT_OK       OK: Transfer request accepted
+ *  @retval         IICMB_EXIT_BUSY     FAIL: Transfer request not accepted, transfer queue of bus is full
+ *  @retval         IICMB_EXIT_OCC      FAIL: I2C bus is occupied by another master
+ *  @retval         IICMB_EXIT_ERROR    FAIL: Bus number out of range or no write-read request
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+int iicmb_bus_wr_rd(t_iicmb *self, uint8_t bus, uint8_t adr7, void* data, uint16_t wrLen, uint16_t rdLen);
+
+
+
+/** @brief segment transfer
+ *
+ *  writes the write segments in order, sends a repeated start
+ *  condition and reads into the read segments in order. Without
+ *  read segments it is a write, without write segments a read.
+ *  Segment lists with more than one entry and all buffers need
+ *  to stay valid until the transfer is finished.
+ *
+ *  @param[in,out]  self                storage element
+ *  @param[in]      adr7                Slave address (7bit)
+ *  @param[in]      *wr                 write segments, f.e. register address and payload
+ *  @param[in]      wrNum               number of write segments
+ *  @param[in]      *rd                 read segments
+ *  @param[in]      rdNum               number of read segments
+ *  @return         int                 state
+ *  @retval         IICMB_EXIT_OK       OK: Transfer request accepted
+ *  @retval         IICMB_EXIT_BUSY     FAIL: Transfer request not accepted, transfer queue is full
+ *  @retval         IICMB_EXIT_OCC      FAIL: I2C bus is occupied by another master
+ *  @retval         IICMB_EXIT_ERROR    FAIL: More than 65535 bytes per direction
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+int iicmb_xfer(t_iicmb *self, uint8_t adr7, const t_iicmb_seg *wr, uint8_t wrNum, const t_iicmb_seg *rd, uint8_t rdNum);
+
+
+
+/** @brief bus segment transfer
+ *
+ *  #iicmb_xfer on selected bus, the scheduler inserts the bus switch
+ *
+ *  @param[in,out]  self                storage element
+ *  @param[in]      bus                 I2C bus number 0..IICMB_BUS_NUM-1
+ *  @param[in]      adr7                Slave address (7bit)
+ *  @param[in]      *wr                 write segments
+ *  @param[in]      wrNum               number of write segments
+ *  @param[in]      *rd                 read segments
+ *  @param[in]      rdNum               number of read segments
+ *  @return         int                 state
+ *  @retval         IICMB_EXIT_OK       OK: Transfer request accepted
+ *  @retval         IICMB_EXIT_BUSY     FAIL: Transfer request not accepted, transfer queue of bus is full
+ *  @retval         IICMB_EXIT_OCC      FAIL: I2C bus is occupied by another master
+ *  @retval         IICMB_EXIT_ERROR    FAIL: Bus number out of range or more than 65535 bytes per direction
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+int iicmb_bus_xfer(t_iicmb *self, uint8_t bus, uint8_t adr7, const t_iicmb_seg *wr, uint8_t wrNum, const t_iicmb_seg *rd, uint8_t rdNum);
+
+
+
+/** @brief bus segment transfer with completion callback
+ *
+ *  #iicmb_bus_xfer, calls cb when the transfer is finished. The callback
+ *  runs in the context of #iicmb_fsm, in case of an empty transfer
+ *  directly from the caller.
+ *
+ *  @param[in,out]  self                storage element
+ *  @param[in]      bus                 I2C bus number 0..IICMB_BUS_NUM-1
+ *  @param[in]      adr7                Slave address (7bit)
+ *  @param[in]      *wr                 write segments
+ *  @param[in]      wrNum               number of write segments
+ *  @param[in]      *rd                 read segments
+ *  @param[in]      rdNum               number of read segments
+ *  @param[in]      cb                  completion callback, NULL disables
+ *  @param[in]      *ctx                user context passed to cb
+ *  @return         int                 state
+ *  @retval         IICMB_EXIT_OK       OK: Transfer request accepted
+ *  @retval         IICMB_EXIT_BUSY     FAIL: Transfer request not accepted, transfer queue of bus is full
+ *  @retval         IICMB_EXIT_OCC      FAIL: I2C bus is occupied by another master
+ *  @retval         IICMB_EXIT_ERROR    FAIL: Bus number out of range or more than 65535 bytes per direction
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+int iicmb_bus_xfer_cb(t_iicmb *self, uint8_t bus, uint8_t adr7, const t_iicmb_seg *wr, uint8_t wrNum, const t_iicmb_seg *rd, uint8_t rdNum, t_iicmb_cb cb, void *ctx);
+
+
+
+/** @brief retry policy
+ *
+ *  sets the retry policy of transfers submitted afterwards on the bus.
+ *  On arbitration loss or an occupied bus the ISR waits with the IICMB
+ *  wait command and replays the complete transfer, the wait starts
+ *  with waitMs and doubles with every attempt, saturated at 255ms.
+ *  With retries a submit on an occupied bus is queued instead of
+ *  returning IICMB_EXIT_OCC. After the last attempt the transfer ends
+ *  with IICMB_E_ARBLOST or IICMB_E_BUSOCC.
+ *
+ *  @param[in,out]  self                storage element
+ *  @param[in]      bus                 I2C bus number 0..IICMB_BUS_NUM-1
+ *  @param[in]      attempts            maximum number of replays, 0 disables retry
+ *  @param[in]      waitMs              backoff before first replay in ms
+ *  @return         int                 state
+ *  @retval         IICMB_EXIT_OK       OK
+ *  @retval         IICMB_EXIT_ERROR    FAIL: Bus number out of range
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+int iicmb_set_retry(t_iicmb *self, uint8_t bus, uint8_t attempts, uint8_t waitMs);
+
+
+
+/** @brief SCL timing calculation
+ *
+ *  calculates the timing of an SCL frequency for an IICMB clocked
+ *  with clkKhz, identical to the synthesis timing of the HDL. Up to
+ *  100kHz standard mode, up to 400kHz fast mode, up to 1MHz fast
+ *  mode plus, above high-speed mode timing is used.
+ *
+ *  @param[out]     *timing             calculated timing
+ *  @param[in]      clkKhz              IICMB 'clk' frequency in kHz
+ *  @param[in]      sclKhz              SCL frequency in kHz
+ *  @return         int                 state
+ *  @retval         IICMB_EXIT_OK       OK
+ *  @retval         IICMB_EXIT_ERROR    FAIL: SCL frequency not reachable with clkKhz
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+int iicmb_timing_calc(t_iicmb_timing *timing, uint32_t clkKhz, uint32_t sclKhz);
+
+
+
+/** @brief SCL timing
+ *
+ *  sets the timing of transfers submitted afterwards on the bus.
+ *  The timing is referenced and needs to be valid until the
+ *  transfers are finished. The ISR loads it into the IICMB core
+ *  before a transfer starts with a different timing than the
+ *  previous transfer of the bus. NULL selects the synthesis timing.
+ *  Requires IICMB_TIMING.
+ *
+ *  @param[in,out]  self                storage element
+ *  @param[in]      bus                 I2C bus number 0..IICMB_BUS_NUM-1
+ *  @param[in]      *timing             timing, NULL for synthesis timing
+ *  @return         int                 state
+ *  @retval         IICMB_EXIT_OK       OK
+ *  @retval         IICMB_EXIT_ERROR    FAIL: Bus number out of range or timing registers disabled
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+int iicmb_set_timing(t_iicmb *self, uint8_t bus, const t_iicmb_timing *timing);
+
+
+
+/** @brief High-speed mode
+ *
+ *  sets the High-speed mode of transfers submitted afterwards on the
+ *  bus. The IICMB sends the master code 00001XXX in the timing of the
+ *  bus, followed by a repeated Start and the transfer in High-speed
+ *  mode, the Stop returns to the bus timing. The High-speed timing
+ *  is shared by all buses and referenced, the ISR loads it before a
+ *  transfer starts with another High-speed timing. Requires IICMB_TIMING.
+ *
+ *  @param[in,out]  self                storage element
+ *  @param[in]      bus                 I2C bus number 0..IICMB_BUS_NUM-1
+ *  @param[in]      code                master code 0..7, IICMB_HS_OFF for Fast mode
+ *  @param[in]      *timing             High-speed timing, NULL for synthesis timing 'g_f_scl_hs'
+ *  @return         int                 state
+ *  @retval         IICMB_EXIT_OK       OK
+ *  @retval         IICMB_EXIT_ERROR    FAIL: Bus number or master code out of range or timing registers disabled
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+int iicmb_set_hs(t_iicmb *self, uint8_t bus, uint8_t code, const t_iicmb_timing *timing);
+
+
+
+/** @brief interrupt mode
+ *
+ *  sets the interrupt causes and coalescing of the IICMB core. The mask
+ *  applies to message commands, #IICMB_IMSK_EOT interrupts only on
+ *  errors and at the end of the transaction. Errors and END are always
+ *  added, the driver needs them to finish a transfer. Transfers which
+ *  don't fit into the FIFOs, bus selection and retry run with every
+ *  command interrupting. The core executes one command at a time, a
+ *  count above one therefore needs the timeout. Requires IICMB_IRQ_CTRL.
+ *
+ *  @param[in,out]  self                storage element
+ *  @param[in]      mask                interrupt causes, IICMB_IMSK_*
+ *  @param[in]      cnt                 commands per interrupt, 0 or 1 every command
+ *  @param[in]      tim                 timeout in clock cycles, 0 disabled
+ *  @return         int                 state
+ *  @retval         IICMB_EXIT_OK       OK
+ *  @retval         IICMB_EXIT_ERROR    FAIL: Invalid mask, count without timeout or interrupt control registers disabled
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+int iicmb_set_irq(t_iicmb *self, uint8_t mask, uint8_t cnt, uint16_t tim);
+
+
+
+/** @brief arm bus trace
+ *
+ *  empties the trace RAM of the core and starts recording. An
+ *  entry of an event in the trigger mask freezes the trace post
+ *  entries later, the trace keeps running without trigger. Clock
+ *  stretch events need SCL held low stretch clock cycles, the
+ *  timestamps count pre+1 clock cycles. Requires IICMB_BUS_TRACE.
+ *
+ *  @param[in,out]  self                storage element
+ *  @param[in]      trg                 trigger events, IICMB_BTR_MSK(IICMB_BTR_*)
+ *  @param[in]      post                entries after trigger event
+ *  @param[in]      stretch             stretch threshold in clock cycles, 0 no stretch events
+ *  @param[in]      pre                 timestamp prescaler minus one
+ *  @return         int                 state
+ *  @retval         IICMB_EXIT_OK       OK
+ *  @retval         IICMB_EXIT_ERROR    FAIL: No trace RAM in core or bus trace disabled
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+int iicmb_btrace_arm(t_iicmb *self, uint16_t trg, uint8_t post, uint8_t stretch, uint8_t pre);
+
+
+
+/** @brief read bus trace
+ *
+ *  freezes the trace and copies the newest entries, oldest
+ *  first. Decode with IICMB_BTR_EVT/ARG/TIM or dump them for
+ *  test/iicmb_btrace_dec.c. The trace stays frozen until the
+ *  next #iicmb_btrace_arm. Requires IICMB_BUS_TRACE.
+ *
+ *  @param[in,out]  self                storage element
+ *  @param[out]     *entry              trace entries
+ *  @param[in]      size                size of entry in entries
+ *  @param[out]     *len                copied entries
+ *  @return         int                 state
+ *  @retval         IICMB_EXIT_OK       OK
+ *  @retval         IICMB_EXIT_ERROR    FAIL: No trace RAM in core or bus trace disabled
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+int iicmb_btrace_read(t_iicmb *self, uint32_t *entry, uint16_t size, uint16_t *len);
+
+
+
+/** @brief statistics snapshot
+ *
+ *  consistent copy of the statistics of a bus, retried if the ISR
+ *  updates in between. uint32Occ and uint32Full are counted by the
+ *  submit functions and added to the copy. Requires IICMB_STATS.
+ *
+ *  @param[in,out]  self                storage element
+ *  @param[in]      bus                 I2C bus number 0..IICMB_BUS_NUM-1
+ *  @param[out]     *stats              copy of statistics
+ *  @return         int                 state
+ *  @retval         IICMB_EXIT_OK       OK
+ *  @retval         IICMB_EXIT_ERROR    FAIL: Bus number out of range or statistics disabled
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+int iicmb_stats_get(t_iicmb *self, uint8_t bus, t_iicmb_stats *stats);
+
+
+
+/** @brief statistics reset
+ *
+ *  posts a reset of the statistics of a bus, the ISR performs
+ *  it before its next update, so no event of the ISR gets lost.
+ *  Until then #iicmb_stats_get returns cleared ISR counters.
+ *  uint32Occ and uint32Full are cleared at once, call it from
+ *  the context of the submit functions.
+ *
+ *  @param[in,out]  self                storage element
+ *  @param[in]      bus                 I2C bus number 0..IICMB_BUS_NUM-1
+ *  @return         int                 state
+ *  @retval         IICMB_EXIT_OK       OK
+ *  @retval         IICMB_EXIT_ERROR    FAIL: Bus number out of range or statistics disabled
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+int iicmb_stats_clr(t_iicmb *self, uint8_t bus);
+
+
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
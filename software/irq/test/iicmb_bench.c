@@ -0,0 +1,168 @@
+/*******************************************************************************
+**                                                                             *
+**    Project: IIC Multiple Bus Controller (IICMB)                             *
+**                                                                             *
+**    File:    Performance benchmark of IRQ driver on register model       *
+**    Version:                                                                 *
+**             1.0,     October 16, 2026                                       *
+**                                                                             *
+**    Author:  IICMB contributors                                              *
+**                                                                             *
+********************************************************************************
+********************************************************************************
+** Copyright (c) 2023, Sergey Shuvalkin                                        *
+** All rights reserved.                                                        *
+**                                                                             *
+** Redistribution and use in source and binary forms, with or without          *
+** modification, are permitted provided that the following conditions are met: *
+**                                                                             *
+** 1. Redistributions of source code must retain the above copyright notice,   *
+**    this list of conditions and the following disclaimer.                    *
+** 2. Redistributions in binary form must reproduce the above copyright        *
+**    notice, this list of conditions and the following disclaimer in the      *
+**    documentation and/or other materials provided with the distribution.     *
+**                                                                             *
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" *
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE   *
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE  *
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE    *
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR         *
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF        *
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS    *
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN     *
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)     *
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE  *
+** POSSIBILITY OF SUCH DAMAGE.                                                 *
+*******************************************************************************/
+
+
+
+/** Standard libs **/
+#include <stdio.h>          // f.e. printf
+#include <stdlib.h>         // defines four variables, several macros,
+                            // and various functions for performing
+                            // general functions
+#include <stdint.h>         // defines fiexd data types, like int8_t...
+#include <string.h>         // string handling functions
+
+/** User Libs **/
+#include "iicmb.h"			// driver
+#include "iicmb_model.h"	// register model
+
+
+
+/**
+ *  Benchmark configuration
+ */
+#define BENCH_REPEAT	(16)	// transfers per matrix point
+#define BENCH_ADR		(0x50)	// EEPROM address
+#define BENCH_MEM		(4096)	// EEPROM size
+#ifdef IICMB_REG_32
+	#define BENCH_REG_BITS	(32)	// register access width of driver
+#else
+	#define BENCH_REG_BITS	(8)
+#endif
+
+
+
+/**
+ *  Benchmark operations
+ */
+enum { BENCH_WRITE, BENCH_READ, BENCH_WR_RD, BENCH_OP_NUM };
+static const char* strBenchOp[BENCH_OP_NUM] = {"write", "read", "wr_rd"};
+
+
+
+/**
+ *  Main
+ *  ----
+ *  prints one CSV line per operation, length and SCL frequency,
+ *  all per byte values relate to the payload bytes of the driver call
+ */
+int main ()
+{
+    /** Variables **/
+	t_iicmb_model		model;								// IICMB register model
+	t_iicmb				iicm;								// handle for IICMB driver
+	t_iicmb_model_slave	eeprom;								// EEPROM on bus 0
+	uint8_t				uint8Mem[BENCH_MEM];				// EEPROM memory
+	uint8_t				uint8Buf[2+256];					// I2C payload, memory address and data
+	const uint16_t		uint16Len[] = {1, 4, 16, 64, 256};	// payload length
+	const uint32_t		uint32Scl[] = {100, 400, 1000};		// SCL frequency in kHz
+	uint32_t			uint32Op;							// operation
+	uint32_t			uint32LenIdx;						// length index
+	uint32_t			uint32SclIdx;						// SCL index
+	uint32_t			uint32Iter;							// loop counter
+	uint32_t			uint32Bytes;						// payload bytes of matrix point
+	uint64_t			uint64TimeNs;						// simulated time at start of matrix point
+	int					ret;								// driver return
+	
+	
+	
+	/* build system */
+	memset(uint8Mem, 0, sizeof(uint8Mem));
+	memset(uint8Buf, 0, sizeof(uint8Buf));
+	if ( 0 != iicmb_model_init(&model, 1, 100000, 100) ) {
+		printf("ERROR:%s:iicmb_model_init: failed\n", __FUNCTION__);
+		return EXIT_FAILURE;
+	}
+	iicmb_model_eeprom(&eeprom, 0, BENCH_ADR, uint8Mem, sizeof(uint8Mem), 2, 256);
+	if ( (0 != iicmb_model_attach(&model, &eeprom)) || (0 != iicmb_init(&iicm, (void*) &model, 0)) ) {
+		printf("ERROR:%s:init: failed\n", __FUNCTION__);
+		return EXIT_FAILURE;
+	}
+	
+	/* CSV header */
+	printf("op,fifo,reg_bits,len,scl_khz,isr_per_byte,reg_rd_per_byte,reg_wr_per_byte,fsm_ticks_per_isr,fsm_ticks_per_byte,bus_ns_per_byte,bytes_per_sec\n");
+	
+	/* matrix */
+	for ( uint32Op = 0; uint32Op < BENCH_OP_NUM; uint32Op++ ) {
+		for ( uint32LenIdx = 0; uint32LenIdx < sizeof(uint16Len)/sizeof(uint16Len[0]); uint32LenIdx++ ) {
+			for ( uint32SclIdx = 0; uint32SclIdx < sizeof(uint32Scl)/sizeof(uint32Scl[0]); uint32SclIdx++ ) {
+				(void) iicmb_model_set_scl(&model, 0, uint32Scl[uint32SclIdx]);
+				iicmb_model_stat_clr(&model);
+				uint64TimeNs = model.uint64TimeNs;
+				uint32Bytes = 0;
+				for ( uint32Iter = 0; uint32Iter < BENCH_REPEAT; uint32Iter++ ) {
+					switch (uint32Op) {
+						case BENCH_WRITE:
+							ret = iicmb_write(&iicm, BENCH_ADR, uint8Buf, uint16Len[uint32LenIdx]);
+							uint32Bytes += uint16Len[uint32LenIdx];
+							break;
+						case BENCH_READ:
+							ret = iicmb_read(&iicm, BENCH_ADR, uint8Buf, uint16Len[uint32LenIdx]);
+							uint32Bytes += uint16Len[uint32LenIdx];
+							break;
+						default:
+							uint8Buf[0] = 0;	// memory address
+							uint8Buf[1] = 0;
+							ret = iicmb_wr_rd(&iicm, BENCH_ADR, uint8Buf, 2, uint16Len[uint32LenIdx]);
+							uint32Bytes += 2u + uint16Len[uint32LenIdx];
+							break;
+					}
+					if ( (IICMB_EXIT_OK != ret) || (0 != iicmb_model_run(&model, &iicm)) || (0 != iicmb_is_error(&iicm)) ) {
+						printf("ERROR:%s:%s: len=%u scl=%u failed\n", __FUNCTION__, strBenchOp[uint32Op], uint16Len[uint32LenIdx], uint32Scl[uint32SclIdx]);
+						return EXIT_FAILURE;
+					}
+				}
+				printf("%s,%u,%u,%u,%u,%.3f,%.3f,%.3f,%.1f,%.1f,%.1f,%.0f\n",
+						strBenchOp[uint32Op],
+						(unsigned) IICMB_FIFO_DEPTH,
+						(unsigned) BENCH_REG_BITS,
+						uint16Len[uint32LenIdx],
+						uint32Scl[uint32SclIdx],
+						(double) model.uint32Isr / uint32Bytes,
+						(double) model.uint32RegRd / uint32Bytes,
+						(double) model.uint32RegWr / uint32Bytes,
+						(double) model.uint64IsrTicks / model.uint32Isr,
+						(double) model.uint64IsrTicks / uint32Bytes,
+						(double) model.uint64BusNs / uint32Bytes,
+						(double) uint32Bytes * 1e9 / (double) (model.uint64TimeNs - uint64TimeNs)
+					);
+			}
+		}
+	}
+	
+	/* graceful end */
+	return EXIT_SUCCESS;
+}
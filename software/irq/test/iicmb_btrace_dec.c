@@ -0,0 +1,124 @@
+/*******************************************************************************
+**                                                                             *
+**    Project: IIC Multiple Bus Controller (IICMB)                             *
+**                                                                             *
+**    File:    Host decoder of IICMB bus trace RAM dump                        *
+**    Version:                                                                 *
+**             1.0,     October 16, 2026                                       *
+**                                                                             *
+**    Author:  IICMB contributors                                              *
+**                                                                             *
+********************************************************************************
+********************************************************************************
+** Copyright (c) 2023, Sergey Shuvalkin                                        *
+** All rights reserved.                                                        *
+**                                                                             *
+** Redistribution and use in source and binary forms, with or without          *
+** modification, are permitted provided that the following conditions are met: *
+**                                                                             *
+** 1. Redistributions of source code must retain the above copyright notice,   *
+**    this list of conditions and the following disclaimer.                    *
+** 2. Redistributions in binary form must reproduce the above copyright        *
+**    notice, this list of conditions and the following disclaimer in the      *
+**    documentation and/or other materials provided with the distribution.     *
+**                                                                             *
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" *
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE   *
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE  *
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE    *
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR         *
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF        *
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS    *
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN     *
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)     *
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE  *
+** POSSIBILITY OF SUCH DAMAGE.                                                 *
+*******************************************************************************/
+
+
+
+/** Standard libs **/
+#include <stdio.h>          // f.e. printf
+#include <stdlib.h>         // defines four variables, several macros,
+                            // and various functions for performing
+                            // general functions
+#include <stdint.h>         // defines fiexd data types, like int8_t...
+#include <string.h>         // string handling functions
+
+/** User Libs **/
+#include "iicmb.h"			// bus trace entry fields
+
+
+
+/**
+ *  Decoder tables
+ */
+static const char* strBtrEvt[] = {"START", "RSTART", "STOP", "WACK", "WNAK", "RACK", "RNAK", "AL", "ERR", "BUS", "STRB", "STRE"};
+
+
+
+/**
+ *  Main
+ *  ----
+ *  decodes the entries of iicmb_btrace_read, uint32 per entry
+ *  in target byte order, oldest first. Prints one CSV line per
+ *  event, time and dt in us if the system clock is given, else
+ *  in timestamp ticks. sat marks saturated deltas, the gap to the
+ *  previous event is at least this long.
+ */
+int main ( int argc, char *argv[] )
+{
+	/** Variables **/
+	FILE			*fh;				// dump file
+	uint32_t		uint32Entry;		// trace entry
+	uint32_t		uint32Iter = 0;		// entry counter
+	uint32_t		uint32ClkKhz = 0;	// system clock, 0 prints ticks
+	uint32_t		uint32Pre = 0;		// TPRE
+	uint64_t		uint64Time = 0;		// accumulated clock cycles
+	uint64_t		uint64Dt;			// clock cycles to previous event
+	uint8_t			uint8Evt;			// event code
+
+
+
+	/* check args */
+	if ( (2 > argc) || (4 < argc) ) {
+		printf("usage: %s <bus trace dump> [clk_khz] [tpre]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	if ( 3 <= argc ) {
+		uint32ClkKhz = (uint32_t) strtoul(argv[2], NULL, 0);
+	}
+	if ( 4 <= argc ) {
+		uint32Pre = (uint32_t) strtoul(argv[3], NULL, 0);
+	}
+	/* load dump */
+	fh = fopen(argv[1], "rb");
+	if ( NULL == fh ) {
+		printf("ERROR:%s: open '%s' failed\n", __FUNCTION__, argv[1]);
+		return EXIT_FAILURE;
+	}
+	/* decode, first entry starts the time line */
+	printf("entry,time,dt,event,arg,sat\n");
+	while ( 1 == fread(&uint32Entry, sizeof(uint32Entry), 1, fh) ) {
+		uint8Evt = IICMB_BTR_EVT(uint32Entry);
+		uint64Dt = (0 == uint32Iter) ? 0 : (uint64_t) IICMB_BTR_TIM(uint32Entry) * (uint32Pre + 1);
+		uint64Time += uint64Dt;
+		if ( 0 == uint32ClkKhz ) {
+			printf("%u,%llu,%llu,", uint32Iter, (unsigned long long) uint64Time, (unsigned long long) uint64Dt);
+		} else {
+			printf("%u,%.3f,%.3f,", uint32Iter, (double) uint64Time * 1000.0 / uint32ClkKhz, (double) uint64Dt * 1000.0 / uint32ClkKhz);
+		}
+		printf	(	"%s,0x%02x,%u\n",
+					(uint8Evt < (sizeof(strBtrEvt) / sizeof(strBtrEvt[0]))) ? strBtrEvt[uint8Evt] : "?",
+					IICMB_BTR_ARG(uint32Entry),
+					(IICMB_BTR_TIM_MAX == IICMB_BTR_TIM(uint32Entry)) ? 1 : 0
+				);
+		uint32Iter++;
+	}
+	fclose(fh);
+	if ( 0 == uint32Iter ) {
+		printf("ERROR:%s: dump empty\n", __FUNCTION__);
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,1692 @@
+/*******************************************************************************
+**                                                                             *
+**    Project: IIC Multiple Bus Controller (IICMB)                             *
+**                                                                             *
+**    File:    Host register model of IICMB for driver tests.                  *
+**    Version:                                                                 *
+**             1.0,     October 16, 2026                                       *
+**                                                                             *
+**    Author:  IICMB contributors                                              *
+**                                                                             *
+********************************************************************************
+********************************************************************************
+** Copyright (c) 2016, Sergey Shuvalkin                                        *
+** All rights reserved.                                                        *
+**                                                                             *
+** Redistribution and use in source and binary forms, with or without          *
+** modification, are permitted provided that the following conditions are met: *
+**                                                                             *
+** 1. Redistributions of source code must retain the above copyright notice,   *
+**    this list of conditions and the following disclaimer.                    *
+** 2. Redistributions in binary form must reproduce the above copyright        *
+**    notice, this list of conditions and the following disclaimer in the      *
+**    documentation and/or other materials provided with the distribution.     *
+**                                                                             *
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" *
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE   *
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE  *
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE    *
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR         *
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF        *
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS    *
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN     *
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)     *
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE  *
+** POSSIBILITY OF SUCH DAMAGE.                                                 *
+*******************************************************************************/
+
+
+
+/** Includes **/
+/* Standard libs */
+#include <stdint.h>     // defines fixed data types: int8_t...
+#include <stddef.h>     // various variable types and macros: size_t, offsetof, NULL, ...
+#include <string.h>     // memset
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>  // __rdtsc
+#else
+    #include <time.h>       // clock_gettime
+#endif
+/* Self */
+#include "iicmb_model.h"    // related definitions
+
+
+
+/**
+ *  @defgroup IICMB_MODEL_STATE
+ *
+ *  byte FSM states, encoding as mbyte.vhd
+ *
+ *  @{
+ */
+#define IICMB_MODEL_S_IDLE          (0x0)   /**<  Idle */
+#define IICMB_MODEL_S_BUS_TAKEN     (0x1)   /**<  Bus is taken */
+#define IICMB_MODEL_S_START_PENDING (0x2)   /**<  Waiting for right moment to capture bus */
+#define IICMB_MODEL_S_START         (0x3)   /**<  Sending Start Condition */
+#define IICMB_MODEL_S_STOP          (0x4)   /**<  Sending Stop Condition */
+#define IICMB_MODEL_S_WRITE         (0x5)   /**<  Sending a byte */
+#define IICMB_MODEL_S_READ          (0x6)   /**<  Receiving a byte */
+#define IICMB_MODEL_S_WAIT          (0x7)   /**<  Wait command */
+/** @} */
+
+
+
+/**
+ *  @defgroup IICMB_MODEL_MSG
+ *
+ *  next step of a message command, as msg_state_type in regblock.vhd
+ *
+ *  @{
+ */
+#define IICMB_MODEL_M_START         (0)     /**<  Start condition */
+#define IICMB_MODEL_M_ADR           (1)     /**<  Slave address */
+#define IICMB_MODEL_M_WRITE         (2)     /**<  Data byte from TX FIFO */
+#define IICMB_MODEL_M_RSTART        (3)     /**<  Repeated start condition */
+#define IICMB_MODEL_M_RADR          (4)     /**<  Slave address with read bit */
+#define IICMB_MODEL_M_READ          (5)     /**<  Data byte into RX FIFO */
+#define IICMB_MODEL_M_STOP          (6)     /**<  Stop condition */
+/** @} */
+
+
+
+/**
+ *  @brief clock cycles to ns
+ *
+ *  @param[in]      self                model handle
+ *  @param[in]      clk                 number of clock cycles
+ *  @return         uint64_t            time in ns
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static uint64_t iicmb_model_clk_ns(t_iicmb_model *self, uint64_t clk)
+{
+    return (clk * 1000000) / self->uint32ClkKhz;
+}
+
+
+
+/**
+ *  @brief SCL period
+ *
+ *  High-speed mode timing after master code until stop
+ *
+ *  @param[in]      self                model handle
+ *  @param[in]      bus                 I2C bus
+ *  @return         uint64_t            SCL period in ns
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static uint64_t iicmb_model_scl_ns(t_iicmb_model *self, uint8_t bus)
+{
+    if ( 0 != self->uint8Hs ) {
+        return iicmb_model_clk_ns(self, (uint64_t) self->timingHs.uint16Scl + 1);
+    }
+    return iicmb_model_clk_ns(self, (uint64_t) self->timing[bus].uint16Scl + 1);
+}
+
+
+
+/**
+ *  @brief bus free time
+ *
+ *  t_BUF between stop and start, as TBUF in bus_state.vhd
+ *
+ *  @param[in]      self                model handle
+ *  @param[in]      bus                 I2C bus
+ *  @return         uint64_t            t_BUF in ns
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static uint64_t iicmb_model_t_buf_ns(t_iicmb_model *self, uint8_t bus)
+{
+    return iicmb_model_clk_ns(self, (uint64_t) self->timing[bus].uint16Buf + 1);
+}
+
+
+
+/**
+ *  @brief timing register
+ *
+ *  16-bit timing value of the bus or High-speed mode selected by TSEL
+ *
+ *  @param[in,out]  self                model handle
+ *  @param[in]      offset              register offset in #t_iicm_reg, low or high byte
+ *  @return         uint16_t*           timing value, NULL if no timing register
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+#ifdef IICMB_TIMING
+static uint16_t* iicmb_model_tp(t_iicmb_model *self, size_t offset)
+{
+    /** Variables **/
+    t_iicmb_timing  *tp = &(self->timing[self->uint8Tsel & IICMB_TSEL_BUS]);
+
+    /* High-speed mode */
+    if ( 0 != (self->uint8Tsel & IICMB_TSEL_HS) ) {
+        tp = &(self->timingHs);
+    }
+    /* register */
+    switch (offset & ~((size_t) 1)) {
+        case offsetof(t_iicm_reg, TSCL):
+            return &(tp->uint16Scl);
+        case offsetof(t_iicm_reg, THIGH):
+            return &(tp->uint16High);
+        case offsetof(t_iicm_reg, TSUSTA):
+            return &(tp->uint16SuSta);
+        case offsetof(t_iicm_reg, THDSTA):
+            return &(tp->uint16HdSta);
+        case offsetof(t_iicm_reg, TSUDAT):
+            return &(tp->uint16SuDat);
+        case offsetof(t_iicm_reg, TSUSTO):
+            return &(tp->uint16SuSto);
+        case offsetof(t_iicm_reg, TBUF):
+            return &(tp->uint16Buf);
+        case offsetof(t_iicm_reg, TVDDAT):
+            return &(tp->uint16VdDat);
+        default:
+            return NULL;
+    }
+}
+#endif
+
+
+
+/**
+ *  @brief captured
+ *
+ *  @param[in]      self                model handle
+ *  @return         uint8_t             1 if IICMB holds the selected bus
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static uint8_t iicmb_model_captured(t_iicmb_model *self)
+{
+    switch (self->uint8State) {
+        case IICMB_MODEL_S_BUS_TAKEN:
+        case IICMB_MODEL_S_STOP:
+        case IICMB_MODEL_S_WRITE:
+        case IICMB_MODEL_S_READ:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+
+
+/**
+ *  @brief reset
+ *
+ *  regblock/mbyte reset, CSR enable cleared
+ *
+ *  @param[in,out]  self                model handle
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static void iicmb_model_reset(t_iicmb_model *self)
+{
+    self->uint8Rsp = IICMB_RSP_DONE;
+    self->uint8CmdCode = 0;
+    self->uint8RxData = 0;
+    self->uint8Irq = 0;
+    self->uint8IrqCnt = 0;
+    self->uint8BusId = 0;
+    self->uint8State = IICMB_MODEL_S_IDLE;
+    self->uint8StateNext = IICMB_MODEL_S_IDLE;
+    self->uint8RspPend = 0;
+    self->uint8AdrPhase = 0;
+    self->slaveAct = NULL;
+    self->uint8TxHead = 0;
+    self->uint8TxLvl = 0;
+    self->uint8RxHead = 0;
+    self->uint8RxLvl = 0;
+    self->uint8Burst = 0;
+    self->uint8RdPend = 0;
+    self->uint8Mcnt = 0;
+    self->uint8Msg = 0;
+    self->uint8MsgPend = 0;
+    self->uint8Hs = 0;
+}
+
+
+
+/**
+ *  @brief slave visible
+ *
+ *  checks mux chain between bus and slave
+ *
+ *  @param[in]      slave               slave model
+ *  @return         int                 1 if all upstream mux channels are enabled
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static int iicmb_model_visible(t_iicmb_model_slave *slave)
+{
+    while ( NULL != slave->mux ) {
+        if ( 0 == (slave->mux->uint8Ctrl & (1 << slave->uint8MuxChan)) ) {
+            return 0;
+        }
+        slave = slave->mux;
+    }
+    return 1;
+}
+
+
+
+/**
+ *  @brief respond
+ *
+ *  schedules the byte response of the active command
+ *
+ *  @param[in,out]  self                model handle
+ *  @param[in]      rsp                 response bits of CMDR
+ *  @param[in]      ns                  execution time from now
+ *  @param[in]      state               byte FSM state after execution
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static void iicmb_model_respond(t_iicmb_model *self, uint8_t rsp, uint64_t ns, uint8_t state)
+{
+    self->uint8RspPend = 1;
+    self->uint8RspId = rsp;
+    self->uint64RspNs = self->uint64TimeNs + ns;
+    self->uint8StateNext = state;
+    /* bus occupied by own transfer */
+    if ( 0 != iicmb_model_captured(self) ) {
+        self->uint64BusNs += ns;
+    }
+}
+
+
+
+/**
+ *  @brief command
+ *
+ *  executes byte command as mbyte.vhd
+ *
+ *  @param[in,out]  self                model handle
+ *  @param[in]      cmd                 command code
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static void iicmb_model_cmd(t_iicmb_model *self, uint8_t cmd)
+{
+    /** Variables **/
+    uint8_t                 uint8Bus = self->uint8BusId;                // selected bus
+    uint64_t                uint64Scl = iicmb_model_scl_ns(self, uint8Bus); // SCL period
+    uint64_t                uint64Wait = 0;                             // wait for bus free
+    uint64_t                uint64Stretch = 0;                          // clock stretching of slave
+    t_iicmb_model_slave*    slave;                                      // slave candidate
+    uint8_t                 uint8Iter;                                  // loop counter
+
+    /* bus trace of response */
+    self->uint8TrcCmd = cmd;
+    self->uint8TrcData = self->uint8Param;
+    self->uint8TrcCap = iicmb_model_captured(self);
+    self->uint64TrcStrNs = 0;
+    /* execution states */
+    switch (self->uint8State) {
+        /* Idle */
+        case IICMB_MODEL_S_IDLE:
+            switch (cmd) {
+                case IICMB_CMD_START:
+                    /* start pending until bus free */
+                    if ( self->uint64FreeNs[uint8Bus] > self->uint64TimeNs ) {
+                        uint64Wait = self->uint64FreeNs[uint8Bus] - self->uint64TimeNs;
+                    }
+                    self->uint8State = IICMB_MODEL_S_START;
+                    self->uint8AdrPhase = 1;
+                    if ( 0 != self->uint8ArbLost ) {
+                        self->uint8ArbLost = 0;
+                        iicmb_model_respond(self, IICMB_RSP_ARB_LOST, uint64Wait + uint64Scl/2, IICMB_MODEL_S_IDLE);
+                        return;
+                    }
+#ifdef IICMB_TIMING
+                    /* master code in bus timing, not acknowledged, repeated start in High-speed mode */
+                    if ( 0 != (self->uint8Hscr & IICMB_HSCR_HSE) ) {
+                        self->uint8Hs = 1;
+                        uint64Scl += 9*uint64Scl + iicmb_model_scl_ns(self, uint8Bus) + iicmb_model_scl_ns(self, uint8Bus)/2;
+                    }
+#endif
+                    self->uint64BusNs += uint64Scl;
+                    iicmb_model_respond(self, IICMB_RSP_DONE, uint64Wait + uint64Scl, IICMB_MODEL_S_BUS_TAKEN);
+                    return;
+                case IICMB_CMD_SET_BUS:
+                    if ( (self->uint8Param & 0x0F) > (self->uint8BusNum - 1) ) {
+                        iicmb_model_respond(self, IICMB_RSP_ERR, iicmb_model_clk_ns(self, 2), IICMB_MODEL_S_IDLE);
+                        return;
+                    }
+                    self->uint8BusId = self->uint8Param & 0x0F;
+                    iicmb_model_respond(self, IICMB_RSP_DONE, iicmb_model_clk_ns(self, 2), IICMB_MODEL_S_IDLE);
+                    return;
+                case IICMB_CMD_WAIT:
+                    self->uint8State = IICMB_MODEL_S_WAIT;
+                    iicmb_model_respond(self, IICMB_RSP_DONE, (uint64_t) self->uint8Param * 1000000 + iicmb_model_clk_ns(self, 2), IICMB_MODEL_S_IDLE);
+                    return;
+                default:
+                    iicmb_model_respond(self, IICMB_RSP_ERR, iicmb_model_clk_ns(self, 2), IICMB_MODEL_S_IDLE);
+                    return;
+            }
+        /* Bus is taken */
+        case IICMB_MODEL_S_BUS_TAKEN:
+            switch (cmd) {
+                case IICMB_CMD_START:
+                    /* repeated start, slave detects new transfer */
+                    self->uint8State = IICMB_MODEL_S_START;
+                    self->uint8AdrPhase = 1;
+                    self->slaveAct = NULL;
+                    self->uint64BusNs += uint64Scl + uint64Scl/2;
+                    iicmb_model_respond(self, IICMB_RSP_DONE, uint64Scl + uint64Scl/2, IICMB_MODEL_S_BUS_TAKEN);
+                    return;
+                case IICMB_CMD_WRITE:
+                    self->uint8State = IICMB_MODEL_S_WRITE;
+                    /* slave address */
+                    if ( 0 != self->uint8AdrPhase ) {
+                        self->uint8AdrPhase = 0;
+                        self->uint8RdDir = self->uint8Param & IICMB_I2C_RD;
+                        self->slaveAct = NULL;
+                        for ( uint8Iter = 0; uint8Iter < self->uint8SlaveNum; uint8Iter++ ) {
+                            slave = self->slave[uint8Iter];
+                            if ( (uint8Bus == slave->uint8Bus) && ((self->uint8Param >> 1) == slave->uint8Adr) && (0 != iicmb_model_visible(slave)) ) {
+                                if ( 0 == slave->start(slave, self->uint8RdDir) ) {
+                                    self->slaveAct = slave;
+                                    uint64Stretch = slave->uint32StretchNs;
+                                }
+                                break;
+                            }
+                        }
+                        self->uint64PerfNs[2] += uint64Stretch;
+                        self->uint64TrcStrNs = uint64Stretch;
+                        iicmb_model_respond(self, (NULL == self->slaveAct) ? IICMB_RSP_NAK : IICMB_RSP_DONE, 9*uint64Scl + uint64Stretch, IICMB_MODEL_S_BUS_TAKEN);
+                        return;
+                    }
+                    /* data */
+                    self->uint32Bytes++;
+                    if ( (NULL == self->slaveAct) || (0 != self->uint8RdDir) ) {
+                        iicmb_model_respond(self, IICMB_RSP_NAK, 9*uint64Scl, IICMB_MODEL_S_BUS_TAKEN);
+                        return;
+                    }
+                    uint64Stretch = self->slaveAct->uint32StretchNs;
+                    self->uint64PerfNs[2] += uint64Stretch;
+                    self->uint64TrcStrNs = uint64Stretch;
+                    iicmb_model_respond(self, (0 == self->slaveAct->write(self->slaveAct, self->uint8Param)) ? IICMB_RSP_DONE : IICMB_RSP_NAK, 9*uint64Scl + uint64Stretch, IICMB_MODEL_S_BUS_TAKEN);
+                    return;
+                case IICMB_CMD_READ_ACK:
+                case IICMB_CMD_READ_NAK:
+                    self->uint8State = IICMB_MODEL_S_READ;
+                    self->uint32Bytes++;
+                    /* released SDA reads as one */
+                    self->uint8RspData = 0xFF;
+                    if ( (NULL != self->slaveAct) && (0 != self->uint8RdDir) ) {
+                        self->uint8RspData = self->slaveAct->read(self->slaveAct, (uint8_t) (IICMB_CMD_READ_NAK == cmd));
+                        uint64Stretch = self->slaveAct->uint32StretchNs;
+                        self->uint64PerfNs[2] += uint64Stretch;
+                        self->uint64TrcStrNs = uint64Stretch;
+                    }
+                    iicmb_model_respond(self, IICMB_RSP_DONE, 9*uint64Scl + uint64Stretch, IICMB_MODEL_S_BUS_TAKEN);
+                    return;
+                case IICMB_CMD_STOP:
+                    self->uint8State = IICMB_MODEL_S_STOP;
+                    if ( NULL != self->slaveAct ) {
+                        self->slaveAct->stop(self->slaveAct);
+                        self->slaveAct = NULL;
+                    }
+                    iicmb_model_respond(self, IICMB_RSP_DONE, uint64Scl, IICMB_MODEL_S_IDLE);
+                    self->uint8Hs = 0;  // stop returns to bus timing
+                    self->uint64FreeNs[uint8Bus] = self->uint64RspNs + iicmb_model_t_buf_ns(self, uint8Bus);
+                    return;
+                default:
+                    /* other commands are rejected in 'Bus Is Taken' state */
+                    iicmb_model_respond(self, IICMB_RSP_ERR, iicmb_model_clk_ns(self, 2), IICMB_MODEL_S_BUS_TAKEN);
+                    return;
+            }
+        /* not possible, commands are only accepted if completed */
+        default:
+            iicmb_model_respond(self, IICMB_RSP_ERR, iicmb_model_clk_ns(self, 2), IICMB_MODEL_S_IDLE);
+            return;
+    }
+}
+
+
+
+/**
+ *  @brief parameter
+ *
+ *  parameter of write, set bus and wait command, head of TX FIFO
+ *  or last DPR write if empty
+ *
+ *  @param[in,out]  self                model handle
+ *  @return         uint8_t             parameter
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static uint8_t iicmb_model_param(t_iicmb_model *self)
+{
+    /** Variables **/
+    uint8_t uint8Data;
+
+    if ( 0 == self->uint8TxLvl ) {
+        return self->uint8TxData;
+    }
+    uint8Data = self->uint8TxFifo[self->uint8TxHead++];
+    self->uint8TxLvl--;
+    return uint8Data;
+}
+
+
+
+/**
+ *  @brief burst read
+ *
+ *  next read of a read command with FRCNT > 1, last byte
+ *  with the acknowledge of the command
+ *
+ *  @param[in,out]  self                model handle
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static void iicmb_model_burst_read(t_iicmb_model *self)
+{
+    self->uint8RdPend = 0;
+    self->uint8BurstCnt--;
+    iicmb_model_cmd(self, (0 == self->uint8BurstCnt) ? self->uint8BurstId : IICMB_CMD_READ_ACK);
+}
+
+
+
+/**
+ *  @brief message step
+ *
+ *  issues the next byte command of a message, waits with held
+ *  bus for TX FIFO data or RX FIFO space
+ *
+ *  @param[in,out]  self                model handle
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static void iicmb_model_msg_issue(t_iicmb_model *self)
+{
+    self->uint8MsgPend = 0;
+    switch (self->uint8MsgState) {
+        case IICMB_MODEL_M_START:
+        case IICMB_MODEL_M_RSTART:
+            iicmb_model_cmd(self, IICMB_CMD_START);
+            return;
+        case IICMB_MODEL_M_ADR:
+            self->uint8Param = (uint8_t) ((self->uint8Madr & 0xFE) | self->uint8MsgAdrRd);
+            iicmb_model_cmd(self, IICMB_CMD_WRITE);
+            return;
+        case IICMB_MODEL_M_RADR:
+            self->uint8Param = (uint8_t) (self->uint8Madr | IICMB_I2C_RD);
+            iicmb_model_cmd(self, IICMB_CMD_WRITE);
+            return;
+        case IICMB_MODEL_M_WRITE:
+            if ( 0 == self->uint8TxLvl ) {
+                self->uint8MsgPend = 1; // wait for DPR write
+                return;
+            }
+            self->uint8Param = iicmb_model_param(self);
+            iicmb_model_cmd(self, IICMB_CMD_WRITE);
+            return;
+        case IICMB_MODEL_M_READ:
+            if ( self->uint8RxLvl >= self->uint8FifoDepth ) {
+                self->uint8MsgPend = 1; // wait for DPR read
+                return;
+            }
+            iicmb_model_cmd(self, (1 == self->uint8MsgRcnt) ? IICMB_CMD_READ_NAK : IICMB_CMD_READ_ACK);
+            return;
+        default:
+            iicmb_model_cmd(self, IICMB_CMD_STOP);
+            return;
+    }
+}
+
+
+
+/**
+ *  @brief message response
+ *
+ *  advances the message with the byte response, as msg_proc
+ *  in regblock.vhd
+ *
+ *  @param[in,out]  self                model handle
+ *  @return         int                 state
+ *  @retval         0                   message completed
+ *  @retval         1                   message continues
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static int iicmb_model_msg_next(t_iicmb_model *self)
+{
+    /* stop, arbitration lost or error close the message */
+    if ( (IICMB_MODEL_M_STOP == self->uint8MsgState) || (IICMB_RSP_ARB_LOST == self->uint8RspId) || (IICMB_RSP_ERR == self->uint8RspId) ) {
+        self->uint8Msg = 0;
+        if ( (IICMB_MODEL_M_STOP == self->uint8MsgState) && (0 != self->uint8MsgNak) ) {
+            self->uint8RspId = IICMB_RSP_NAK;
+        }
+        return 0;
+    }
+    switch (self->uint8MsgState) {
+        case IICMB_MODEL_M_START:
+            self->uint8MsgState = IICMB_MODEL_M_ADR;
+            break;
+        case IICMB_MODEL_M_ADR:
+        case IICMB_MODEL_M_RADR:
+            if ( IICMB_RSP_NAK == self->uint8RspId ) {
+                self->uint8MsgNak = 1;
+                self->uint8MsgState = IICMB_MODEL_M_STOP;
+            } else if ( 0 != self->uint8MsgWcnt ) {
+                self->uint8MsgState = IICMB_MODEL_M_WRITE;
+            } else if ( (0 != self->uint8MsgRcnt) && ((IICMB_MODEL_M_RADR == self->uint8MsgState) || (0 != self->uint8MsgAdrRd)) ) {
+                self->uint8MsgState = IICMB_MODEL_M_READ;
+            } else {
+                self->uint8MsgState = IICMB_MODEL_M_STOP;
+            }
+            break;
+        case IICMB_MODEL_M_WRITE:
+            self->uint8Mcnt++;
+            self->uint8MsgWcnt--;
+            if ( IICMB_RSP_NAK == self->uint8RspId ) {
+                self->uint8MsgNak = 1;
+                self->uint8MsgState = IICMB_MODEL_M_STOP;
+            } else if ( 0 == self->uint8MsgWcnt ) {
+                self->uint8MsgState = (0 != self->uint8MsgRcnt) ? IICMB_MODEL_M_RSTART : IICMB_MODEL_M_STOP;
+            }
+            break;
+        case IICMB_MODEL_M_RSTART:
+            self->uint8MsgState = IICMB_MODEL_M_RADR;
+            break;
+        case IICMB_MODEL_M_READ:
+            self->uint8Mcnt++;
+            self->uint8MsgRcnt--;
+            if ( 0 == self->uint8MsgRcnt ) {
+                self->uint8MsgState = IICMB_MODEL_M_STOP;
+            }
+            break;
+        default:
+            break;
+    }
+    iicmb_model_msg_issue(self);
+    return 1;
+}
+
+
+
+/**
+ *  @brief message start
+ *
+ *  loads the message command from MADR/MLEN/MRSW
+ *
+ *  @param[in,out]  self                model handle
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static void iicmb_model_msg_start(t_iicmb_model *self)
+{
+    self->uint8Msg = 1;
+    self->uint8MsgState = IICMB_MODEL_M_START;
+    self->uint8MsgNak = 0;
+    self->uint8Mcnt = 0;
+    if ( 0 == (self->uint8Madr & IICMB_I2C_RD) ) {
+        self->uint8MsgAdrRd = 0;
+        self->uint8MsgWcnt = self->uint8Mlen;
+        self->uint8MsgRcnt = 0;
+    } else if ( 0 == self->uint8Mrsw ) {
+        self->uint8MsgAdrRd = 1;
+        self->uint8MsgWcnt = 0;
+        self->uint8MsgRcnt = self->uint8Mlen;
+    } else {
+        self->uint8MsgAdrRd = 0;
+        self->uint8MsgWcnt = self->uint8Mrsw;
+        self->uint8MsgRcnt = self->uint8Mlen;
+    }
+    iicmb_model_msg_issue(self);
+}
+
+
+
+/**
+ *  @brief interrupt
+ *
+ *  interrupt of completed command, as regblock.vhd. Errors
+ *  interrupt immediately, done is counted by the coalescing.
+ *
+ *  @param[in,out]  self                model handle
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static void iicmb_model_irq(t_iicmb_model *self)
+{
+    /** Variables **/
+    uint8_t uint8Cause;
+
+    /* requires IE */
+    if ( 0 == self->uint8IE ) {
+        return;
+    }
+    /* causes of response */
+    switch (self->uint8Rsp) {
+        case IICMB_RSP_DONE:
+            uint8Cause = IICMB_IMSK_DON;
+            if ( (IICMB_CMD_STOP == self->uint8CmdCode) || (IICMB_CMD_MSG == self->uint8CmdCode) ) {
+                uint8Cause |= IICMB_IMSK_END;
+            }
+            break;
+        case IICMB_RSP_NAK:
+            uint8Cause = IICMB_IMSK_NAK;
+            break;
+        case IICMB_RSP_ARB_LOST:
+            uint8Cause = IICMB_IMSK_AL;
+            break;
+        default:
+            uint8Cause = IICMB_IMSK_ERR;
+            break;
+    }
+    uint8Cause &= self->uint8Imsk;
+    if ( 0 == uint8Cause ) {
+        return;
+    }
+    /* count done, timeout starts with first */
+    if ( (0 == (uint8Cause & (IICMB_IMSK_NAK | IICMB_IMSK_AL | IICMB_IMSK_ERR))) && (self->uint8Icnt > self->uint8IrqCnt + 1) ) {
+        if ( 0 == self->uint8IrqCnt ) {
+            self->uint64IrqNs = self->uint64TimeNs + iicmb_model_clk_ns(self, self->uint16Itim);
+        }
+        self->uint8IrqCnt++;
+        return;
+    }
+    self->uint8IrqCnt = 0;
+    self->uint8Irq = 1;
+    self->uint32Irq++;
+}
+
+
+
+/**
+ *  @brief trace entry
+ *
+ *  writes bus trace entry with timestamp since the previous
+ *  entry and handles trigger, as trc_proc in regblock.vhd
+ *
+ *  @param[in,out]  self                model handle
+ *  @param[in]      evt                 event, IICMB_BTR_*
+ *  @param[in]      arg                 argument of event
+ *  @param[in]      ns                  simulated time of event
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static void iicmb_model_trace(t_iicmb_model *self, uint8_t evt, uint8_t arg, uint64_t ns)
+{
+    /** Variables **/
+    uint64_t    uint64Tim;
+
+    /* recording */
+    if ( (0 == (self->uint8Tcr & IICMB_TCR_EN)) || (0 != (self->uint8Tcr & IICMB_TCR_FRZ)) ) {
+        return;
+    }
+    uint64Tim = (ns - self->uint64TrcNs) * self->uint32ClkKhz / 1000000 / ((uint64_t) self->uint8Tpre + 1);
+    if ( IICMB_BTR_TIM_MAX < uint64Tim ) {
+        uint64Tim = IICMB_BTR_TIM_MAX;  // saturates
+    }
+    self->uint32Trc[self->uint16Tptr] = ((uint32_t) evt << 28) | ((uint32_t) arg << 20) | (uint32_t) uint64Tim;
+    self->uint16Tptr = (uint16_t) ((self->uint16Tptr + 1) & ((1 << IICMB_MODEL_TRC_LOG2) - 1));
+    if ( 0 == self->uint16Tptr ) {
+        self->uint8Tcr |= IICMB_TCR_WRAP;
+    }
+    self->uint64TrcNs = ns;
+    /* trigger, freeze post entries later */
+    if ( 0 == (self->uint8Tcr & IICMB_TCR_TRG) ) {
+        if ( 0 != (self->uint16Ttrg & IICMB_BTR_MSK(evt)) ) {
+            self->uint8Tcr |= IICMB_TCR_TRG;
+            self->uint8TrcPost = self->uint8Tpost;
+            if ( 0 == self->uint8Tpost ) {
+                self->uint8Tcr |= IICMB_TCR_FRZ;
+            }
+        }
+    } else if ( 0 != self->uint8TrcPost ) {
+        self->uint8TrcPost--;
+        if ( 0 == self->uint8TrcPost ) {
+            self->uint8Tcr |= IICMB_TCR_FRZ;
+        }
+    }
+}
+
+
+
+/**
+ *  @brief trace response
+ *
+ *  bus trace events of the byte response, clock stretching
+ *  above TSTR ends one SCL period before the response
+ *
+ *  @param[in,out]  self                model handle
+ *  @param[in]      rd                  response of read, mrsp_byte
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static void iicmb_model_trace_rsp(t_iicmb_model *self, uint8_t rd)
+{
+    /** Variables **/
+    uint64_t    uint64Str = iicmb_model_clk_ns(self, self->uint8Tstr);  // stretch threshold
+    uint64_t    uint64Beg;                                              // stretch begin
+
+    /* clock stretch, slave holds SCL in data/acknowledge bit */
+    if ( (0 != self->uint8Tstr) && (0 != self->uint64TrcStrNs) && (self->uint64TrcStrNs >= uint64Str) ) {
+        uint64Beg = self->uint64TimeNs - iicmb_model_scl_ns(self, self->uint8BusId) - self->uint64TrcStrNs;
+        iicmb_model_trace(self, IICMB_BTR_STRB, 0x5, uint64Beg + uint64Str);   // s_rw_b
+        iicmb_model_trace(self, IICMB_BTR_STRE, 0, uint64Beg + self->uint64TrcStrNs);
+    }
+    /* response */
+    if ( 0 != rd ) {
+        iicmb_model_trace(self, (IICMB_CMD_READ_NAK == self->uint8TrcCmd) ? IICMB_BTR_RNAK : IICMB_BTR_RACK, self->uint8RspData, self->uint64TimeNs);
+        return;
+    }
+    switch (self->uint8RspId) {
+        case IICMB_RSP_DONE:
+            if ( IICMB_CMD_START == self->uint8TrcCmd ) {
+                iicmb_model_trace(self, (0 != self->uint8TrcCap) ? IICMB_BTR_RSTART : IICMB_BTR_START, 0, self->uint64TimeNs);
+            } else if ( IICMB_CMD_STOP == self->uint8TrcCmd ) {
+                iicmb_model_trace(self, IICMB_BTR_STOP, 0, self->uint64TimeNs);
+            } else if ( IICMB_CMD_WRITE == self->uint8TrcCmd ) {
+                iicmb_model_trace(self, IICMB_BTR_WACK, self->uint8TrcData, self->uint64TimeNs);
+            } else if ( IICMB_CMD_SET_BUS == self->uint8TrcCmd ) {
+                iicmb_model_trace(self, IICMB_BTR_BUS, self->uint8TrcData, self->uint64TimeNs);
+            }
+            return;
+        case IICMB_RSP_NAK:
+            iicmb_model_trace(self, IICMB_BTR_WNAK, self->uint8TrcData, self->uint64TimeNs);
+            return;
+        case IICMB_RSP_ARB_LOST:
+            iicmb_model_trace(self, IICMB_BTR_AL, self->uint8TrcCmd, self->uint64TimeNs);
+            return;
+        default:
+            iicmb_model_trace(self, IICMB_BTR_ERR, self->uint8TrcCmd, self->uint64TimeNs);
+            return;
+    }
+}
+
+
+
+/**
+ *  @brief deliver
+ *
+ *  response of the byte FSM, as regblock.vhd. Inside a write/read
+ *  burst the next byte command follows without status update.
+ *
+ *  @param[in,out]  self                model handle
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static void iicmb_model_deliver(t_iicmb_model *self)
+{
+    /** Variables **/
+    uint8_t uint8Rd = (uint8_t) (IICMB_MODEL_S_READ == self->uint8State);  // mrsp_byte
+
+    self->uint8RspPend = 0;
+    self->uint8State = self->uint8StateNext;
+    iicmb_model_trace_rsp(self, uint8Rd);
+    if ( 0 != uint8Rd ) {
+        self->uint8RxData = self->uint8RspData;
+        if ( self->uint8RxLvl < self->uint8FifoDepth ) {
+            self->uint8RxFifo[(uint8_t) (self->uint8RxHead + self->uint8RxLvl)] = self->uint8RspData;
+            self->uint8RxLvl++;
+        }
+    }
+    /* message continues */
+    if ( (0 != self->uint8Msg) && (0 != iicmb_model_msg_next(self)) ) {
+        return;
+    }
+    /* burst continues */
+    if ( 0 != self->uint8Burst ) {
+        if ( IICMB_CMD_WRITE == self->uint8BurstId ) {
+            if ( (IICMB_RSP_DONE == self->uint8RspId) && (0 != self->uint8TxLvl) ) {
+                self->uint8Param = iicmb_model_param(self);
+                iicmb_model_cmd(self, IICMB_CMD_WRITE);
+                return;
+            }
+        } else if ( (0 != uint8Rd) && (0 != self->uint8BurstCnt) ) {
+            if ( self->uint8RxLvl < self->uint8FifoDepth ) {
+                iicmb_model_burst_read(self);
+            } else {
+                self->uint8RdPend = 1;  // wait for DPR read
+            }
+            return;
+        }
+        self->uint8Burst = 0;
+    }
+    /* command completed */
+    self->uint8Rsp = self->uint8RspId;
+    iicmb_model_irq(self);
+}
+
+
+
+/**
+ *  @brief coalescing timeout
+ *
+ *  raises the interrupt of counted commands if the
+ *  timeout ITIM expires until the given time
+ *
+ *  @param[in,out]  self                model handle
+ *  @param[in]      ns                  simulated time
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static void iicmb_model_timeout(t_iicmb_model *self, uint64_t ns)
+{
+    if ( (0 != self->uint8IrqCnt) && (0 != self->uint16Itim) && (self->uint64IrqNs <= ns) ) {
+        self->uint8IrqCnt = 0;
+        self->uint8Irq = 1;
+        self->uint32Irq++;
+    }
+}
+
+
+
+/**
+ *  @brief performance counters
+ *
+ *  counts the time since the last call as the counters of
+ *  regblock.vhd, the state must not change in between.
+ *  Clock stretching is counted on command execution.
+ *
+ *  @param[in,out]  self                model handle
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static void iicmb_model_perf(t_iicmb_model *self)
+{
+    /** Variables **/
+    uint64_t    uint64Dt = self->uint64TimeNs - self->uint64PerfAccNs;
+    uint64_t    uint64Free = self->uint64FreeNs[self->uint8BusId];
+
+    /* counters run while enabled */
+    if ( 0 != self->uint8E ) {
+        if ( 0 == self->uint8Rsp ) {
+            self->uint64PerfNs[1] += uint64Dt;  // command latency
+        } else if ( 0 != iicmb_model_captured(self) ) {
+            self->uint64PerfNs[3] += uint64Dt;  // turnaround
+        }
+        if ( (0 == iicmb_model_captured(self)) && (uint64Free > self->uint64PerfAccNs) ) {
+            self->uint64PerfNs[4] += ((uint64Free < self->uint64TimeNs) ? uint64Free : self->uint64TimeNs) - self->uint64PerfAccNs;
+        }
+    }
+    self->uint64PerfAccNs = self->uint64TimeNs;
+}
+
+
+
+/**
+ *  @brief advance time
+ *
+ *  advances simulated time, delivers due responses
+ *
+ *  @param[in,out]  self                model handle
+ *  @param[in]      ns                  time step
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static void iicmb_model_advance(t_iicmb_model *self, uint64_t ns)
+{
+    /** Variables **/
+    uint64_t    uint64End = self->uint64TimeNs + ns;
+
+    /* burst commands start at response time */
+    while ( (0 != self->uint8RspPend) && (self->uint64RspNs <= uint64End) ) {
+        iicmb_model_timeout(self, self->uint64RspNs);
+        self->uint64TimeNs = self->uint64RspNs;
+        iicmb_model_perf(self);
+        iicmb_model_deliver(self);
+    }
+    iicmb_model_timeout(self, uint64End);
+    self->uint64TimeNs = uint64End;
+    iicmb_model_perf(self);
+}
+
+
+
+/**
+ *  @brief register read
+ *
+ *  one byte lane of a register access, as regblock.vhd
+ *
+ *  @param[in,out]  self                model handle
+ *  @param[in]      offset              register offset in #t_iicm_reg
+ *  @return         uint8_t             read value
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static uint8_t iicmb_model_rd(t_iicmb_model *self, size_t offset)
+{
+    /** Variables **/
+    uint8_t         uint8Data;
+#ifdef IICMB_TIMING
+    uint16_t        *uint16Tp;  // timing register
+#endif
+
+    /* register */
+    switch (offset) {
+        case offsetof(t_iicm_reg, CSR):
+            return (uint8_t) ( (self->uint8E << 7) | (self->uint8IE << 6) |
+                               ((((0 != iicmb_model_captured(self)) || (self->uint64FreeNs[self->uint8BusId] > self->uint64TimeNs)) ? 1 : 0) << 5) |
+                               (iicmb_model_captured(self) << 4) | self->uint8BusId );
+        case offsetof(t_iicm_reg, DPR):
+            if ( 0 != self->uint8RxLvl ) {
+                uint8Data = self->uint8RxFifo[self->uint8RxHead++];
+                self->uint8RxLvl--;
+                if ( 0 != self->uint8RdPend ) {
+                    iicmb_model_burst_read(self);   // space in RX FIFO
+                }
+                if ( 0 != self->uint8MsgPend ) {
+                    iicmb_model_msg_issue(self);
+                }
+                return uint8Data;
+            }
+            return self->uint8RxData;
+        case offsetof(t_iicm_reg, CMDR):
+            self->uint8Irq = 0; // clear on read
+            return (uint8_t) (self->uint8Rsp | self->uint8CmdCode);
+        case offsetof(t_iicm_reg, FSMR):
+            return (uint8_t) (self->uint8State << 4);
+#if IICMB_FIFO_DEPTH > 0
+        case offsetof(t_iicm_reg, FTXL):
+            return self->uint8TxLvl;
+        case offsetof(t_iicm_reg, FRXL):
+            return self->uint8RxLvl;
+        case offsetof(t_iicm_reg, FSR):
+            return (uint8_t) ( ((0 == self->uint8TxLvl) ? IICMB_FSR_TXE : 0) |
+                               ((self->uint8FifoDepth == self->uint8TxLvl) ? IICMB_FSR_TXF : 0) |
+                               ((0 == self->uint8RxLvl) ? IICMB_FSR_RXE : 0) |
+                               ((self->uint8FifoDepth == self->uint8RxLvl) ? IICMB_FSR_RXF : 0) |
+                               ((((0 != self->uint8Burst) && (IICMB_CMD_WRITE == self->uint8BurstId)) || ((0 != self->uint8Msg) && (0 != self->uint8MsgWcnt))) && (self->uint8TxLvl <= self->uint8TxThr) ? IICMB_FSR_TXT : 0) |
+                               (((0 != self->uint8RxLvl) && (self->uint8RxLvl >= self->uint8RxThr)) ? IICMB_FSR_RXT : 0) |
+                               (((0 != self->uint8Burst) || (0 != self->uint8Msg)) ? IICMB_FSR_BST : 0) );
+        case offsetof(t_iicm_reg, FDEPTH):
+            return self->uint8FifoDepth;
+        case offsetof(t_iicm_reg, FTXT):
+            return self->uint8TxThr;
+        case offsetof(t_iicm_reg, FRXT):
+            return self->uint8RxThr;
+        case offsetof(t_iicm_reg, FRCNT):
+            return self->uint8Rcnt;
+        case offsetof(t_iicm_reg, FCR):
+            return self->uint8Fie;
+        case offsetof(t_iicm_reg, MADR):
+            return self->uint8Madr;
+        case offsetof(t_iicm_reg, MLEN):
+            return self->uint8Mlen;
+        case offsetof(t_iicm_reg, MRSW):
+            return self->uint8Mrsw;
+        case offsetof(t_iicm_reg, MCNT):
+            return self->uint8Mcnt;
+#endif
+#ifdef IICMB_IRQ_CTRL
+        case offsetof(t_iicm_reg, IMSK):
+            return self->uint8Imsk;
+        case offsetof(t_iicm_reg, ICNT):
+            return self->uint8Icnt;
+        case offsetof(t_iicm_reg, ITIM[0]):
+            return (uint8_t) self->uint16Itim;
+        case offsetof(t_iicm_reg, ITIM[1]):
+            return (uint8_t) (self->uint16Itim >> 8);
+#endif
+#ifdef IICMB_TIMING
+        case offsetof(t_iicm_reg, TSEL):
+            return self->uint8Tsel;
+        case offsetof(t_iicm_reg, HSCR):
+            return (uint8_t) (self->uint8Hscr | ((0 != self->uint8Hs) ? IICMB_HSCR_HS : 0));
+#endif
+#ifdef IICMB_BUS_TRACE
+        case offsetof(t_iicm_reg, TCR):
+            return self->uint8Tcr;
+        case offsetof(t_iicm_reg, TPOST):
+            return self->uint8Tpost;
+        case offsetof(t_iicm_reg, TTRG[0]):
+            return (uint8_t) self->uint16Ttrg;
+        case offsetof(t_iicm_reg, TTRG[1]):
+            return (uint8_t) (self->uint16Ttrg >> 8);
+        case offsetof(t_iicm_reg, TPTR[0]):
+            return (uint8_t) self->uint16Tptr;
+        case offsetof(t_iicm_reg, TPTR[1]):
+            return (uint8_t) (self->uint16Tptr >> 8);
+        case offsetof(t_iicm_reg, TSTR):
+            return self->uint8Tstr;
+        case offsetof(t_iicm_reg, TPRE):
+            return self->uint8Tpre;
+        case offsetof(t_iicm_reg, TIDX[0]):
+            return (uint8_t) self->uint16Tidx;
+        case offsetof(t_iicm_reg, TIDX[1]):
+            return (uint8_t) (self->uint16Tidx >> 8);
+        case offsetof(t_iicm_reg, TDEP):
+            return IICMB_MODEL_TRC_LOG2;
+        case offsetof(t_iicm_reg, TDAT[0]):
+        case offsetof(t_iicm_reg, TDAT[1]):
+        case offsetof(t_iicm_reg, TDAT[2]):
+            return (uint8_t) (self->uint32Trc[self->uint16Tidx & ((1 << IICMB_MODEL_TRC_LOG2) - 1)] >> (8 * (offset & 3)));
+        case offsetof(t_iicm_reg, TDAT[3]):
+            uint8Data = (uint8_t) (self->uint32Trc[self->uint16Tidx & ((1 << IICMB_MODEL_TRC_LOG2) - 1)] >> 24);
+            self->uint16Tidx++; // next entry
+            return uint8Data;
+#endif
+        default:
+#ifdef IICMB_PERF
+            if ( (offset >= offsetof(t_iicm_reg, PCMD)) && (offset < offsetof(t_iicm_reg, PCMD) + 4*IICMB_PERF_NUM) ) {
+                return (uint8_t) (self->uint32Perf[(offset - offsetof(t_iicm_reg, PCMD)) / 4] >> (8 * (offset & 3)));
+            }
+#endif
+#ifdef IICMB_TIMING
+            uint16Tp = iicmb_model_tp(self, offset);
+            if ( NULL != uint16Tp ) {
+                return (uint8_t) (*uint16Tp >> (8 * (offset & 1)));
+            }
+#endif
+            return 0;
+    }
+}
+
+
+
+/**
+ *  @brief register write
+ *
+ *  one byte lane of a register access, as regblock.vhd
+ *
+ *  @param[in,out]  self                model handle
+ *  @param[in]      offset              register offset in #t_iicm_reg
+ *  @param[in]      val                 write value
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static void iicmb_model_wr(t_iicmb_model *self, size_t offset, uint8_t val)
+{
+    /** Variables **/
+    uint8_t         uint8Completed;
+#ifdef IICMB_TIMING
+    uint16_t        *uint16Tp;  // timing register
+#endif
+#ifdef IICMB_PERF
+    uint8_t         uint8Iter;
+#endif
+
+    /* register */
+    switch (offset) {
+        case offsetof(t_iicm_reg, CSR):
+            self->uint8E = (uint8_t) ((val >> 7) & 1);
+            self->uint8IE = (uint8_t) ((val >> 6) & 1);
+            if ( 0 == self->uint8E ) {
+                iicmb_model_reset(self);    // disable is synchronous reset of the core
+            }
+            if ( 0 == self->uint8IE ) {
+                self->uint8Irq = 0;
+                self->uint8IrqCnt = 0;
+            }
+            return;
+        case offsetof(t_iicm_reg, DPR):
+            self->uint8TxData = val;
+            if ( self->uint8TxLvl < self->uint8FifoDepth ) {
+                self->uint8TxFifo[(uint8_t) (self->uint8TxHead + self->uint8TxLvl)] = val;
+                self->uint8TxLvl++;
+                if ( 0 != self->uint8MsgPend ) {
+                    iicmb_model_msg_issue(self);    // data for message
+                }
+            }
+            return;
+        case offsetof(t_iicm_reg, CMDR):
+            /* disabled core ignores commands */
+            if ( 0 == self->uint8E ) {
+                return;
+            }
+            /* write clears status, command only accepted if last completed */
+            uint8Completed = (uint8_t) (0 != self->uint8Rsp);
+            self->uint8Rsp = 0;
+            if ( 0 == uint8Completed ) {
+                return;
+            }
+            self->uint32PerfCmd++;
+            self->uint8CmdCode = val & 0x07;
+            /* parameter from TX FIFO or DPR */
+            if ( (IICMB_CMD_WRITE == self->uint8CmdCode) || (IICMB_CMD_SET_BUS == self->uint8CmdCode) || (IICMB_CMD_WAIT == self->uint8CmdCode) ) {
+                self->uint8Param = iicmb_model_param(self);
+            }
+            /* FIFOs: write sends TX FIFO, read receives FRCNT bytes */
+            self->uint8Burst = 0;
+            self->uint8BurstId = self->uint8CmdCode;
+            if ( 0 != self->uint8FifoDepth ) {
+                if ( IICMB_CMD_MSG == self->uint8CmdCode ) {
+                    iicmb_model_msg_start(self);
+                    return;
+                }
+                if ( IICMB_CMD_WRITE == self->uint8CmdCode ) {
+                    self->uint8Burst = 1;
+                } else if ( ((IICMB_CMD_READ_ACK == self->uint8CmdCode) || (IICMB_CMD_READ_NAK == self->uint8CmdCode)) && (1 < self->uint8Rcnt) ) {
+                    self->uint8Burst = 1;
+                    self->uint8BurstCnt = (uint8_t) (self->uint8Rcnt - 1);
+                    iicmb_model_cmd(self, IICMB_CMD_READ_ACK);
+                    return;
+                }
+            }
+            iicmb_model_cmd(self, self->uint8CmdCode);
+            return;
+#if IICMB_FIFO_DEPTH > 0
+        case offsetof(t_iicm_reg, FTXT):
+            self->uint8TxThr = val;
+            return;
+        case offsetof(t_iicm_reg, FRXT):
+            self->uint8RxThr = val;
+            return;
+        case offsetof(t_iicm_reg, FRCNT):
+            self->uint8Rcnt = val;
+            return;
+        case offsetof(t_iicm_reg, FCR):
+            self->uint8Fie = val & 0x0F;
+            if ( 0 != (val & IICMB_FCR_TXC) ) {
+                self->uint8TxHead = 0;
+                self->uint8TxLvl = 0;
+            }
+            if ( 0 != (val & IICMB_FCR_RXC) ) {
+                self->uint8RxHead = 0;
+                self->uint8RxLvl = 0;
+            }
+            return;
+        case offsetof(t_iicm_reg, MADR):
+            self->uint8Madr = val;
+            return;
+        case offsetof(t_iicm_reg, MLEN):
+            self->uint8Mlen = val;
+            return;
+        case offsetof(t_iicm_reg, MRSW):
+            self->uint8Mrsw = val;
+            return;
+#endif
+#ifdef IICMB_IRQ_CTRL
+        case offsetof(t_iicm_reg, IMSK):
+            self->uint8Imsk = val & (IICMB_IMSK_ALL | IICMB_IMSK_END);
+            return;
+        case offsetof(t_iicm_reg, ICNT):
+            self->uint8Icnt = val;
+            return;
+        case offsetof(t_iicm_reg, ITIM[0]):
+            self->uint16Itim = (uint16_t) ((self->uint16Itim & 0xFF00) | val);
+            return;
+        case offsetof(t_iicm_reg, ITIM[1]):
+            self->uint16Itim = (uint16_t) ((self->uint16Itim & 0x00FF) | (val << 8));
+            return;
+#endif
+#ifdef IICMB_PERF
+        case offsetof(t_iicm_reg, PCR):
+            if ( 0 != (val & IICMB_PCR_CLR) ) {
+                self->uint32PerfCmd = 0;
+                memset(self->uint64PerfNs, 0, sizeof(self->uint64PerfNs));
+            }
+            if ( 0 != (val & IICMB_PCR_SNAP) ) {
+                self->uint32Perf[0] = self->uint32PerfCmd;
+                for ( uint8Iter = 1; uint8Iter < IICMB_PERF_NUM; uint8Iter++ ) {
+                    self->uint32Perf[uint8Iter] = (uint32_t) (self->uint64PerfNs[uint8Iter] * self->uint32ClkKhz / 1000000);
+                }
+            }
+            return;
+#endif
+#ifdef IICMB_BUS_TRACE
+        case offsetof(t_iicm_reg, TCR):
+            self->uint8Tcr = (uint8_t) ((self->uint8Tcr & (IICMB_TCR_TRG | IICMB_TCR_WRAP)) | (val & (IICMB_TCR_EN | IICMB_TCR_FRZ)));
+            if ( 0 == (val & IICMB_TCR_FRZ) ) {
+                self->uint8Tcr &= (uint8_t) ~IICMB_TCR_TRG;  // rearm
+            }
+            if ( 0 != (val & IICMB_TCR_CLR) ) {
+                self->uint8Tcr &= IICMB_TCR_EN;
+                self->uint16Tptr = 0;
+                self->uint64TrcNs = self->uint64TimeNs;
+            }
+            return;
+        case offsetof(t_iicm_reg, TPOST):
+            self->uint8Tpost = val;
+            return;
+        case offsetof(t_iicm_reg, TTRG[0]):
+            self->uint16Ttrg = (uint16_t) ((self->uint16Ttrg & 0xFF00) | val);
+            return;
+        case offsetof(t_iicm_reg, TTRG[1]):
+            self->uint16Ttrg = (uint16_t) ((self->uint16Ttrg & 0x00FF) | (val << 8));
+            return;
+        case offsetof(t_iicm_reg, TSTR):
+            self->uint8Tstr = val;
+            return;
+        case offsetof(t_iicm_reg, TPRE):
+            self->uint8Tpre = val;
+            return;
+        case offsetof(t_iicm_reg, TIDX[0]):
+            self->uint16Tidx = (uint16_t) ((self->uint16Tidx & 0xFF00) | val);
+            return;
+        case offsetof(t_iicm_reg, TIDX[1]):
+            self->uint16Tidx = (uint16_t) ((self->uint16Tidx & 0x00FF) | (val << 8));
+            return;
+#endif
+#ifdef IICMB_TIMING
+        case offsetof(t_iicm_reg, TSEL):
+            self->uint8Tsel = val & (IICMB_TSEL_HS | IICMB_TSEL_BUS);
+            if ( 0 != (val & IICMB_TSEL_DEF) ) {
+                if ( 0 != (self->uint8Tsel & IICMB_TSEL_HS) ) {
+                    self->timingHs = self->timingHsDef;
+                } else if ( self->uint8Tsel < self->uint8BusNum ) {
+                    self->timing[self->uint8Tsel] = self->timingDef[self->uint8Tsel];
+                }
+            }
+            return;
+        case offsetof(t_iicm_reg, HSCR):
+            self->uint8Hscr = val & (IICMB_HSCR_HSE | IICMB_HSCR_MC);
+            return;
+#endif
+        default:
+#ifdef IICMB_TIMING
+            /* only implemented buses or High-speed mode */
+            uint16Tp = iicmb_model_tp(self, offset);
+            if ( (NULL != uint16Tp) && ((0 != (self->uint8Tsel & IICMB_TSEL_HS)) || (self->uint8Tsel < self->uint8BusNum)) ) {
+                if ( 0 == (offset & 1) ) {
+                    *uint16Tp = (uint16_t) ((*uint16Tp & 0xFF00) | val);
+                } else {
+                    *uint16Tp = (uint16_t) ((*uint16Tp & 0x00FF) | (val << 8));
+                }
+            }
+#endif
+            return;
+    }
+}
+
+
+
+/**
+ *  iicmb_reg_rd
+ *    register read of driver, IICMB_REG_HOOK
+ */
+uint8_t iicmb_reg_rd(void *reg, size_t offset)
+{
+    /** Variables **/
+    t_iicmb_model   *self = (t_iicmb_model*) reg;
+
+    /* CPU access */
+    iicmb_model_advance(self, iicmb_model_clk_ns(self, IICMB_MODEL_ACC_CLK));
+    self->uint32RegRd++;
+    return iicmb_model_rd(self, offset);
+}
+
+
+
+/**
+ *  iicmb_reg_wr
+ *    register write of driver, IICMB_REG_HOOK
+ */
+void iicmb_reg_wr(void *reg, size_t offset, uint8_t val)
+{
+    /** Variables **/
+    t_iicmb_model   *self = (t_iicmb_model*) reg;
+
+    /* CPU access */
+    iicmb_model_advance(self, iicmb_model_clk_ns(self, IICMB_MODEL_ACC_CLK));
+    self->uint32RegWr++;
+    iicmb_model_wr(self, offset, val);
+}
+
+
+
+/**
+ *  iicmb_reg_rd32
+ *    32-bit register read of driver, all lanes in one access
+ */
+uint32_t iicmb_reg_rd32(void *reg, size_t offset)
+{
+    /** Variables **/
+    t_iicmb_model   *self = (t_iicmb_model*) reg;
+    uint32_t        uint32Data = 0;
+    uint8_t         uint8Lane;
+
+    /* CPU access */
+    iicmb_model_advance(self, iicmb_model_clk_ns(self, IICMB_MODEL_ACC_CLK));
+    self->uint32RegRd++;
+    /* little-endian, lowest offset in bits 7..0 */
+    for ( uint8Lane = 0; uint8Lane < 4; uint8Lane++ ) {
+        uint32Data |= (uint32_t) iicmb_model_rd(self, offset + uint8Lane) << (8 * uint8Lane);
+    }
+    return uint32Data;
+}
+
+
+
+/**
+ *  iicmb_reg_wr32
+ *    32-bit register write of driver, DPR lane before CMDR lane
+ *    as the 'Data' bypass of regblock.vhd
+ */
+void iicmb_reg_wr32(void *reg, size_t offset, uint32_t val)
+{
+    /** Variables **/
+    t_iicmb_model   *self = (t_iicmb_model*) reg;
+    uint8_t         uint8Lane;
+
+    /* CPU access */
+    iicmb_model_advance(self, iicmb_model_clk_ns(self, IICMB_MODEL_ACC_CLK));
+    self->uint32RegWr++;
+    for ( uint8Lane = 0; uint8Lane < 4; uint8Lane++ ) {
+        iicmb_model_wr(self, offset + uint8Lane, (uint8_t) (val >> (8 * uint8Lane)));
+    }
+}
+
+
+
+/**
+ *  iicmb_trace_time
+ *    trace timestamp of driver, simulated time in ns, IICMB_TRACE_LEN
+ */
+uint32_t iicmb_trace_time(void *reg)
+{
+    return (uint32_t) ((t_iicmb_model*) reg)->uint64TimeNs;
+}
+
+
+
+/**
+ *  iicmb_model_init
+ *    reset model
+ */
+int iicmb_model_init(t_iicmb_model *self, uint8_t busNum, uint32_t clkKhz, uint32_t sclKhz)
+{
+    /** Variables **/
+    uint8_t uint8Bus;   // loop counter
+
+    /* check */
+    if ( (0 == busNum) || (16 < busNum) || (0 == clkKhz) || (0 == sclKhz) ) {
+        return -1;
+    }
+    memset(self, 0, sizeof(t_iicmb_model));
+    self->uint8BusNum = busNum;
+    self->uint8FifoDepth = IICMB_FIFO_DEPTH;
+    self->uint32ClkKhz = clkKhz;
+    for ( uint8Bus = 0; uint8Bus < 16; uint8Bus++ ) {
+        if ( 0 != iicmb_timing_calc(&(self->timingDef[uint8Bus]), clkKhz, sclKhz) ) {
+            return -1;  // SCL not reachable
+        }
+        self->timing[uint8Bus] = self->timingDef[uint8Bus];
+    }
+    (void) iicmb_timing_calc(&(self->timingHsDef), clkKhz, 3400);  // g_f_scl_hs, not reachable with slow clk
+    self->timingHs = self->timingHsDef;
+    self->uint8Imsk = IICMB_IMSK_ALL;
+    iicmb_model_reset(self);
+    return 0;
+}
+
+
+
+/**
+ *  iicmb_model_set_scl
+ *    change SCL of one bus
+ */
+int iicmb_model_set_scl(t_iicmb_model *self, uint8_t bus, uint32_t sclKhz)
+{
+    if ( self->uint8BusNum <= bus ) {
+        return -1;
+    }
+    if ( 0 != iicmb_timing_calc(&(self->timingDef[bus]), self->uint32ClkKhz, sclKhz) ) {
+        return -1;
+    }
+    self->timing[bus] = self->timingDef[bus];
+    return 0;
+}
+
+
+
+/**
+ *  iicmb_model_attach
+ *    connect slave
+ */
+int iicmb_model_attach(t_iicmb_model *self, t_iicmb_model_slave *slave)
+{
+    if ( (IICMB_MODEL_SLAVE_MAX <= self->uint8SlaveNum) || (self->uint8BusNum <= slave->uint8Bus) ) {
+        return -1;
+    }
+    self->slave[self->uint8SlaveNum++] = slave;
+    return 0;
+}
+
+
+
+/**
+ *  iicmb_model_occupy
+ *    other master on bus
+ */
+void iicmb_model_occupy(t_iicmb_model *self, uint8_t bus, uint32_t ns)
+{
+    uint64_t    uint64Free = self->uint64TimeNs + ns + iicmb_model_t_buf_ns(self, bus);
+
+    iicmb_model_perf(self);
+    if ( uint64Free > self->uint64FreeNs[bus] ) {
+        self->uint64FreeNs[bus] = uint64Free;
+    }
+}
+
+
+
+/**
+ *  iicmb_model_run
+ *    execute until driver idle
+ */
+int iicmb_model_run(t_iicmb_model *self, t_iicmb *drv)
+{
+    /** Variables **/
+    uint32_t    uint32Isr = 0;  // ISR calls in this run
+    uint64_t    uint64Ticks;    // ISR entry
+
+    /* serve IRQs */
+    while ( uint32Isr < IICMB_MODEL_ISR_MAX ) {
+        if ( 0 != self->uint8Irq ) {
+            self->uint32Isr++;
+            uint32Isr++;
+            uint64Ticks = iicmb_model_ticks();
+            iicmb_fsm(drv);
+            self->uint64IsrTicks += iicmb_model_ticks() - uint64Ticks;
+            continue;
+        }
+        if ( 0 == self->uint8RspPend ) {
+            /* counted commands wait for timeout */
+            if ( (0 != self->uint8IrqCnt) && (0 != self->uint16Itim) ) {
+                iicmb_model_advance(self, self->uint64IrqNs - self->uint64TimeNs);
+                continue;
+            }
+            break;
+        }
+        iicmb_model_advance(self, self->uint64RspNs - self->uint64TimeNs);
+    }
+    /* bus guard time t_BUF after own stop, otherwise next submit sees occupied bus */
+    if ( self->uint64FreeNs[self->uint8BusId] > self->uint64TimeNs ) {
+        iicmb_model_advance(self, self->uint64FreeNs[self->uint8BusId] - self->uint64TimeNs);
+    }
+    /* driver waits for IRQ which never comes */
+    if ( (IICMB_MODEL_ISR_MAX <= uint32Isr) || (0 != iicmb_busy(drv)) ) {
+        return -1;
+    }
+    return 0;
+}
+
+
+
+/**
+ *  iicmb_model_stat_clr
+ *    clear statistic
+ */
+void iicmb_model_stat_clr(t_iicmb_model *self)
+{
+    self->uint64BusNs = 0;
+    self->uint32RegRd = 0;
+    self->uint32RegWr = 0;
+    self->uint32Irq = 0;
+    self->uint32Isr = 0;
+    self->uint32Bytes = 0;
+    self->uint64IsrTicks = 0;
+}
+
+
+
+/**
+ *  iicmb_model_ticks
+ *    host time stamp
+ */
+uint64_t iicmb_model_ticks(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return (uint64_t) __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000 + (uint64_t) ts.tv_nsec;
+#endif
+}
+
+
+
+/**
+ *  @brief EEPROM callbacks
+ *
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static int iicmb_model_eeprom_start(t_iicmb_model_slave *self, uint8_t rd)
+{
+    if ( 0 == rd ) {
+        self->uint8AdrCnt = 0;  // write transfer starts with memory address
+    }
+    return 0;
+}
+
+static int iicmb_model_eeprom_write(t_iicmb_model_slave *self, uint8_t data)
+{
+    /* memory address */
+    if ( self->uint8AdrCnt < self->uint8AdrBytes ) {
+        if ( 0 == self->uint8AdrCnt ) {
+            self->uint16Ptr = 0;
+        }
+        self->uint16Ptr = (uint16_t) (((self->uint16Ptr << 8) | data) % self->uint16MemSize);
+        self->uint8AdrCnt++;
+        return 0;
+    }
+    /* data, page write wraps in page */
+    self->uint8PtrMem[self->uint16Ptr] = data;
+    self->uint16Ptr = (uint16_t) ((self->uint16Ptr & ~(self->uint16PageSize - 1)) | ((self->uint16Ptr + 1) & (self->uint16PageSize - 1)));
+    return 0;
+}
+
+static uint8_t iicmb_model_eeprom_read(t_iicmb_model_slave *self, uint8_t nak)
+{
+    uint8_t uint8Data = self->uint8PtrMem[self->uint16Ptr];
+
+    (void) nak;
+    self->uint16Ptr = (uint16_t) ((self->uint16Ptr + 1) % self->uint16MemSize);
+    return uint8Data;
+}
+
+static void iicmb_model_eeprom_stop(t_iicmb_model_slave *self)
+{
+    (void) self;    // write cycle not modelled, next access is accepted immediately
+}
+
+
+
+/**
+ *  iicmb_model_eeprom
+ *    EEPROM slave
+ */
+void iicmb_model_eeprom(t_iicmb_model_slave *self, uint8_t bus, uint8_t adr7, uint8_t *mem, uint16_t size, uint8_t adrBytes, uint16_t pageSize)
+{
+    memset(self, 0, sizeof(t_iicmb_model_slave));
+    self->uint8Bus = bus;
+    self->uint8Adr = adr7;
+    self->uint8PtrMem = mem;
+    self->uint16MemSize = size;
+    self->uint8AdrBytes = adrBytes;
+    self->uint16PageSize = pageSize;
+    self->start = iicmb_model_eeprom_start;
+    self->write = iicmb_model_eeprom_write;
+    self->read = iicmb_model_eeprom_read;
+    self->stop = iicmb_model_eeprom_stop;
+}
+
+
+
+/**
+ *  @brief Sensor callbacks
+ *
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static void iicmb_model_sensor_stop(t_iicmb_model_slave *self)
+{
+    /* conversion */
+    self->uint32Sample++;
+    self->uint8PtrMem[0] = (uint8_t) (self->uint32Sample >> 8);
+    self->uint8PtrMem[1] = (uint8_t) (self->uint32Sample);
+}
+
+
+
+/**
+ *  iicmb_model_sensor
+ *    sensor slave
+ */
+void iicmb_model_sensor(t_iicmb_model_slave *self, uint8_t bus, uint8_t adr7, uint8_t *reg, uint16_t num)
+{
+    iicmb_model_eeprom(self, bus, adr7, reg, num, 1, num);  // pointer byte, register file without page
+    self->stop = iicmb_model_sensor_stop;
+}
+
+
+
+/**
+ *  @brief Mux callbacks
+ *
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+static int iicmb_model_mux_start(t_iicmb_model_slave *self, uint8_t rd)
+{
+    (void) self;
+    (void) rd;
+    return 0;
+}
+
+static int iicmb_model_mux_write(t_iicmb_model_slave *self, uint8_t data)
+{
+    self->uint8Ctrl = data;
+    return 0;
+}
+
+static uint8_t iicmb_model_mux_read(t_iicmb_model_slave *self, uint8_t nak)
+{
+    (void) nak;
+    return self->uint8Ctrl;
+}
+
+
+
+/**
+ *  iicmb_model_mux
+ *    mux slave
+ */
+void iicmb_model_mux(t_iicmb_model_slave *self, uint8_t bus, uint8_t adr7)
+{
+    memset(self, 0, sizeof(t_iicmb_model_slave));
+    self->uint8Bus = bus;
+    self->uint8Adr = adr7;
+    self->start = iicmb_model_mux_start;
+    self->write = iicmb_model_mux_write;
+    self->read = iicmb_model_mux_read;
+    self->stop = iicmb_model_eeprom_stop;
+}
@@ -0,0 +1,415 @@
+/*******************************************************************************
+**                                                                             *
+**    Project: IIC Multiple Bus Controller (IICMB)                             *
+**                                                                             *
+**    File:    Host register model of IICMB for driver tests.                  *
+**    Version:                                                                 *
+**             1.0,     October 16, 2026                                       *
+**                                                                             *
+**    Author:  IICMB contributors                                              *
+**                                                                             *
+********************************************************************************
+********************************************************************************
+** Copyright (c) 2016, Sergey Shuvalkin                                        *
+** All rights reserved.                                                        *
+**                                                                             *
+** Redistribution and use in source and binary forms, with or without          *
+** modification, are permitted provided that the following conditions are met: *
+**                                                                             *
+** 1. Redistributions of source code must retain the above copyright notice,   *
+**    this list of conditions and the following disclaimer.                    *
+** 2. Redistributions in binary form must reproduce the above copyright        *
+**    notice, this list of conditions and the following disclaimer in the      *
+**    documentation and/or other materials provided with the distribution.     *
+**                                                                             *
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" *
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE   *
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE  *
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE    *
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR         *
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF        *
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS    *
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN     *
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)     *
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE  *
+** POSSIBILITY OF SUCH DAMAGE.                                                 *
+*******************************************************************************/
+
+
+
+//--------------------------------------------------------------
+// Define Guard
+//--------------------------------------------------------------
+#ifndef __IICMB_MODEL_H
+#define __IICMB_MODEL_H
+
+
+/** Includes **/
+#include <stdint.h>     // defines fixed data types: int8_t...
+#include "iicmb.h"      // driver handle
+
+
+
+/**
+ * @defgroup IICMB_MODEL
+ *
+ * Model configuration
+ *
+ * @{
+ */
+#define IICMB_MODEL_SLAVE_MAX   (16)    /**<  Max. number of attached slave models */
+#define IICMB_MODEL_ACC_CLK     (4)     /**<  Clock cycles per register access of the CPU */
+#define IICMB_MODEL_ISR_MAX     (100000)    /**<  Max. ISR calls in #iicmb_model_run, catches hanging driver */
+#define IICMB_MODEL_TRC_LOG2    (6)     /**<  Bus trace RAM entries as log2, g_trace_depth */
+/** @} */
+
+
+
+/** C++ compatibility **/
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+
+
+/**
+ *  @typedef t_iicmb_model_slave
+ *
+ *  @brief  I2C slave model
+ *
+ *  Slave on one I2C bus, optionally behind a mux channel. The
+ *  callbacks are set by the device constructors
+ *  #iicmb_model_eeprom, #iicmb_model_sensor and #iicmb_model_mux.
+ *
+ *  @since  2026-10-16
+ *  @author IICMB contributors
+ */
+typedef struct t_iicmb_model_slave {
+    uint8_t                         uint8Bus;           /**<  I2C bus of the slave */
+    uint8_t                         uint8Adr;           /**<  7bit slave address */
+    struct t_iicmb_model_slave*     mux;                /**<  upstream mux, NULL if connected to bus */
+    uint8_t                         uint8MuxChan;       /**<  channel of upstream mux */
+    uint32_t                        uint32StretchNs;    /**<  SCL clock stretching per byte */
+    int                             (*start)(struct t_iicmb_model_slave *self, uint8_t rd);    /**<  address match, 0: ACK */
+    int                             (*write)(struct t_iicmb_model_slave *self, uint8_t data);  /**<  data write, 0: ACK */
+    uint8_t                         (*read)(struct t_iicmb_model_slave *self, uint8_t nak);    /**<  data read */
+    void                            (*stop)(struct t_iicmb_model_slave *self);                 /**<  stop condition */
+    uint8_t*                        uint8PtrMem;        /**<  Memory/Register file of the device */
+    uint16_t                        uint16MemSize;      /**<  Size of memory in bytes */
+    uint16_t                        uint16Ptr;          /**<  Address pointer */
+    uint16_t                        uint16PageSize;     /**<  EEPROM: page size, write wraps inside page */
+    uint8_t                         uint8AdrBytes;      /**<  Number of address bytes after slave address */
+    uint8_t                         uint8AdrCnt;        /**<  Received address bytes in current transfer */
+    uint8_t                         uint8Ctrl;          /**<  Mux: channel enable register */
+    uint32_t                        uint32Sample;       /**<  Sensor: conversion counter */
+} t_iicmb_model_slave;
+
+
+
+/**
+ *  @typedef t_iicmb_model
+ *
+ *  @brief  IICMB register model
+ *
+ *  Register level model of regblock/mbyte/mbit. Its address is
+ *  passed as register base to #iicmb_init, the driver accesses it
+ *  via #iicmb_reg_rd/#iicmb_reg_wr or the 32-bit variants
+ *  #iicmb_reg_rd32/#iicmb_reg_wr32 (build with IICMB_REG_HOOK).
+ *  Every register access advances the simulated time by
+ *  #IICMB_MODEL_ACC_CLK clock cycles. #iicmb_trace_time returns
+ *  the simulated time for trace builds (IICMB_TRACE_LEN > 0).
+ *  With IICMB_FIFO_DEPTH > 0 the TX/RX FIFOs of the register
+ *  block and the message command are modelled, the level sensitive
+ *  FIFO interrupts not. The interrupt mask and coalescing registers
+ *  are accessible with IICMB_IRQ_CTRL. The bus trace (IICMB_BUS_TRACE)
+ *  records the byte responses, clock stretching is placed before
+ *  the acknowledge bit.
+ *
+ *  @since  2026-10-16
+ *  @author IICMB contributors
+ */
+typedef struct {
+    /* regblock */
+    uint8_t                 uint8E;             /**<  CSR: enable */
+    uint8_t                 uint8IE;            /**<  CSR: interrupt enable */
+    uint8_t                 uint8TxData;        /**<  DPR: write value */
+    uint8_t                 uint8RxData;        /**<  DPR: read value */
+    uint8_t                 uint8Rsp;           /**<  CMDR: response bits DON/NAK/AL/ERR */
+    uint8_t                 uint8CmdCode;       /**<  CMDR: last accepted command */
+    uint8_t                 uint8Irq;           /**<  IRQ line */
+    uint8_t                 uint8Imsk;          /**<  IMSK: interrupt causes */
+    uint8_t                 uint8Icnt;          /**<  ICNT: commands per interrupt */
+    uint16_t                uint16Itim;         /**<  ITIM: coalescing timeout in clock cycles */
+    uint8_t                 uint8IrqCnt;        /**<  Counted commands without interrupt */
+    uint64_t                uint64IrqNs;        /**<  Simulated time of coalescing timeout */
+    uint32_t                uint32Perf[IICMB_PERF_NUM];     /**<  PCMD..PFBY: counter snapshot in clock cycles */
+    uint32_t                uint32PerfCmd;      /**<  Accepted commands */
+    uint64_t                uint64PerfNs[IICMB_PERF_NUM];   /**<  Latency, stretch, turnaround and foreign busy time, index as uint32Perf, 0 unused */
+    uint64_t                uint64PerfAccNs;    /**<  Simulated time counted in uint64PerfNs */
+    uint8_t                 uint8Tcr;           /**<  TCR: EN, FRZ, TRG and WRAP */
+    uint8_t                 uint8Tpost;         /**<  TPOST: entries after trigger */
+    uint16_t                uint16Ttrg;         /**<  TTRG: trigger events */
+    uint8_t                 uint8Tstr;          /**<  TSTR: stretch threshold in clock cycles */
+    uint8_t                 uint8Tpre;          /**<  TPRE: timestamp prescaler */
+    uint16_t                uint16Tidx;         /**<  TIDX: read index of TDAT */
+    uint16_t                uint16Tptr;         /**<  TPTR: next write index */
+    uint8_t                 uint8TrcPost;       /**<  Entries until freeze */
+    uint32_t                uint32Trc[1 << IICMB_MODEL_TRC_LOG2];   /**<  Bus trace RAM */
+    uint64_t                uint64TrcNs;        /**<  Simulated time of last entry or clear */
+    uint8_t                 uint8TrcCmd;        /**<  Command of next response */
+    uint8_t                 uint8TrcData;       /**<  Parameter of next response */
+    uint8_t                 uint8TrcCap;        /**<  Bus captured on command, Repeated Start */
+    uint64_t                uint64TrcStrNs;     /**<  Clock stretching of next response */
+    /* mbyte */
+    uint8_t                 uint8BusNum;        /**<  Number of implemented buses, g_bus_num */
+    uint8_t                 uint8BusId;         /**<  Selected bus */
+    uint8_t                 uint8State;         /**<  byte FSM state, as FSMR */
+    uint8_t                 uint8StateNext;     /**<  byte FSM state after execution */
+    uint8_t                 uint8RdDir;         /**<  Active transfer is a read */
+    uint8_t                 uint8AdrPhase;      /**<  Next written byte is slave address */
+    t_iicmb_model_slave*    slaveAct;           /**<  Addressed slave */
+    /* pending byte response */
+    uint8_t                 uint8RspPend;       /**<  Command in execution */
+    uint8_t                 uint8RspId;         /**<  Response bits after execution */
+    uint8_t                 uint8RspData;       /**<  Received byte */
+    uint64_t                uint64RspNs;        /**<  Simulated time of response */
+    /* FIFOs, only with IICMB_FIFO_DEPTH > 0 */
+    uint8_t                 uint8FifoDepth;     /**<  FIFO depth, g_fifo_depth */
+    uint8_t                 uint8TxFifo[256];   /**<  TX FIFO */
+    uint8_t                 uint8TxHead;        /**<  TX FIFO read index */
+    uint8_t                 uint8TxLvl;         /**<  TX FIFO level */
+    uint8_t                 uint8RxFifo[256];   /**<  RX FIFO */
+    uint8_t                 uint8RxHead;        /**<  RX FIFO read index */
+    uint8_t                 uint8RxLvl;         /**<  RX FIFO level */
+    uint8_t                 uint8TxThr;         /**<  FTXT: TX threshold */
+    uint8_t                 uint8RxThr;         /**<  FRXT: RX threshold */
+    uint8_t                 uint8Rcnt;          /**<  FRCNT: bytes per read command */
+    uint8_t                 uint8Fie;           /**<  FCR: FIFO interrupt enables */
+    uint8_t                 uint8Param;         /**<  Parameter of active command, TX FIFO or DPR */
+    uint8_t                 uint8Burst;         /**<  Write/Read command moves several bytes */
+    uint8_t                 uint8BurstId;       /**<  Command code of burst */
+    uint8_t                 uint8BurstCnt;      /**<  Pending read bytes of burst */
+    uint8_t                 uint8RdPend;        /**<  Burst read waits for space in RX FIFO */
+    /* message, only with IICMB_FIFO_DEPTH > 0 */
+    uint8_t                 uint8Madr;          /**<  MADR: slave address and direction */
+    uint8_t                 uint8Mlen;          /**<  MLEN: message length */
+    uint8_t                 uint8Mrsw;          /**<  MRSW: write length before repeated start */
+    uint8_t                 uint8Mcnt;          /**<  MCNT: transferred data bytes */
+    uint8_t                 uint8Msg;           /**<  Message command in progress */
+    uint8_t                 uint8MsgState;      /**<  Next step of message */
+    uint8_t                 uint8MsgAdrRd;      /**<  Direction bit of first slave address */
+    uint8_t                 uint8MsgNak;        /**<  Message ends with NAK after stop */
+    uint8_t                 uint8MsgWcnt;       /**<  Pending write bytes */
+    uint8_t                 uint8MsgRcnt;       /**<  Pending read bytes */
+    uint8_t                 uint8MsgPend;       /**<  Message waits for TX data or RX space */
+    /* bus */
+    uint32_t                uint32ClkKhz;       /**<  System clock, g_f_clk */
+    t_iicmb_timing          timingDef[16];      /**<  Synthesis timing per bus, g_f_scl_x */
+    t_iicmb_timing          timing[16];         /**<  TSCL..TVDDAT: timing per bus */
+    t_iicmb_timing          timingHsDef;        /**<  Synthesis High-speed mode timing, g_f_scl_hs */
+    t_iicmb_timing          timingHs;           /**<  TSCL..TVDDAT: High-speed mode timing, TSEL.HS */
+    uint8_t                 uint8Tsel;          /**<  TSEL: bus of timing registers, IICMB_TSEL_HS */
+    uint8_t                 uint8Hscr;          /**<  HSCR: High-speed mode enable and master code */
+    uint8_t                 uint8Hs;            /**<  High-speed mode active until stop */
+    uint64_t                uint64FreeNs[16];   /**<  Bus free after this time, stop or other master */
+    uint8_t                 uint8ArbLost;       /**<  Fault injection: next start loses arbitration */
+    /* slaves */
+    t_iicmb_model_slave*    slave[IICMB_MODEL_SLAVE_MAX];   /**<  attached slaves */
+    uint8_t                 uint8SlaveNum;      /**<  Number of attached slaves */
+    /* statistic */
+    uint64_t                uint64TimeNs;       /**<  Simulated time */
+    uint64_t                uint64BusNs;        /**<  Time with bus captured by IICMB */
+    uint32_t                uint32RegRd;        /**<  Register reads */
+    uint32_t                uint32RegWr;        /**<  Register writes */
+    uint32_t                uint32Irq;          /**<  Raised interrupts */
+    uint32_t                uint32Isr;          /**<  ISR calls */
+    uint32_t                uint32Bytes;        /**<  Transferred data bytes, without slave address */
+    uint64_t                uint64IsrTicks;     /**<  Host ticks spent in #iicmb_fsm, see #iicmb_model_ticks */
+} t_iicmb_model;
+
+
+
+/**
+ *  @brief init
+ *
+ *  reset model, all buses run with same SCL frequency
+ *
+ *  @param[in,out]  self                model handle
+ *  @param[in]      busNum              implemented buses 1..16
+ *  @param[in]      clkKhz              system clock in kHz
+ *  @param[in]      sclKhz              SCL clock in kHz
+ *  @return         int                 state
+ *  @retval         0                   OK
+ *  @retval         -1                  FAIL
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+int iicmb_model_init(t_iicmb_model *self, uint8_t busNum, uint32_t clkKhz, uint32_t sclKhz);
+
+
+
+/**
+ *  @brief set SCL
+ *
+ *  change SCL frequency of one bus, as synthesized with other
+ *  g_f_scl_x, also reloads the timing registers of the bus
+ *
+ *  @param[in,out]  self                model handle
+ *  @param[in]      bus                 I2C bus
+ *  @param[in]      sclKhz              SCL clock in kHz
+ *  @return         int                 state
+ *  @retval         0                   OK
+ *  @retval         -1                  FAIL
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+int iicmb_model_set_scl(t_iicmb_model *self, uint8_t bus, uint32_t sclKhz);
+
+
+
+/**
+ *  @brief attach slave
+ *
+ *  connects slave model to the bus, slave needs to stay valid
+ *
+ *  @param[in,out]  self                model handle
+ *  @param[in,out]  slave               slave model
+ *  @return         int                 state
+ *  @retval         0                   OK
+ *  @retval         -1                  FAIL
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+int iicmb_model_attach(t_iicmb_model *self, t_iicmb_model_slave *slave);
+
+
+
+/**
+ *  @brief occupy bus
+ *
+ *  another master uses the bus for the given time
+ *
+ *  @param[in,out]  self                model handle
+ *  @param[in]      bus                 I2C bus
+ *  @param[in]      ns                  occupation time from now
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+void iicmb_model_occupy(t_iicmb_model *self, uint8_t bus, uint32_t ns);
+
+
+
+/**
+ *  @brief run
+ *
+ *  executes the pending IICMB commands and calls the ISR
+ *  #iicmb_fsm for every raised interrupt until IICMB and
+ *  driver are idle. Returns after the bus free time t_BUF
+ *  of the selected bus, the IICMB reports the bus busy
+ *  until then.
+ *
+ *  @param[in,out]  self                model handle
+ *  @param[in,out]  drv                 driver handle
+ *  @return         int                 state
+ *  @retval         0                   OK
+ *  @retval         -1                  FAIL: driver waits on IRQ which never comes or ISR loop
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+int iicmb_model_run(t_iicmb_model *self, t_iicmb *drv);
+
+
+
+/**
+ *  @brief host ticks
+ *
+ *  time stamp counter on x86, otherwise monotonic clock in ns
+ *
+ *  @return         uint64_t            ticks
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+uint64_t iicmb_model_ticks(void);
+
+
+
+/**
+ *  @brief clear statistic
+ *
+ *  resets access, interrupt, byte, tick and bus time counters
+ *
+ *  @param[in,out]  self                model handle
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+void iicmb_model_stat_clr(t_iicmb_model *self);
+
+
+
+/**
+ *  @brief EEPROM
+ *
+ *  24Cxx like EEPROM: address bytes set the pointer, page write
+ *  wraps inside the page, sequential read wraps at memory end
+ *
+ *  @param[in,out]  self                slave model
+ *  @param[in]      bus                 I2C bus
+ *  @param[in]      adr7                7bit slave address
+ *  @param[in,out]  mem                 memory content
+ *  @param[in]      size                memory size in bytes
+ *  @param[in]      adrBytes            number of address bytes 1..2
+ *  @param[in]      pageSize            page size in bytes, power of two
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+void iicmb_model_eeprom(t_iicmb_model_slave *self, uint8_t bus, uint8_t adr7, uint8_t *mem, uint16_t size, uint8_t adrBytes, uint16_t pageSize);
+
+
+
+/**
+ *  @brief Sensor
+ *
+ *  register file with pointer byte and auto increment, every stop
+ *  condition starts a conversion, register 0..1 hold the
+ *  conversion counter (MSB first)
+ *
+ *  @param[in,out]  self                slave model
+ *  @param[in]      bus                 I2C bus
+ *  @param[in]      adr7                7bit slave address
+ *  @param[in,out]  reg                 register file, at least two bytes
+ *  @param[in]      num                 number of registers
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+void iicmb_model_sensor(t_iicmb_model_slave *self, uint8_t bus, uint8_t adr7, uint8_t *reg, uint16_t num);
+
+
+
+/**
+ *  @brief Mux
+ *
+ *  PCA9548 like mux: one control register, bit n enables channel n.
+ *  Downstream slaves point with @ref t_iicmb_model_slave::mux to the mux.
+ *
+ *  @param[in,out]  self                slave model
+ *  @param[in]      bus                 I2C bus
+ *  @param[in]      adr7                7bit slave address
+ *  @return         void
+ *  @since          2026-10-16
+ *  @author         IICMB contributors
+ */
+void iicmb_model_mux(t_iicmb_model_slave *self, uint8_t bus, uint8_t adr7);
+
+
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+
+#endif // __IICMB_MODEL_H
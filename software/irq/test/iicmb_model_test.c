@@ -0,0 +1,755 @@
+/*******************************************************************************
+**                                                                             *
+**    Project: IIC Multiple Bus Controller (IICMB)                             *
+**                                                                             *
+**    File:    IRQ driver against host register model of IICMB             *
+**    Version:                                                                 *
+**             1.0,     October 16, 2026                                       *
+**                                                                             *
+**    Author:  IICMB contributors                                              *
+**                                                                             *
+********************************************************************************
+********************************************************************************
+** Copyright (c) 2023, Sergey Shuvalkin                                        *
+** All rights reserved.                                                        *
+**                                                                             *
+** Redistribution and use in source and binary forms, with or without          *
+** modification, are permitted provided that the following conditions are met: *
+**                                                                             *
+** 1. Redistributions of source code must retain the above copyright notice,   *
+**    this list of conditions and the following disclaimer.                    *
+** 2. Redistributions in binary form must reproduce the above copyright        *
+**    notice, this list of conditions and the following disclaimer in the      *
+**    documentation and/or other materials provided with the distribution.     *
+**                                                                             *
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" *
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE   *
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE  *
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE    *
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR         *
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF        *
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS    *
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN     *
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)     *
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE  *
+** POSSIBILITY OF SUCH DAMAGE.                                                 *
+*******************************************************************************/
+
+
+
+/** Standard libs **/
+#include <stdio.h>          // f.e. printf
+#include <stdlib.h>         // defines four variables, several macros,
+                            // and various functions for performing
+                            // general functions
+#include <stdint.h>         // defines fiexd data types, like int8_t...
+#include <string.h>         // string handling functions
+
+/** User Libs **/
+#include "iicmb.h"			// driver
+#include "iicmb_model.h"	// register model
+
+
+
+/**
+ *  prints model statistic
+ */
+void print_stat ( const char* name, t_iicmb_model* model )
+{
+	printf (	"INFO:%s: %u ISR, %u IRQ, %u reg rd, %u reg wr, %u byte, %llu ns bus, %llu ns sim time\n",
+				name,
+				model->uint32Isr,
+				model->uint32Irq,
+				model->uint32RegRd,
+				model->uint32RegWr,
+				model->uint32Bytes,
+				(unsigned long long) model->uint64BusNs,
+				(unsigned long long) model->uint64TimeNs
+			);
+}
+
+
+
+/**
+ *  write protected EEPROM, NCK on data bytes
+ */
+static int eeprom_wp_write ( t_iicmb_model_slave* self, uint8_t data )
+{
+	if ( self->uint8AdrCnt < self->uint8AdrBytes ) {
+		self->uint16Ptr = data;
+		self->uint8AdrCnt++;
+		return 0;
+	}
+	return 1;
+}
+
+
+
+/**
+ *  completion callback context
+ */
+typedef struct {
+	uint32_t	uint32Calls;	// number of callbacks
+	t_iicmb_ero	error;			// result of last transfer
+	uint16_t	uint16RdLen;	// read bytes of last transfer
+	t_iicmb_seg	*chainWr;		// follow-up transfer, write segment
+	t_iicmb_seg	*chainRd;		// follow-up transfer, read segment
+} t_cb_ctx;
+
+
+
+/**
+ *  completion callback, chains follow-up transfer
+ */
+static void xfer_done ( t_iicmb* self, void* ctx, t_iicmb_ero error, uint16_t wrLen, uint16_t rdLen )
+{
+	t_cb_ctx	*cbCtx = (t_cb_ctx*) ctx;
+
+	(void) wrLen;
+	cbCtx->uint32Calls++;
+	cbCtx->error = error;
+	cbCtx->uint16RdLen = rdLen;
+	if ( (IICMB_E_NO == error) && (NULL != cbCtx->chainWr) ) {
+		(void) iicmb_bus_xfer_cb(self, 0, 0x50, cbCtx->chainWr, 1, cbCtx->chainRd, 1, xfer_done, ctx);
+		cbCtx->chainWr = NULL;
+	}
+}
+
+
+
+/**
+ *  Main
+ *  ----
+ */
+int main ()
+{
+    /** Variables **/
+	t_iicmb_model		model;							// IICMB register model
+	t_iicmb				iicm;							// handle for IICMB driver
+	t_iicmb_model_slave	eeprom;							// EEPROM on bus 0
+	t_iicmb_model_slave	sensor;							// Sensor on bus 1
+	t_iicmb_model_slave	mux;							// Mux on bus 2
+	t_iicmb_model_slave	eepromMux;						// EEPROM behind mux channel 3
+	uint8_t				uint8Eeprom[256];				// EEPROM memory
+	uint8_t				uint8EepromMux[4096];			// EEPROM memory
+	uint8_t				uint8Sensor[8];					// Sensor register file
+	uint8_t				uint8Buf[8];					// I2C payload
+	uint8_t				uint8Buf2[8];					// I2C payload
+	uint8_t				uint8Buf3[8];					// I2C payload
+	uint8_t				uint8Buf4[48];					// I2C payload, more than FIFO depth
+	uint8_t				uint8MuxCtrl;					// mux channel
+	t_iicmb_seg			segWr[2];						// write segments
+	t_iicmb_seg			segRd[3];						// read segments
+	t_cb_ctx			cbCtx;							// callback context
+	t_cb_ctx			cbCtx2;							// callback context
+#if IICMB_TRACE_LEN > 0
+	FILE				*fh;							// trace dump
+#endif
+#ifdef IICMB_TIMING
+	t_iicmb_timing		timingFast;						// 400kHz timing
+	uint64_t			uint64BusNs;					// bus time with synthesis timing
+#endif
+#ifdef IICMB_STATS
+	t_iicmb_stats		stats;							// bus statistics
+	uint32_t			uint32Lat;						// transfers in latency histogram
+#endif
+#ifdef IICMB_BUS_TRACE
+	uint32_t			uint32Btr[1 << IICMB_MODEL_TRC_LOG2];	// bus trace entries
+	uint16_t			uint16BtrLen;					// read bus trace entries
+	uint8_t				uint8BtrSeen;					// recorded events
+	FILE				*fhBtr;							// bus trace dump
+#endif
+	uint32_t			uint32Iter;						// loop counter
+	
+	
+	
+	/* entry message */
+	printf("INFO:%s: model test started\n", __FUNCTION__);
+	
+	/* build system */
+	memset(uint8Eeprom, 0xff, sizeof(uint8Eeprom));
+	memset(uint8EepromMux, 0xff, sizeof(uint8EepromMux));
+	memset(uint8Sensor, 0, sizeof(uint8Sensor));
+	if ( 0 != iicmb_model_init(&model, 4, 100000, 100) ) {
+		printf("ERROR:%s:iicmb_model_init: failed\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	iicmb_model_eeprom(&eeprom, 0, 0x50, uint8Eeprom, sizeof(uint8Eeprom), 1, 16);
+	iicmb_model_sensor(&sensor, 1, 0x48, uint8Sensor, sizeof(uint8Sensor));
+	iicmb_model_mux(&mux, 2, 0x70);
+	iicmb_model_eeprom(&eepromMux, 2, 0x51, uint8EepromMux, sizeof(uint8EepromMux), 2, 32);
+	eepromMux.mux = &mux;
+	eepromMux.uint8MuxChan = 3;
+	if ( (0 != iicmb_model_attach(&model, &eeprom)) || (0 != iicmb_model_attach(&model, &sensor)) || (0 != iicmb_model_attach(&model, &mux)) || (0 != iicmb_model_attach(&model, &eepromMux)) ) {
+		printf("ERROR:%s:iicmb_model_attach: failed\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	
+	/* iicm_init */
+	printf("INFO:%s:iicm_init\n", __FUNCTION__);
+	if ( 0 != iicmb_init(&iicm, (void*) &model, 1) ) {
+		printf("ERROR:%s:iicm_init: failed\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	if ( (1 != model.uint8BusId) || (0 != model.uint8Irq) ) {
+		printf("ERROR:%s:iicm_init: bus not selected\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	if ( -1 != iicmb_set_bus(&iicm, 7) ) {
+		printf("ERROR:%s:iicmb_set_bus: not implemented bus accepted\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	if ( 0 != iicmb_set_bus(&iicm, 0) ) {
+		printf("ERROR:%s:iicmb_set_bus: failed\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	if ( 0 != iicmb_model_run(&model, &iicm) ) {
+		printf("ERROR:%s:iicmb_set_bus: driver hangs\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	
+	/* EEPROM write */
+	printf("INFO:%s:eeprom:write\n", __FUNCTION__);
+	iicmb_model_stat_clr(&model);
+	uint8Buf[0] = 0x1e;	// memory address, page wrap after two bytes
+	for ( uint32Iter = 1; uint32Iter < 5; uint32Iter++ ) {
+		uint8Buf[uint32Iter] = (uint8_t) (0xa0 + uint32Iter);
+	}
+	if ( IICMB_EXIT_OK != iicmb_write(&iicm, 0x50, uint8Buf, 5) ) {
+		printf("ERROR:%s:iicmb_write: not accepted\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	if ( (0 != iicmb_model_run(&model, &iicm)) || (0 != iicmb_is_error(&iicm)) ) {
+		printf("ERROR:%s:iicmb_write: failed, error=%i\n", __FUNCTION__, iicm.error);
+		goto ERO_END;
+	}
+	if ( (0xa1 != uint8Eeprom[0x1e]) || (0xa2 != uint8Eeprom[0x1f]) || (0xa3 != uint8Eeprom[0x10]) || (0xa4 != uint8Eeprom[0x11]) ) {
+		printf("ERROR:%s:iicmb_write: EEPROM content mismatch\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	print_stat("eeprom:write", &model);
+	
+	/* EEPROM read back */
+	printf("INFO:%s:eeprom:wr_rd\n", __FUNCTION__);
+	iicmb_model_stat_clr(&model);
+	memset(uint8Buf, 0, sizeof(uint8Buf));
+	uint8Buf[0] = 0x1e;
+	if ( IICMB_EXIT_OK != iicmb_wr_rd(&iicm, 0x50, uint8Buf, 1, 3) ) {
+		printf("ERROR:%s:iicmb_wr_rd: not accepted\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	if ( (0 != iicmb_model_run(&model, &iicm)) || (0 != iicmb_is_error(&iicm)) ) {
+		printf("ERROR:%s:iicmb_wr_rd: failed, error=%i\n", __FUNCTION__, iicm.error);
+		goto ERO_END;
+	}
+	if ( (0xa1 != uint8Buf[0]) || (0xa2 != uint8Buf[1]) || (0xff != uint8Buf[2]) ) {
+		printf("ERROR:%s:iicmb_wr_rd: read data mismatch 0x%02x 0x%02x 0x%02x\n", __FUNCTION__, uint8Buf[0], uint8Buf[1], uint8Buf[2]);
+		goto ERO_END;
+	}
+	print_stat("eeprom:wr_rd", &model);
+	
+	/* Missing slave */
+	printf("INFO:%s:noslave\n", __FUNCTION__);
+	if ( (IICMB_EXIT_OK != iicmb_write(&iicm, 0x33, uint8Buf, 2)) || (0 != iicmb_model_run(&model, &iicm)) || (IICMB_E_NOSLAVE != iicm.error) ) {
+		printf("ERROR:%s:iicmb_write: missing slave not detected\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	
+	/* Sensor, conversion with every stop */
+	printf("INFO:%s:sensor\n", __FUNCTION__);
+	for ( uint32Iter = 0; uint32Iter < 3; uint32Iter++ ) {
+		uint8Buf[0] = 0x00;	// register pointer
+		if ( (IICMB_EXIT_OK != iicmb_bus_wr_rd(&iicm, 1, 0x48, uint8Buf, 1, 2)) || (0 != iicmb_model_run(&model, &iicm)) || (0 != iicmb_is_error(&iicm)) ) {
+			printf("ERROR:%s:iicmb_bus_wr_rd: failed\n", __FUNCTION__);
+			goto ERO_END;
+		}
+		if ( (0 != uint8Buf[0]) || (2*uint32Iter != uint8Buf[1]) ) {
+			printf("ERROR:%s:iicmb_bus_wr_rd: wrong sample %u\n", __FUNCTION__, uint8Buf[1]);
+			goto ERO_END;
+		}
+		if ( (IICMB_EXIT_OK != iicmb_bus_write(&iicm, 1, 0x48, uint8Buf, 1)) || (0 != iicmb_model_run(&model, &iicm)) ) {
+			printf("ERROR:%s:iicmb_bus_write: failed\n", __FUNCTION__);
+			goto ERO_END;
+		}
+	}
+	
+	/* Mux, queued on one bus, served in order */
+	printf("INFO:%s:mux\n", __FUNCTION__);
+	uint8Buf[0] = 0x01;	// memory address
+	uint8Buf[1] = 0x23;
+	uint8Buf[2] = 0x5a;
+	if ( (IICMB_EXIT_OK != iicmb_bus_write(&iicm, 2, 0x51, uint8Buf, 3)) || (0 != iicmb_model_run(&model, &iicm)) || (IICMB_E_NOSLAVE != iicm.error) ) {
+		printf("ERROR:%s:mux: disabled channel visible\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	uint8MuxCtrl = (1 << 3);
+	if ( (IICMB_EXIT_OK != iicmb_bus_write(&iicm, 2, 0x70, &uint8MuxCtrl, 1)) || (IICMB_EXIT_OK != iicmb_bus_write(&iicm, 2, 0x51, uint8Buf, 3)) ) {
+		printf("ERROR:%s:mux: not accepted\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	if ( (0 != iicmb_model_run(&model, &iicm)) || (0 != iicmb_is_error(&iicm)) || (0x5a != uint8EepromMux[0x123]) ) {
+		printf("ERROR:%s:mux: write behind mux failed, error=%i\n", __FUNCTION__, iicm.error);
+		goto ERO_END;
+	}
+	
+	/* Multi bus, round-robin */
+	printf("INFO:%s:round-robin\n", __FUNCTION__);
+	iicmb_model_stat_clr(&model);
+	uint8Buf[0] = 0x40;
+	uint8Buf2[0] = 0x04;
+	uint8Buf3[0] = 0x01;
+	uint8Buf3[1] = 0x23;
+	if ( (IICMB_EXIT_OK != iicmb_bus_wr_rd(&iicm, 0, 0x50, uint8Buf, 1, 4)) || (IICMB_EXIT_OK != iicmb_bus_wr_rd(&iicm, 1, 0x48, uint8Buf2, 1, 4)) || (IICMB_EXIT_OK != iicmb_bus_wr_rd(&iicm, 2, 0x51, uint8Buf3, 2, 1)) ) {
+		printf("ERROR:%s:round-robin: not accepted\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	if ( (0 != iicmb_model_run(&model, &iicm)) || (0 != iicmb_is_error(&iicm)) || (0xff != uint8Buf[0]) || (0x00 != uint8Buf2[3]) || (0x5a != uint8Buf3[0]) ) {
+		printf("ERROR:%s:round-robin: failed, error=%i\n", __FUNCTION__, iicm.error);
+		goto ERO_END;
+	}
+	print_stat("round-robin", &model);
+	
+	/* Other master */
+	printf("INFO:%s:occupied\n", __FUNCTION__);
+	if ( (0 != iicmb_set_bus(&iicm, 0)) || (0 != iicmb_model_run(&model, &iicm)) ) {
+		printf("ERROR:%s:iicmb_set_bus: failed\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	iicmb_model_occupy(&model, 0, 50000);
+	if ( IICMB_EXIT_OCC != iicmb_write(&iicm, 0x50, uint8Buf, 2) ) {
+		printf("ERROR:%s:iicmb_write: occupied bus not detected\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	for ( uint32Iter = 0; (IICMB_EXIT_OK != iicmb_bus_state(&iicm)) && (uint32Iter < 100000); uint32Iter++ );
+	if ( IICMB_EXIT_OK != iicmb_write(&iicm, 0x50, uint8Buf, 2) || (0 != iicmb_model_run(&model, &iicm)) || (0 != iicmb_is_error(&iicm)) ) {
+		printf("ERROR:%s:iicmb_write: bus not released\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	
+	/* Arbitration lost, queue continues */
+	printf("INFO:%s:arbitration lost\n", __FUNCTION__);
+	model.uint8ArbLost = 1;
+	if ( (IICMB_EXIT_OK != iicmb_write(&iicm, 0x50, uint8Buf, 2)) || (IICMB_EXIT_OK != iicmb_write(&iicm, 0x50, uint8Buf, 2)) ) {
+		printf("ERROR:%s:iicmb_write: not accepted\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	if ( (0 != iicmb_model_run(&model, &iicm)) || (IICMB_E_ARBLOST != iicm.error) || (0 != model.uint8State) ) {
+		printf("ERROR:%s:iicmb_write: arbitration lost not handled\n", __FUNCTION__);
+		goto ERO_END;
+	}
+
+	/* Retry, replay after arbitration loss and on occupied bus */
+	printf("INFO:%s:retry\n", __FUNCTION__);
+	if ( IICMB_EXIT_OK != iicmb_set_retry(&iicm, 0, 2, 1) ) {
+		printf("ERROR:%s:iicmb_set_retry: failed\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	model.uint8ArbLost = 1;
+	if ( (IICMB_EXIT_OK != iicmb_write(&iicm, 0x50, uint8Buf, 2)) || (0 != iicmb_model_run(&model, &iicm)) || (0 != iicmb_is_error(&iicm)) ) {
+		printf("ERROR:%s:retry: arbitration lost not replayed, error=%i\n", __FUNCTION__, iicm.error);
+		goto ERO_END;
+	}
+	iicmb_model_occupy(&model, 0, 50000);
+	if ( (IICMB_EXIT_OK != iicmb_write(&iicm, 0x50, uint8Buf, 2)) || (0 != iicmb_model_run(&model, &iicm)) || (0 != iicmb_is_error(&iicm)) ) {
+		printf("ERROR:%s:retry: occupied bus not waited, error=%i\n", __FUNCTION__, iicm.error);
+		goto ERO_END;
+	}
+	iicmb_model_occupy(&model, 0, 10000000);	// longer than 1ms + 2ms backoff
+	if ( (IICMB_EXIT_OK != iicmb_write(&iicm, 0x50, uint8Buf, 2)) || (0 != iicmb_model_run(&model, &iicm)) || (IICMB_E_BUSOCC != iicm.error) ) {
+		printf("ERROR:%s:retry: attempts not limited, error=%i\n", __FUNCTION__, iicm.error);
+		goto ERO_END;
+	}
+	(void) iicmb_set_retry(&iicm, 0, 0, 0);
+
+#ifdef IICMB_TIMING
+	/* Timing, 400kHz on bus with 100kHz synthesis timing and back */
+	printf("INFO:%s:timing\n", __FUNCTION__);
+	if ( (IICMB_EXIT_OK != iicmb_timing_calc(&timingFast, 100000, 400)) || (249 != timingFast.uint16Scl) || (129 != timingFast.uint16Buf) ) {
+		printf("ERROR:%s:iicmb_timing_calc: wrong timing, scl=%u buf=%u\n", __FUNCTION__, timingFast.uint16Scl, timingFast.uint16Buf);
+		goto ERO_END;
+	}
+	if ( (IICMB_EXIT_ERROR != iicmb_set_timing(&iicm, IICMB_BUS_NUM, &timingFast)) || (IICMB_EXIT_ERROR != iicmb_timing_calc(&timingFast, 2000, 1000)) ) {
+		printf("ERROR:%s:timing: invalid arguments accepted\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	(void) iicmb_timing_calc(&timingFast, 100000, 400);
+	iicmb_model_stat_clr(&model);
+	if ( (IICMB_EXIT_OK != iicmb_write(&iicm, 0x50, uint8Buf, 4)) || (0 != iicmb_model_run(&model, &iicm)) || (0 != iicmb_is_error(&iicm)) ) {
+		printf("ERROR:%s:timing: synthesis timing failed, error=%i\n", __FUNCTION__, iicm.error);
+		goto ERO_END;
+	}
+	uint64BusNs = model.uint64BusNs;
+	iicmb_model_stat_clr(&model);
+	if ( (IICMB_EXIT_OK != iicmb_set_timing(&iicm, 0, &timingFast)) || (IICMB_EXIT_OK != iicmb_write(&iicm, 0x50, uint8Buf, 4)) || (0 != iicmb_model_run(&model, &iicm)) || (0 != iicmb_is_error(&iicm)) ) {
+		printf("ERROR:%s:timing: 400kHz failed, error=%i\n", __FUNCTION__, iicm.error);
+		goto ERO_END;
+	}
+	if ( (249 != model.timing[0].uint16Scl) || (model.uint64BusNs * 3 > uint64BusNs) ) {
+		printf("ERROR:%s:timing: not loaded, scl=%u, %lu ns at 100kHz, %lu ns at 400kHz\n", __FUNCTION__, model.timing[0].uint16Scl, (unsigned long) uint64BusNs, (unsigned long) model.uint64BusNs);
+		goto ERO_END;
+	}
+	printf("INFO:%s:timing: %lu ns at 100kHz, %lu ns at 400kHz\n", __FUNCTION__, (unsigned long) uint64BusNs, (unsigned long) model.uint64BusNs);
+	if ( (IICMB_EXIT_OK != iicmb_set_timing(&iicm, 0, NULL)) || (IICMB_EXIT_OK != iicmb_write(&iicm, 0x50, uint8Buf, 4)) || (0 != iicmb_model_run(&model, &iicm)) || (999 != model.timing[0].uint16Scl) ) {
+		printf("ERROR:%s:timing: synthesis timing not restored, scl=%u\n", __FUNCTION__, model.timing[0].uint16Scl);
+		goto ERO_END;
+	}
+	/* Fast-mode Plus and High-speed mode, master code 001 */
+	printf("INFO:%s:timing:hs\n", __FUNCTION__);
+	if ( (IICMB_EXIT_OK != iicmb_timing_calc(&timingFast, 100000, 1000)) || (99 != timingFast.uint16Scl) || (19 != timingFast.uint16VdDat) ) {
+		printf("ERROR:%s:iicmb_timing_calc: wrong Fm+ timing, scl=%u vd=%u\n", __FUNCTION__, timingFast.uint16Scl, timingFast.uint16VdDat);
+		goto ERO_END;
+	}
+	if ( (IICMB_EXIT_OK != iicmb_timing_calc(&timingFast, 100000, 3400)) || (29 != timingFast.uint16Scl) || (16 != timingFast.uint16HdSta) ) {
+		printf("ERROR:%s:iicmb_timing_calc: wrong Hs timing, scl=%u hd_sta=%u\n", __FUNCTION__, timingFast.uint16Scl, timingFast.uint16HdSta);
+		goto ERO_END;
+	}
+	if ( IICMB_EXIT_ERROR != iicmb_set_hs(&iicm, 0, 8, NULL) ) {
+		printf("ERROR:%s:iicmb_set_hs: invalid master code accepted\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	iicmb_model_stat_clr(&model);
+	if ( (IICMB_EXIT_OK != iicmb_set_hs(&iicm, 0, 1, &timingFast)) || (IICMB_EXIT_OK != iicmb_write(&iicm, 0x50, uint8Buf, 4)) || (0 != iicmb_model_run(&model, &iicm)) || (0 != iicmb_is_error(&iicm)) ) {
+		printf("ERROR:%s:timing:hs: failed, error=%i\n", __FUNCTION__, iicm.error);
+		goto ERO_END;
+	}
+	if ( ((IICMB_HSCR_HSE | 1) != model.uint8Hscr) || (0 != model.uint8Hs) || (29 != model.timingHs.uint16Scl) || (model.uint64BusNs * 3 > uint64BusNs) ) {
+		printf("ERROR:%s:timing:hs: hscr=0x%02x, hs=%u, %lu ns\n", __FUNCTION__, model.uint8Hscr, model.uint8Hs, (unsigned long) model.uint64BusNs);
+		goto ERO_END;
+	}
+	printf("INFO:%s:timing:hs: %lu ns with master code at 100kHz\n", __FUNCTION__, (unsigned long) model.uint64BusNs);
+	if ( (IICMB_EXIT_OK != iicmb_set_hs(&iicm, 0, IICMB_HS_OFF, NULL)) || (IICMB_EXIT_OK != iicmb_write(&iicm, 0x50, uint8Buf, 4)) || (0 != iicmb_model_run(&model, &iicm)) || (0 != model.uint8Hscr) ) {
+		printf("ERROR:%s:timing:hs: not disabled, hscr=0x%02x\n", __FUNCTION__, model.uint8Hscr);
+		goto ERO_END;
+	}
+#endif
+
+	/* Long transfers, FIFO chunks */
+	printf("INFO:%s:burst\n", __FUNCTION__);
+	iicmb_model_stat_clr(&model);
+	uint8Buf4[0] = 0x20;	// memory address, one page
+	for ( uint32Iter = 1; uint32Iter < 17; uint32Iter++ ) {
+		uint8Buf4[uint32Iter] = (uint8_t) (0x30 + uint32Iter);
+	}
+	if ( (IICMB_EXIT_OK != iicmb_write(&iicm, 0x50, uint8Buf4, 17)) || (0 != iicmb_model_run(&model, &iicm)) || (0 != iicmb_is_error(&iicm)) ) {
+		printf("ERROR:%s:burst: write failed, error=%i\n", __FUNCTION__, iicm.error);
+		goto ERO_END;
+	}
+	memset(uint8Buf4, 0, sizeof(uint8Buf4));
+	uint8Buf4[0] = 0x10;
+	if ( (IICMB_EXIT_OK != iicmb_wr_rd(&iicm, 0x50, uint8Buf4, 1, 40)) || (0 != iicmb_model_run(&model, &iicm)) || (0 != iicmb_is_error(&iicm)) ) {
+		printf("ERROR:%s:burst: read failed, error=%i\n", __FUNCTION__, iicm.error);
+		goto ERO_END;
+	}
+	for ( uint32Iter = 1; uint32Iter < 17; uint32Iter++ ) {
+		if ( (uint8_t) (0x30 + uint32Iter) != uint8Buf4[0x0f + uint32Iter] ) {
+			printf("ERROR:%s:burst: data mismatch at %u\n", __FUNCTION__, uint32Iter);
+			goto ERO_END;
+		}
+	}
+	if ( (0 != IICMB_FIFO_DEPTH) && (model.uint32Isr >= model.uint32Bytes) ) {
+		printf("ERROR:%s:burst: FIFO not used\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	print_stat("burst", &model);
+
+	/* NCK on data byte, FIFO dropped */
+	printf("INFO:%s:data nck\n", __FUNCTION__);
+	eeprom.write = eeprom_wp_write;
+	uint8Buf[0] = 0x00;
+	if ( (IICMB_EXIT_OK != iicmb_write(&iicm, 0x50, uint8Buf, 5)) || (0 != iicmb_model_run(&model, &iicm)) || (IICMB_E_ICTF != iicm.error) || (2 != iicm.uint16WrByteIs) ) {
+		printf("ERROR:%s:iicmb_write: data NCK not detected, error=%i\n", __FUNCTION__, iicm.error);
+		goto ERO_END;
+	}
+	iicmb_model_eeprom(&eeprom, 0, 0x50, uint8Eeprom, sizeof(uint8Eeprom), 1, 16);
+	uint8Buf[0] = 0x1e;
+	if ( (0 != model.uint8TxLvl) || (IICMB_EXIT_OK != iicmb_wr_rd(&iicm, 0x50, uint8Buf, 1, 2)) || (0 != iicmb_model_run(&model, &iicm)) || (0 != iicmb_is_error(&iicm)) || (0xa1 != uint8Buf[0]) ) {
+		printf("ERROR:%s:iicmb_wr_rd: failed after data NCK, error=%i\n", __FUNCTION__, iicm.error);
+		goto ERO_END;
+	}
+
+	/* Message, complete transfer with one IRQ */
+	printf("INFO:%s:message\n", __FUNCTION__);
+	iicmb_model_stat_clr(&model);
+	memset(uint8Buf, 0, sizeof(uint8Buf));
+	uint8Buf[0] = 0x20;
+	if ( (IICMB_EXIT_OK != iicmb_wr_rd(&iicm, 0x50, uint8Buf, 1, 8)) || (0 != iicmb_model_run(&model, &iicm)) || (0 != iicmb_is_error(&iicm)) ) {
+		printf("ERROR:%s:message: wr_rd failed, error=%i\n", __FUNCTION__, iicm.error);
+		goto ERO_END;
+	}
+	for ( uint32Iter = 0; uint32Iter < 8; uint32Iter++ ) {
+		if ( (uint8_t) (0x31 + uint32Iter) != uint8Buf[uint32Iter] ) {
+			printf("ERROR:%s:message: data mismatch at %u\n", __FUNCTION__, uint32Iter);
+			goto ERO_END;
+		}
+	}
+	if ( (0 != IICMB_FIFO_DEPTH) && ((1 != model.uint32Isr) || (9 != model.uint32Bytes)) ) {
+		printf("ERROR:%s:message: %u ISR calls, message command not used\n", __FUNCTION__, model.uint32Isr);
+		goto ERO_END;
+	}
+	print_stat("message", &model);
+
+#ifdef IICMB_IRQ_CTRL
+	/* Interrupt only on errors and end of transaction, message completion with timeout */
+	printf("INFO:%s:irq\n", __FUNCTION__);
+	if ( (IICMB_EXIT_ERROR != iicmb_set_irq(&iicm, 0x40, 0, 0)) || (IICMB_EXIT_ERROR != iicmb_set_irq(&iicm, IICMB_IMSK_EOT, 4, 0)) ) {
+		printf("ERROR:%s:iicmb_set_irq: invalid arguments accepted\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	iicmb_model_stat_clr(&model);
+	memset(uint8Buf, 0, sizeof(uint8Buf));
+	uint8Buf[0] = 0x20;
+	if ( (IICMB_EXIT_OK != iicmb_set_irq(&iicm, IICMB_IMSK_EOT, 4, 1000)) || (IICMB_EXIT_OK != iicmb_wr_rd(&iicm, 0x50, uint8Buf, 1, 8)) || (0 != iicmb_model_run(&model, &iicm)) || (0 != iicmb_is_error(&iicm)) ) {
+		printf("ERROR:%s:irq: message failed, error=%i\n", __FUNCTION__, iicm.error);
+		goto ERO_END;
+	}
+	if ( (IICMB_IMSK_EOT != model.uint8Imsk) || (4 != model.uint8Icnt) || (1000 != model.uint16Itim) || (1 != model.uint32Isr) || (0x31 != uint8Buf[0]) || (0x38 != uint8Buf[7]) ) {
+		printf("ERROR:%s:irq: imsk=0x%02x, %u ISR calls\n", __FUNCTION__, model.uint8Imsk, model.uint32Isr);
+		goto ERO_END;
+	}
+	/* longer than FIFO, byte commands need every completion */
+	memset(uint8Buf4, 0, sizeof(uint8Buf4));
+	uint8Buf4[0] = 0x10;
+	if ( (IICMB_EXIT_OK != iicmb_wr_rd(&iicm, 0x50, uint8Buf4, 1, 40)) || (0 != iicmb_model_run(&model, &iicm)) || (0 != iicmb_is_error(&iicm)) || (0x31 != uint8Buf4[0x10]) ) {
+		printf("ERROR:%s:irq: burst failed, error=%i\n", __FUNCTION__, iicm.error);
+		goto ERO_END;
+	}
+	if ( ((IICMB_IMSK_EOT | IICMB_IMSK_DON) != model.uint8Imsk) || (0 != model.uint8Icnt) || (0 != model.uint16Itim) ) {
+		printf("ERROR:%s:irq: byte commands coalesced, imsk=0x%02x\n", __FUNCTION__, model.uint8Imsk);
+		goto ERO_END;
+	}
+	/* NCK without timeout */
+	if ( (IICMB_EXIT_OK != iicmb_write(&iicm, 0x10, uint8Buf, 2)) || (0 != iicmb_model_run(&model, &iicm)) || (IICMB_E_NOSLAVE != iicm.error) || (0 != model.uint8IrqCnt) ) {
+		printf("ERROR:%s:irq: slave NCK not detected, error=%i\n", __FUNCTION__, iicm.error);
+		goto ERO_END;
+	}
+	if ( (IICMB_EXIT_OK != iicmb_set_irq(&iicm, IICMB_IMSK_ALL, 0, 0)) || (IICMB_EXIT_OK != iicmb_write(&iicm, 0x50, uint8Buf, 2)) || (0 != iicmb_model_run(&model, &iicm)) || (0 != iicmb_is_error(&iicm)) || ((IICMB_IMSK_ALL | IICMB_IMSK_END) != model.uint8Imsk) ) {
+		printf("ERROR:%s:irq: not restored, imsk=0x%02x\n", __FUNCTION__, model.uint8Imsk);
+		goto ERO_END;
+	}
+	print_stat("irq", &model);
+#endif
+
+	/* Segments, register address and payload in separate buffers */
+	printf("INFO:%s:segments\n", __FUNCTION__);
+	uint8Buf[0] = 0x40;	// memory address
+	for ( uint32Iter = 0; uint32Iter < 4; uint32Iter++ ) {
+		uint8Buf2[uint32Iter] = (uint8_t) (0xc0 + uint32Iter);
+	}
+	segWr[0].uint8PtrData = uint8Buf;
+	segWr[0].uint16Len = 1;
+	segWr[1].uint8PtrData = uint8Buf2;
+	segWr[1].uint16Len = 4;
+	if ( (IICMB_EXIT_OK != iicmb_xfer(&iicm, 0x50, segWr, 2, NULL, 0)) || (0 != iicmb_model_run(&model, &iicm)) || (0 != iicmb_is_error(&iicm)) ) {
+		printf("ERROR:%s:segments: write failed, error=%i\n", __FUNCTION__, iicm.error);
+		goto ERO_END;
+	}
+	if ( (0xc0 != uint8Eeprom[0x40]) || (0xc3 != uint8Eeprom[0x43]) ) {
+		printf("ERROR:%s:segments: EEPROM content mismatch\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	memset(uint8Buf2, 0, sizeof(uint8Buf2));
+	memset(uint8Buf3, 0, sizeof(uint8Buf3));
+	segRd[0].uint8PtrData = uint8Buf2;
+	segRd[0].uint16Len = 1;
+	segRd[1].uint8PtrData = NULL;	// empty segment is skipped
+	segRd[1].uint16Len = 0;
+	segRd[2].uint8PtrData = uint8Buf3;
+	segRd[2].uint16Len = 3;
+	if ( (IICMB_EXIT_OK != iicmb_xfer(&iicm, 0x50, segWr, 1, segRd, 3)) || (0 != iicmb_model_run(&model, &iicm)) || (0 != iicmb_is_error(&iicm)) ) {
+		printf("ERROR:%s:segments: read failed, error=%i\n", __FUNCTION__, iicm.error);
+		goto ERO_END;
+	}
+	if ( (0x40 != uint8Buf[0]) || (0xc0 != uint8Buf2[0]) || (0xc1 != uint8Buf3[0]) || (0xc3 != uint8Buf3[2]) ) {
+		printf("ERROR:%s:segments: data mismatch\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	segWr[1].uint16Len = UINT16_MAX;
+	if ( IICMB_EXIT_ERROR != iicmb_xfer(&iicm, 0x50, segWr, 2, NULL, 0) ) {
+		printf("ERROR:%s:segments: length overflow not detected\n", __FUNCTION__);
+		goto ERO_END;
+	}
+
+	/* Completion callback, follow-up read chained from callback */
+	printf("INFO:%s:callback\n", __FUNCTION__);
+	memset(&cbCtx, 0, sizeof(cbCtx));
+	memset(uint8Buf3, 0, sizeof(uint8Buf3));
+	for ( uint32Iter = 0; uint32Iter < 4; uint32Iter++ ) {
+		uint8Buf2[uint32Iter] = (uint8_t) (0xc0 + uint32Iter);
+	}
+	segWr[1].uint16Len = 4;
+	segRd[0].uint8PtrData = uint8Buf3;
+	segRd[0].uint16Len = 4;
+	cbCtx.chainWr = &segWr[0];
+	cbCtx.chainRd = &segRd[0];
+	if ( (IICMB_EXIT_OK != iicmb_bus_xfer_cb(&iicm, 0, 0x50, segWr, 2, NULL, 0, xfer_done, &cbCtx)) || (0 != iicmb_model_run(&model, &iicm)) || (0 != iicmb_is_error(&iicm)) ) {
+		printf("ERROR:%s:callback: transfer failed, error=%i\n", __FUNCTION__, iicm.error);
+		goto ERO_END;
+	}
+	if ( (2 != cbCtx.uint32Calls) || (IICMB_E_NO != cbCtx.error) || (4 != cbCtx.uint16RdLen) || (0xc0 != uint8Buf3[0]) || (0xc3 != uint8Buf3[3]) ) {
+		printf("ERROR:%s:callback: %u calls, chained read failed\n", __FUNCTION__, cbCtx.uint32Calls);
+		goto ERO_END;
+	}
+	/* result per transfer, error of queue kept */
+	memset(&cbCtx, 0, sizeof(cbCtx));
+	memset(&cbCtx2, 0, sizeof(cbCtx2));
+	if ( (IICMB_EXIT_OK != iicmb_bus_xfer_cb(&iicm, 0, 0x10, segWr, 2, NULL, 0, xfer_done, &cbCtx)) || (IICMB_EXIT_OK != iicmb_bus_xfer_cb(&iicm, 0, 0x50, segWr, 1, segRd, 1, xfer_done, &cbCtx2)) || (0 != iicmb_model_run(&model, &iicm)) ) {
+		printf("ERROR:%s:callback: queue failed\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	if ( (IICMB_E_NOSLAVE != cbCtx.error) || (IICMB_E_NO != cbCtx2.error) || (1 != cbCtx2.uint32Calls) || (IICMB_E_NOSLAVE != iicm.error) ) {
+		printf("ERROR:%s:callback: wrong result, %i/%i, error=%i\n", __FUNCTION__, cbCtx.error, cbCtx2.error, iicm.error);
+		goto ERO_END;
+	}
+
+#ifdef IICMB_STATS
+	/* Statistics of bus 0, every transfer in one latency bucket */
+	printf("INFO:%s:statistics\n", __FUNCTION__);
+	if ( IICMB_EXIT_OK != iicmb_stats_get(&iicm, 0, &stats) ) {
+		printf("ERROR:%s:statistics: snapshot failed\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	uint32Lat = 0;
+	for ( uint32Iter = 0; uint32Iter < IICMB_STATS_HIST; uint32Iter++ ) {
+		uint32Lat += stats.uint32Lat[uint32Iter];
+	}
+	if ( (0 == stats.uint32Xfer) || (uint32Lat != stats.uint32Xfer) || (0 == stats.uint32NoSlave) || (0 == stats.uint32Ictf) || (0 == stats.uint32WrByte) || (0 == stats.uint32RdByte) || (0 == stats.uint32Retry) ) {
+		printf("ERROR:%s:statistics: %u transfers, %u in histogram, %u noslave, %u ictf\n", __FUNCTION__, stats.uint32Xfer, uint32Lat, stats.uint32NoSlave, stats.uint32Ictf);
+		goto ERO_END;
+	}
+	printf("INFO:%s:statistics: %u transfers, %u noslave, %u ictf, %u byte wr, %u byte rd\n", __FUNCTION__, stats.uint32Xfer, stats.uint32NoSlave, stats.uint32Ictf, stats.uint32WrByte, stats.uint32RdByte);
+	if ( (IICMB_EXIT_OK != iicmb_stats_clr(&iicm, 0)) || (IICMB_EXIT_OK != iicmb_stats_get(&iicm, 0, &stats)) || (0 != stats.uint32Xfer) || (0 != stats.uint32Lat[0]) ) {
+		printf("ERROR:%s:statistics: reset failed\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	for ( uint32Iter = 0; uint32Iter < IICMB_QUEUE_LEN; uint32Iter++ ) {
+		if ( IICMB_EXIT_OK != iicmb_write(&iicm, 0x50, uint8Buf, 2) ) {
+			printf("ERROR:%s:statistics: submit %u failed\n", __FUNCTION__, uint32Iter);
+			goto ERO_END;
+		}
+	}
+	if ( (IICMB_EXIT_BUSY != iicmb_write(&iicm, 0x50, uint8Buf, 2)) || (IICMB_EXIT_OK != iicmb_stats_get(&iicm, 0, &stats)) || (0 != stats.uint32Xfer) || (1 != stats.uint32Full) ) {
+		printf("ERROR:%s:statistics: %u full queue, lost while reset posted\n", __FUNCTION__, stats.uint32Full);
+		goto ERO_END;
+	}
+	if ( (0 != iicmb_model_run(&model, &iicm)) || (IICMB_EXIT_OK != iicmb_stats_get(&iicm, 0, &stats)) || (IICMB_QUEUE_LEN != stats.uint32Xfer) || (0 != stats.uint32NoSlave) || (1 != stats.uint32Full) ) {
+		printf("ERROR:%s:statistics: reset not done by ISR, %u transfers\n", __FUNCTION__, stats.uint32Xfer);
+		goto ERO_END;
+	}
+#ifdef IICMB_PERF
+	/* Hardware counters, stretching slave after other master */
+	printf("INFO:%s:perf\n", __FUNCTION__);
+	eeprom.uint32StretchNs = 5000;
+	iicmb_model_occupy(&model, 0, 50000);
+	for ( uint32Iter = 0; (IICMB_EXIT_OK != iicmb_bus_state(&iicm)) && (uint32Iter < 100000); uint32Iter++ );
+	if ( (IICMB_EXIT_OK != iicmb_write(&iicm, 0x50, uint8Buf, 2)) || (0 != iicmb_model_run(&model, &iicm)) || (0 != iicmb_is_error(&iicm)) ) {
+		printf("ERROR:%s:perf: write failed, error=%i\n", __FUNCTION__, iicm.error);
+		goto ERO_END;
+	}
+	eeprom.uint32StretchNs = 0;
+	if ( IICMB_EXIT_OK != iicmb_stats_get(&iicm, 0, &stats) ) {
+		printf("ERROR:%s:perf: snapshot failed\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	/* 100MHz clock: 3 bytes with 5us stretching, 50us other master */
+	if ( (0 == stats.uint32Cmd) || (0 == stats.uint32CmdClk) || (1500 > stats.uint32StretchClk) || (5000 > stats.uint32ForeignClk) || ((0 == IICMB_FIFO_DEPTH) && (0 == stats.uint32TurnClk)) ) {
+		printf("ERROR:%s:perf: %u cmd, %u clk cmd, %u clk stretch, %u clk turnaround, %u clk foreign\n", __FUNCTION__, stats.uint32Cmd, stats.uint32CmdClk, stats.uint32StretchClk, stats.uint32TurnClk, stats.uint32ForeignClk);
+		goto ERO_END;
+	}
+	printf("INFO:%s:perf: %u cmd, %u clk cmd, %u clk stretch, %u clk turnaround, %u clk foreign\n", __FUNCTION__, stats.uint32Cmd, stats.uint32CmdClk, stats.uint32StretchClk, stats.uint32TurnClk, stats.uint32ForeignClk);
+#endif
+#endif
+
+#ifdef IICMB_BUS_TRACE
+	/* Bus trace, stretching slave then address NCK freezes after stop, dump for host decoder */
+	printf("INFO:%s:bus trace\n", __FUNCTION__);
+	if ( IICMB_EXIT_OK != iicmb_btrace_arm(&iicm, IICMB_BTR_MSK(IICMB_BTR_WNAK), 1, 10, 0) ) {
+		printf("ERROR:%s:bus trace: arm failed\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	eeprom.uint32StretchNs = 5000;
+	if ( (IICMB_EXIT_OK != iicmb_write(&iicm, 0x50, uint8Buf, 2)) || (0 != iicmb_model_run(&model, &iicm)) || (0 != iicmb_is_error(&iicm)) ) {
+		printf("ERROR:%s:bus trace: write failed, error=%i\n", __FUNCTION__, iicm.error);
+		goto ERO_END;
+	}
+	eeprom.uint32StretchNs = 0;
+	if ( (IICMB_EXIT_OK != iicmb_write(&iicm, 0x10, uint8Buf, 2)) || (0 != iicmb_model_run(&model, &iicm)) || (IICMB_E_NOSLAVE != iicm.error) ) {
+		printf("ERROR:%s:bus trace: slave NCK not detected, error=%i\n", __FUNCTION__, iicm.error);
+		goto ERO_END;
+	}
+	/* not recorded, frozen */
+	if ( (IICMB_EXIT_OK != iicmb_write(&iicm, 0x50, uint8Buf, 2)) || (0 != iicmb_model_run(&model, &iicm)) || (0 != iicmb_is_error(&iicm)) ) {
+		printf("ERROR:%s:bus trace: write after trigger failed, error=%i\n", __FUNCTION__, iicm.error);
+		goto ERO_END;
+	}
+	if ( (IICMB_EXIT_OK != iicmb_btrace_read(&iicm, uint32Btr, (uint16_t) (sizeof(uint32Btr) / sizeof(uint32Btr[0])), &uint16BtrLen)) || (2 > uint16BtrLen) || (0 == (model.uint8Tcr & IICMB_TCR_TRG)) ) {
+		printf("ERROR:%s:bus trace: read failed, %u entries\n", __FUNCTION__, uint16BtrLen);
+		goto ERO_END;
+	}
+	if ( (IICMB_BTR_STOP != IICMB_BTR_EVT(uint32Btr[uint16BtrLen - 1])) || (IICMB_BTR_WNAK != IICMB_BTR_EVT(uint32Btr[uint16BtrLen - 2])) || (0x20 != IICMB_BTR_ARG(uint32Btr[uint16BtrLen - 2])) ) {
+		printf("ERROR:%s:bus trace: trigger not last, 0x%08x 0x%08x\n", __FUNCTION__, uint32Btr[uint16BtrLen - 2], uint32Btr[uint16BtrLen - 1]);
+		goto ERO_END;
+	}
+	uint8BtrSeen = 0;
+	for ( uint32Iter = 0; uint32Iter < uint16BtrLen; uint32Iter++ ) {
+		switch (IICMB_BTR_EVT(uint32Btr[uint32Iter])) {
+			case IICMB_BTR_START:
+				uint8BtrSeen |= 1;
+				break;
+			case IICMB_BTR_WACK:
+				uint8BtrSeen |= 2;
+				break;
+			case IICMB_BTR_STRB:
+				uint8BtrSeen |= 4;
+				break;
+			case IICMB_BTR_STRE:
+				if ( 0 != IICMB_BTR_TIM(uint32Btr[uint32Iter]) ) {
+					uint8BtrSeen |= 8;	// stretch duration
+				}
+				break;
+			default:
+				break;
+		}
+	}
+	if ( 0x0F != uint8BtrSeen ) {
+		printf("ERROR:%s:bus trace: events missing, seen=0x%02x\n", __FUNCTION__, uint8BtrSeen);
+		goto ERO_END;
+	}
+	printf("INFO:%s:bus trace: %u entries\n", __FUNCTION__, uint16BtrLen);
+	fhBtr = fopen("./test/iicmb_btrace.bin", "wb");
+	if ( (NULL == fhBtr) || (uint16BtrLen != fwrite(uint32Btr, sizeof(uint32Btr[0]), uint16BtrLen, fhBtr)) ) {
+		printf("ERROR:%s:bus trace: dump failed\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	fclose(fhBtr);
+#endif
+
+#if IICMB_TRACE_LEN > 0
+	/* Trace, last event is end of last transfer, dump for host decoder */
+	printf("INFO:%s:trace\n", __FUNCTION__);
+	if ( (IICMB_TRACE_LEN > iicm.trace.uint32Head) || (IICMB_TRC_DONE != iicm.trace.entry[(iicm.trace.uint32Head - 1) & (IICMB_TRACE_LEN - 1)].uint8Evt) || (IICMB_E_NO != iicm.trace.entry[(iicm.trace.uint32Head - 1) & (IICMB_TRACE_LEN - 1)].uint8Arg) ) {
+		printf("ERROR:%s:trace: %u events, last transfer not recorded\n", __FUNCTION__, iicm.trace.uint32Head);
+		goto ERO_END;
+	}
+	fh = fopen("./test/iicmb_trace.bin", "wb");
+	if ( (NULL == fh) || (1 != fwrite(&iicm.trace, sizeof(iicm.trace), 1, fh)) ) {
+		printf("ERROR:%s:trace: dump failed\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	fclose(fh);
+#endif
+
+	/* avoid warning */
+	goto OK_END;
+    /* gracefull end */
+    OK_END:
+		printf("INFO:%s: Model test SUCCESSFUL :-)\n", __FUNCTION__);
+		exit(EXIT_SUCCESS);
+
+	/* avoid warning */
+	goto ERO_END;
+    /* abnormal end */
+    ERO_END:
+        printf("FAIL:%s: Model test FAILED :-(\n", __FUNCTION__);
+        exit(EXIT_FAILURE);
+
+}
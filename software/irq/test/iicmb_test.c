@@ -84,6 +84,8 @@ int main ()
     /** Variables **/
 	uint8_t		uint8RegIICMB[4] = {0xff, 0x00, 0x80, 0x00};	// register handle for IICMB: CSR, DPR, CMDR, FSMR
 	t_iicmb  	iicm;											// handle for IICMB driver
+	uint8_t		uint8Data[4] = {0x01, 0x02, 0x03, 0x04};		// I2C payload
+	uint32_t	uint32Iter;										// loop counter
 	
 	
 	
@@ -99,13 +101,67 @@ int main ()
 		goto ERO_END;
 	}
 	
-
-
-
-
-
-
-
+	/* iicmb_write: fill transfer queue */
+	printf("INFO:%s:iicmb_write:queue\n", __FUNCTION__);
+	for ( uint32Iter = 0; uint32Iter < IICMB_QUEUE_LEN; uint32Iter++ ) {
+		if ( IICMB_EXIT_OK != iicmb_write(&iicm, 0x12, uint8Data, sizeof(uint8Data)) ) {
+			printf("ERROR:%s:iicmb_write: request %u not queued\n", __FUNCTION__, uint32Iter);
+			goto ERO_END;
+		}
+	}
+	if ( IICMB_EXIT_BUSY != iicmb_write(&iicm, 0x12, uint8Data, sizeof(uint8Data)) ) {
+		printf("ERROR:%s:iicmb_write: full queue not detected\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	if ( IICMB_CMD_START != uint8RegIICMB[2] ) {
+		printf("ERROR:%s:iicmb_write: first request not started\n", __FUNCTION__);
+		print_reg_iicmb( (uint8_t*) &uint8RegIICMB);
+		goto ERO_END;
+	}
+	
+	/* iicmb_fsm: drain first request, next one starts from ISR */
+	printf("INFO:%s:iicmb_fsm:back-to-back\n", __FUNCTION__);
+	for ( uint32Iter = 0; (0 == iicm.queue[5].uint8Tail) && (uint32Iter < 100); uint32Iter++ ) {
+		uint8RegIICMB[2] = IICMB_RSP_DONE;	// CMDR, last command done
+		iicmb_fsm(&iicm);
+	}
+	if ( (1 != iicm.queue[5].uint8Tail) || (IICMB_WR_ADR_SET != iicm.fsm) || (IICMB_CMD_START != uint8RegIICMB[2]) || (0 != iicmb_is_error(&iicm)) ) {
+		printf("ERROR:%s:iicmb_fsm: next request not started\n", __FUNCTION__);
+		print_reg_iicmb( (uint8_t*) &uint8RegIICMB);
+		goto ERO_END;
+	}
+	if ( 0 == iicmb_busy(&iicm) ) {
+		printf("ERROR:%s:iicmb_busy: pending requests not reported\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	
+	/* iicmb_bus_write: request on other bus, selected round-robin after active transfer */
+	printf("INFO:%s:iicmb_bus_write:round-robin\n", __FUNCTION__);
+	if ( IICMB_EXIT_OK != iicmb_bus_write(&iicm, 2, 0x34, uint8Data, sizeof(uint8Data)) ) {
+		printf("ERROR:%s:iicmb_bus_write: request not queued\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	if ( IICMB_EXIT_ERROR != iicmb_bus_write(&iicm, IICMB_BUS_NUM, 0x34, uint8Data, sizeof(uint8Data)) ) {
+		printf("ERROR:%s:iicmb_bus_write: invalid bus not detected\n", __FUNCTION__);
+		goto ERO_END;
+	}
+	for ( uint32Iter = 0; (IICMB_SET_BUS != iicm.fsm) && (uint32Iter < 100); uint32Iter++ ) {
+		uint8RegIICMB[2] = IICMB_RSP_DONE;	// CMDR, last command done
+		iicmb_fsm(&iicm);
+	}
+	if ( (2 != iicm.queue[5].uint8Tail) || (IICMB_CMD_SET_BUS != uint8RegIICMB[2]) || (2 != uint8RegIICMB[1]) ) {
+		printf("ERROR:%s:iicmb_fsm: bus switch not requested\n", __FUNCTION__);
+		print_reg_iicmb( (uint8_t*) &uint8RegIICMB);
+		goto ERO_END;
+	}
+	uint8RegIICMB[0] = 0xf2;			// CSR, bus switched
+	uint8RegIICMB[2] = IICMB_RSP_DONE;	// CMDR, set bus done
+	iicmb_fsm(&iicm);
+	if ( (2 != iicm.uint8BusSel) || (IICMB_WR_ADR_SET != iicm.fsm) || (IICMB_CMD_START != uint8RegIICMB[2]) ) {
+		printf("ERROR:%s:iicmb_fsm: transfer on new bus not started\n", __FUNCTION__);
+		print_reg_iicmb( (uint8_t*) &uint8RegIICMB);
+		goto ERO_END;
+	}
 	
 	/* end register dump */
 	print_reg_iicmb((uint8_t*) &uint8RegIICMB);
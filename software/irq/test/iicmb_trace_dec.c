@@ -0,0 +1,137 @@
+/*******************************************************************************
+**                                                                             *
+**    Project: IIC Multiple Bus Controller (IICMB)                             *
+**                                                                             *
+**    File:    Host decoder of IRQ driver binary trace ring                *
+**    Version:                                                                 *
+**             1.0,     October 16, 2026                                       *
+**                                                                             *
+**    Author:  IICMB contributors                                              *
+**                                                                             *
+********************************************************************************
+********************************************************************************
+** Copyright (c) 2023, Sergey Shuvalkin                                        *
+** All rights reserved.                                                        *
+**                                                                             *
+** Redistribution and use in source and binary forms, with or without          *
+** modification, are permitted provided that the following conditions are met: *
+**                                                                             *
+** 1. Redistributions of source code must retain the above copyright notice,   *
+**    this list of conditions and the following disclaimer.                    *
+** 2. Redistributions in binary form must reproduce the above copyright        *
+**    notice, this list of conditions and the following disclaimer in the      *
+**    documentation and/or other materials provided with the distribution.     *
+**                                                                             *
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" *
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE   *
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE  *
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE    *
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR         *
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF        *
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS    *
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN     *
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)     *
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE  *
+** POSSIBILITY OF SUCH DAMAGE.                                                 *
+*******************************************************************************/
+
+
+
+/** Standard libs **/
+#include <stdio.h>          // f.e. printf
+#include <stdlib.h>         // defines four variables, several macros,
+                            // and various functions for performing
+                            // general functions
+#include <stdint.h>         // defines fiexd data types, like int8_t...
+#include <string.h>         // string handling functions
+
+/** User Libs **/
+#include "iicmb.h"			// trace entry
+
+
+
+/**
+ *  Decoder tables
+ */
+static const char* strTrcEvt[] = {"submit", "start", "isr", "error", "done", "retry"};
+static const char* strFsm[] = {"IDLE", "WT_IDLE", "WR_ADR_SET", "WR_ADR_CHK", "WR_BYTE", "RD_ADR_SET", "RD_ADR_CHK", "RD_BYTE", "SET_BUS", "MSG", "BACKOFF"};
+
+
+
+/**
+ *  Main
+ *  ----
+ *  decodes a memory dump of t_iicmb_trace_ring, uint32 head
+ *  followed by the ring entries in target byte order. Prints one
+ *  CSV line per event, oldest first, dt is the timestamp delta
+ *  to the previous event.
+ */
+int main ( int argc, char *argv[] )
+{
+	/** Variables **/
+	FILE			*fh;				// dump file
+	long			lngSize;			// dump size
+	uint32_t		uint32Head;			// recorded events
+	uint32_t		uint32Len;			// ring entries
+	uint32_t		uint32First;		// oldest event in ring
+	uint32_t		uint32Iter;			// loop counter
+	uint32_t		uint32TimeLast = 0;	// timestamp of previous event
+	t_iicmb_trace	*trace;				// ring entries
+	t_iicmb_trace	*entry;				// decoded entry
+
+
+
+	/* check args */
+	if ( 2 != argc ) {
+		printf("usage: %s <trace dump>\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	/* load dump */
+	fh = fopen(argv[1], "rb");
+	if ( NULL == fh ) {
+		printf("ERROR:%s: open '%s' failed\n", __FUNCTION__, argv[1]);
+		return EXIT_FAILURE;
+	}
+	fseek(fh, 0, SEEK_END);
+	lngSize = ftell(fh);
+	fseek(fh, 0, SEEK_SET);
+	if ( lngSize < (long) (sizeof(uint32Head) + sizeof(t_iicmb_trace)) ) {
+		printf("ERROR:%s: dump too short\n", __FUNCTION__);
+		fclose(fh);
+		return EXIT_FAILURE;
+	}
+	uint32Len = (uint32_t) (((unsigned long) lngSize - sizeof(uint32Head)) / sizeof(t_iicmb_trace));
+	if ( 0 != (uint32Len & (uint32Len - 1)) ) {
+		printf("ERROR:%s: %u entries, not a power of two\n", __FUNCTION__, uint32Len);
+		fclose(fh);
+		return EXIT_FAILURE;
+	}
+	trace = (t_iicmb_trace*) malloc(uint32Len * sizeof(t_iicmb_trace));
+	if ( (NULL == trace) || (1 != fread(&uint32Head, sizeof(uint32Head), 1, fh)) || (uint32Len != fread(trace, sizeof(t_iicmb_trace), uint32Len, fh)) ) {
+		printf("ERROR:%s: read '%s' failed\n", __FUNCTION__, argv[1]);
+		free(trace);
+		fclose(fh);
+		return EXIT_FAILURE;
+	}
+	fclose(fh);
+	/* decode, oldest first */
+	uint32First = (uint32Head > uint32Len) ? (uint32Head - uint32Len) : 0;
+	printf("event,time,dt,type,fsm,arg,bus,wr,rd\n");
+	for ( uint32Iter = uint32First; uint32Iter != uint32Head; uint32Iter++ ) {
+		entry = &trace[uint32Iter & (uint32Len - 1)];
+		printf	(	"%u,%u,%u,%s,%s,0x%02x,%u,%u,%u\n",
+					uint32Iter,
+					entry->uint32Time,
+					(uint32Iter == uint32First) ? 0 : (entry->uint32Time - uint32TimeLast),	// unsigned, wrap safe
+					(entry->uint8Evt < (sizeof(strTrcEvt) / sizeof(strTrcEvt[0]))) ? strTrcEvt[entry->uint8Evt] : "?",
+					(entry->uint8Fsm < (sizeof(strFsm) / sizeof(strFsm[0]))) ? strFsm[entry->uint8Fsm] : "?",
+					entry->uint8Arg,
+					entry->uint8Bus,
+					entry->uint16WrByteIs,
+					entry->uint16RdByteIs
+				);
+		uint32TimeLast = entry->uint32Time;
+	}
+	free(trace);
+	return EXIT_SUCCESS;
+}
@@ -146,35 +146,90 @@ rsp_tt iicmb_cmd_set_bus(unsigned char n)
 }
 
 
+/* Execute a list of encoded commands */
+int iicmb_exec(const iicmb_op_tt * op, int n, unsigned char * d, rsp_tt * r)
+{
+  int i;
+  int tmp;
+  rsp_tt ret = rsp_done;
+
+  for (i = 0; i < n; i++)
+  {
+    /* Issue command, data byte only for commands that use it */
+    if ((op[i].cmd == IICMB_CMD_WRITE) || (op[i].cmd == IICMB_CMD_WAIT) || (op[i].cmd == IICMB_CMD_SET_BUS))
+    {
+      IICMB_REG_WRITE(IICMB_DPR, ((unsigned int)op[i].dat & 0x000000FFu));
+    }
+    IICMB_REG_WRITE(IICMB_CMDR, op[i].cmd);
+
+    /* Wait for response */
+    do
+    {
+      tmp = IICMB_REG_READ(IICMB_CMDR);
+    } while ((tmp & IICMB_RSP_COMPLETED) == 0);
+
+    if (tmp & IICMB_RSP_DONE)
+    {
+      /* Store received data */
+      if ((op[i].cmd == IICMB_CMD_READ_ACK) || (op[i].cmd == IICMB_CMD_READ_NAK))
+      {
+        *d++ = (unsigned char)IICMB_REG_READ(IICMB_DPR);
+      }
+      continue;
+    }
+
+    if (tmp & IICMB_RSP_NAK)           { ret = rsp_nak; }
+    else if (tmp & IICMB_RSP_ARB_LOST) { ret = rsp_arb_lost; }
+    else                               { ret = rsp_err; }
+    break;
+  }
+
+  /* Stop condition releases the bus after a NAK */
+  if (ret == rsp_nak) { (void)iicmb_cmd_stop(); }
+
+  if (r != NULL) { *r = ret; }
+
+  return (i < n) ? i : -1;
+}
+
+
+/* Commands per iicmb_exec() call of the multi-byte operations */
+#define IICMB_EXEC_PART 8
+
+/* Execute a part of a high-level operation. As the former hand-coded
+ * sequences it sends a Stop after a failed Write, or after the last part
+ * if it was done, and ignores the Stop response. A failed (repeated) Start
+ * or Read ends without Stop. Returns non-zero if the operation is finished. */
+static int iicmb_exec_part(const iicmb_op_tt * op, int n, unsigned char * d, int last, rsp_tt * r)
+{
+  int i;
+
+  i = iicmb_exec(op, n, d, r);
+
+  /* iicmb_exec() has already sent a Stop after a NAK */
+  if (((i < 0) && last) || ((i >= 0) && (op[i].cmd == IICMB_CMD_WRITE) && (*r != rsp_nak)))
+  {
+    (void)iicmb_cmd_stop();
+  }
+
+  return (i >= 0) || last;
+}
+
 /* Read a single byte */
 rsp_tt iicmb_read_bus(unsigned char sa, unsigned char a, unsigned char * d)
 {
   rsp_tt ret;
+  const iicmb_op_tt op[] =
+  {
+    IICMB_OP(IICMB_CMD_START,    0),                                 /* Start condition                   */
+    IICMB_OP(IICMB_CMD_WRITE,    (unsigned char)((sa << 1) | 0x00u)), /* Slave address and write bit       */
+    IICMB_OP(IICMB_CMD_WRITE,    a),                                 /* Byte address                      */
+    IICMB_OP(IICMB_CMD_START,    0),                                 /* Repeated start                    */
+    IICMB_OP(IICMB_CMD_WRITE,    (unsigned char)((sa << 1) | 0x01u)), /* Slave address and read bit        */
+    IICMB_OP(IICMB_CMD_READ_NAK, 0)                                  /* Byte of data with not-acknowledge */
+  };
 
-  /* Start condition */
-  ret = iicmb_cmd_start();
-  if (ret != rsp_done) return ret;
-
-  do {
-    /* Write slave address and write bit */
-    ret = iicmb_cmd_write((sa << 1) | 0x00u);
-    if (ret != rsp_done) break;
-    /* Write byte address */
-    ret = iicmb_cmd_write(a);
-    if (ret != rsp_done) break;
-    /* Repeated start */
-    ret = iicmb_cmd_start();
-    if (ret != rsp_done) return ret;
-    /* Write slave address and read bit */
-    ret = iicmb_cmd_write((sa << 1) | 0x01u);
-    if (ret != rsp_done) break;
-    /* Read byte of data with not-acknowledge */
-    ret = iicmb_cmd_read_nak(d);
-    if (ret != rsp_done) return ret;
-  } while (0);
-
-  /* Stop condition */
-  (void)iicmb_cmd_stop();
+  (void)iicmb_exec_part(op, (int)(sizeof(op) / sizeof(op[0])), d, 1, &ret);
 
   return ret;
 }
@@ -184,37 +239,35 @@ rsp_tt iicmb_read_bus_mul(unsigned char sa, unsigned char a, unsigned char * d,
 {
   rsp_tt ret;
   int i;
+  int k;
+  const iicmb_op_tt op[] =
+  {
+    IICMB_OP(IICMB_CMD_START, 0),                                 /* Start condition             */
+    IICMB_OP(IICMB_CMD_WRITE, (unsigned char)((sa << 1) | 0x00u)), /* Slave address and write bit */
+    IICMB_OP(IICMB_CMD_WRITE, a),                                 /* Byte address                */
+    IICMB_OP(IICMB_CMD_START, 0),                                 /* Repeated start              */
+    IICMB_OP(IICMB_CMD_WRITE, (unsigned char)((sa << 1) | 0x01u))  /* Slave address and read bit  */
+  };
+  const iicmb_op_tt rd_nak[] = { IICMB_OP(IICMB_CMD_READ_NAK, 0) };
+  iicmb_op_tt rd_ack[IICMB_EXEC_PART];
+
+  for (k = 0; k < IICMB_EXEC_PART; k++)
+  {
+    rd_ack[k].cmd = IICMB_CMD_READ_ACK;
+    rd_ack[k].dat = 0;
+  }
 
-  /* Start condition */
-  ret = iicmb_cmd_start();
-  if (ret != rsp_done) return ret;
-
-  do {
-    /* Write slave address and write bit */
-    ret = iicmb_cmd_write((sa << 1) | 0x00u);
-    if (ret != rsp_done) break;
-    /* Write byte address */
-    ret = iicmb_cmd_write(a);
-    if (ret != rsp_done) break;
-    /* Repeated start */
-    ret = iicmb_cmd_start();
-    if (ret != rsp_done) return ret;
-    /* Write slave address and read bit */
-    ret = iicmb_cmd_write((sa << 1) | 0x01u);
-    if (ret != rsp_done) break;
-    for (i = 0; i < (n - 1); i++)
-    {
-      /* Read byte of data with acknowledge */
-      ret = iicmb_cmd_read_ack(d + i);
-      if (ret != rsp_done) return ret;
-    }
-    /* Read byte of data with not-acknowledge */
-    ret = iicmb_cmd_read_nak(d + i);
-    if (ret != rsp_done) return ret;
-  } while (0);
+  if (iicmb_exec_part(op, (int)(sizeof(op) / sizeof(op[0])), NULL, 0, &ret)) return ret;
 
-  /* Stop condition */
-  (void)iicmb_cmd_stop();
+  /* Read bytes of data with acknowledge */
+  for (i = 0; i < (n - 1); i += k)
+  {
+    k = ((n - 1 - i) < IICMB_EXEC_PART) ? (n - 1 - i) : IICMB_EXEC_PART;
+    if (iicmb_exec_part(rd_ack, k, d + i, 0, &ret)) return ret;
+  }
+
+  /* Read byte of data with not-acknowledge */
+  (void)iicmb_exec_part(rd_nak, 1, d + ((n > 1) ? (n - 1) : 0), 1, &ret);
 
   return ret;
 }
@@ -223,25 +276,15 @@ rsp_tt iicmb_read_bus_mul(unsigned char sa, unsigned char a, unsigned char * d,
 rsp_tt iicmb_write_bus(unsigned char sa, unsigned char a, unsigned char d)
 {
   rsp_tt ret;
+  const iicmb_op_tt op[] =
+  {
+    IICMB_OP(IICMB_CMD_START, 0),                                 /* Start condition             */
+    IICMB_OP(IICMB_CMD_WRITE, (unsigned char)((sa << 1) | 0x00u)), /* Slave address and write bit */
+    IICMB_OP(IICMB_CMD_WRITE, a),                                 /* Byte address                */
+    IICMB_OP(IICMB_CMD_WRITE, d)                                  /* Byte of data                */
+  };
 
-  /* Start condition */
-  ret = iicmb_cmd_start();
-  if (ret != rsp_done) return ret;
-
-  do {
-    /* Write slave address and write bit */
-    ret = iicmb_cmd_write((sa << 1) | 0x00000000);
-    if (ret != rsp_done) break;
-    /* Write byte address */
-    ret = iicmb_cmd_write(a);
-    if (ret != rsp_done) break;
-    /* Write byte of data */
-    ret = iicmb_cmd_write(d);
-    if (ret != rsp_done) break;
-  } while (0);
-
-  /* Stop condition */
-  (void)iicmb_cmd_stop();
+  (void)iicmb_exec_part(op, (int)(sizeof(op) / sizeof(op[0])), NULL, 1, &ret);
 
   return ret;
 }
@@ -251,28 +294,27 @@ rsp_tt iicmb_write_bus_mul(unsigned char sa, unsigned char a, unsigned char * d,
 {
   rsp_tt ret;
   int i;
+  int k;
+  const iicmb_op_tt op[] =
+  {
+    IICMB_OP(IICMB_CMD_START, 0),                                 /* Start condition             */
+    IICMB_OP(IICMB_CMD_WRITE, (unsigned char)((sa << 1) | 0x00u)), /* Slave address and write bit */
+    IICMB_OP(IICMB_CMD_WRITE, a)                                  /* Byte address                */
+  };
+  iicmb_op_tt wr[IICMB_EXEC_PART];
 
-  /* Start condition */
-  ret = iicmb_cmd_start();
-  if (ret != rsp_done) return ret;
-
-  do {
-    /* Write slave address and write bit */
-    ret = iicmb_cmd_write((sa << 1) | 0x00000000);
-    if (ret != rsp_done) break;
-    /* Write byte address */
-    ret = iicmb_cmd_write(a);
-    if (ret != rsp_done) break;
-    for (i = 0; i < n; i++)
+  if (iicmb_exec_part(op, (int)(sizeof(op) / sizeof(op[0])), NULL, (n <= 0), &ret)) return ret;
+
+  /* Write bytes of data */
+  for (i = 0; i < n; i += k)
+  {
+    for (k = 0; (k < IICMB_EXEC_PART) && ((i + k) < n); k++)
     {
-      /* Write byte of data */
-      ret = iicmb_cmd_write(*(d + i));
-      if (ret != rsp_done) break;
+      wr[k].cmd = IICMB_CMD_WRITE;
+      wr[k].dat = *(d + i + k);
     }
-  } while (0);
-
-  /* Stop condition */
-  (void)iicmb_cmd_stop();
+    if (iicmb_exec_part(wr, k, NULL, ((i + k) >= n), &ret)) return ret;
+  }
 
   return ret;
 }
@@ -360,3 +402,74 @@ void iicmb_report_registers(FILE *fp)
   fprintf(fp, "\n");
 }
 
+/* Start bus trace */
+void iicmb_trace_arm(unsigned short trg, unsigned char post, unsigned char str, unsigned char pre)
+{
+  IICMB_REG_WRITE(IICMB_TCR, IICMB_TCR_CLR);
+  IICMB_REG_WRITE(IICMB_TPOST, post);
+  IICMB_REG_WRITE(IICMB_TTRG, trg & 0xFF);
+  IICMB_REG_WRITE(IICMB_TTRG + 1, trg >> 8);
+  IICMB_REG_WRITE(IICMB_TSTR, str);
+  IICMB_REG_WRITE(IICMB_TPRE, pre);
+  IICMB_REG_WRITE(IICMB_TCR, IICMB_TCR_EN);
+}
+
+/* Report bus trace */
+void iicmb_report_trace(FILE *fp)
+{
+  int           tcr;
+  unsigned int  depth;
+  unsigned int  ptr;
+  unsigned int  num;
+  unsigned int  idx;
+  unsigned int  i;
+  unsigned long e;
+  unsigned long t = 0;
+
+  fprintf(fp, "\n--------------------------------------------------------\n");
+  fprintf(fp, "IICMB bus trace:\n\n");
+
+  depth = 1u << IICMB_REG_READ(IICMB_TDEP);
+  if (depth == 1) { fprintf(fp, "  No trace RAM in core\n"); return; }
+
+  /* Freeze, trigger state is kept */
+  tcr = IICMB_REG_READ(IICMB_TCR);
+  IICMB_REG_WRITE(IICMB_TCR, (tcr & IICMB_TCR_EN) | IICMB_TCR_FRZ);
+  ptr = IICMB_REG_READ(IICMB_TPTR) | (IICMB_REG_READ(IICMB_TPTR + 1) << 8);
+  num = (tcr & IICMB_TCR_WRAP) ? depth : ptr;
+  fprintf(fp, "TCR  = 0x%02x, %u entries", tcr, num);
+  if (tcr & IICMB_TCR_TRG) { fprintf(fp, ", triggered\n"); } else { fprintf(fp, "\n"); }
+  fprintf(fp, "  Timestamps in units of %u clock cycles\n", IICMB_REG_READ(IICMB_TPRE) + 1);
+
+  /* Oldest entry first, reading byte 3 of TDAT advances TIDX */
+  idx = (ptr - num) & (depth - 1);
+  IICMB_REG_WRITE(IICMB_TIDX, idx & 0xFF);
+  IICMB_REG_WRITE(IICMB_TIDX + 1, idx >> 8);
+  for (i = 0; i < num; i++)
+  {
+    e  = (unsigned long)IICMB_REG_READ(IICMB_TDAT);
+    e |= (unsigned long)IICMB_REG_READ(IICMB_TDAT + 1) << 8;
+    e |= (unsigned long)IICMB_REG_READ(IICMB_TDAT + 2) << 16;
+    e |= (unsigned long)IICMB_REG_READ(IICMB_TDAT + 3) << 24;
+    if (i != 0) { t += e & 0x000FFFFF; }
+    fprintf(fp, "  %8lu%s ", t, ((e & 0x000FFFFF) == 0x000FFFFF) ? "+" : " ");
+    switch ((e >> 28) & 0x0000000F)
+    {
+      case IICMB_BTR_START  : fprintf(fp, "Start\n");                                break;
+      case IICMB_BTR_RSTART : fprintf(fp, "Repeated Start\n");                       break;
+      case IICMB_BTR_STOP   : fprintf(fp, "Stop\n");                                 break;
+      case IICMB_BTR_WACK   : fprintf(fp, "Write 0x%02lx, Ack\n", (e >> 20) & 0xFF); break;
+      case IICMB_BTR_WNAK   : fprintf(fp, "Write 0x%02lx, Nak\n", (e >> 20) & 0xFF); break;
+      case IICMB_BTR_RACK   : fprintf(fp, "Read 0x%02lx, Ack\n", (e >> 20) & 0xFF);  break;
+      case IICMB_BTR_RNAK   : fprintf(fp, "Read 0x%02lx, Nak\n", (e >> 20) & 0xFF);  break;
+      case IICMB_BTR_AL     : fprintf(fp, "Arbitration lost, command %lu\n", (e >> 20) & 0xFF); break;
+      case IICMB_BTR_ERR    : fprintf(fp, "Error, command %lu\n", (e >> 20) & 0xFF); break;
+      case IICMB_BTR_BUS    : fprintf(fp, "Bus #%lu\n", (e >> 20) & 0xFF);          break;
+      case IICMB_BTR_STRB   : fprintf(fp, "Clock stretch begin, bit state 0x%lx\n", (e >> 20) & 0xFF); break;
+      case IICMB_BTR_STRE   : fprintf(fp, "Clock stretch end\n");                    break;
+      default               : fprintf(fp, "STRANGE!!!\n");                           break;
+    }
+  }
+  fprintf(fp, "--------------------------------------------------------\n");
+  fprintf(fp, "\n");
+}
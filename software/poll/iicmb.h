@@ -49,10 +49,42 @@
 #define IICMB_CMDR           (0x02)
 #define IICMB_FSMR           (0x03)
 
+/* Bus trace register offsets, HDL generic g_trace_depth > 0: */
+#define IICMB_TCR            (0x40)
+#define IICMB_TPOST          (0x41)
+#define IICMB_TTRG           (0x42)
+#define IICMB_TPTR           (0x44)
+#define IICMB_TSTR           (0x46)
+#define IICMB_TPRE           (0x47)
+#define IICMB_TIDX           (0x48)
+#define IICMB_TDEP           (0x4A)
+#define IICMB_TDAT           (0x4C)
+
 /* Bits of CSR register */
 #define IICMB_CSR_ENABLE     (0x80)
 #define IICMB_CSR_IRQ_ENABLE (0x40)
 
+/* Bits of TCR register */
+#define IICMB_TCR_EN         (0x01)
+#define IICMB_TCR_FRZ        (0x02)
+#define IICMB_TCR_TRG        (0x04)
+#define IICMB_TCR_WRAP       (0x08)
+#define IICMB_TCR_CLR        (0x80)
+
+/* Event codes in bits 31..28 of a bus trace entry: */
+#define IICMB_BTR_START      (0x0)
+#define IICMB_BTR_RSTART     (0x1)
+#define IICMB_BTR_STOP       (0x2)
+#define IICMB_BTR_WACK       (0x3)
+#define IICMB_BTR_WNAK       (0x4)
+#define IICMB_BTR_RACK       (0x5)
+#define IICMB_BTR_RNAK       (0x6)
+#define IICMB_BTR_AL         (0x7)
+#define IICMB_BTR_ERR        (0x8)
+#define IICMB_BTR_BUS        (0x9)
+#define IICMB_BTR_STRB       (0xA)
+#define IICMB_BTR_STRE       (0xB)
+
 /* Response codes in CMDR register: */
 #define IICMB_RSP_DONE       (0x80)
 #define IICMB_RSP_NAK        (0x40)
@@ -94,6 +126,17 @@ typedef enum
 } cmd_tt;
 
 
+/* Encoded command for the command-list executor */
+typedef struct
+{
+  unsigned char cmd;   /* Command code, one of IICMB_CMD_*                  */
+  unsigned char dat;   /* Data byte for Wait, Write and Set Bus, else unused */
+} iicmb_op_tt;
+
+/* Initializer of an encoded command */
+#define IICMB_OP(cmd, dat)   { (cmd), (dat) }
+
+
 /* IICMB controller register read/write primitives: */
 #define IICMB_REG_WRITE(off, val) IOWR_8DIRECT(IICMB_BASE_ADDR, (off), (val))
 #define IICMB_REG_READ(off)       IORD_8DIRECT(IICMB_BASE_ADDR, (off))
@@ -112,6 +155,24 @@ rsp_tt iicmb_cmd_stop(void);                  /* Stop          */
 rsp_tt iicmb_cmd_set_bus(unsigned char n);    /* Set Bus       */
 
 
+/* Command-list executor: ****************************************************/
+
+/* Execute a list of encoded commands
+ * Parameters:
+ *    const iicmb_op_tt * op  -- Pointer to a list of commands
+ *    int                 n   -- Number of commands in the list
+ *    unsigned char *     d   -- Pointer to a storage for received data, one
+ *                               byte per Read command in list order
+ *    rsp_tt *            r   -- Pointer to a storage for the response of the
+ *                               last executed command, may be NULL
+ * Returns:
+ *    int                     -- Index of the first failing command,
+ *                               or -1 when all commands are done.
+ * A Stop is issued after a non-acknowledged command to release the bus.
+ */
+int iicmb_exec(const iicmb_op_tt * op, int n, unsigned char * d, rsp_tt * r);
+
+
 /* High-level operations: ****************************************************/
 
 /* Read a single byte
@@ -158,8 +219,24 @@ rsp_tt iicmb_write_bus(unsigned char sa, unsigned char a, unsigned char d);
  */
 rsp_tt iicmb_write_bus_mul(unsigned char sa, unsigned char a, unsigned char * d, int n);
 
+
+/* Bus trace: ****************************************************************/
+
+/* Empty the trace RAM and start recording
+ * Parameters:
+ *    unsigned short   trg  -- Trigger events, bit n for event code n
+ *    unsigned char    post -- Entries after the trigger event until freeze
+ *    unsigned char    str  -- Stretch threshold in clock cycles, 0: no
+ *                             stretch events
+ *    unsigned char    pre  -- Timestamp prescaler, ticks of pre+1 cycles
+ */
+void iicmb_trace_arm(unsigned short trg, unsigned char post, unsigned char str, unsigned char pre);
+
 /* Report IICMB registers */
 void iicmb_report_registers(FILE *fp);
 
+/* Freeze the bus trace and report its entries, oldest first */
+void iicmb_report_trace(FILE *fp);
+
 #endif /* __IICMB_H__ */
 
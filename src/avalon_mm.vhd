@@ -58,9 +58,11 @@ entity avalon_mm is
     write         : in    std_logic;                            -- Asserted to indicate write transfer
     read          : in    std_logic;                            -- Asserted to indicate read transfer
     byteenable    : in    std_logic_vector( 3 downto 0);        -- Enables specific byte lane(s)
+    address       : in    std_logic_vector( 4 downto 0) := "00000"; -- Word address
     ------------------------------------
     ------------------------------------
     -- Regblock interface:
+    adr           :   out std_logic_vector( 4 downto 0);        -- Word address
     wr            :   out std_logic_vector( 3 downto 0);        -- Write (active high)
     rd            :   out std_logic_vector( 3 downto 0);        -- Read (active high)
     idata         :   out std_logic_vector(31 downto 0);        -- Data from System Bus
@@ -76,6 +78,7 @@ architecture rtl of avalon_mm is
 begin
 
   waitrequest <= '0';
+  adr         <= address;
   wr          <= (3 downto 0 => write) and byteenable;
   rd          <= (3 downto 0 => read ) and byteenable;
   idata       <= writedata;
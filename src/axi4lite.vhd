@@ -0,0 +1,199 @@
+
+--==============================================================================
+--                                                                             |
+--    Project: IIC Multiple Bus Controller (IICMB)                             |
+--                                                                             |
+--    Module:  AXI4-Lite slave interface.                                      |
+--    Version:                                                                 |
+--             1.0,   October 16, 2026                                         |
+--                                                                             |
+--    Author:  IICMB contributors                                              |
+--                                                                             |
+--==============================================================================
+--==============================================================================
+-- Copyright (c) 2016, Sergey Shuvalkin                                        |
+-- All rights reserved.                                                        |
+--                                                                             |
+-- Redistribution and use in source and binary forms, with or without          |
+-- modification, are permitted provided that the following conditions are met: |
+--                                                                             |
+-- 1. Redistributions of source code must retain the above copyright notice,   |
+--    this list of conditions and the following disclaimer.                    |
+-- 2. Redistributions in binary form must reproduce the above copyright        |
+--    notice, this list of conditions and the following disclaimer in the      |
+--    documentation and/or other materials provided with the distribution.     |
+--                                                                             |
+-- THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" |
+-- AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE   |
+-- IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE  |
+-- ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE    |
+-- LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR         |
+-- CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF        |
+-- SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS    |
+-- INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN     |
+-- CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)     |
+-- ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE  |
+-- POSSIBILITY OF SUCH DAMAGE.                                                 |
+--==============================================================================
+
+
+library ieee;
+use ieee.std_logic_1164.all;
+
+
+--==============================================================================
+-- Write address and write data are accepted independently and buffered
+-- until both are present, the register write then happens in the same cycle
+-- with 'wstrb' as byte lanes. A read is executed in the cycle its address is
+-- accepted, 'rdata' follows in the next cycle. A new read address is accepted
+-- every cycle as long as the read data is taken, so back-to-back reads
+-- overlap. A write has priority over a read in the same cycle.
+--==============================================================================
+entity axi4lite is
+  port
+  (
+    ------------------------------------
+    aclk          : in    std_logic;                            -- Clock input
+    aresetn       : in    std_logic;                            -- Synchronous reset (active low)
+    ------------------------------------
+    ------------------------------------
+    -- AXI4-Lite slave interface:
+    awvalid       : in    std_logic;                            -- Write address valid
+    awready       :   out std_logic;                            -- Write address ready
+    awaddr        : in    std_logic_vector(11 downto 0);        -- Write address
+    wvalid        : in    std_logic;                            -- Write data valid
+    wready        :   out std_logic;                            -- Write data ready
+    wdata         : in    std_logic_vector(31 downto 0);        -- Write data
+    wstrb         : in    std_logic_vector( 3 downto 0);        -- Write strobes
+    bvalid        :   out std_logic;                            -- Write response valid
+    bready        : in    std_logic;                            -- Write response ready
+    bresp         :   out std_logic_vector( 1 downto 0);        -- Write response
+    arvalid       : in    std_logic;                            -- Read address valid
+    arready       :   out std_logic;                            -- Read address ready
+    araddr        : in    std_logic_vector(11 downto 0);        -- Read address
+    rvalid        :   out std_logic;                            -- Read data valid
+    rready        : in    std_logic;                            -- Read data ready
+    rdata         :   out std_logic_vector(31 downto 0);        -- Read data
+    rresp         :   out std_logic_vector( 1 downto 0);        -- Read response
+    ------------------------------------
+    ------------------------------------
+    -- Regblock interface:
+    pl            :   out std_logic;                            -- Poll window
+    eng           :   out std_logic_vector( 3 downto 0);        -- Engine window
+    adr           :   out std_logic_vector( 4 downto 0);        -- Word address
+    wr            :   out std_logic_vector( 3 downto 0);        -- Write (active high)
+    rd            :   out std_logic_vector( 3 downto 0);        -- Read (active high)
+    idata         :   out std_logic_vector(31 downto 0);        -- Data from System Bus
+    odata         : in    std_logic_vector(31 downto 0)         -- Data to System Bus
+    ------------------------------------
+  );
+end entity axi4lite;
+--==============================================================================
+
+--==============================================================================
+architecture rtl of axi4lite is
+
+  -- Buffered write address and data:
+  signal aw_buf_v     : std_logic                     := '0';
+  signal aw_buf       : std_logic_vector(11 downto 0) := (others => '0');
+  signal w_buf_v      : std_logic                     := '0';
+  signal w_buf        : std_logic_vector(31 downto 0) := (others => '0');
+  signal w_buf_strb   : std_logic_vector( 3 downto 0) := (others => '0');
+
+  signal aw_adr       : std_logic_vector(11 downto 0);
+  signal wr_go        : std_logic;
+  signal rd_go        : std_logic;
+  signal awready_y    : std_logic;
+  signal wready_y     : std_logic;
+  signal arready_y    : std_logic;
+  signal bvalid_y     : std_logic                     := '0';
+  signal rvalid_y     : std_logic                     := '0';
+  signal rdata_y      : std_logic_vector(31 downto 0) := (others => '0');
+
+begin
+
+  awready   <= awready_y;
+  wready    <= wready_y;
+  arready   <= arready_y;
+  bvalid    <= bvalid_y;
+  rvalid    <= rvalid_y;
+  rdata     <= rdata_y;
+  bresp     <= "00";
+  rresp     <= "00";
+
+  awready_y <= not(aw_buf_v);
+  wready_y  <= not(w_buf_v);
+
+  aw_adr    <= aw_buf when (aw_buf_v = '1') else awaddr;
+
+  -- Write with address and data present and response slot free:
+  wr_go     <= '1' when ((aw_buf_v = '1')or(awvalid = '1'))and((w_buf_v = '1')or(wvalid = '1'))and
+                        ((bvalid_y = '0')or(bready = '1')) else '0';
+  -- Read with read data slot free, not in a write cycle:
+  arready_y <= '1' when ((rvalid_y = '0')or(rready = '1'))and(wr_go = '0') else '0';
+  rd_go     <= arvalid and arready_y;
+
+  ------------------------------------------------------------------------------
+  -- Register access
+  pl        <= aw_adr(11)          when (wr_go = '1') else araddr(11);
+  eng       <= aw_adr(10 downto 7) when (wr_go = '1') else araddr(10 downto 7);
+  adr       <= aw_adr( 6 downto 2) when (wr_go = '1') else araddr( 6 downto 2);
+  wr        <= "0000"     when (wr_go = '0') else
+               w_buf_strb when (w_buf_v = '1') else
+               wstrb;
+  rd        <= "1111"     when (rd_go = '1') else "0000";
+  idata     <= w_buf      when (w_buf_v = '1') else wdata;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  axi_proc:
+  process(aclk)
+  begin
+    if rising_edge(aclk) then
+      if (aresetn = '0') then
+        aw_buf_v   <= '0';
+        aw_buf     <= (others => '0');
+        w_buf_v    <= '0';
+        w_buf      <= (others => '0');
+        w_buf_strb <= (others => '0');
+        bvalid_y   <= '0';
+        rvalid_y   <= '0';
+        rdata_y    <= (others => '0');
+      else
+        -- Write address/data waiting for the other one:
+        if (wr_go = '1') then
+          aw_buf_v   <= '0';
+          w_buf_v    <= '0';
+        else
+          if (awvalid = '1')and(awready_y = '1') then
+            aw_buf_v   <= '1';
+            aw_buf     <= awaddr;
+          end if;
+          if (wvalid = '1')and(wready_y = '1') then
+            w_buf_v    <= '1';
+            w_buf      <= wdata;
+            w_buf_strb <= wstrb;
+          end if;
+        end if;
+
+        -- Write response:
+        if (wr_go = '1') then
+          bvalid_y   <= '1';
+        elsif (bready = '1') then
+          bvalid_y   <= '0';
+        end if;
+
+        -- Read data:
+        if (rd_go = '1') then
+          rvalid_y   <= '1';
+          rdata_y    <= odata;
+        elsif (rready = '1') then
+          rvalid_y   <= '0';
+        end if;
+      end if;
+    end if;
+  end process axi_proc;
+  ------------------------------------------------------------------------------
+
+end architecture rtl;
+--==============================================================================
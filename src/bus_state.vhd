@@ -39,14 +39,14 @@
 
 library ieee;
 use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
 
 
 --==============================================================================
 entity bus_state is
   generic
   (
-    g_f_clk   :       real     := 100000.0;  -- Frequency of 'clk' input (in kHz)
-    g_f_scl   :       real     :=    100.0   -- Frequency of 'scl' input (in kHz)
+    g_f_clk   :       real     := 100000.0   -- Frequency of 'clk' input (in kHz)
   );
   port
   (
@@ -55,6 +55,7 @@ entity bus_state is
     s_rst     : in    std_logic;             -- Synchronous reset (active high)
     ------------------------------------
     ------------------------------------
+    t_buf     : in    unsigned(15 downto 0); -- Bus free time (in 'clk' cycles minus one)
     busy      :   out std_logic;             -- Bus busy indication (busy = high)
     scl_d     :   out std_logic;             -- Delayed I2C Clock signal
     ------------------------------------
@@ -70,20 +71,8 @@ end entity bus_state;
 --==============================================================================
 architecture rtl of bus_state is
 
-  ------------------------------------------------------------------------------
-  function get_t_buf(a : real) return real is
-  begin
-    if (a <= 100.0) then
-      return 4.7;
-    else
-      return 1.3;
-    end if;
-  end function get_t_buf;
-  ------------------------------------------------------------------------------
-
-  constant c_t_buf         : real    := get_t_buf(g_f_scl); -- in microseconds
-  constant c_t_buf_cnt     : integer := integer((g_f_clk*(c_t_buf/1000.0)) + 0.4999); -- in 'clk' cycles
-  constant c_max_cnt       : integer := c_t_buf_cnt;
+  -- One above the largest t_buf, the guard ends for t_buf = x"FFFF" too
+  constant c_max_cnt       : integer := 2**16;
 
   signal   scl_d_y         : std_logic                    := '1';
   signal   scl_y           : std_logic;
@@ -150,7 +139,7 @@ begin
             end if;
           when s_guard =>
             busy_y <= '1';
-            if (sda_d_y = '1')and(scl_d_y = '1')and(sda_cnt = c_t_buf_cnt) then
+            if (sda_d_y = '1')and(scl_d_y = '1')and(sda_cnt > to_integer(t_buf)) then
               state  <= s_free;
               busy_y <= '0';
             end if;
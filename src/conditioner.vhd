@@ -39,6 +39,7 @@
 
 library ieee;
 use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
 
 
 --==============================================================================
@@ -46,8 +47,7 @@ entity conditioner is
   generic
   (
     ------------------------------------
-    g_f_clk   :       real   := 100000.0; -- Frequency of 'clk' input (in kHz)
-    g_f_scl   :       real   :=    100.0  -- Frequency of 'scl_i' input (in kHz)
+    g_f_clk   :       real   := 100000.0  -- Frequency of 'clk' input (in kHz)
     ------------------------------------
   );
   port
@@ -57,6 +57,10 @@ entity conditioner is
     s_rst     : in    std_logic;         -- Synchronous reset (active high)
     ------------------------------------
     ------------------------------------
+    t_buf     : in    unsigned(15 downto 0); -- Bus free time (in 'clk' cycles minus one)
+    hs        : in    std_logic;         -- High-speed mode active (short spike filter)
+    ------------------------------------
+    ------------------------------------
     -- Interface to I2C FSMs:
     busy      :   out std_logic;         -- Bus busy indication (busy = high)
     --
@@ -73,7 +77,9 @@ entity conditioner is
     scl_i     : in    std_logic;         -- I2C Clock input
     sda_i     : in    std_logic;         -- I2C Data input
     scl_o     :   out std_logic;         -- I2C Clock output
-    sda_o     :   out std_logic          -- I2C Data output
+    sda_o     :   out std_logic;         -- I2C Data output
+    scl_pu_tx : in    std_logic;         -- I2C Clock current-source pull-up from FSMs
+    scl_pu_o  :   out std_logic          -- I2C Clock current-source pull-up enable
     ------------------------------------
   );
 end entity conditioner;
@@ -86,13 +92,13 @@ architecture str of conditioner is
   component bus_state is
     generic
     (
-      g_f_clk   :       real     := 100000.0;
-      g_f_scl   :       real     :=    100.0
+      g_f_clk   :       real     := 100000.0
     );
     port
     (
       clk       : in    std_logic;
       s_rst     : in    std_logic;
+      t_buf     : in    unsigned(15 downto 0);
       busy      :   out std_logic;
       scl_d     :   out std_logic;
       scl       : in    std_logic;
@@ -118,15 +124,21 @@ architecture str of conditioner is
   ------------------------------------------------------------------------------
 
   ------------------------------------------------------------------------------
-  function get_cycles(a : real) return positive is
+  -- Filter length suppressing spikes up to 't_sp' (in microseconds), the
+  -- filter output follows after 'cycles - 1' stable 'clk' cycles
+  function get_cycles(a : real; t_sp : real) return positive is
     variable ret : positive;
   begin
-    ret := 4 + integer((4.0*a)/50000.0);
+    ret := 1 + integer((a*(t_sp/1000.0)) + 0.4999);
+    if (ret < 2) then
+      ret := 2;
+    end if;
     return ret;
   end function get_cycles;
   ------------------------------------------------------------------------------
 
-  constant c_cycles      : positive := get_cycles(g_f_clk);
+  constant c_cycles      : positive := get_cycles(g_f_clk, 0.05); -- t_{SP} <= 50 ns: Standard, Fast and Fast-mode Plus
+  constant c_cycles_hs   : positive := get_cycles(g_f_clk, 0.01); -- t_{SP} <= 10 ns: High-speed mode
 
   signal   scl_i_ndeb_1  : std_logic;
   signal   sda_i_ndeb_1  : std_logic;
@@ -134,6 +146,10 @@ architecture str of conditioner is
   signal   sda_i_ndeb_2  : std_logic;
   signal   scl_i_deb     : std_logic;
   signal   sda_i_deb     : std_logic;
+  signal   scl_i_fs      : std_logic;
+  signal   sda_i_fs      : std_logic;
+  signal   scl_i_hs      : std_logic;
+  signal   sda_i_hs      : std_logic;
 
 begin
 
@@ -171,7 +187,7 @@ begin
       clk                => clk,
       s_rst              => s_rst,
       sig_in             => scl_i_ndeb_2,
-      sig_out            => scl_i_deb
+      sig_out            => scl_i_fs
     );
   ------------------------------------------------------------------------------
 
@@ -186,9 +202,42 @@ begin
       clk                => clk,
       s_rst              => s_rst,
       sig_in             => sda_i_ndeb_2,
-      sig_out            => sda_i_deb
+      sig_out            => sda_i_fs
+    );
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  scl_filter_hs : filter
+    generic map
+    (
+      g_cycles           => c_cycles_hs
+    )
+    port map
+    (
+      clk                => clk,
+      s_rst              => s_rst,
+      sig_in             => scl_i_ndeb_2,
+      sig_out            => scl_i_hs
+    );
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  sda_filter_hs : filter
+    generic map
+    (
+      g_cycles           => c_cycles_hs
+    )
+    port map
+    (
+      clk                => clk,
+      s_rst              => s_rst,
+      sig_in             => sda_i_ndeb_2,
+      sig_out            => sda_i_hs
     );
   ------------------------------------------------------------------------------
+
+  scl_i_deb <= scl_i_hs when (hs = '1') else scl_i_fs;
+  sda_i_deb <= sda_i_hs when (hs = '1') else sda_i_fs;
   -- ###########################################################################
   -- # End of debouncing SCL and SDA signals                                   #
   -- ###########################################################################
@@ -197,13 +246,13 @@ begin
   bus_state_inst0 : bus_state
     generic map
     (
-      g_f_clk   => g_f_clk,
-      g_f_scl   => g_f_scl
+      g_f_clk   => g_f_clk
     )
     port map
     (
       clk       => clk,
       s_rst     => s_rst,
+      t_buf     => t_buf,
       busy      => busy,
       scl_d     => scl_d_rx,
       scl       => scl_i_deb,
@@ -213,8 +262,9 @@ begin
 
   scl_rx <= scl_i_deb;
   sda_rx <= sda_i_deb;
-  scl_o  <= scl_tx;
-  sda_o  <= sda_tx;
+  scl_o    <= scl_tx;
+  sda_o    <= sda_tx;
+  scl_pu_o <= scl_pu_tx;
 
 end architecture str;
 --==============================================================================
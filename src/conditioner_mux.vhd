@@ -39,6 +39,9 @@
 
 library ieee;
 use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+use work.iicmb_pkg.all;
 
 
 --==============================================================================
@@ -47,23 +50,7 @@ entity conditioner_mux is
   (
     ------------------------------------
     g_bus_num :       positive range 1 to 16 := 1;          -- Number of separate I2C busses
-    g_f_clk   :       real           := 100000.0;   -- Frequency of 'clk' clock (in kHz)
-    g_f_scl_0 :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #0 (in kHz)
-    g_f_scl_1 :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #1 (in kHz)
-    g_f_scl_2 :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #2 (in kHz)
-    g_f_scl_3 :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #3 (in kHz)
-    g_f_scl_4 :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #4 (in kHz)
-    g_f_scl_5 :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #5 (in kHz)
-    g_f_scl_6 :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #6 (in kHz)
-    g_f_scl_7 :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #7 (in kHz)
-    g_f_scl_8 :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #8 (in kHz)
-    g_f_scl_9 :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #9 (in kHz)
-    g_f_scl_a :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #10 (in kHz)
-    g_f_scl_b :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #11 (in kHz)
-    g_f_scl_c :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #12 (in kHz)
-    g_f_scl_d :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #13 (in kHz)
-    g_f_scl_e :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #14 (in kHz)
-    g_f_scl_f :       real           :=    100.0    -- Frequency of 'SCL' clock of I2C bus #15 (in kHz)
+    g_f_clk   :       real           := 100000.0    -- Frequency of 'clk' clock (in kHz)
     ------------------------------------
   );
   port
@@ -75,6 +62,7 @@ entity conditioner_mux is
     ------------------------------------
     -- Interface to controller:
     bus_id    : in    natural range 0 to g_bus_num - 1;
+    tp        : in    tp_type_array(0 to 15);               -- Timing of I2C buses
     --
     busy      :   out std_logic := '0';                     -- Bus busy indication (busy = high)
     --
@@ -85,13 +73,16 @@ entity conditioner_mux is
     --
     scl_tx    : in    std_logic;                            -- I2C Clock from bit controller
     sda_tx    : in    std_logic;                            -- I2C Data from bit controller
+    scl_pu_tx : in    std_logic;                            -- I2C Clock current-source pull-up from bit controller
+    hs        : in    std_logic;                            -- High-speed mode active on selected bus
     ------------------------------------
     ------------------------------------
     -- I2C interfaces:
     scl_i     : in    std_logic_vector(0 to g_bus_num - 1); -- I2C Clock inputs
     sda_i     : in    std_logic_vector(0 to g_bus_num - 1); -- I2C Data inputs
     scl_o     :   out std_logic_vector(0 to g_bus_num - 1); -- I2C Clock outputs
-    sda_o     :   out std_logic_vector(0 to g_bus_num - 1)  -- I2C Data outputs
+    sda_o     :   out std_logic_vector(0 to g_bus_num - 1); -- I2C Data outputs
+    scl_pu_o  :   out std_logic_vector(0 to g_bus_num - 1)  -- I2C Clock current-source pull-up enables
     ------------------------------------
   );
 end entity conditioner_mux;
@@ -100,23 +91,18 @@ end entity conditioner_mux;
 --==============================================================================
 architecture str of conditioner_mux is
 
-  type real_array is array (natural range <>) of real;
-  constant c_f_scl : real_array(0 to 15) := (g_f_scl_0, g_f_scl_1, g_f_scl_2, g_f_scl_3,
-                                             g_f_scl_4, g_f_scl_5, g_f_scl_6, g_f_scl_7,
-                                             g_f_scl_8, g_f_scl_9, g_f_scl_a, g_f_scl_b,
-                                             g_f_scl_c, g_f_scl_d, g_f_scl_e, g_f_scl_f);
-
   ------------------------------------------------------------------------------
   component conditioner is
     generic
     (
-      g_f_clk   :       real   := 100000.0;
-      g_f_scl   :       real   :=    100.0
+      g_f_clk   :       real   := 100000.0
     );
     port
     (
       clk       : in    std_logic;
       s_rst     : in    std_logic;
+      t_buf     : in    unsigned(15 downto 0);
+      hs        : in    std_logic;
       busy      :   out std_logic;
       scl_rx    :   out std_logic;
       sda_rx    :   out std_logic;
@@ -126,7 +112,9 @@ architecture str of conditioner_mux is
       scl_i     : in    std_logic;
       sda_i     : in    std_logic;
       scl_o     :   out std_logic;
-      sda_o     :   out std_logic
+      sda_o     :   out std_logic;
+      scl_pu_tx : in    std_logic;
+      scl_pu_o  :   out std_logic
     );
   end component conditioner;
   ------------------------------------------------------------------------------
@@ -137,6 +125,8 @@ architecture str of conditioner_mux is
   signal   busy_y        : std_logic_vector(0 to g_bus_num - 1);
   signal   scl_tx_y      : std_logic_vector(0 to g_bus_num - 1) := (others => '1');
   signal   sda_tx_y      : std_logic_vector(0 to g_bus_num - 1) := (others => '1');
+  signal   scl_pu_tx_y   : std_logic_vector(0 to g_bus_num - 1) := (others => '0');
+  signal   hs_y          : std_logic_vector(0 to g_bus_num - 1) := (others => '0');
 
 begin
 
@@ -166,13 +156,14 @@ begin
     conditioner_inst0 : conditioner
       generic map
       (
-        g_f_clk   => g_f_clk,
-        g_f_scl   => c_f_scl(i)
+        g_f_clk   => g_f_clk
       )
       port map
       (
         clk       => clk,
         s_rst     => s_rst,
+        t_buf     => tp(i).buf,
+        hs        => hs_y(i),
         busy      => busy_y(i),
         scl_rx    => scl_rx_y(i),
         sda_rx    => sda_rx_y(i),
@@ -182,7 +173,9 @@ begin
         scl_i     => scl_i(i),
         sda_i     => sda_i(i),
         scl_o     => scl_o(i),
-        sda_o     => sda_o(i)
+        sda_o     => sda_o(i),
+        scl_pu_tx => scl_pu_tx_y(i),
+        scl_pu_o  => scl_pu_o(i)
       );
     ----------------------------------------------------------------------------
 
@@ -191,15 +184,21 @@ begin
     begin
       if rising_edge(clk) then
         if (s_rst = '1') then
-          scl_tx_y(i) <= '1';
-          sda_tx_y(i) <= '1';
+          scl_tx_y(i)    <= '1';
+          sda_tx_y(i)    <= '1';
+          scl_pu_tx_y(i) <= '0';
+          hs_y(i)        <= '0';
         else
           if (i = bus_id) then
-            scl_tx_y(i) <= scl_tx;
-            sda_tx_y(i) <= sda_tx;
+            scl_tx_y(i)    <= scl_tx;
+            sda_tx_y(i)    <= sda_tx;
+            scl_pu_tx_y(i) <= scl_pu_tx;
+            hs_y(i)        <= hs;
           else
-            scl_tx_y(i) <= '1';
-            sda_tx_y(i) <= '1';
+            scl_tx_y(i)    <= '1';
+            sda_tx_y(i)    <= '1';
+            scl_pu_tx_y(i) <= '0';
+            hs_y(i)        <= '0';
           end if;
         end if;
       end if;
@@ -0,0 +1,469 @@
+
+--==============================================================================
+--                                                                             |
+--    Project: IIC Multiple Bus Controller (IICMB)                             |
+--                                                                             |
+--    Module:  DMA controller for Message commands of 'regblock'.              |
+--    Version:                                                                 |
+--             1.0,   October 16, 2026                                         |
+--                                                                             |
+--    Author:  IICMB contributors                                              |
+--                                                                             |
+--==============================================================================
+--==============================================================================
+-- Copyright (c) 2016, Sergey Shuvalkin                                        |
+-- All rights reserved.                                                        |
+--                                                                             |
+-- Redistribution and use in source and binary forms, with or without          |
+-- modification, are permitted provided that the following conditions are met: |
+--                                                                             |
+-- 1. Redistributions of source code must retain the above copyright notice,   |
+--    this list of conditions and the following disclaimer.                    |
+-- 2. Redistributions in binary form must reproduce the above copyright        |
+--    notice, this list of conditions and the following disclaimer in the      |
+--    documentation and/or other materials provided with the distribution.     |
+--                                                                             |
+-- THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" |
+-- AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE   |
+-- IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE  |
+-- ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE    |
+-- LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR         |
+-- CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF        |
+-- SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS    |
+-- INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN     |
+-- CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)     |
+-- ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE  |
+-- POSSIBILITY OF SUCH DAMAGE.                                                 |
+--==============================================================================
+
+
+--------------------------------------------------------------------------------
+-- Implemented registers (common to all engine windows):
+--
+--   0x60  DSRC  Source address of TX data (word aligned)                R/W
+--   0x64  DDST  Destination address of RX data (word aligned)           R/W
+--   0x68  DNXT  Address of next descriptor, 0 ends the chain            R/W
+--   0x6C  DMSG  Message of descriptor:                                  R/W
+--                 7.. 0 : MADR, slave address and R/W
+--                15.. 8 : MLEN
+--                23..16 : MRSW
+--                27..24 : Engine
+--   0x70  DCSR  Control/Status:
+--                 0     : GO (W) / BUSY (R), start chain with DSRC..DMSG
+--                 1     : IE, interrupt at end of chain                  R/W
+--                 2     : DONE, chain ended, write '1' to clear          R/W1C
+--                10.. 8 : Response of last descriptor (see 'mrsp_x')    RO
+--
+--   Each descriptor runs one Message command (see 'regblock') on its engine:
+--   the TX bytes are read from DSRC, the RX bytes written to DDST, both
+--   packed 4 per word, first byte in bits 7..0. The last RX word is written
+--   with byte enables. A descriptor in memory is 4 words at DNXT: DMSG,
+--   DSRC, DDST, DNXT. The chain continues while descriptors complete with
+--   Done and ends on the first not-acknowledge, arbitration lost or error.
+--   The engine must be enabled, have FIFOs and its IE cleared, the DMA
+--   clears its FIFOs and FIFO interrupt enables before each descriptor.
+--   System bus accesses to the engines have priority, the DMA waits.
+--------------------------------------------------------------------------------
+
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+use work.iicmb_pkg.all;
+
+
+--==============================================================================
+entity dma is
+  port
+  (
+    ------------------------------------
+    clk         : in    std_logic;                                -- Clock input
+    s_rst       : in    std_logic;                                -- Synchronous reset (active high)
+    ------------------------------------
+    ------------------------------------
+    -- System bus side:
+    s_eng       : in    std_logic_vector( 3 downto 0);            -- Engine window
+    s_adr       : in    std_logic_vector( 4 downto 0);            -- Word address
+    s_wr        : in    std_logic_vector( 3 downto 0);            -- Write (active high)
+    s_rd        : in    std_logic_vector( 3 downto 0);            -- Read (active high)
+    s_idata     : in    std_logic_vector(31 downto 0);            -- Data from System Bus
+    s_odata     :   out std_logic_vector(31 downto 0);            -- Data to System Bus
+    ------------------------------------
+    ------------------------------------
+    -- Engine side:
+    eng         :   out std_logic_vector( 3 downto 0);            -- Engine window
+    adr         :   out std_logic_vector( 4 downto 0);            -- Word address
+    wr          :   out std_logic_vector( 3 downto 0);            -- Write (active high)
+    rd          :   out std_logic_vector( 3 downto 0);            -- Read (active high)
+    idata       :   out std_logic_vector(31 downto 0);            -- Data to engine
+    odata       : in    std_logic_vector(31 downto 0);            -- Data from engine
+    ------------------------------------
+    ------------------------------------
+    irq         :   out std_logic;                                -- Interrupt request, end of chain
+    ------------------------------------
+    ------------------------------------
+    -- Master interface, request held until acknowledged:
+    m_req       :   out std_logic;                                -- Request
+    m_we        :   out std_logic;                                -- Write enable
+    m_sel       :   out std_logic_vector( 3 downto 0);            -- Byte enables
+    m_adr       :   out std_logic_vector(31 downto 0);            -- Byte address
+    m_wdata     :   out std_logic_vector(31 downto 0);            -- Write data
+    m_rdata     : in    std_logic_vector(31 downto 0);            -- Read data, valid with 'm_ack'
+    m_ack       : in    std_logic                                 -- Acknowledge
+    ------------------------------------
+  );
+end entity dma;
+--==============================================================================
+
+--==============================================================================
+architecture rtl of dma is
+
+  -- Register word addresses:
+  constant c_dsrc    : std_logic_vector(4 downto 0) := "11000";
+  constant c_ddst    : std_logic_vector(4 downto 0) := "11001";
+  constant c_dnxt    : std_logic_vector(4 downto 0) := "11010";
+  constant c_dmsg    : std_logic_vector(4 downto 0) := "11011";
+  constant c_dcsr    : std_logic_vector(4 downto 0) := "11100";
+
+  ------------------------------------------------------------------------------
+  -- Byte lanes 'wr' of 'd' replace the ones of 'q'
+  function set_lanes(q : std_logic_vector(31 downto 0); d : std_logic_vector(31 downto 0);
+                     wr : std_logic_vector(3 downto 0)) return std_logic_vector is
+    variable v_ret : std_logic_vector(31 downto 0);
+  begin
+    v_ret := q;
+    for i in 0 to 3 loop
+      if (wr(i) = '1') then
+        v_ret(8*i + 7 downto 8*i) := d(8*i + 7 downto 8*i);
+      end if;
+    end loop;
+    return v_ret;
+  end function set_lanes;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  -- Byte 'i' of a word
+  function get_byte(a : std_logic_vector(31 downto 0); i : natural) return std_logic_vector is
+  begin
+    case i is
+      when 0      => return a( 7 downto  0);
+      when 1      => return a(15 downto  8);
+      when 2      => return a(23 downto 16);
+      when others => return a(31 downto 24);
+    end case;
+  end function get_byte;
+  ------------------------------------------------------------------------------
+
+  type state_type is (s_idle, s_desc, s_clr, s_msg, s_lvl, s_pop, s_push, s_cmd, s_sts, s_mrd, s_mwr, s_end);
+  signal   state     : state_type                        := s_idle;
+
+  -- Registers:
+  signal   dsrc      : std_logic_vector(31 downto 0)     := (others => '0');
+  signal   ddst      : std_logic_vector(31 downto 0)     := (others => '0');
+  signal   dnxt      : std_logic_vector(31 downto 0)     := (others => '0');
+  signal   dmsg      : std_logic_vector(31 downto 0)     := (others => '0');
+  signal   ie_reg    : std_logic                         := '0';
+  signal   done_reg  : std_logic                         := '0';
+  signal   status    : std_logic_vector( 2 downto 0)     := mrsp_done;
+  signal   busy_y    : std_logic                         := '0';
+
+  -- Transfer of a descriptor:
+  signal   dcnt      : integer range 0 to 3              := 0;
+  signal   tx_left   : integer range 0 to 255            := 0;
+  signal   tx_idx    : integer range 0 to 3              := 0;
+  signal   tx_word   : std_logic_vector(31 downto 0)     := (others => '0');
+  signal   rx_idx    : integer range 0 to 3              := 0;
+  signal   rx_word   : std_logic_vector(31 downto 0)     := (others => '0');
+  signal   rx_sel    : std_logic_vector( 3 downto 0)     := (others => '0');
+  signal   issued    : std_logic                         := '0';
+  signal   fin       : std_logic                         := '0';
+
+  -- Register access of the DMA, granted without system bus access:
+  signal   s_act     : std_logic;
+  signal   s_win     : std_logic;
+  signal   d_adr     : std_logic_vector( 4 downto 0);
+  signal   d_wr      : std_logic_vector( 3 downto 0);
+  signal   d_rd      : std_logic_vector( 3 downto 0);
+  signal   d_idata   : std_logic_vector(31 downto 0);
+  signal   grant     : std_logic;
+
+begin
+
+  s_act   <= '1' when (s_wr /= "0000")or(s_rd /= "0000") else '0';
+  s_win   <= '1' when (s_adr(4 downto 3) = "11") else '0';
+  grant   <= not(s_act);
+
+  ------------------------------------------------------------------------------
+  -- Register access of current state
+  d_adr   <= "00001" when (state = s_lvl) else
+             "00010" when (state = s_clr) else
+             "00011" when (state = s_msg) else
+             "00000";
+  d_wr    <= "1000"  when (state = s_clr) else
+             "0111"  when (state = s_msg) else
+             "0010"  when (state = s_push) else
+             "0100"  when (state = s_cmd) else
+             "0000";
+  d_rd    <= "0010"  when (state = s_pop) else "0000";
+  d_idata <= x"C0000000"                                   when (state = s_clr) else
+             x"00" & dmsg(23 downto 0)                     when (state = s_msg) else
+             x"0000" & get_byte(tx_word, tx_idx) & x"00"   when (state = s_push) else
+             x"00" & "00000" & mcmd_msg & x"0000";
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  -- Engine access: system bus, or DMA while busy
+  eng     <= s_eng   when (s_act = '1')or(busy_y = '0') else dmsg(27 downto 24);
+  adr     <= s_adr   when (s_act = '1')or(busy_y = '0') else d_adr;
+  idata   <= s_idata when (s_act = '1')or(busy_y = '0') else d_idata;
+  wr      <= "0000"  when (s_act = '1')and(s_win = '1') else
+             s_wr    when (s_act = '1')or(busy_y = '0') else d_wr;
+  rd      <= "0000"  when (s_act = '1')and(s_win = '1') else
+             s_rd    when (s_act = '1')or(busy_y = '0') else d_rd;
+
+  s_odata <= dsrc when (s_adr = c_dsrc) else
+             ddst when (s_adr = c_ddst) else
+             dnxt when (s_adr = c_dnxt) else
+             dmsg when (s_adr = c_dmsg) else
+             x"00000" & '0' & status & "00000" & done_reg & ie_reg & busy_y when (s_adr = c_dcsr) else
+             odata;
+
+  irq     <= done_reg and ie_reg;
+
+  m_adr   <= std_logic_vector(unsigned(dnxt) + to_unsigned(4*dcnt, 32)) when (state = s_desc) else
+             ddst when (state = s_mwr) else
+             dsrc;
+  m_req   <= '1' when (state = s_desc)or(state = s_mrd)or(state = s_mwr) else '0';
+  m_we    <= '1' when (state = s_mwr) else '0';
+  m_sel   <= rx_sel when (state = s_mwr) else "1111";
+  m_wdata <= rx_word;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  state_proc:
+  process(clk)
+  begin
+    if rising_edge(clk) then
+      if (s_rst = '1') then
+        state    <= s_idle;
+        dsrc     <= (others => '0');
+        ddst     <= (others => '0');
+        dnxt     <= (others => '0');
+        dmsg     <= (others => '0');
+        ie_reg   <= '0';
+        done_reg <= '0';
+        status   <= mrsp_done;
+        busy_y   <= '0';
+        dcnt     <= 0;
+        tx_left  <= 0;
+        tx_idx   <= 0;
+        tx_word  <= (others => '0');
+        rx_idx   <= 0;
+        rx_word  <= (others => '0');
+        rx_sel   <= (others => '0');
+        issued   <= '0';
+        fin      <= '0';
+      else
+        -- System bus access of registers:
+        if (s_adr = c_dcsr) then
+          if (s_wr(0) = '1') then
+            ie_reg <= s_idata(1);
+            if (s_idata(2) = '1') then
+              done_reg <= '0';
+            end if;
+          end if;
+        end if;
+        if (busy_y = '0') then
+          if (s_adr = c_dsrc) then dsrc <= set_lanes(dsrc, s_idata, s_wr); end if;
+          if (s_adr = c_ddst) then ddst <= set_lanes(ddst, s_idata, s_wr); end if;
+          if (s_adr = c_dnxt) then dnxt <= set_lanes(dnxt, s_idata, s_wr); end if;
+          if (s_adr = c_dmsg) then dmsg <= set_lanes(dmsg, s_idata, s_wr); end if;
+        end if;
+
+        -- FSM:
+        case state is
+          -------------- 's_idle' state ------------------------
+          when s_idle   =>
+            busy_y   <= '0';
+            if (s_adr = c_dcsr)and(s_wr(0) = '1')and(s_idata(0) = '1') then
+              state    <= s_clr;
+              busy_y   <= '1';
+              done_reg <= '0';
+            end if;
+          -------------- 's_idle' state ------------------------
+
+          -------------- 's_desc' state ------------------------
+          -- Fetch descriptor from 'dnxt'
+          when s_desc   =>
+            if (m_ack = '1') then
+              case dcnt is
+                when 0      => dmsg <= m_rdata;
+                when 1      => dsrc <= m_rdata;
+                when 2      => ddst <= m_rdata;
+                when others => dnxt <= m_rdata;
+              end case;
+              if (dcnt = 3) then
+                state    <= s_clr;
+                dcnt     <= 0;
+              else
+                dcnt     <= dcnt + 1;
+              end if;
+            end if;
+          -------------- 's_desc' state ------------------------
+
+          -------------- 's_clr' state -------------------------
+          -- Clear FIFOs of engine
+          when s_clr    =>
+            if (grant = '1') then
+              state    <= s_msg;
+            end if;
+          -------------- 's_clr' state -------------------------
+
+          -------------- 's_msg' state -------------------------
+          -- Write MADR, MLEN, MRSW of engine
+          when s_msg    =>
+            if (grant = '1') then
+              state    <= s_lvl;
+              tx_idx   <= 0;
+              rx_idx   <= 0;
+              rx_sel   <= (others => '0');
+              issued   <= '0';
+              fin      <= '0';
+              status   <= mrsp_done;
+              if (dmsg(0) = '0') then
+                tx_left  <= to_integer(unsigned(dmsg(15 downto 8)));
+              else
+                tx_left  <= to_integer(unsigned(dmsg(23 downto 16)));
+              end if;
+            end if;
+          -------------- 's_msg' state -------------------------
+
+          -------------- 's_lvl' state -------------------------
+          -- FIFO levels of engine select next action
+          when s_lvl    =>
+            if (grant = '1') then
+              if (odata(15 downto 8) /= x"00") then
+                state    <= s_pop;
+              elsif (fin = '1') then
+                state    <= s_end;
+              elsif (tx_left /= 0)and(unsigned(odata(7 downto 0)) < unsigned(odata(31 downto 24))) then
+                if (tx_idx = 0) then
+                  state    <= s_mrd;
+                else
+                  state    <= s_push;
+                end if;
+              elsif (issued = '0') then
+                state    <= s_cmd;
+              else
+                state    <= s_sts;
+              end if;
+            end if;
+          -------------- 's_lvl' state -------------------------
+
+          -------------- 's_pop' state -------------------------
+          when s_pop    =>
+            if (grant = '1') then
+              case rx_idx is
+                when 0      => rx_word( 7 downto  0) <= odata(15 downto 8);
+                when 1      => rx_word(15 downto  8) <= odata(15 downto 8);
+                when 2      => rx_word(23 downto 16) <= odata(15 downto 8);
+                when others => rx_word(31 downto 24) <= odata(15 downto 8);
+              end case;
+              rx_sel(rx_idx) <= '1';
+              if (rx_idx = 3) then
+                state    <= s_mwr;
+                rx_idx   <= 0;
+              else
+                state    <= s_lvl;
+                rx_idx   <= rx_idx + 1;
+              end if;
+            end if;
+          -------------- 's_pop' state -------------------------
+
+          -------------- 's_push' state ------------------------
+          when s_push   =>
+            if (grant = '1') then
+              state    <= s_lvl;
+              tx_left  <= tx_left - 1;
+              if (tx_idx = 3) then
+                tx_idx   <= 0;
+              else
+                tx_idx   <= tx_idx + 1;
+              end if;
+            end if;
+          -------------- 's_push' state ------------------------
+
+          -------------- 's_cmd' state -------------------------
+          -- Start Message command, TX FIFO is full or holds all bytes
+          when s_cmd    =>
+            if (grant = '1') then
+              state    <= s_lvl;
+              issued   <= '1';
+            end if;
+          -------------- 's_cmd' state -------------------------
+
+          -------------- 's_sts' state -------------------------
+          -- Command status of engine
+          when s_sts    =>
+            if (grant = '1') then
+              state    <= s_lvl;
+              if (odata(23 downto 20) /= "0000") then
+                fin      <= '1';
+                if (odata(22) = '1') then
+                  status   <= mrsp_nak;
+                elsif (odata(21) = '1') then
+                  status   <= mrsp_arb_lost;
+                elsif (odata(20) = '1') then
+                  status   <= mrsp_error;
+                else
+                  status   <= mrsp_done;
+                end if;
+              end if;
+            end if;
+          -------------- 's_sts' state -------------------------
+
+          -------------- 's_mrd' state -------------------------
+          -- Read next TX word
+          when s_mrd    =>
+            if (m_ack = '1') then
+              state    <= s_push;
+              tx_word  <= m_rdata;
+              dsrc     <= std_logic_vector(unsigned(dsrc) + 4);
+            end if;
+          -------------- 's_mrd' state -------------------------
+
+          -------------- 's_mwr' state -------------------------
+          -- Write RX word
+          when s_mwr    =>
+            if (m_ack = '1') then
+              ddst     <= std_logic_vector(unsigned(ddst) + 4);
+              rx_sel   <= (others => '0');
+              -- RX FIFO is drained in 's_lvl' before 'fin' ends the message
+              state    <= s_lvl;
+            end if;
+          -------------- 's_mwr' state -------------------------
+
+          -------------- 's_end' state -------------------------
+          when s_end    =>
+            if (rx_sel /= "0000") then
+              -- Last partial RX word:
+              state    <= s_mwr;
+              rx_idx   <= 0;
+            elsif (status = mrsp_done)and(dnxt /= x"00000000") then
+              state    <= s_desc;
+              dcnt     <= 0;
+            else
+              state    <= s_idle;
+              busy_y   <= '0';
+              done_reg <= '1';
+            end if;
+          -------------- 's_end' state -------------------------
+        end case;
+      end if;
+    end if;
+  end process state_proc;
+  ------------------------------------------------------------------------------
+
+end architecture rtl;
+--==============================================================================
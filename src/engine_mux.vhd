@@ -0,0 +1,517 @@
+
+--==============================================================================
+--                                                                             |
+--    Project: IIC Multiple Bus Controller (IICMB)                             |
+--                                                                             |
+--    Module:  Multiplexer of IICMB engines.                                   |
+--    Version:                                                                 |
+--             1.0,   October 16, 2026                                         |
+--                                                                             |
+--    Author:  IICMB contributors                                              |
+--                                                                             |
+--==============================================================================
+--==============================================================================
+-- Copyright (c) 2016, Sergey Shuvalkin                                        |
+-- All rights reserved.                                                        |
+--                                                                             |
+-- Redistribution and use in source and binary forms, with or without          |
+-- modification, are permitted provided that the following conditions are met: |
+--                                                                             |
+-- 1. Redistributions of source code must retain the above copyright notice,   |
+--    this list of conditions and the following disclaimer.                    |
+-- 2. Redistributions in binary form must reproduce the above copyright        |
+--    notice, this list of conditions and the following disclaimer in the      |
+--    documentation and/or other materials provided with the distribution.     |
+--                                                                             |
+-- THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" |
+-- AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE   |
+-- IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE  |
+-- ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE    |
+-- LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR         |
+-- CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF        |
+-- SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS    |
+-- INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN     |
+-- CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)     |
+-- ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE  |
+-- POSSIBILITY OF SUCH DAMAGE.                                                 |
+--==============================================================================
+
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+use work.iicmb_pkg.all;
+
+
+--==============================================================================
+-- Each engine is a register block with its own byte and bit controller and
+-- serves a contiguous subset of the I2C buses, so transfers on buses of
+-- different engines run concurrently. Engine 'e' serves the buses
+-- e*g_bus_num/g_engines .. (e+1)*g_bus_num/g_engines-1, its local bus IDs
+-- (CSR, Set Bus command, TSEL) start at 0. 'eng' selects the register window
+-- of an engine, every engine has its own interrupt request.
+--
+-- With 'g_poll_depth' > 0 a 'poller' reads slave registers in the
+-- background, its table and shadow memory are accessed through the 'pl_x'
+-- ports (see 'poller'). The poller borrows the byte level interface of the
+-- engine serving the bus of a poll as soon as the register block has no
+-- command in flight and does not hold the bus captured. A command written by
+-- the register block meanwhile is held and passed on when the poll is done.
+--==============================================================================
+entity engine_mux is
+  generic
+  (
+    ------------------------------------
+    g_bus_num     :       positive range 1 to 16 := 1;          -- Number of separate I2C buses
+    g_engines     :       positive range 1 to 16 := 1;          -- Number of engines (1 to 'g_bus_num')
+    g_fifo_depth  :       natural range 0 to 255 := 0;          -- Depth of TX/RX FIFOs of each register block (0: no FIFOs)
+    g_trace_depth :       natural range 0 to 12  := 0;          -- log2 of bus trace RAM entries of each register block (0: no bus trace)
+    g_poll_depth  :       natural range 0 to 127 := 0;          -- Number of poll table entries (0: no poller)
+    g_f_clk       :       real                   := 100000.0;   -- Frequency of 'clk' clock (in kHz)
+    g_tp          :       tp_type_array(0 to 15) := get_tp(100000.0, (others => 100.0)); -- Reset timing of I2C buses
+    g_tp_hs       :       tp_type                := get_tp(100000.0, 3400.0)            -- Reset timing of High-speed mode
+    ------------------------------------
+  );
+  port
+  (
+    ------------------------------------
+    clk          : in    std_logic;                            -- Clock
+    s_rst        : in    std_logic;                            -- Synchronous reset (active high)
+    ------------------------------------
+    ------------------------------------
+    -- Register access:
+    eng          : in    std_logic_vector( 3 downto 0);        -- Engine of register access
+    adr          : in    std_logic_vector( 4 downto 0);        -- Word address
+    wr           : in    std_logic_vector( 3 downto 0);        -- Write (active high)
+    rd           : in    std_logic_vector( 3 downto 0);        -- Read (active high)
+    idata        : in    std_logic_vector(31 downto 0);        -- Data from System Bus
+    odata        :   out std_logic_vector(31 downto 0);        -- Data to System Bus
+    ------------------------------------
+    ------------------------------------
+    -- Poll table and shadow memory access:
+    pl_adr       : in    std_logic_vector( 8 downto 0) := (others => '0'); -- Word address
+    pl_wr        : in    std_logic_vector( 3 downto 0) := "0000";          -- Write (active high)
+    pl_idata     : in    std_logic_vector(31 downto 0) := (others => '0'); -- Data from System Bus
+    pl_odata     :   out std_logic_vector(31 downto 0);        -- Data to System Bus
+    ------------------------------------
+    ------------------------------------
+    -- Interrupt requests:
+    irq          :   out std_logic_vector(0 to g_engines - 1); -- Interrupt request per engine
+    ------------------------------------
+    ------------------------------------
+    -- I2C interfaces:
+    scl_i        : in    std_logic_vector(0 to g_bus_num - 1); -- I2C Clock inputs
+    sda_i        : in    std_logic_vector(0 to g_bus_num - 1); -- I2C Data inputs
+    scl_o        :   out std_logic_vector(0 to g_bus_num - 1); -- I2C Clock outputs
+    sda_o        :   out std_logic_vector(0 to g_bus_num - 1); -- I2C Data outputs
+    scl_pu_o     :   out std_logic_vector(0 to g_bus_num - 1)  -- I2C Clock current-source pull-up enables (High-speed mode)
+    ------------------------------------
+  );
+end entity engine_mux;
+--==============================================================================
+
+--==============================================================================
+architecture str of engine_mux is
+
+  ------------------------------------------------------------------------------
+  component regblock is
+    generic
+    (
+      g_bus_num     : positive range 1 to 16 := 1;
+      g_fifo_depth  : natural range 0 to 255 := 0;
+      g_trace_depth : natural range 0 to 12  := 0;
+      g_tp          : tp_type_array(0 to 15) := get_tp(100000.0, (others => 100.0));
+      g_tp_hs       : tp_type                := get_tp(100000.0, 3400.0)
+    );
+    port
+    (
+      clk         : in    std_logic;
+      s_rst       : in    std_logic;
+      adr         : in    std_logic_vector( 4 downto 0) := "00000";
+      wr          : in    std_logic_vector( 3 downto 0);
+      rd          : in    std_logic_vector( 3 downto 0);
+      idata       : in    std_logic_vector(31 downto 0);
+      odata       :   out std_logic_vector(31 downto 0);
+      irq         :   out std_logic;
+      busy        : in    std_logic;
+      captured    : in    std_logic;
+      bus_id      : in    std_logic_vector( 3 downto 0);
+      bit_state   : in    std_logic_vector( 3 downto 0);
+      byte_state  : in    std_logic_vector( 3 downto 0);
+      disable     :   out std_logic;
+      tp          :   out tp_type_array(0 to 15);
+      tp_hs       :   out tp_type;
+      hs_en       :   out std_logic;
+      hs_code     :   out std_logic_vector( 2 downto 0);
+      hs          : in    std_logic;
+      mcmd_wr     :   out std_logic;
+      mcmd_id     :   out std_logic_vector( 2 downto 0);
+      mcmd_data   :   out std_logic_vector( 7 downto 0);
+      mrsp_wr     : in    std_logic;
+      mrsp_id     : in    std_logic_vector( 2 downto 0);
+      mrsp_data   : in    std_logic_vector( 7 downto 0)
+    );
+  end component regblock;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  component iicmb_m is
+    generic
+    (
+      g_bus_num   :       positive range 1 to 16 := 1;
+      g_f_clk     :       real                   := 100000.0
+    );
+    port
+    (
+      clk         : in    std_logic;
+      s_rst       : in    std_logic;
+      busy        :   out std_logic;
+      captured    :   out std_logic;
+      bus_id      :   out std_logic_vector(3 downto 0);
+      bit_state   :   out std_logic_vector(3 downto 0);
+      byte_state  :   out std_logic_vector(3 downto 0);
+      hs          :   out std_logic;
+      tp          : in    tp_type_array(0 to 15);
+      tp_hs       : in    tp_type;
+      hs_en       : in    std_logic;
+      hs_code     : in    std_logic_vector(2 downto 0);
+      mcmd_wr     : in    std_logic;
+      mcmd_id     : in    std_logic_vector(2 downto 0);
+      mcmd_data   : in    std_logic_vector(7 downto 0);
+      mrsp_wr     :   out std_logic;
+      mrsp_id     :   out std_logic_vector(2 downto 0);
+      mrsp_data   :   out std_logic_vector(7 downto 0);
+      scl_i       : in    std_logic_vector(0 to g_bus_num - 1);
+      sda_i       : in    std_logic_vector(0 to g_bus_num - 1);
+      scl_o       :   out std_logic_vector(0 to g_bus_num - 1);
+      sda_o       :   out std_logic_vector(0 to g_bus_num - 1);
+      scl_pu_o    :   out std_logic_vector(0 to g_bus_num - 1)
+    );
+  end component iicmb_m;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  component poller is
+    generic
+    (
+      g_bus_num   :       positive range 1 to 16  := 1;
+      g_entries   :       positive range 1 to 127 := 8;
+      g_f_clk     :       real                    := 100000.0
+    );
+    port
+    (
+      clk         : in    std_logic;
+      s_rst       : in    std_logic;
+      adr         : in    std_logic_vector( 8 downto 0);
+      wr          : in    std_logic_vector( 3 downto 0);
+      idata       : in    std_logic_vector(31 downto 0);
+      odata       :   out std_logic_vector(31 downto 0);
+      pl_req      :   out std_logic;
+      pl_bus      :   out std_logic_vector(3 downto 0);
+      pl_gnt      : in    std_logic;
+      bus_id      : in    std_logic_vector(3 downto 0);
+      mcmd_wr     :   out std_logic;
+      mcmd_id     :   out std_logic_vector(2 downto 0);
+      mcmd_data   :   out std_logic_vector(7 downto 0);
+      mrsp_wr     : in    std_logic;
+      mrsp_id     : in    std_logic_vector(2 downto 0);
+      mrsp_data   : in    std_logic_vector(7 downto 0)
+    );
+  end component poller;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  -- First I2C bus of engine 'a_eng'
+  function get_first_bus(a_eng : natural) return natural is
+  begin
+    return (a_eng*g_bus_num)/g_engines;
+  end function get_first_bus;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  -- Timing of the I2C buses of an engine, starting with its first bus
+  function get_tp_eng(a_tp : tp_type_array(0 to 15); a_first : natural) return tp_type_array is
+    variable ret : tp_type_array(0 to 15);
+  begin
+    for i in ret'range loop
+      ret(i) := a_tp((a_first + i) mod 16);
+    end loop;
+    return ret;
+  end function get_tp_eng;
+  ------------------------------------------------------------------------------
+
+  type odata_array is array (natural range <>) of std_logic_vector(31 downto 0);
+  type nibble_array is array (natural range <>) of std_logic_vector( 3 downto 0);
+  type rsp_array   is array (natural range <>) of std_logic_vector(10 downto 0);
+
+  signal   odata_y       : odata_array(0 to g_engines - 1);
+
+  -- Poller and its byte level interface:
+  signal   pl_req        : std_logic;
+  signal   pl_bus        : std_logic_vector( 3 downto 0);
+  signal   pl_gnt        : std_logic;
+  signal   pl_bus_id     : std_logic_vector( 3 downto 0);
+  signal   pl_mcmd_wr    : std_logic;
+  signal   pl_mcmd_id    : std_logic_vector( 2 downto 0);
+  signal   pl_mcmd_data  : std_logic_vector( 7 downto 0);
+  signal   pl_mrsp_wr    : std_logic;
+  signal   pl_mrsp_id    : std_logic_vector( 2 downto 0);
+  signal   pl_mrsp_data  : std_logic_vector( 7 downto 0);
+  signal   own           : std_logic_vector(0 to g_engines - 1);
+  signal   own_rsp       : std_logic_vector(0 to g_engines - 1);
+  signal   own_bus       : nibble_array(0 to g_engines - 1);
+  signal   own_mrsp      : rsp_array(0 to g_engines - 1);
+
+begin
+
+  assert (g_engines <= g_bus_num)
+    report "engine_mux: g_engines exceeds g_bus_num"
+    severity failure;
+
+  odata <= odata_y(to_integer(unsigned(eng))) when (to_integer(unsigned(eng)) < g_engines) else (others => '0');
+
+  --****************************************************************************
+  pl_gen : if g_poll_depth > 0 generate
+    poller_inst0 : poller
+      generic map
+      (
+        g_bus_num   => g_bus_num,
+        g_entries   => g_poll_depth,
+        g_f_clk     => g_f_clk
+      )
+      port map
+      (
+        clk         => clk,
+        s_rst       => s_rst,
+        adr         => pl_adr,
+        wr          => pl_wr,
+        idata       => pl_idata,
+        odata       => pl_odata,
+        pl_req      => pl_req,
+        pl_bus      => pl_bus,
+        pl_gnt      => pl_gnt,
+        bus_id      => pl_bus_id,
+        mcmd_wr     => pl_mcmd_wr,
+        mcmd_id     => pl_mcmd_id,
+        mcmd_data   => pl_mcmd_data,
+        mrsp_wr     => pl_mrsp_wr,
+        mrsp_id     => pl_mrsp_id,
+        mrsp_data   => pl_mrsp_data
+      );
+  end generate pl_gen;
+
+  no_pl_gen : if g_poll_depth = 0 generate
+    pl_odata     <= (others => '0');
+    pl_req       <= '0';
+    pl_bus       <= (others => '0');
+    pl_mcmd_wr   <= '0';
+    pl_mcmd_id   <= "000";
+    pl_mcmd_data <= "00000000";
+  end generate no_pl_gen;
+
+  ------------------------------------------------------------------------------
+  -- Grant, selected bus and responses of the engine serving the poller
+  pl_proc:
+  process(own, own_rsp, own_bus, own_mrsp)
+    variable v_gnt  : std_logic;
+    variable v_wr   : std_logic;
+    variable v_bus  : std_logic_vector( 3 downto 0);
+    variable v_mrsp : std_logic_vector(10 downto 0);
+  begin
+    v_gnt  := '0';
+    v_wr   := '0';
+    v_bus  := (others => '0');
+    v_mrsp := (others => '0');
+    for i in 0 to g_engines - 1 loop
+      if (own(i) = '1') then
+        v_gnt  := '1';
+        v_wr   := own_rsp(i);
+        v_bus  := own_bus(i);
+        v_mrsp := own_mrsp(i);
+      end if;
+    end loop;
+    pl_gnt       <= v_gnt;
+    pl_bus_id    <= v_bus;
+    pl_mrsp_wr   <= v_wr;
+    pl_mrsp_id   <= v_mrsp(10 downto 8);
+    pl_mrsp_data <= v_mrsp( 7 downto 0);
+  end process pl_proc;
+  ------------------------------------------------------------------------------
+  --****************************************************************************
+
+  --****************************************************************************
+  eng_gen:
+  for i in 0 to g_engines - 1 generate
+    constant c_first     : natural  := get_first_bus(i);
+    constant c_last      : natural  := get_first_bus(i + 1) - 1;
+    signal   wr_y        : std_logic_vector( 3 downto 0);
+    signal   rd_y        : std_logic_vector( 3 downto 0);
+    signal   busy        : std_logic;
+    signal   captured    : std_logic;
+    signal   bus_id      : std_logic_vector( 3 downto 0);
+    signal   bit_state   : std_logic_vector( 3 downto 0);
+    signal   byte_state  : std_logic_vector( 3 downto 0);
+    signal   disable     : std_logic; -- used as synchronous reset for 'iicmb_m'
+    signal   tp          : tp_type_array(0 to 15);
+    signal   tp_hs       : tp_type;
+    signal   hs_en       : std_logic;
+    signal   hs_code     : std_logic_vector( 2 downto 0);
+    signal   hs          : std_logic;
+    signal   mcmd_wr     : std_logic;
+    signal   mcmd_id     : std_logic_vector( 2 downto 0);
+    signal   mcmd_data   : std_logic_vector( 7 downto 0);
+    signal   mrsp_wr     : std_logic;
+    signal   mrsp_id     : std_logic_vector( 2 downto 0);
+    signal   mrsp_data   : std_logic_vector( 7 downto 0);
+    -- Register block side of the byte level interface:
+    signal   rb_hs_en    : std_logic;
+    signal   rb_cmd_wr   : std_logic;
+    signal   rb_cmd_id   : std_logic_vector( 2 downto 0);
+    signal   rb_cmd_data : std_logic_vector( 7 downto 0);
+    signal   rb_rsp_wr   : std_logic;
+    signal   rb_act      : std_logic                     := '0'; -- command of register block in flight
+    signal   hold_v      : std_logic                     := '0'; -- command of register block held
+    signal   hold_id     : std_logic_vector( 2 downto 0) := (others => '0');
+    signal   hold_data   : std_logic_vector( 7 downto 0) := (others => '0');
+    signal   own_y       : std_logic                     := '0'; -- byte level interface owned by poller
+    signal   pl_sel      : std_logic;
+    signal   pl_data     : std_logic_vector( 7 downto 0);
+  begin
+
+    wr_y <= wr when (to_integer(unsigned(eng)) = i) else (others => '0');
+    rd_y <= rd when (to_integer(unsigned(eng)) = i) else (others => '0');
+
+    ----------------------------------------------------------------------------
+    regblock_inst0 : regblock
+      generic map
+      (
+        g_bus_num     => c_last - c_first + 1,
+        g_fifo_depth  => g_fifo_depth,
+        g_trace_depth => g_trace_depth,
+        g_tp          => get_tp_eng(g_tp, c_first),
+        g_tp_hs       => g_tp_hs
+      )
+      port map
+      (
+        clk         => clk,
+        s_rst       => s_rst,
+        adr         => adr,
+        wr          => wr_y,
+        rd          => rd_y,
+        idata       => idata,
+        odata       => odata_y(i),
+        irq         => irq(i),
+        busy        => busy,
+        captured    => captured,
+        bus_id      => bus_id,
+        bit_state   => bit_state,
+        byte_state  => byte_state,
+        disable     => disable,
+        tp          => tp,
+        tp_hs       => tp_hs,
+        hs_en       => rb_hs_en,
+        hs_code     => hs_code,
+        hs          => hs,
+        mcmd_wr     => rb_cmd_wr,
+        mcmd_id     => rb_cmd_id,
+        mcmd_data   => rb_cmd_data,
+        mrsp_wr     => rb_rsp_wr,
+        mrsp_id     => mrsp_id,
+        mrsp_data   => mrsp_data
+      );
+    ----------------------------------------------------------------------------
+
+    ----------------------------------------------------------------------------
+    -- Byte level interface shared by register block and poller
+    pl_sel     <= '1' when (to_integer(unsigned(pl_bus)) >= c_first)and(to_integer(unsigned(pl_bus)) <= c_last) else '0';
+    -- Set Bus of poller with global bus ID:
+    pl_data    <= std_logic_vector(unsigned(pl_mcmd_data) - c_first) when (pl_mcmd_id = mcmd_set_bus) else pl_mcmd_data;
+
+    mcmd_wr    <= pl_mcmd_wr when (own_y = '1') else rb_cmd_wr or hold_v;
+    mcmd_id    <= pl_mcmd_id when (own_y = '1') else hold_id   when (hold_v = '1') else rb_cmd_id;
+    mcmd_data  <= pl_data    when (own_y = '1') else hold_data when (hold_v = '1') else rb_cmd_data;
+    rb_rsp_wr  <= mrsp_wr and not(own_y);
+    hs_en      <= rb_hs_en and not(own_y);
+
+    own(i)      <= own_y;
+    own_rsp(i)  <= mrsp_wr;
+    own_bus(i)  <= std_logic_vector(unsigned(bus_id) + c_first);
+    own_mrsp(i) <= mrsp_id & mrsp_data;
+
+    own_proc:
+    process(clk)
+    begin
+      if rising_edge(clk) then
+        if (s_rst = '1')or(disable = '1') then
+          rb_act    <= '0';
+          hold_v    <= '0';
+          own_y     <= '0';
+        else
+          if (rb_cmd_wr = '1') then
+            rb_act    <= '1';
+          elsif (mrsp_wr = '1')and(own_y = '0') then
+            rb_act    <= '0';
+          end if;
+          if (own_y = '1') then
+            if (rb_cmd_wr = '1') then
+              hold_v    <= '1';
+              hold_id   <= rb_cmd_id;
+              hold_data <= rb_cmd_data;
+            end if;
+            if (pl_req = '0') then
+              own_y     <= '0';
+            end if;
+          else
+            -- Held command is passed on in this cycle:
+            hold_v    <= '0';
+            if (pl_req = '1')and(pl_sel = '1')and(rb_act = '0')and(rb_cmd_wr = '0')and(captured = '0') then
+              own_y     <= '1';
+            end if;
+          end if;
+        end if;
+      end if;
+    end process own_proc;
+    ----------------------------------------------------------------------------
+
+    ----------------------------------------------------------------------------
+    iicmb_m_inst0 : iicmb_m
+      generic map
+      (
+        g_bus_num   => c_last - c_first + 1,
+        g_f_clk     => g_f_clk
+      )
+      port map
+      (
+        clk         => clk,
+        s_rst       => disable,
+        busy        => busy,
+        captured    => captured,
+        bus_id      => bus_id,
+        bit_state   => bit_state,
+        byte_state  => byte_state,
+        hs          => hs,
+        tp          => tp,
+        tp_hs       => tp_hs,
+        hs_en       => hs_en,
+        hs_code     => hs_code,
+        mcmd_wr     => mcmd_wr,
+        mcmd_id     => mcmd_id,
+        mcmd_data   => mcmd_data,
+        mrsp_wr     => mrsp_wr,
+        mrsp_id     => mrsp_id,
+        mrsp_data   => mrsp_data,
+        scl_i       => scl_i(c_first to c_last),
+        sda_i       => sda_i(c_first to c_last),
+        scl_o       => scl_o(c_first to c_last),
+        sda_o       => sda_o(c_first to c_last),
+        scl_pu_o    => scl_pu_o(c_first to c_last)
+      );
+    ----------------------------------------------------------------------------
+
+  end generate eng_gen;
+  --****************************************************************************
+
+end architecture str;
+--==============================================================================
+
@@ -67,7 +67,8 @@ entity iicmb_m is
     g_f_scl_c   :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #12 (in kHz)
     g_f_scl_d   :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #13 (in kHz)
     g_f_scl_e   :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #14 (in kHz)
-    g_f_scl_f   :       real                   :=    100.0    -- Frequency of 'SCL' clock of I2C bus #15 (in kHz)
+    g_f_scl_f   :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #15 (in kHz)
+    g_f_scl_hs  :       real                   :=   3400.0    -- Frequency of 'SCL' clock in High-speed mode (in kHz)
     ------------------------------------
   );
   port
@@ -83,6 +84,20 @@ entity iicmb_m is
     bus_id      :   out std_logic_vector(3 downto 0);         -- ID of selected I2C bus
     bit_state   :   out std_logic_vector(3 downto 0);         -- State of bit level FSM
     byte_state  :   out std_logic_vector(3 downto 0);         -- State of byte level FSM
+    hs          :   out std_logic;                            -- High-speed mode status
+    ------------------------------------
+    ------------------------------------
+    -- Timing of I2C buses, loaded at runtime by register block (default: 'g_f_scl_x'):
+    tp          : in    tp_type_array(0 to 15) := get_tp(g_f_clk, real_array'(g_f_scl_0, g_f_scl_1, g_f_scl_2, g_f_scl_3,
+                                                                           g_f_scl_4, g_f_scl_5, g_f_scl_6, g_f_scl_7,
+                                                                           g_f_scl_8, g_f_scl_9, g_f_scl_a, g_f_scl_b,
+                                                                           g_f_scl_c, g_f_scl_d, g_f_scl_e, g_f_scl_f));
+    tp_hs       : in    tp_type                := get_tp(g_f_clk, g_f_scl_hs);
+    ------------------------------------
+    ------------------------------------
+    -- High-speed mode, entered by next Start with master code '00001XXX':
+    hs_en       : in    std_logic                    := '0';  -- Start enters High-speed mode
+    hs_code     : in    std_logic_vector(2 downto 0) := "000"; -- Master code 'XXX'
     ------------------------------------
     ------------------------------------
     -- 'Generic interface' signals:
@@ -99,7 +114,8 @@ entity iicmb_m is
     scl_i       : in    std_logic_vector(0 to g_bus_num - 1); -- I2C Clock inputs
     sda_i       : in    std_logic_vector(0 to g_bus_num - 1); -- I2C Data inputs
     scl_o       :   out std_logic_vector(0 to g_bus_num - 1); -- I2C Clock outputs
-    sda_o       :   out std_logic_vector(0 to g_bus_num - 1)  -- I2C Data outputs
+    sda_o       :   out std_logic_vector(0 to g_bus_num - 1); -- I2C Data outputs
+    scl_pu_o    :   out std_logic_vector(0 to g_bus_num - 1)  -- I2C Clock current-source pull-up enables (High-speed mode)
     ------------------------------------
   );
 end entity iicmb_m;
@@ -113,39 +129,27 @@ architecture str of iicmb_m is
     generic
     (
       g_bus_num :       positive range 1 to 16 := 1;
-      g_f_clk   :       real                   := 100000.0;
-      g_f_scl_0 :       real           :=    100.0;
-      g_f_scl_1 :       real           :=    100.0;
-      g_f_scl_2 :       real           :=    100.0;
-      g_f_scl_3 :       real           :=    100.0;
-      g_f_scl_4 :       real           :=    100.0;
-      g_f_scl_5 :       real           :=    100.0;
-      g_f_scl_6 :       real           :=    100.0;
-      g_f_scl_7 :       real           :=    100.0;
-      g_f_scl_8 :       real           :=    100.0;
-      g_f_scl_9 :       real           :=    100.0;
-      g_f_scl_a :       real           :=    100.0;
-      g_f_scl_b :       real           :=    100.0;
-      g_f_scl_c :       real           :=    100.0;
-      g_f_scl_d :       real           :=    100.0;
-      g_f_scl_e :       real           :=    100.0;
-      g_f_scl_f :       real           :=    100.0
+      g_f_clk   :       real                   := 100000.0
     );
     port
     (
       clk       : in    std_logic;
       s_rst     : in    std_logic;
       bus_id    : in    natural range 0 to g_bus_num - 1;
+      tp        : in    tp_type_array(0 to 15);
       busy      :   out std_logic := '0';
       scl_rx    :   out std_logic := '1';
       sda_rx    :   out std_logic := '1';
       scl_d_rx  :   out std_logic := '1';
       scl_tx    : in    std_logic;
       sda_tx    : in    std_logic;
+      scl_pu_tx : in    std_logic;
+      hs        : in    std_logic;
       scl_i     : in    std_logic_vector(0 to g_bus_num - 1);
       sda_i     : in    std_logic_vector(0 to g_bus_num - 1);
       scl_o     :   out std_logic_vector(0 to g_bus_num - 1);
-      sda_o     :   out std_logic_vector(0 to g_bus_num - 1)
+      sda_o     :   out std_logic_vector(0 to g_bus_num - 1);
+      scl_pu_o  :   out std_logic_vector(0 to g_bus_num - 1)
     );
   end component conditioner_mux;
   ------------------------------------------------------------------------------
@@ -155,23 +159,7 @@ architecture str of iicmb_m is
     generic
     (
       g_bus_num :       positive range 1 to 16 := 1;
-      g_f_clk   :       real           := 100000.0;
-      g_f_scl_0 :       real           :=    100.0;
-      g_f_scl_1 :       real           :=    100.0;
-      g_f_scl_2 :       real           :=    100.0;
-      g_f_scl_3 :       real           :=    100.0;
-      g_f_scl_4 :       real           :=    100.0;
-      g_f_scl_5 :       real           :=    100.0;
-      g_f_scl_6 :       real           :=    100.0;
-      g_f_scl_7 :       real           :=    100.0;
-      g_f_scl_8 :       real           :=    100.0;
-      g_f_scl_9 :       real           :=    100.0;
-      g_f_scl_a :       real           :=    100.0;
-      g_f_scl_b :       real           :=    100.0;
-      g_f_scl_c :       real           :=    100.0;
-      g_f_scl_d :       real           :=    100.0;
-      g_f_scl_e :       real           :=    100.0;
-      g_f_scl_f :       real           :=    100.0
+      g_f_clk   :       real           := 100000.0
     );
     port
     (
@@ -179,6 +167,9 @@ architecture str of iicmb_m is
       s_rst     : in    std_logic;
       fsm_state :   out std_logic_vector(3 downto 0);
       bus_id    : in    natural range 0 to g_bus_num - 1;
+      tp        : in    tp_type_array(0 to 15);
+      tp_hs     : in    tp_type;
+      hs        : in    std_logic;
       mbc_wr    : in    std_logic;
       mbc       : in    mbc_type;
       mbr_wr    :   out std_logic      := '0';
@@ -187,7 +178,8 @@ architecture str of iicmb_m is
       sda_i     : in    std_logic;
       scl_i_d   : in    std_logic;
       scl_o     :   out std_logic      := '1';
-      sda_o     :   out std_logic      := '1'
+      sda_o     :   out std_logic      := '1';
+      scl_pu    :   out std_logic      := '0'
     );
   end component mbit;
   ------------------------------------------------------------------------------
@@ -207,6 +199,9 @@ architecture str of iicmb_m is
       busy        : in    std_logic;
       bus_id      :   out natural range 0 to g_bus_num - 1 := 0;
       fsm_state   :   out std_logic_vector(3 downto 0);
+      hs_en       : in    std_logic                    := '0';
+      hs_code     : in    std_logic_vector(2 downto 0) := "000";
+      hs          :   out std_logic                    := '0';
       mcmd_wr     : in    std_logic;
       mcmd_id     : in    std_logic_vector(2 downto 0);
       mcmd_data   : in    std_logic_vector(7 downto 0);
@@ -228,6 +223,8 @@ architecture str of iicmb_m is
   signal scl_d_rx  : std_logic;
   signal scl_tx    : std_logic;
   signal sda_tx    : std_logic;
+  signal scl_pu_tx : std_logic;
+  signal hs_y      : std_logic;
 
   signal mbc_wr    : std_logic;
   signal mbc       : mbc_type;
@@ -237,6 +234,7 @@ architecture str of iicmb_m is
 begin
 
   busy   <= busy_y;
+  hs     <= hs_y;
   bus_id <= std_logic_vector(to_unsigned(bus_id_y, 4));
 
   ------------------------------------------------------------------------------
@@ -254,6 +252,9 @@ begin
       busy        => busy_y,
       bus_id      => bus_id_y,
       fsm_state   => byte_state,
+      hs_en       => hs_en,
+      hs_code     => hs_code,
+      hs          => hs_y,
       mcmd_wr     => mcmd_wr,
       mcmd_id     => mcmd_id,
       mcmd_data   => mcmd_data,
@@ -272,23 +273,7 @@ begin
     generic map
     (
       g_bus_num => g_bus_num,
-      g_f_clk   => g_f_clk,
-      g_f_scl_0 => g_f_scl_0,
-      g_f_scl_1 => g_f_scl_1,
-      g_f_scl_2 => g_f_scl_2,
-      g_f_scl_3 => g_f_scl_3,
-      g_f_scl_4 => g_f_scl_4,
-      g_f_scl_5 => g_f_scl_5,
-      g_f_scl_6 => g_f_scl_6,
-      g_f_scl_7 => g_f_scl_7,
-      g_f_scl_8 => g_f_scl_8,
-      g_f_scl_9 => g_f_scl_9,
-      g_f_scl_a => g_f_scl_a,
-      g_f_scl_b => g_f_scl_b,
-      g_f_scl_c => g_f_scl_c,
-      g_f_scl_d => g_f_scl_d,
-      g_f_scl_e => g_f_scl_e,
-      g_f_scl_f => g_f_scl_f
+      g_f_clk   => g_f_clk
     )
     port map
     (
@@ -296,6 +281,9 @@ begin
       s_rst     => s_rst,
       fsm_state => bit_state,
       bus_id    => bus_id_y,
+      tp        => tp,
+      tp_hs     => tp_hs,
+      hs        => hs_y,
       mbc_wr    => mbc_wr,
       mbc       => mbc,
       mbr_wr    => mbr_wr,
@@ -304,7 +292,8 @@ begin
       sda_i     => sda_rx,
       scl_i_d   => scl_d_rx,
       scl_o     => scl_tx,
-      sda_o     => sda_tx
+      sda_o     => sda_tx,
+      scl_pu    => scl_pu_tx
     );
   ------------------------------------------------------------------------------
 
@@ -313,39 +302,27 @@ begin
     generic map
     (
       g_bus_num => g_bus_num,
-      g_f_clk   => g_f_clk,
-      g_f_scl_0 => g_f_scl_0,
-      g_f_scl_1 => g_f_scl_1,
-      g_f_scl_2 => g_f_scl_2,
-      g_f_scl_3 => g_f_scl_3,
-      g_f_scl_4 => g_f_scl_4,
-      g_f_scl_5 => g_f_scl_5,
-      g_f_scl_6 => g_f_scl_6,
-      g_f_scl_7 => g_f_scl_7,
-      g_f_scl_8 => g_f_scl_8,
-      g_f_scl_9 => g_f_scl_9,
-      g_f_scl_a => g_f_scl_a,
-      g_f_scl_b => g_f_scl_b,
-      g_f_scl_c => g_f_scl_c,
-      g_f_scl_d => g_f_scl_d,
-      g_f_scl_e => g_f_scl_e,
-      g_f_scl_f => g_f_scl_f
+      g_f_clk   => g_f_clk
     )
     port map
     (
       clk       => clk,
       s_rst     => s_rst,
       bus_id    => bus_id_y,
+      tp        => tp,
       busy      => busy_y,
       scl_rx    => scl_rx,
       sda_rx    => sda_rx,
       scl_d_rx  => scl_d_rx,
       scl_tx    => scl_tx,
       sda_tx    => sda_tx,
+      scl_pu_tx => scl_pu_tx,
+      hs        => hs_y,
       scl_i     => scl_i,
       sda_i     => sda_i,
       scl_o     => scl_o,
-      sda_o     => sda_o
+      sda_o     => sda_o,
+      scl_pu_o  => scl_pu_o
     );
   ------------------------------------------------------------------------------
 
@@ -40,6 +40,8 @@
 library ieee;
 use ieee.std_logic_1164.all;
 
+use work.iicmb_pkg.all;
+
 
 --==============================================================================
 entity iicmb_m_av is
@@ -47,6 +49,11 @@ entity iicmb_m_av is
   (
     ------------------------------------
     g_bus_num     :       positive range 1 to 16 := 1;          -- Number of separate I2C buses
+    g_engines     :       positive range 1 to 16 := 1;          -- Number of concurrent engines, each with own register window (1 to 'g_bus_num')
+    g_fifo_depth  :       natural range 0 to 255 := 0;          -- Depth of TX/RX FIFOs of each register block (0: no FIFOs)
+    g_trace_depth :       natural range 0 to 12  := 0;          -- log2 of bus trace RAM entries of each register block (0: no bus trace)
+    g_poll_depth  :       natural range 0 to 127 := 0;          -- Number of poll table entries (0: no poller)
+    g_dma         :       boolean                := false;      -- DMA controller with master port (requires FIFOs)
     g_f_clk       :       real                   := 100000.0;   -- Frequency of system clock 'clk' (in kHz)
     g_f_scl_0     :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #0 (in kHz)
     g_f_scl_1     :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #1 (in kHz)
@@ -63,7 +70,8 @@ entity iicmb_m_av is
     g_f_scl_c     :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #12 (in kHz)
     g_f_scl_d     :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #13 (in kHz)
     g_f_scl_e     :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #14 (in kHz)
-    g_f_scl_f     :       real                   :=    100.0    -- Frequency of 'SCL' clock of I2C bus #15 (in kHz)
+    g_f_scl_f     :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #15 (in kHz)
+    g_f_scl_hs    :       real                   :=   3400.0    -- Frequency of 'SCL' clock in High-speed mode (in kHz)
     ------------------------------------
   );
   port
@@ -80,17 +88,33 @@ entity iicmb_m_av is
     write         : in    std_logic;                            -- Asserted to indicate write transfer
     read          : in    std_logic;                            -- Asserted to indicate read transfer
     byteenable    : in    std_logic_vector( 3 downto 0);        -- Enables specific byte lane(s)
+    address       : in    std_logic_vector( 4 downto 0) := "00000"; -- Word address
+    address_eng   : in    std_logic_vector( 3 downto 0) := "0000";  -- Address bits above 'address': engine window
+    address_pl    : in    std_logic                     := '0';     -- Address bit above 'address_eng': poll window
+    ------------------------------------
+    ------------------------------------
+    -- Interrupt requests:
+    irq           :   out std_logic;                            -- Interrupt request, any engine
+    irq_eng       :   out std_logic_vector(0 to g_engines - 1); -- Interrupt request per engine
+    irq_dma       :   out std_logic;                            -- Interrupt request of DMA, end of descriptor chain
     ------------------------------------
     ------------------------------------
-    -- Interrupt request:
-    irq           :   out std_logic;                            -- Interrupt request
+    -- Avalon-MM master of DMA (only with 'g_dma'):
+    avm_address     :   out std_logic_vector(31 downto 0);      -- Byte address
+    avm_read        :   out std_logic;                          -- Read transfer
+    avm_write       :   out std_logic;                          -- Write transfer
+    avm_byteenable  :   out std_logic_vector( 3 downto 0);      -- Byte lanes
+    avm_writedata   :   out std_logic_vector(31 downto 0);      -- Data from master to slave
+    avm_readdata    : in    std_logic_vector(31 downto 0) := (others => '0'); -- Data from slave to master
+    avm_waitrequest : in    std_logic                     := '0'; -- Wait request
     ------------------------------------
     ------------------------------------
     -- I2C interfaces:
     scl_i         : in    std_logic_vector(0 to g_bus_num - 1); -- I2C Clock inputs
     sda_i         : in    std_logic_vector(0 to g_bus_num - 1); -- I2C Data inputs
     scl_o         :   out std_logic_vector(0 to g_bus_num - 1); -- I2C Clock outputs
-    sda_o         :   out std_logic_vector(0 to g_bus_num - 1)  -- I2C Data outputs
+    sda_o         :   out std_logic_vector(0 to g_bus_num - 1); -- I2C Data outputs
+    scl_pu_o      :   out std_logic_vector(0 to g_bus_num - 1)  -- I2C Clock current-source pull-up enables (High-speed mode)
     ------------------------------------
   );
 end entity iicmb_m_av;
@@ -112,6 +136,8 @@ architecture str of iicmb_m_av is
       write         : in    std_logic;
       read          : in    std_logic;
       byteenable    : in    std_logic_vector( 3 downto 0);
+      address       : in    std_logic_vector( 4 downto 0) := "00000";
+      adr           :   out std_logic_vector( 4 downto 0);
       wr            :   out std_logic_vector( 3 downto 0);
       rd            :   out std_logic_vector( 3 downto 0);
       idata         :   out std_logic_vector(31 downto 0);
@@ -121,99 +147,114 @@ architecture str of iicmb_m_av is
   ------------------------------------------------------------------------------
 
   ------------------------------------------------------------------------------
-  component regblock is
+  component engine_mux is
+    generic
+    (
+      g_bus_num     : positive range 1 to 16 := 1;
+      g_engines     : positive range 1 to 16 := 1;
+      g_fifo_depth  : natural range 0 to 255 := 0;
+      g_trace_depth : natural range 0 to 12  := 0;
+      g_poll_depth  : natural range 0 to 127 := 0;
+      g_f_clk       : real                   := 100000.0;
+      g_tp          : tp_type_array(0 to 15) := get_tp(100000.0, (others => 100.0));
+      g_tp_hs       : tp_type                := get_tp(100000.0, 3400.0)
+    );
     port
     (
-      clk         : in    std_logic;
-      s_rst       : in    std_logic;
-      wr          : in    std_logic_vector( 3 downto 0);
-      rd          : in    std_logic_vector( 3 downto 0);
-      idata       : in    std_logic_vector(31 downto 0);
-      odata       :   out std_logic_vector(31 downto 0);
-      irq         :   out std_logic;
-      busy        : in    std_logic;
-      captured    : in    std_logic;
-      bus_id      : in    std_logic_vector( 3 downto 0);
-      bit_state   : in    std_logic_vector( 3 downto 0);
-      byte_state  : in    std_logic_vector( 3 downto 0);
-      disable     :   out std_logic;
-      mcmd_wr     :   out std_logic;
-      mcmd_id     :   out std_logic_vector( 2 downto 0);
-      mcmd_data   :   out std_logic_vector( 7 downto 0);
-      mrsp_wr     : in    std_logic;
-      mrsp_id     : in    std_logic_vector( 2 downto 0);
-      mrsp_data   : in    std_logic_vector( 7 downto 0)
+      clk          : in    std_logic;
+      s_rst        : in    std_logic;
+      eng          : in    std_logic_vector( 3 downto 0);
+      adr          : in    std_logic_vector( 4 downto 0);
+      wr           : in    std_logic_vector( 3 downto 0);
+      rd           : in    std_logic_vector( 3 downto 0);
+      idata        : in    std_logic_vector(31 downto 0);
+      odata        :   out std_logic_vector(31 downto 0);
+      pl_adr       : in    std_logic_vector( 8 downto 0) := (others => '0');
+      pl_wr        : in    std_logic_vector( 3 downto 0) := "0000";
+      pl_idata     : in    std_logic_vector(31 downto 0) := (others => '0');
+      pl_odata     :   out std_logic_vector(31 downto 0);
+      irq          :   out std_logic_vector(0 to g_engines - 1);
+      scl_i        : in    std_logic_vector(0 to g_bus_num - 1);
+      sda_i        : in    std_logic_vector(0 to g_bus_num - 1);
+      scl_o        :   out std_logic_vector(0 to g_bus_num - 1);
+      sda_o        :   out std_logic_vector(0 to g_bus_num - 1);
+      scl_pu_o     :   out std_logic_vector(0 to g_bus_num - 1)
     );
-  end component regblock;
+  end component engine_mux;
   ------------------------------------------------------------------------------
 
   ------------------------------------------------------------------------------
-  component iicmb_m is
-    generic
-    (
-      g_bus_num   :       positive range 1 to 16 := 1;
-      g_f_clk     :       real                   := 100000.0;
-      g_f_scl_0   :       real                   :=    100.0;
-      g_f_scl_1   :       real                   :=    100.0;
-      g_f_scl_2   :       real                   :=    100.0;
-      g_f_scl_3   :       real                   :=    100.0;
-      g_f_scl_4   :       real                   :=    100.0;
-      g_f_scl_5   :       real                   :=    100.0;
-      g_f_scl_6   :       real                   :=    100.0;
-      g_f_scl_7   :       real                   :=    100.0;
-      g_f_scl_8   :       real                   :=    100.0;
-      g_f_scl_9   :       real                   :=    100.0;
-      g_f_scl_a   :       real                   :=    100.0;
-      g_f_scl_b   :       real                   :=    100.0;
-      g_f_scl_c   :       real                   :=    100.0;
-      g_f_scl_d   :       real                   :=    100.0;
-      g_f_scl_e   :       real                   :=    100.0;
-      g_f_scl_f   :       real                   :=    100.0
-    );
+  component dma is
     port
     (
       clk         : in    std_logic;
       s_rst       : in    std_logic;
-      busy        :   out std_logic;
-      captured    :   out std_logic;
-      bus_id      :   out std_logic_vector(3 downto 0);
-      bit_state   :   out std_logic_vector(3 downto 0);
-      byte_state  :   out std_logic_vector(3 downto 0);
-      mcmd_wr     : in    std_logic;
-      mcmd_id     : in    std_logic_vector(2 downto 0);
-      mcmd_data   : in    std_logic_vector(7 downto 0);
-      mrsp_wr     :   out std_logic;
-      mrsp_id     :   out std_logic_vector(2 downto 0);
-      mrsp_data   :   out std_logic_vector(7 downto 0);
-      scl_i       : in    std_logic_vector(0 to g_bus_num - 1);
-      sda_i       : in    std_logic_vector(0 to g_bus_num - 1);
-      scl_o       :   out std_logic_vector(0 to g_bus_num - 1);
-      sda_o       :   out std_logic_vector(0 to g_bus_num - 1)
+      s_eng       : in    std_logic_vector( 3 downto 0);
+      s_adr       : in    std_logic_vector( 4 downto 0);
+      s_wr        : in    std_logic_vector( 3 downto 0);
+      s_rd        : in    std_logic_vector( 3 downto 0);
+      s_idata     : in    std_logic_vector(31 downto 0);
+      s_odata     :   out std_logic_vector(31 downto 0);
+      eng         :   out std_logic_vector( 3 downto 0);
+      adr         :   out std_logic_vector( 4 downto 0);
+      wr          :   out std_logic_vector( 3 downto 0);
+      rd          :   out std_logic_vector( 3 downto 0);
+      idata       :   out std_logic_vector(31 downto 0);
+      odata       : in    std_logic_vector(31 downto 0);
+      irq         :   out std_logic;
+      m_req       :   out std_logic;
+      m_we        :   out std_logic;
+      m_sel       :   out std_logic_vector( 3 downto 0);
+      m_adr       :   out std_logic_vector(31 downto 0);
+      m_wdata     :   out std_logic_vector(31 downto 0);
+      m_rdata     : in    std_logic_vector(31 downto 0);
+      m_ack       : in    std_logic
     );
-  end component iicmb_m;
+  end component dma;
   ------------------------------------------------------------------------------
 
+  signal adr         : std_logic_vector( 4 downto 0);
   signal wr          : std_logic_vector( 3 downto 0);
   signal rd          : std_logic_vector( 3 downto 0);
   signal idata       : std_logic_vector(31 downto 0);
   signal odata       : std_logic_vector(31 downto 0);
 
-  signal busy        : std_logic;
-  signal captured    : std_logic;
-  signal bus_id      : std_logic_vector( 3 downto 0);
-  signal bit_state   : std_logic_vector( 3 downto 0);
-  signal byte_state  : std_logic_vector( 3 downto 0);
-  signal disable     : std_logic; -- used as synchronous reset for 'iicmb_m'
+  -- Register access outside of poll window:
+  signal r_wr        : std_logic_vector( 3 downto 0);
+  signal r_rd        : std_logic_vector( 3 downto 0);
+  signal r_odata     : std_logic_vector(31 downto 0);
+
+  -- Poll window:
+  signal pl_adr      : std_logic_vector( 8 downto 0);
+  signal pl_wr       : std_logic_vector( 3 downto 0);
+  signal pl_odata    : std_logic_vector(31 downto 0);
 
-  -- Signals of 'Generic Interface':
-  -- Command:
-  signal mcmd_wr     : std_logic;
-  signal mcmd_id     : std_logic_vector( 2 downto 0);
-  signal mcmd_data   : std_logic_vector( 7 downto 0);
-  -- Response:
-  signal mrsp_wr     : std_logic;
-  signal mrsp_id     : std_logic_vector( 2 downto 0);
-  signal mrsp_data   : std_logic_vector( 7 downto 0);
+  -- Register interface of engines:
+  signal e_eng       : std_logic_vector( 3 downto 0);
+  signal e_adr       : std_logic_vector( 4 downto 0);
+  signal e_wr        : std_logic_vector( 3 downto 0);
+  signal e_rd        : std_logic_vector( 3 downto 0);
+  signal e_idata     : std_logic_vector(31 downto 0);
+  signal e_odata     : std_logic_vector(31 downto 0);
+
+  -- Master of DMA:
+  signal m_req       : std_logic;
+  signal m_we        : std_logic;
+  signal m_sel       : std_logic_vector( 3 downto 0);
+  signal m_adr       : std_logic_vector(31 downto 0);
+  signal m_wdata     : std_logic_vector(31 downto 0);
+  signal m_rdata     : std_logic_vector(31 downto 0);
+  signal m_ack       : std_logic;
+
+  signal irq_eng_y   : std_logic_vector(0 to g_engines - 1);
+  signal irq_dma_y   : std_logic;
+
+  -- Reset timing of I2C buses:
+  constant c_tp      : tp_type_array(0 to 15) := get_tp(g_f_clk, real_array'(g_f_scl_0, g_f_scl_1, g_f_scl_2, g_f_scl_3,
+                                                                             g_f_scl_4, g_f_scl_5, g_f_scl_6, g_f_scl_7,
+                                                                             g_f_scl_8, g_f_scl_9, g_f_scl_a, g_f_scl_b,
+                                                                             g_f_scl_c, g_f_scl_d, g_f_scl_e, g_f_scl_f));
+  constant c_tp_hs   : tp_type                := get_tp(g_f_clk, g_f_scl_hs);
 
 begin
 
@@ -230,6 +271,8 @@ begin
       write         => write,
       read          => read,
       byteenable    => byteenable,
+      address       => address,
+      adr           => adr,
       wr            => wr,
       rd            => rd,
       idata         => idata,
@@ -238,76 +281,120 @@ begin
   ------------------------------------------------------------------------------
 
   ------------------------------------------------------------------------------
-  regblock_inst9 : regblock
-    port map
-    (
-      clk         => clk,
-      s_rst       => s_rst,
-      wr          => wr,
-      rd          => rd,
-      idata       => idata,
-      odata       => odata,
-      irq         => irq,
-      busy        => busy,
-      captured    => captured,
-      bus_id      => bus_id,
-      bit_state   => bit_state,
-      byte_state  => byte_state,
-      disable     => disable,
-      mcmd_wr     => mcmd_wr,
-      mcmd_id     => mcmd_id,
-      mcmd_data   => mcmd_data,
-      mrsp_wr     => mrsp_wr,
-      mrsp_id     => mrsp_id,
-      mrsp_data   => mrsp_data 
-    );
-  ------------------------------------------------------------------------------
-
-  ------------------------------------------------------------------------------
-  iicmb_m_inst0 : iicmb_m
+  engine_mux_inst0 : engine_mux
     generic map
     (
-      g_bus_num   => g_bus_num,
-      g_f_clk     => g_f_clk,
-      g_f_scl_0   => g_f_scl_0,
-      g_f_scl_1   => g_f_scl_1,
-      g_f_scl_2   => g_f_scl_2,
-      g_f_scl_3   => g_f_scl_3,
-      g_f_scl_4   => g_f_scl_4,
-      g_f_scl_5   => g_f_scl_5,
-      g_f_scl_6   => g_f_scl_6,
-      g_f_scl_7   => g_f_scl_7,
-      g_f_scl_8   => g_f_scl_8,
-      g_f_scl_9   => g_f_scl_9,
-      g_f_scl_a   => g_f_scl_a,
-      g_f_scl_b   => g_f_scl_b,
-      g_f_scl_c   => g_f_scl_c,
-      g_f_scl_d   => g_f_scl_d,
-      g_f_scl_e   => g_f_scl_e,
-      g_f_scl_f   => g_f_scl_f
+      g_bus_num     => g_bus_num,
+      g_engines     => g_engines,
+      g_fifo_depth  => g_fifo_depth,
+      g_trace_depth => g_trace_depth,
+      g_poll_depth  => g_poll_depth,
+      g_f_clk       => g_f_clk,
+      g_tp          => c_tp,
+      g_tp_hs       => c_tp_hs
     )
     port map
     (
-      clk         => clk,
-      s_rst       => disable,
-      busy        => busy,
-      captured    => captured,
-      bus_id      => bus_id,
-      bit_state   => bit_state,
-      byte_state  => byte_state,
-      mcmd_wr     => mcmd_wr,
-      mcmd_id     => mcmd_id,
-      mcmd_data   => mcmd_data,
-      mrsp_wr     => mrsp_wr,
-      mrsp_id     => mrsp_id,
-      mrsp_data   => mrsp_data,
-      scl_i       => scl_i,
-      sda_i       => sda_i,
-      scl_o       => scl_o,
-      sda_o       => sda_o
+      clk          => clk,
+      s_rst        => s_rst,
+      eng          => e_eng,
+      adr          => e_adr,
+      wr           => e_wr,
+      rd           => e_rd,
+      idata        => e_idata,
+      odata        => e_odata,
+      pl_adr       => pl_adr,
+      pl_wr        => pl_wr,
+      pl_idata     => idata,
+      pl_odata     => pl_odata,
+      irq          => irq_eng_y,
+      scl_i        => scl_i,
+      sda_i        => sda_i,
+      scl_o        => scl_o,
+      sda_o        => sda_o,
+      scl_pu_o     => scl_pu_o
     );
   ------------------------------------------------------------------------------
 
+  ------------------------------------------------------------------------------
+  -- Poll window, not seen by DMA
+  pl_adr    <= address_eng & adr;
+  pl_wr     <= wr       when (address_pl = '1') else "0000";
+  r_wr      <= "0000"   when (address_pl = '1') else wr;
+  r_rd      <= "0000"   when (address_pl = '1') else rd;
+  odata     <= pl_odata when (address_pl = '1') else r_odata;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  dma_gen : if g_dma generate
+    dma_inst0 : dma
+      port map
+      (
+        clk         => clk,
+        s_rst       => s_rst,
+        s_eng       => address_eng,
+        s_adr       => adr,
+        s_wr        => r_wr,
+        s_rd        => r_rd,
+        s_idata     => idata,
+        s_odata     => r_odata,
+        eng         => e_eng,
+        adr         => e_adr,
+        wr          => e_wr,
+        rd          => e_rd,
+        idata       => e_idata,
+        odata       => e_odata,
+        irq         => irq_dma_y,
+        m_req       => m_req,
+        m_we        => m_we,
+        m_sel       => m_sel,
+        m_adr       => m_adr,
+        m_wdata     => m_wdata,
+        m_rdata     => m_rdata,
+        m_ack       => m_ack
+      );
+  end generate dma_gen;
+
+  no_dma_gen : if not(g_dma) generate
+    e_eng     <= address_eng;
+    e_adr     <= adr;
+    e_wr      <= r_wr;
+    e_rd      <= r_rd;
+    e_idata   <= idata;
+    r_odata   <= e_odata;
+    irq_dma_y <= '0';
+    m_req     <= '0';
+    m_we      <= '0';
+    m_sel     <= "0000";
+    m_adr     <= (others => '0');
+    m_wdata   <= (others => '0');
+  end generate no_dma_gen;
+  ------------------------------------------------------------------------------
+
+  avm_address    <= m_adr;
+  avm_read       <= m_req and not(m_we);
+  avm_write      <= m_req and m_we;
+  avm_byteenable <= m_sel;
+  avm_writedata  <= m_wdata;
+  m_rdata        <= avm_readdata;
+  m_ack          <= m_req and not(avm_waitrequest);
+
+  irq_eng <= irq_eng_y;
+  irq_dma <= irq_dma_y;
+
+  ------------------------------------------------------------------------------
+  irq_proc:
+  process(irq_eng_y, irq_dma_y)
+    variable v_irq : std_logic;
+  begin
+    v_irq := irq_dma_y;
+    for i in irq_eng_y'range loop
+      v_irq := v_irq or irq_eng_y(i);
+    end loop;
+    irq <= v_irq;
+  end process irq_proc;
+  ------------------------------------------------------------------------------
+
 end architecture str;
 --==============================================================================
 
@@ -0,0 +1,319 @@
+
+--==============================================================================
+--                                                                             |
+--    Project: IIC Multiple Bus Controller (IICMB)                             |
+--                                                                             |
+--    Module:  Top level of IICMB controller with AXI4-Lite interface.         |
+--    Version:                                                                 |
+--             1.0,   October 16, 2026                                         |
+--                                                                             |
+--    Author:  IICMB contributors                                              |
+--                                                                             |
+--==============================================================================
+--==============================================================================
+-- Copyright (c) 2016, Sergey Shuvalkin                                        |
+-- All rights reserved.                                                        |
+--                                                                             |
+-- Redistribution and use in source and binary forms, with or without          |
+-- modification, are permitted provided that the following conditions are met: |
+--                                                                             |
+-- 1. Redistributions of source code must retain the above copyright notice,   |
+--    this list of conditions and the following disclaimer.                    |
+-- 2. Redistributions in binary form must reproduce the above copyright        |
+--    notice, this list of conditions and the following disclaimer in the      |
+--    documentation and/or other materials provided with the distribution.     |
+--                                                                             |
+-- THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" |
+-- AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE   |
+-- IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE  |
+-- ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE    |
+-- LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR         |
+-- CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF        |
+-- SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS    |
+-- INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN     |
+-- CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)     |
+-- ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE  |
+-- POSSIBILITY OF SUCH DAMAGE.                                                 |
+--==============================================================================
+
+
+library ieee;
+use ieee.std_logic_1164.all;
+
+use work.iicmb_pkg.all;
+
+
+--==============================================================================
+entity iicmb_m_axi is
+  generic
+  (
+    ------------------------------------
+    g_bus_num     :       positive range 1 to 16 := 1;          -- Number of separate I2C buses
+    g_engines     :       positive range 1 to 16 := 1;          -- Number of concurrent engines, each with own register window (1 to 'g_bus_num')
+    g_fifo_depth  :       natural range 0 to 255 := 0;          -- Depth of TX/RX FIFOs of each register block (0: no FIFOs)
+    g_trace_depth :       natural range 0 to 12  := 0;          -- log2 of bus trace RAM entries of each register block (0: no bus trace)
+    g_poll_depth  :       natural range 0 to 127 := 0;          -- Number of poll table entries (0: no poller)
+    g_f_clk       :       real                   := 100000.0;   -- Frequency of system clock 'aclk' (in kHz)
+    g_f_scl_0     :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #0 (in kHz)
+    g_f_scl_1     :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #1 (in kHz)
+    g_f_scl_2     :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #2 (in kHz)
+    g_f_scl_3     :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #3 (in kHz)
+    g_f_scl_4     :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #4 (in kHz)
+    g_f_scl_5     :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #5 (in kHz)
+    g_f_scl_6     :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #6 (in kHz)
+    g_f_scl_7     :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #7 (in kHz)
+    g_f_scl_8     :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #8 (in kHz)
+    g_f_scl_9     :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #9 (in kHz)
+    g_f_scl_a     :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #10 (in kHz)
+    g_f_scl_b     :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #11 (in kHz)
+    g_f_scl_c     :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #12 (in kHz)
+    g_f_scl_d     :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #13 (in kHz)
+    g_f_scl_e     :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #14 (in kHz)
+    g_f_scl_f     :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #15 (in kHz)
+    g_f_scl_hs    :       real                   :=   3400.0    -- Frequency of 'SCL' clock in High-speed mode (in kHz)
+    ------------------------------------
+  );
+  port
+  (
+    ------------------------------------
+    -- AXI4-Lite signals:
+    aclk          : in    std_logic;                            -- Clock
+    aresetn       : in    std_logic;                            -- Synchronous reset (active low)
+    -------------
+    s_axi_awvalid : in    std_logic;                            -- Write address valid
+    s_axi_awready :   out std_logic;                            -- Write address ready
+    s_axi_awaddr  : in    std_logic_vector(11 downto 0);        -- Write address, bits 10..7: engine window, bit 11: poll window
+    s_axi_wvalid  : in    std_logic;                            -- Write data valid
+    s_axi_wready  :   out std_logic;                            -- Write data ready
+    s_axi_wdata   : in    std_logic_vector(31 downto 0);        -- Write data
+    s_axi_wstrb   : in    std_logic_vector( 3 downto 0);        -- Write strobes
+    s_axi_bvalid  :   out std_logic;                            -- Write response valid
+    s_axi_bready  : in    std_logic;                            -- Write response ready
+    s_axi_bresp   :   out std_logic_vector( 1 downto 0);        -- Write response
+    s_axi_arvalid : in    std_logic;                            -- Read address valid
+    s_axi_arready :   out std_logic;                            -- Read address ready
+    s_axi_araddr  : in    std_logic_vector(11 downto 0);        -- Read address, bits 10..7: engine window, bit 11: poll window
+    s_axi_rvalid  :   out std_logic;                            -- Read data valid
+    s_axi_rready  : in    std_logic;                            -- Read data ready
+    s_axi_rdata   :   out std_logic_vector(31 downto 0);        -- Read data
+    s_axi_rresp   :   out std_logic_vector( 1 downto 0);        -- Read response
+    ------------------------------------
+    ------------------------------------
+    -- Interrupt requests:
+    irq           :   out std_logic;                            -- Interrupt request, any engine
+    irq_eng       :   out std_logic_vector(0 to g_engines - 1); -- Interrupt request per engine
+    ------------------------------------
+    ------------------------------------
+    -- I2C interfaces:
+    scl_i         : in    std_logic_vector(0 to g_bus_num - 1); -- I2C Clock inputs
+    sda_i         : in    std_logic_vector(0 to g_bus_num - 1); -- I2C Data inputs
+    scl_o         :   out std_logic_vector(0 to g_bus_num - 1); -- I2C Clock outputs
+    sda_o         :   out std_logic_vector(0 to g_bus_num - 1); -- I2C Data outputs
+    scl_pu_o      :   out std_logic_vector(0 to g_bus_num - 1)  -- I2C Clock current-source pull-up enables (High-speed mode)
+    ------------------------------------
+  );
+end entity iicmb_m_axi;
+--==============================================================================
+
+--==============================================================================
+architecture str of iicmb_m_axi is
+
+  ------------------------------------------------------------------------------
+  component axi4lite is
+    port
+    (
+      aclk        : in    std_logic;
+      aresetn     : in    std_logic;
+      awvalid     : in    std_logic;
+      awready     :   out std_logic;
+      awaddr      : in    std_logic_vector(11 downto 0);
+      wvalid      : in    std_logic;
+      wready      :   out std_logic;
+      wdata       : in    std_logic_vector(31 downto 0);
+      wstrb       : in    std_logic_vector( 3 downto 0);
+      bvalid      :   out std_logic;
+      bready      : in    std_logic;
+      bresp       :   out std_logic_vector( 1 downto 0);
+      arvalid     : in    std_logic;
+      arready     :   out std_logic;
+      araddr      : in    std_logic_vector(11 downto 0);
+      rvalid      :   out std_logic;
+      rready      : in    std_logic;
+      rdata       :   out std_logic_vector(31 downto 0);
+      rresp       :   out std_logic_vector( 1 downto 0);
+      pl          :   out std_logic;
+      eng         :   out std_logic_vector( 3 downto 0);
+      adr         :   out std_logic_vector( 4 downto 0);
+      wr          :   out std_logic_vector( 3 downto 0);
+      rd          :   out std_logic_vector( 3 downto 0);
+      idata       :   out std_logic_vector(31 downto 0);
+      odata       : in    std_logic_vector(31 downto 0)
+    );
+  end component axi4lite;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  component engine_mux is
+    generic
+    (
+      g_bus_num     : positive range 1 to 16 := 1;
+      g_engines     : positive range 1 to 16 := 1;
+      g_fifo_depth  : natural range 0 to 255 := 0;
+      g_trace_depth : natural range 0 to 12  := 0;
+      g_poll_depth  : natural range 0 to 127 := 0;
+      g_f_clk       : real                   := 100000.0;
+      g_tp          : tp_type_array(0 to 15) := get_tp(100000.0, (others => 100.0));
+      g_tp_hs       : tp_type                := get_tp(100000.0, 3400.0)
+    );
+    port
+    (
+      clk          : in    std_logic;
+      s_rst        : in    std_logic;
+      eng          : in    std_logic_vector( 3 downto 0);
+      adr          : in    std_logic_vector( 4 downto 0);
+      wr           : in    std_logic_vector( 3 downto 0);
+      rd           : in    std_logic_vector( 3 downto 0);
+      idata        : in    std_logic_vector(31 downto 0);
+      odata        :   out std_logic_vector(31 downto 0);
+      pl_adr       : in    std_logic_vector( 8 downto 0) := (others => '0');
+      pl_wr        : in    std_logic_vector( 3 downto 0) := "0000";
+      pl_idata     : in    std_logic_vector(31 downto 0) := (others => '0');
+      pl_odata     :   out std_logic_vector(31 downto 0);
+      irq          :   out std_logic_vector(0 to g_engines - 1);
+      scl_i        : in    std_logic_vector(0 to g_bus_num - 1);
+      sda_i        : in    std_logic_vector(0 to g_bus_num - 1);
+      scl_o        :   out std_logic_vector(0 to g_bus_num - 1);
+      sda_o        :   out std_logic_vector(0 to g_bus_num - 1);
+      scl_pu_o     :   out std_logic_vector(0 to g_bus_num - 1)
+    );
+  end component engine_mux;
+  ------------------------------------------------------------------------------
+
+  signal s_rst       : std_logic;
+
+  signal pl          : std_logic;
+  signal eng         : std_logic_vector( 3 downto 0);
+  signal adr         : std_logic_vector( 4 downto 0);
+  signal wr          : std_logic_vector( 3 downto 0);
+  signal rd          : std_logic_vector( 3 downto 0);
+  signal idata       : std_logic_vector(31 downto 0);
+  signal odata       : std_logic_vector(31 downto 0);
+
+  -- Register access outside of poll window:
+  signal r_wr        : std_logic_vector( 3 downto 0);
+  signal r_rd        : std_logic_vector( 3 downto 0);
+  signal r_odata     : std_logic_vector(31 downto 0);
+
+  -- Poll window:
+  signal pl_adr      : std_logic_vector( 8 downto 0);
+  signal pl_wr       : std_logic_vector( 3 downto 0);
+  signal pl_odata    : std_logic_vector(31 downto 0);
+
+  signal irq_eng_y   : std_logic_vector(0 to g_engines - 1);
+
+  -- Reset timing of I2C buses:
+  constant c_tp      : tp_type_array(0 to 15) := get_tp(g_f_clk, real_array'(g_f_scl_0, g_f_scl_1, g_f_scl_2, g_f_scl_3,
+                                                                             g_f_scl_4, g_f_scl_5, g_f_scl_6, g_f_scl_7,
+                                                                             g_f_scl_8, g_f_scl_9, g_f_scl_a, g_f_scl_b,
+                                                                             g_f_scl_c, g_f_scl_d, g_f_scl_e, g_f_scl_f));
+  constant c_tp_hs   : tp_type                := get_tp(g_f_clk, g_f_scl_hs);
+
+begin
+
+  s_rst <= not(aresetn);
+
+  ------------------------------------------------------------------------------
+  axi4lite_inst0 : axi4lite
+    port map
+    (
+      aclk        => aclk,
+      aresetn     => aresetn,
+      awvalid     => s_axi_awvalid,
+      awready     => s_axi_awready,
+      awaddr      => s_axi_awaddr,
+      wvalid      => s_axi_wvalid,
+      wready      => s_axi_wready,
+      wdata       => s_axi_wdata,
+      wstrb       => s_axi_wstrb,
+      bvalid      => s_axi_bvalid,
+      bready      => s_axi_bready,
+      bresp       => s_axi_bresp,
+      arvalid     => s_axi_arvalid,
+      arready     => s_axi_arready,
+      araddr      => s_axi_araddr,
+      rvalid      => s_axi_rvalid,
+      rready      => s_axi_rready,
+      rdata       => s_axi_rdata,
+      rresp       => s_axi_rresp,
+      pl          => pl,
+      eng         => eng,
+      adr         => adr,
+      wr          => wr,
+      rd          => rd,
+      idata       => idata,
+      odata       => odata
+    );
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  engine_mux_inst0 : engine_mux
+    generic map
+    (
+      g_bus_num     => g_bus_num,
+      g_engines     => g_engines,
+      g_fifo_depth  => g_fifo_depth,
+      g_trace_depth => g_trace_depth,
+      g_poll_depth  => g_poll_depth,
+      g_f_clk       => g_f_clk,
+      g_tp          => c_tp,
+      g_tp_hs       => c_tp_hs
+    )
+    port map
+    (
+      clk          => aclk,
+      s_rst        => s_rst,
+      eng          => eng,
+      adr          => adr,
+      wr           => r_wr,
+      rd           => r_rd,
+      idata        => idata,
+      odata        => r_odata,
+      pl_adr       => pl_adr,
+      pl_wr        => pl_wr,
+      pl_idata     => idata,
+      pl_odata     => pl_odata,
+      irq          => irq_eng_y,
+      scl_i        => scl_i,
+      sda_i        => sda_i,
+      scl_o        => scl_o,
+      sda_o        => sda_o,
+      scl_pu_o     => scl_pu_o
+    );
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  -- Poll window
+  pl_adr    <= eng & adr;
+  pl_wr     <= wr       when (pl = '1') else "0000";
+  r_wr      <= "0000"   when (pl = '1') else wr;
+  r_rd      <= "0000"   when (pl = '1') else rd;
+  odata     <= pl_odata when (pl = '1') else r_odata;
+  ------------------------------------------------------------------------------
+
+  irq_eng <= irq_eng_y;
+
+  ------------------------------------------------------------------------------
+  irq_proc:
+  process(irq_eng_y)
+    variable v_irq : std_logic;
+  begin
+    v_irq := '0';
+    for i in irq_eng_y'range loop
+      v_irq := v_irq or irq_eng_y(i);
+    end loop;
+    irq <= v_irq;
+  end process irq_proc;
+  ------------------------------------------------------------------------------
+
+end architecture str;
+--==============================================================================
@@ -66,7 +66,8 @@ entity iicmb_m_sq is
     g_f_scl_d     :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #13 (in kHz)
     g_f_scl_e     :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #14 (in kHz)
     g_f_scl_f     :       real                   :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #15 (in kHz)
-    g_cmd         :       seq_cmd_type_array     := c_empty_array -- Sequence of commands (supported: WAIT, SET_BUS and WRITE_BYTE)
+    g_cmd         :       seq_cmd_type_array     := c_empty_array; -- Sequence of commands (supported: WAIT, SET_BUS, WRITE_BYTE, READ_BYTE, WRITE_READ, WRITE_BURST, DATA and END)
+    g_steps       :       natural range 0 to 256 := 0           -- Depth of sequencer program memory (at least g_cmd'length)
     ------------------------------------
   );
   port
@@ -79,6 +80,19 @@ entity iicmb_m_sq is
     cs_start      : in    std_logic;                            -- Start executing command sequence
     cs_busy       :   out std_logic;                            -- Command sequence is being executed
     cs_status     :   out std_logic_vector(2 downto 0);         -- Execution status
+    cs_step       :   out std_logic_vector(7 downto 0);         -- Command being executed or last executed
+    ------------------------------------
+    ------------------------------------
+    -- Sequencer program memory, written by system bus or DMA stream:
+    pm_wr         : in    std_logic                     := '0'; -- Write command (active high, ignored while busy)
+    pm_adr        : in    std_logic_vector( 7 downto 0) := (others => '0'); -- Step of command
+    pm_data       : in    std_logic_vector(31 downto 0) := (others => '0'); -- Command, see 'scmd_encode'
+    ------------------------------------
+    ------------------------------------
+    -- Sequencer result memory, one 'clk' cycle latency:
+    rs_adr        : in    std_logic_vector( 7 downto 0) := (others => '0'); -- Step of result
+    rs_status     :   out std_logic_vector( 2 downto 0);        -- Response of step
+    rs_data       :   out std_logic_vector( 7 downto 0);        -- Received byte of step
     ------------------------------------
     ------------------------------------
     -- I2C interfaces:
@@ -98,7 +112,8 @@ architecture str of iicmb_m_sq is
   component sequencer is
     generic
     (
-      g_cmd       :       seq_cmd_type_array := c_empty_array
+      g_cmd       :       seq_cmd_type_array := c_empty_array;
+      g_steps     :       natural range 0 to 256 := 0
     );
     port
     (
@@ -107,6 +122,13 @@ architecture str of iicmb_m_sq is
       cs_start    : in    std_logic;
       cs_busy     :   out std_logic;
       cs_status   :   out std_logic_vector(2 downto 0);
+      cs_step     :   out std_logic_vector(7 downto 0);
+      pm_wr       : in    std_logic;
+      pm_adr      : in    std_logic_vector( 7 downto 0);
+      pm_data     : in    std_logic_vector(31 downto 0);
+      rs_adr      : in    std_logic_vector( 7 downto 0);
+      rs_status   :   out std_logic_vector( 2 downto 0);
+      rs_data     :   out std_logic_vector( 7 downto 0);
       busy        : in    std_logic;
       captured    : in    std_logic;
       bus_id      : in    std_logic_vector(3 downto 0);
@@ -190,7 +212,8 @@ begin
   sequencer_inst0 : sequencer
     generic map
     (
-      g_cmd       => g_cmd
+      g_cmd       => g_cmd,
+      g_steps     => g_steps
     )
     port map
     (
@@ -199,6 +222,13 @@ begin
       cs_start    => cs_start,
       cs_busy     => cs_busy,
       cs_status   => cs_status,
+      cs_step     => cs_step,
+      pm_wr       => pm_wr,
+      pm_adr      => pm_adr,
+      pm_data     => pm_data,
+      rs_adr      => rs_adr,
+      rs_status   => rs_status,
+      rs_data     => rs_data,
       busy        => busy,
       captured    => captured,
       bus_id      => bus_id,
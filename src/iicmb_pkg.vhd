@@ -64,6 +64,14 @@ package iicmb_pkg is
   constant mcmd_set_bus  : std_logic_vector(2 downto 0) := "110";
   ------------------------------------------------------------------------------
 
+  ------------------------------------------------------------------------------
+  -- Register block command code (only with FIFOs, executed as sequence of
+  -- byte level commands):
+  ------------------------------------------------------------------------------
+  -- Message                         --> Done | Write Not Acknowledged | Arbitration Lost | Error
+  constant mcmd_msg      : std_logic_vector(2 downto 0) := "111";
+  ------------------------------------------------------------------------------
+
   ------------------------------------------------------------------------------
   -- Byte level master mode responses' codes:
   ------------------------------------------------------------------------------
@@ -80,14 +88,44 @@ package iicmb_pkg is
   ------------------------------------------------------------------------------
 
 
+  ------------------------------------------------------------------------------
+  -- Timing of an I2C bus, all values in 'clk' cycles minus one:
+  ------------------------------------------------------------------------------
+  type tp_type is record
+    scl    : unsigned(15 downto 0); -- 'SCL' period (prescaler)
+    high   : unsigned(15 downto 0); -- 'SCL' high time                 t_{HIGH}
+    su_sta : unsigned(15 downto 0); -- Set-up time for repeated Start  t_{SU;STA}
+    hd_sta : unsigned(15 downto 0); -- Hold time (repeated) Start      t_{HD;STA}
+    su_dat : unsigned(15 downto 0); -- Data set-up time                t_{SU;DAT}
+    su_sto : unsigned(15 downto 0); -- Set-up time for Stop            t_{SU;STO}
+    buf    : unsigned(15 downto 0); -- Bus free time                   t_{BUF}
+    vd_dat : unsigned(15 downto 0); -- Data valid time                 t_{VD;DAT}
+  end record;
+  type tp_type_array is array (natural range <>) of tp_type;
+
+  type real_array is array (natural range <>) of real;
+
+  -- Timing for 'SCL' frequency 'a_f_scl' (in kHz) and 'clk' frequency
+  -- 'a_f_clk' (in kHz): Standard mode up to 100 kHz, Fast mode up to 400 kHz,
+  -- Fast-mode Plus up to 1 MHz, High-speed mode above
+  function get_tp(a_f_clk : real; a_f_scl : real) return tp_type;
+
+  -- Timing of 16 buses for 'SCL' frequencies 'a_f_scl' (in kHz) and
+  -- 'clk' frequency 'a_f_clk' (in kHz)
+  function get_tp(a_f_clk : real; a_f_scl : real_array(0 to 15)) return tp_type_array;
+  ------------------------------------------------------------------------------
+
+
   ------------------------------------------------------------------------------
   -- Sequencer related stuff ---------------------------------------------------
-  type seq_cmd_id is (seq_wait, seq_set_bus, seq_write_byte);
+  type seq_cmd_id is (seq_wait, seq_set_bus, seq_write_byte, seq_read_byte, seq_write_read, seq_end,
+                      seq_write_burst, seq_data);
   type seq_cmd_type is record
     id    : seq_cmd_id;
     saddr : std_logic_vector(6 downto 0);
     daddr : std_logic_vector(7 downto 0);
     data  : std_logic_vector(7 downto 0);
+    bdata : std_logic_vector(31 downto 0); -- Burst data word, first byte in bits 7..0
   end record;
   constant c_seq_cmd_default : seq_cmd_type := (id => seq_wait, others => (others => '0'));
   type seq_cmd_type_array is array (natural range <>) of seq_cmd_type;
@@ -98,6 +136,34 @@ package iicmb_pkg is
   function scmd_write_byte(sa : std_logic_vector(6 downto 0);
                            da : std_logic_vector(7 downto 0);
                            d  : std_logic_vector(7 downto 0)) return seq_cmd_type;
+  function scmd_read_byte(sa : std_logic_vector(6 downto 0)) return seq_cmd_type;
+  function scmd_write_read(sa : std_logic_vector(6 downto 0);
+                           da : std_logic_vector(7 downto 0)) return seq_cmd_type;
+  function scmd_end return seq_cmd_type;
+  function scmd_write_burst(sa : std_logic_vector(6 downto 0);
+                            da : std_logic_vector(7 downto 0);
+                            n  : integer range 1 to 256) return seq_cmd_type;
+  function scmd_data(d0 : std_logic_vector(7 downto 0);
+                     d1 : std_logic_vector(7 downto 0) := x"00";
+                     d2 : std_logic_vector(7 downto 0) := x"00";
+                     d3 : std_logic_vector(7 downto 0) := x"00") return seq_cmd_type;
+
+  -- Sequencer program memory word of a command:
+  --   31..28 : opcode 'sop_x'
+  --   22..16 : slave address
+  --   15.. 8 : data address
+  --    7.. 0 : data (WAIT: time in ms, SET_BUS: bus ID, WRITE_BURST: byte count - 1)
+  -- A WRITE_BURST word is followed by ceil(n/4) packed data words holding the
+  -- burst bytes, 4 per word, first byte in bits 7..0.
+  constant sop_end         : std_logic_vector(3 downto 0) := "0000";
+  constant sop_wait        : std_logic_vector(3 downto 0) := "0001";
+  constant sop_set_bus     : std_logic_vector(3 downto 0) := "0010";
+  constant sop_write_byte  : std_logic_vector(3 downto 0) := "0011";
+  constant sop_read_byte   : std_logic_vector(3 downto 0) := "0100";
+  constant sop_write_read  : std_logic_vector(3 downto 0) := "0101";
+  constant sop_write_burst : std_logic_vector(3 downto 0) := "0110";
+
+  function scmd_encode(a : seq_cmd_type) return std_logic_vector;
   -- End of sequencer related stuff --------------------------------------------
   ------------------------------------------------------------------------------
 
@@ -107,6 +173,68 @@ end package iicmb_pkg;
 --==============================================================================
 package body iicmb_pkg is
 
+  ------------------------------------------------------------------------------
+  function get_tp(a_f_clk : real; a_f_scl : real) return tp_type is
+    variable ret        : tp_type;
+    variable v_t_scl    : integer;
+    variable v_t_high   : integer;
+    variable v_t_low    : integer;
+    variable v_t_hold   : integer;
+    variable v_t_vd_dat : integer;
+    variable v_t_buf    : real;
+    variable v_t_vd     : real;
+  begin
+    v_t_scl             := integer((a_f_clk/a_f_scl) + 0.4999);      -- number of 'clk' periods in an 'SCL' period
+    if (a_f_scl <= 100.0) then
+      v_t_high            := integer(real(v_t_scl)*0.401);             -- 'SCL' high time
+      v_t_low             := integer(real(v_t_scl)*0.47);              -- 'SCL' low time
+      v_t_hold            := v_t_high;                                 -- t_{HD;STA}, t_{SU;STO}
+      v_t_buf             := 4.7;                                      -- in microseconds
+      v_t_vd              := 0.5;                                      -- in microseconds
+    elsif (a_f_scl <= 400.0) then
+      v_t_high            := integer(real(v_t_scl)*0.241);             -- 'SCL' high time
+      v_t_low             := integer(real(v_t_scl)*0.52);              -- 'SCL' low time
+      v_t_hold            := v_t_high;                                 -- t_{HD;STA}, t_{SU;STO}
+      v_t_buf             := 1.3;                                      -- in microseconds
+      v_t_vd              := 0.5;                                      -- in microseconds
+    elsif (a_f_scl <= 1000.0) then
+      v_t_high            := integer(real(v_t_scl)*0.261);             -- 'SCL' high time
+      v_t_low             := integer(real(v_t_scl)*0.5);               -- 'SCL' low time
+      v_t_hold            := v_t_high;                                 -- t_{HD;STA}, t_{SU;STO}
+      v_t_buf             := 0.5;                                      -- in microseconds
+      v_t_vd              := 0.2;                                      -- in microseconds
+    else
+      v_t_high            := integer(real(v_t_scl)*0.25);              -- 'SCL' high time
+      v_t_low             := integer(real(v_t_scl)*0.55);              -- 'SCL' low time
+      v_t_hold            := v_t_low;                                  -- t_{HD;STA}, t_{SU;STO} >= t_{LOW}
+      v_t_buf             := 1.3;                                      -- in microseconds, Stop returns to Fast mode
+      v_t_vd              := 0.03;                                     -- in microseconds
+    end if;
+    v_t_vd_dat          := integer((a_f_clk*(v_t_vd/1000.0)) + 0.4999);
+    --
+    ret.scl             := to_unsigned(v_t_scl - 1, 16);
+    ret.high            := to_unsigned(v_t_high - 1, 16);
+    ret.su_sta          := to_unsigned(v_t_low - 1, 16);
+    ret.hd_sta          := to_unsigned(v_t_hold - 1, 16);
+    ret.su_dat          := to_unsigned(v_t_low - v_t_vd_dat - 1, 16);
+    ret.su_sto          := to_unsigned(v_t_hold - 1, 16);
+    ret.buf             := to_unsigned(integer((a_f_clk*(v_t_buf/1000.0)) + 0.4999) - 1, 16);
+    ret.vd_dat          := to_unsigned(v_t_vd_dat - 1, 16);
+    return ret;
+  end function get_tp;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  function get_tp(a_f_clk : real; a_f_scl : real_array(0 to 15)) return tp_type_array is
+    variable ret        : tp_type_array(0 to 15);
+  begin
+    for i in ret'range loop
+      ret(i)              := get_tp(a_f_clk, a_f_scl(i));
+    end loop;
+    return ret;
+  end function get_tp;
+  ------------------------------------------------------------------------------
+
   ------------------------------------------------------------------------------
   function scmd_wait(a : integer range 0 to 255) return seq_cmd_type is
     variable ret : seq_cmd_type;
@@ -115,6 +243,7 @@ package body iicmb_pkg is
     ret.saddr := (others => '0');
     ret.daddr := (others => '0');
     ret.data  := std_logic_vector(to_unsigned(a, 8));
+    ret.bdata := (others => '0');
     return ret;
   end function scmd_wait;
   ------------------------------------------------------------------------------
@@ -127,6 +256,7 @@ package body iicmb_pkg is
     ret.saddr := (others => '0');
     ret.daddr := (others => '0');
     ret.data  := std_logic_vector(to_unsigned(a, 8));
+    ret.bdata := (others => '0');
     return ret;
   end function scmd_set_bus;
   ------------------------------------------------------------------------------
@@ -141,10 +271,104 @@ package body iicmb_pkg is
     ret.saddr := sa;
     ret.daddr := da;
     ret.data  := d;
+    ret.bdata := (others => '0');
     return ret;
   end function scmd_write_byte;
   ------------------------------------------------------------------------------
 
+  ------------------------------------------------------------------------------
+  function scmd_read_byte(sa : std_logic_vector(6 downto 0)) return seq_cmd_type is
+    variable ret : seq_cmd_type;
+  begin
+    ret.id    := seq_read_byte;
+    ret.saddr := sa;
+    ret.daddr := (others => '0');
+    ret.data  := (others => '0');
+    ret.bdata := (others => '0');
+    return ret;
+  end function scmd_read_byte;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  function scmd_write_read(sa : std_logic_vector(6 downto 0);
+                           da : std_logic_vector(7 downto 0)) return seq_cmd_type is
+    variable ret : seq_cmd_type;
+  begin
+    ret.id    := seq_write_read;
+    ret.saddr := sa;
+    ret.daddr := da;
+    ret.data  := (others => '0');
+    ret.bdata := (others => '0');
+    return ret;
+  end function scmd_write_read;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  function scmd_end return seq_cmd_type is
+    variable ret : seq_cmd_type;
+  begin
+    ret.id    := seq_end;
+    ret.saddr := (others => '0');
+    ret.daddr := (others => '0');
+    ret.data  := (others => '0');
+    ret.bdata := (others => '0');
+    return ret;
+  end function scmd_end;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  function scmd_write_burst(sa : std_logic_vector(6 downto 0);
+                            da : std_logic_vector(7 downto 0);
+                            n  : integer range 1 to 256) return seq_cmd_type is
+    variable ret : seq_cmd_type;
+  begin
+    ret.id    := seq_write_burst;
+    ret.saddr := sa;
+    ret.daddr := da;
+    ret.data  := std_logic_vector(to_unsigned(n - 1, 8));
+    ret.bdata := (others => '0');
+    return ret;
+  end function scmd_write_burst;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  function scmd_data(d0 : std_logic_vector(7 downto 0);
+                     d1 : std_logic_vector(7 downto 0) := x"00";
+                     d2 : std_logic_vector(7 downto 0) := x"00";
+                     d3 : std_logic_vector(7 downto 0) := x"00") return seq_cmd_type is
+    variable ret : seq_cmd_type;
+  begin
+    ret.id    := seq_data;
+    ret.saddr := (others => '0');
+    ret.daddr := (others => '0');
+    ret.data  := (others => '0');
+    ret.bdata := d3 & d2 & d1 & d0;
+    return ret;
+  end function scmd_data;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  function scmd_encode(a : seq_cmd_type) return std_logic_vector is
+    variable ret : std_logic_vector(31 downto 0);
+  begin
+    ret := (others => '0');
+    case a.id is
+      when seq_wait        => ret(31 downto 28) := sop_wait;
+      when seq_set_bus     => ret(31 downto 28) := sop_set_bus;
+      when seq_write_byte  => ret(31 downto 28) := sop_write_byte;
+      when seq_read_byte   => ret(31 downto 28) := sop_read_byte;
+      when seq_write_read  => ret(31 downto 28) := sop_write_read;
+      when seq_end         => ret(31 downto 28) := sop_end;
+      when seq_write_burst => ret(31 downto 28) := sop_write_burst;
+      when seq_data        => return a.bdata;
+    end case;
+    ret(22 downto 16) := a.saddr;
+    ret(15 downto  8) := a.daddr;
+    ret( 7 downto  0) := a.data;
+    return ret;
+  end function scmd_encode;
+  ------------------------------------------------------------------------------
+
 end package body iicmb_pkg;
 --==============================================================================
 
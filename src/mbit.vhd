@@ -39,7 +39,9 @@
 
 library ieee;
 use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
 
+use work.iicmb_pkg.all;
 use work.iicmb_int_pkg.all;
 
 
@@ -48,23 +50,7 @@ entity mbit is
   generic
   (
     g_bus_num :       positive range 1 to 16 := 1;  -- Number of connected I2C buses
-    g_f_clk   :       real           := 100000.0;   -- Frequency of 'clk' clock (in kHz)
-    g_f_scl_0 :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #0 (in kHz)
-    g_f_scl_1 :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #1 (in kHz)
-    g_f_scl_2 :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #2 (in kHz)
-    g_f_scl_3 :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #3 (in kHz)
-    g_f_scl_4 :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #4 (in kHz)
-    g_f_scl_5 :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #5 (in kHz)
-    g_f_scl_6 :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #6 (in kHz)
-    g_f_scl_7 :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #7 (in kHz)
-    g_f_scl_8 :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #8 (in kHz)
-    g_f_scl_9 :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #9 (in kHz)
-    g_f_scl_a :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #10 (in kHz)
-    g_f_scl_b :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #11 (in kHz)
-    g_f_scl_c :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #12 (in kHz)
-    g_f_scl_d :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #13 (in kHz)
-    g_f_scl_e :       real           :=    100.0;   -- Frequency of 'SCL' clock of I2C bus #14 (in kHz)
-    g_f_scl_f :       real           :=    100.0    -- Frequency of 'SCL' clock of I2C bus #15 (in kHz)
+    g_f_clk   :       real           := 100000.0    -- Frequency of 'clk' clock (in kHz)
   );
   port
   (
@@ -75,6 +61,9 @@ entity mbit is
     ------------------------------------
     fsm_state :   out std_logic_vector(3 downto 0); -- FSM state
     bus_id    : in    natural range 0 to g_bus_num - 1; -- I2C Bus ID
+    tp        : in    tp_type_array(0 to 15);       -- Timing of I2C buses
+    tp_hs     : in    tp_type;                      -- Timing of High-speed mode
+    hs        : in    std_logic;                    -- High-speed mode active (active high)
     ------------------------------------
     ------------------------------------
     mbc_wr    : in    std_logic;                    -- Bit command write indication (active high)
@@ -89,7 +78,8 @@ entity mbit is
     sda_i     : in    std_logic;                    -- I2C Data input
     scl_i_d   : in    std_logic;                    -- I2C Clock input delayed for 1 clock cycle
     scl_o     :   out std_logic      := '1';        -- I2C Clock output
-    sda_o     :   out std_logic      := '1'         -- I2C Data output
+    sda_o     :   out std_logic      := '1';        -- I2C Data output
+    scl_pu    :   out std_logic      := '0'         -- I2C Clock current-source pull-up enable (active high)
     ------------------------------------
   );
 end entity mbit;
@@ -98,72 +88,7 @@ end entity mbit;
 --==============================================================================
 architecture rtl of mbit is
 
-  type real_array is array (natural range <>) of real;
-  constant c_f_scl : real_array(0 to 15) := (g_f_scl_0, g_f_scl_1, g_f_scl_2, g_f_scl_3,
-                                             g_f_scl_4, g_f_scl_5, g_f_scl_6, g_f_scl_7,
-                                             g_f_scl_8, g_f_scl_9, g_f_scl_a, g_f_scl_b,
-                                             g_f_scl_c, g_f_scl_d, g_f_scl_e, g_f_scl_f);
-
-  type timing_parameters_type is record
-    max_cnt       : integer; -- Minimum number of 'clk' cycles in single 'SCL' cycle
-    fe_cnt        : integer; -- Time for falling edge of 'SCL'
-    t_hd_sta_cnt  : integer; -- Hold time (repeated) Start condition
-    t_vd_dat_cnt  : integer; -- Data valid time
-    t_high_cnt    : integer; -- 'SCL' high time
-    t_su_sto_cnt  : integer; -- Set-up time for Stop condition
-    t_su_sta_cnt  : integer; -- Set-up time for a repeated Start condition
-    t_su_dat_cnt  : integer; -- Data set-up time
-  end record;
-
-  type timing_parameters_type_array is array (0 to g_bus_num - 1) of timing_parameters_type;
-
-  ------------------------------------------------------------------------------
-  function get_tp(a_f_clk : real; a_f_scl : real_array(0 to 15)) return timing_parameters_type_array is
-    variable ret        : timing_parameters_type_array;
-    variable v_t_scl    : integer;
-    variable v_t_high   : integer;
-    variable v_t_low    : integer;
-    variable v_t_vd_dat : integer;
-  begin
-    for i in ret'range loop
-      v_t_scl             := integer((a_f_clk/a_f_scl(i)) + 0.4999);   -- number of 'clk' periods in an 'SCL' period
-      if (a_f_scl(i) <= 100.0) then
-        v_t_high            := integer(real(v_t_scl)*0.401);             -- 'SCL' high time
-        v_t_low             := integer(real(v_t_scl)*0.47);              -- 'SCL' low time
-      else
-        v_t_high            := integer(real(v_t_scl)*0.241);             -- 'SCL' high time
-        v_t_low             := integer(real(v_t_scl)*0.52);              -- 'SCL' low time
-      end if;
-      v_t_vd_dat          := integer((a_f_clk*(0.5/1000.0)) + 0.4999);
-      --
-      ret(i).max_cnt      := v_t_scl - 1;
-      ret(i).fe_cnt       := v_t_low - v_t_vd_dat + v_t_high - 1;
-      ret(i).t_hd_sta_cnt := v_t_high - 1;
-      ret(i).t_vd_dat_cnt := v_t_vd_dat - 1;
-      ret(i).t_high_cnt   := v_t_high - 1;
-      ret(i).t_su_sto_cnt := v_t_high - 1;
-      ret(i).t_su_sta_cnt := v_t_low - 1;
-      ret(i).t_su_dat_cnt := v_t_low - v_t_vd_dat - 1;
-    end loop;
-    return ret;
-  end function get_tp;
-  ------------------------------------------------------------------------------
-
-  ------------------------------------------------------------------------------
-  function get_max_cnt(a : timing_parameters_type_array) return integer is
-    variable ret        : integer := 0;
-  begin
-    for i in a'range loop
-      if (ret < a(i).max_cnt) then
-        ret := a(i).max_cnt;
-      end if;
-    end loop;
-    return ret;
-  end function get_max_cnt;
-  ------------------------------------------------------------------------------
-
-  constant c_tp            : timing_parameters_type_array := get_tp(g_f_clk, c_f_scl);
-  constant c_max_cnt       : integer := get_max_cnt(c_tp);
+  constant c_max_cnt       : integer := 2**16 - 1;
 
   type state_type is
     (
@@ -221,44 +146,42 @@ architecture rtl of mbit is
   signal   scl_cnt         : integer range 0 to c_max_cnt := 0;      -- Counter of cycles when scl is stable
 
   -- Timing parameters:
-  signal   max_cnt         : integer range 0 to c_max_cnt := c_tp(0).max_cnt;
-  signal   fe_cnt          : integer range 0 to c_max_cnt := c_tp(0).fe_cnt;
-  signal   t_hd_sta_cnt    : integer range 0 to c_max_cnt := c_tp(0).t_hd_sta_cnt;
-  signal   t_vd_dat_cnt    : integer range 0 to c_max_cnt := c_tp(0).t_vd_dat_cnt;
-  signal   t_high_cnt      : integer range 0 to c_max_cnt := c_tp(0).t_high_cnt;
-  signal   t_su_sto_cnt    : integer range 0 to c_max_cnt := c_tp(0).t_su_sto_cnt;
-  signal   t_su_sta_cnt    : integer range 0 to c_max_cnt := c_tp(0).t_su_sta_cnt;
-  signal   t_su_dat_cnt    : integer range 0 to c_max_cnt := c_tp(0).t_su_dat_cnt;
+  signal   max_cnt         : integer range 0 to c_max_cnt     := 0;
+  signal   fe_cnt          : integer range 0 to 2*c_max_cnt+1 := 0;
+  signal   t_hd_sta_cnt    : integer range 0 to c_max_cnt     := 0;
+  signal   t_vd_dat_cnt    : integer range 0 to c_max_cnt     := 0;
+  signal   t_high_cnt      : integer range 0 to c_max_cnt     := 0;
+  signal   t_su_sto_cnt    : integer range 0 to c_max_cnt     := 0;
+  signal   t_su_sta_cnt    : integer range 0 to c_max_cnt     := 0;
+  signal   t_su_dat_cnt    : integer range 0 to c_max_cnt     := 0;
 
 begin
 
   fsm_state <= to_std_logic_vector(state);
 
   ------------------------------------------------------------------------------
-  -- Changing timing parameters:
+  -- Changing timing parameters, loaded at runtime by register block,
+  -- High-speed mode timing after master code:
   tp_proc:
   process(clk)
+    variable v_tp : tp_type;
   begin
     if rising_edge(clk) then
       if (s_rst = '1') then
-        max_cnt      <= c_tp(0).max_cnt;
-        fe_cnt       <= c_tp(0).fe_cnt;
-        t_hd_sta_cnt <= c_tp(0).t_hd_sta_cnt;
-        t_vd_dat_cnt <= c_tp(0).t_vd_dat_cnt;
-        t_high_cnt   <= c_tp(0).t_high_cnt;
-        t_su_sto_cnt <= c_tp(0).t_su_sto_cnt;
-        t_su_sta_cnt <= c_tp(0).t_su_sta_cnt;
-        t_su_dat_cnt <= c_tp(0).t_su_dat_cnt;
+        v_tp := tp(0);
+      elsif (hs = '1') then
+        v_tp := tp_hs;
       else
-        max_cnt      <= c_tp(bus_id).max_cnt;
-        fe_cnt       <= c_tp(bus_id).fe_cnt;
-        t_hd_sta_cnt <= c_tp(bus_id).t_hd_sta_cnt;
-        t_vd_dat_cnt <= c_tp(bus_id).t_vd_dat_cnt;
-        t_high_cnt   <= c_tp(bus_id).t_high_cnt;
-        t_su_sto_cnt <= c_tp(bus_id).t_su_sto_cnt;
-        t_su_sta_cnt <= c_tp(bus_id).t_su_sta_cnt;
-        t_su_dat_cnt <= c_tp(bus_id).t_su_dat_cnt;
+        v_tp := tp(bus_id);
       end if;
+      max_cnt      <= to_integer(v_tp.scl);
+      fe_cnt       <= to_integer(v_tp.su_dat) + to_integer(v_tp.high) + 1;
+      t_hd_sta_cnt <= to_integer(v_tp.hd_sta);
+      t_vd_dat_cnt <= to_integer(v_tp.vd_dat);
+      t_high_cnt   <= to_integer(v_tp.high);
+      t_su_sto_cnt <= to_integer(v_tp.su_sto);
+      t_su_sta_cnt <= to_integer(v_tp.su_sta);
+      t_su_dat_cnt <= to_integer(v_tp.su_dat);
     end if;
   end process tp_proc;
   ------------------------------------------------------------------------------
@@ -529,6 +452,27 @@ begin
   end process scl_sda_proc;
   ------------------------------------------------------------------------------
 
+  ------------------------------------------------------------------------------
+  -- Current-source pull-up of 'SCL', only in High-speed mode while 'SCL' is
+  -- released by the master:
+  scl_pu_proc:
+  process(clk)
+  begin
+    if rising_edge(clk) then
+      if (s_rst = '1') then
+        scl_pu <= '0';
+      else
+        case state is
+          when s_rw_b | s_rw_c | s_stop_b | s_stop_c | s_rstart_b | s_rstart_c =>
+            scl_pu <= hs;
+          when others =>
+            scl_pu <= '0';
+        end case;
+      end if;
+    end if;
+  end process scl_pu_proc;
+  ------------------------------------------------------------------------------
+
 end architecture rtl;
 --==============================================================================
 
@@ -67,6 +67,11 @@ entity mbyte is
     fsm_state   :   out std_logic_vector(3 downto 0);              -- FSM state
     ------------------------------------
     ------------------------------------
+    hs_en       : in    std_logic                    := '0';       -- Start enters High-speed mode (active high)
+    hs_code     : in    std_logic_vector(2 downto 0) := "000";     -- Master code of High-speed mode
+    hs          :   out std_logic                    := '0';       -- High-speed mode active (active high)
+    ------------------------------------
+    ------------------------------------
     mcmd_wr     : in    std_logic;                                 -- Byte command write (active high)
     mcmd_id     : in    std_logic_vector(2 downto 0);              -- Byte command ID
     mcmd_data   : in    std_logic_vector(7 downto 0);              -- Byte command data
@@ -104,7 +109,9 @@ architecture rtl of mbyte is
     s_stop,          -- Sending Stop Condition (Releasing the bus)
     s_write,         -- Sending a byte
     s_read,          -- Receiving a byte
-    s_wait           -- Receiving a byte
+    s_wait,          -- Receiving a byte
+    s_hs_code,       -- Sending master code of High-speed mode
+    s_hs_start       -- Sending Repeated Start in High-speed mode
   );
 
   ------------------------------------------------------------------------------
@@ -120,6 +127,8 @@ architecture rtl of mbyte is
       when s_write         => return "0101";
       when s_read          => return "0110";
       when s_wait          => return "0111";
+      when s_hs_code       => return "1000";
+      when s_hs_start      => return "1001";
     end case;
   end function to_std_logic_vector;
   ------------------------------------------------------------------------------
@@ -130,11 +139,13 @@ architecture rtl of mbyte is
   signal   ack             : std_logic                          := '0';
   signal   cycle_cnt       : integer range 0 to c_cycle_cnt_max := 0;
   signal   ms_cnt          : unsigned( 7 downto 0)              := to_unsigned(0, 8);
+  signal   hs_y            : std_logic                          := '0';
 
 begin
 
   mrsp_data <= sbuf;
   fsm_state <= to_std_logic_vector(state);
+  hs        <= hs_y;
 
   ------------------------------------------------------------------------------
   -- Main FSM:
@@ -191,6 +202,7 @@ begin
         captured  <= '0';
         cycle_cnt <= 0;
         ms_cnt    <= to_unsigned(0, 8);
+        hs_y      <= '0';
       else
         -- Default:
         mbc_wr    <= '0';
@@ -228,6 +240,7 @@ begin
               cnt       <= 0;
             end if;
             captured  <= '0';
+            hs_y      <= '0';
           -- 'Idle' state ----------------------------------
 
           -- 'Wait' state ----------------------------------
@@ -295,7 +308,14 @@ begin
           -- 'Start' state ---------------------------------
           when s_start =>
             if (mbr_wr = '1') then
-              if (mbr = mbr_done) then
+              if (mbr = mbr_done)and(hs_en = '1')and(hs_y = '0') then
+                -- Master code '00001XXX' in Fast mode, not acknowledged
+                state     <= s_hs_code;
+                captured  <= '1';
+                sbuf      <= "0001" & hs_code & '0';
+                cnt       <= 0;
+                bit_command('0');
+              elsif (mbr = mbr_done) then
                 state     <= s_bus_taken;
                 captured  <= '1';
                 byte_response(mrsp_done);
@@ -395,6 +415,60 @@ begin
               end case;
             end if;
           -- 'Byte Writing' state --------------------------
+
+          -- 'Master Code' state ---------------------------
+          when s_hs_code =>
+            captured  <= '1';
+            if (mbr_wr = '1') then
+              case (cnt) is
+                when 8 =>
+                  if (mbr = mbr_error) then
+                    -- Something went wrong
+                    state     <= s_idle;
+                    captured  <= '0';
+                    byte_response(mrsp_error);
+                  else
+                    -- Acknowledge is ignored, switch to High-speed mode
+                    state     <= s_hs_start;
+                    hs_y      <= '1';
+                    bit_command(mbc_start);
+                  end if;
+                when others =>
+                  if (mbr = mbr_done) then
+                    sbuf      <= sbuf(6 downto 0) & '0';
+                    cnt       <= cnt + 1;
+                    if (cnt = 7) then
+                      -- Read Ack/Nak
+                      bit_command(mbc_read);
+                    else
+                      -- Write a bit
+                      bit_command(sbuf(7));
+                    end if;
+                  else
+                    -- (mbr = mbr_arb_lost), other master with lower master code
+                    state     <= s_idle;
+                    captured  <= '0';
+                    byte_response(mrsp_arb_lost);
+                  end if;
+              end case;
+            end if;
+          -- 'Master Code' state ---------------------------
+
+          -- 'High-speed Start' state ----------------------
+          when s_hs_start =>
+            captured  <= '1';
+            if (mbr_wr = '1') then
+              if (mbr = mbr_done) then
+                state     <= s_bus_taken;
+                byte_response(mrsp_done);
+              else
+                -- (mbr = mbr_arb_lost)
+                state     <= s_idle;
+                captured  <= '0';
+                byte_response(mrsp_arb_lost);
+              end if;
+            end if;
+          -- 'High-speed Start' state ----------------------
         end case;
       end if;
     end if;
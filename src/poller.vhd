@@ -0,0 +1,443 @@
+
+--==============================================================================
+--                                                                             |
+--    Project: IIC Multiple Bus Controller (IICMB)                             |
+--                                                                             |
+--    Module:  Autonomous polling engine for 'iicmb_m'.                        |
+--    Version:                                                                 |
+--             1.0,   October 16, 2026                                         |
+--                                                                             |
+--    Author:  IICMB contributors                                              |
+--                                                                             |
+--==============================================================================
+--==============================================================================
+-- Copyright (c) 2016, Sergey Shuvalkin                                        |
+-- All rights reserved.                                                        |
+--                                                                             |
+-- Redistribution and use in source and binary forms, with or without          |
+-- modification, are permitted provided that the following conditions are met: |
+--                                                                             |
+-- 1. Redistributions of source code must retain the above copyright notice,   |
+--    this list of conditions and the following disclaimer.                    |
+-- 2. Redistributions in binary form must reproduce the above copyright        |
+--    notice, this list of conditions and the following disclaimer in the      |
+--    documentation and/or other materials provided with the distribution.     |
+--                                                                             |
+-- THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" |
+-- AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE   |
+-- IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE  |
+-- ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE    |
+-- LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR         |
+-- CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF        |
+-- SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS    |
+-- INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN     |
+-- CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)     |
+-- ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE  |
+-- POSSIBILITY OF SUCH DAMAGE.                                                 |
+--==============================================================================
+
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+use work.iicmb_pkg.all;
+
+
+
+--==============================================================================
+-- The poller scans a table of 'g_entries' read requests round robin. An entry
+-- is read from its slave when enabled and at least its period has passed since
+-- the last poll. The poller requests the byte level interface of the engine
+-- serving the bus of the entry ('pl_req', 'pl_bus') and runs the poll when it
+-- is granted ('pl_gnt'): Set Bus, Start, slave address, register, Start, slave
+-- address, 1 to 4 data bytes, Stop and a final Set Bus back to the bus
+-- selected before ('bus_id' at grant). A NAK releases the bus with Stop. The
+-- entry is latched when the poll starts, table writes take effect with the
+-- next poll. Every poll stores its status and timestamp in the shadow memory,
+-- the data only when the read succeeded, so telemetry can be taken by a
+-- single load without running an I2C transaction. An entry with a bus ID not
+-- below 'g_bus_num' or a poll that loses the grant stores 'mrsp_error'.
+--
+-- Register window ('adr' is the word address):
+--   000..0FF : shadow memory, read only
+--   100..1FD : table, read and write
+--   1FF      : PLCR, bit 0: enable polling, bit 1: poll running (read only)
+-- Table word 0 (100 + entry * 2):
+--   31     : enable
+--   27..24 : bus ID
+--   22..16 : slave address
+--   15.. 8 : register
+--    1.. 0 : data length - 1
+-- Table word 1 (100 + entry * 2 + 1):
+--   15.. 0 : period in ms
+-- Shadow word 0 (entry * 2):
+--   31.. 0 : data, first byte in bits 7..0
+-- Shadow word 1 (entry * 2 + 1):
+--   31     : valid, entry was polled at least once
+--   18..16 : response of last poll (see 'mrsp_x')
+--   15.. 0 : timestamp of last poll in ms
+--==============================================================================
+entity poller is
+  generic
+  (
+    g_bus_num   :       positive range 1 to 16  := 1;         -- Number of separate I2C buses
+    g_entries   :       positive range 1 to 127 := 8;         -- Number of table entries
+    g_f_clk     :       real                    := 100000.0   -- Frequency of system clock 'clk' (in kHz)
+  );
+  port
+  (
+    ------------------------------------
+    clk         : in    std_logic;                            -- Clock input
+    s_rst       : in    std_logic;                            -- Synchronous reset (active high)
+    ------------------------------------
+    ------------------------------------
+    -- Register access:
+    adr         : in    std_logic_vector( 8 downto 0);        -- Word address
+    wr          : in    std_logic_vector( 3 downto 0);        -- Write (active high)
+    idata       : in    std_logic_vector(31 downto 0);        -- Data from System Bus
+    odata       :   out std_logic_vector(31 downto 0);        -- Data to System Bus
+    ------------------------------------
+    ------------------------------------
+    -- Byte level interface arbitration:
+    pl_req      :   out std_logic;                            -- Request byte level interface
+    pl_bus      :   out std_logic_vector(3 downto 0);         -- I2C bus of request
+    pl_gnt      : in    std_logic;                            -- Byte level interface granted
+    bus_id      : in    std_logic_vector(3 downto 0);         -- ID of selected I2C bus of granted engine
+    ------------------------------------
+    ------------------------------------
+    -- 'Generic interface' signals:
+    mcmd_wr     :   out std_logic;                            -- Byte command write (active high)
+    mcmd_id     :   out std_logic_vector(2 downto 0);         -- Byte command ID
+    mcmd_data   :   out std_logic_vector(7 downto 0);         -- Command data
+    --
+    mrsp_wr     : in    std_logic;                            -- Byte response write (active high)
+    mrsp_id     : in    std_logic_vector(2 downto 0);         -- Byte response ID
+    mrsp_data   : in    std_logic_vector(7 downto 0)          -- Response data
+    ------------------------------------
+  );
+end entity poller;
+--==============================================================================
+
+--==============================================================================
+architecture rtl of poller is
+
+  constant c_ms      : positive := integer(g_f_clk);         -- 'clk' cycles per ms
+  constant c_plcr    : std_logic_vector(8 downto 0) := "111111111";
+
+  type cfg_type  is array (0 to g_entries - 1) of std_logic_vector(31 downto 0);
+  type time_type is array (0 to g_entries - 1) of std_logic_vector(15 downto 0);
+
+  ------------------------------------------------------------------------------
+  -- Byte level command 'p' of a poll (ID & data), 'b' is the bus to restore
+  function get_mcmd(a : std_logic_vector(31 downto 0); b : std_logic_vector(3 downto 0);
+                    p : natural; last : boolean) return std_logic_vector is
+    variable v_ret   : std_logic_vector(10 downto 0);
+  begin
+    case p is
+      when 0      => v_ret := mcmd_set_bus & "0000" & a(27 downto 24);
+      when 1      => v_ret := mcmd_start & x"00";
+      when 2      => v_ret := mcmd_write & a(22 downto 16) & '0';
+      when 3      => v_ret := mcmd_write & a(15 downto 8);
+      when 4      => v_ret := mcmd_start & x"00";
+      when 5      => v_ret := mcmd_write & a(22 downto 16) & '1';
+      when 6      =>
+        if (last) then
+          v_ret := mcmd_read_nak & x"00";
+        else
+          v_ret := mcmd_read_ack & x"00";
+        end if;
+      when 7      => v_ret := mcmd_stop & x"00";
+      when others => v_ret := mcmd_set_bus & "0000" & b;
+    end case;
+    return v_ret;
+  end function get_mcmd;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  -- Byte lanes 'wr' of 'd' replace the ones of 'q'
+  function set_lanes(q : std_logic_vector(31 downto 0); d : std_logic_vector(31 downto 0);
+                     wr : std_logic_vector(3 downto 0)) return std_logic_vector is
+    variable v_ret : std_logic_vector(31 downto 0);
+  begin
+    v_ret := q;
+    for i in 0 to 3 loop
+      if (wr(i) = '1') then
+        v_ret(8*i + 7 downto 8*i) := d(8*i + 7 downto 8*i);
+      end if;
+    end loop;
+    return v_ret;
+  end function set_lanes;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  -- Table and shadow memory:
+  signal   tb_cfg    : cfg_type                          := (others => (others => '0'));
+  signal   tb_per    : time_type                         := (others => (others => '0'));
+  signal   tb_last   : time_type                         := (others => (others => '0'));
+  signal   sh_dat    : cfg_type                          := (others => (others => '0'));
+  signal   sh_sts    : cfg_type                          := (others => (others => '0'));
+  signal   sh_wr     : std_logic                         := '0';
+  signal   sh_wr_dat : std_logic                         := '0';
+  signal   sh_wadr   : integer range 0 to g_entries - 1  := 0;
+  signal   sh_wdat   : std_logic_vector(31 downto 0)     := (others => '0');
+  signal   sh_wsts   : std_logic_vector(31 downto 0)     := (others => '0');
+  signal   en_reg    : std_logic                         := '0';
+  signal   a_ent     : integer range 0 to 127;
+  ------------------------------------------------------------------------------
+
+  -- Timestamp:
+  signal   ms_cnt    : integer range 0 to c_ms - 1       := 0;
+  signal   now       : unsigned(15 downto 0)             := (others => '0');
+
+  type state_type is (s_idle, s_check, s_request, s_issue, s_active, s_store);
+  signal   state     : state_type                        := s_idle;
+  signal   idx       : integer range 0 to g_entries - 1  := 0;
+  signal   cfg_q     : std_logic_vector(31 downto 0)     := (others => '0');
+  signal   bus_q     : std_logic_vector( 3 downto 0)     := (others => '0');
+  signal   phase     : integer range 0 to 8              := 0;
+  signal   bcnt      : integer range 0 to 3              := 0;
+  signal   status    : std_logic_vector( 2 downto 0)     := (others => '0');
+  signal   rx_data   : std_logic_vector(31 downto 0)     := (others => '0');
+  signal   busy_y    : std_logic                         := '0';
+  signal   pl_req_y  : std_logic                         := '0';
+
+begin
+
+  pl_req <= pl_req_y;
+  pl_bus <= cfg_q(27 downto 24);
+
+  a_ent  <= to_integer(unsigned(adr(7 downto 1)));
+
+  ------------------------------------------------------------------------------
+  -- Register read
+  odata  <= x"0000000" & "00" & busy_y & en_reg  when (adr = c_plcr) else
+            (others => '0')                      when (a_ent >= g_entries) else
+            sh_dat(a_ent)                        when (adr(8) = '0')and(adr(0) = '0') else
+            sh_sts(a_ent)                        when (adr(8) = '0') else
+            tb_cfg(a_ent)                        when (adr(0) = '0') else
+            x"0000" & tb_per(a_ent);
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  tb_proc:
+  process(clk)
+    variable v_per : std_logic_vector(31 downto 0);
+  begin
+    if rising_edge(clk) then
+      if (s_rst = '1') then
+        en_reg <= '0';
+      elsif (adr = c_plcr) then
+        if (wr(0) = '1') then
+          en_reg <= idata(0);
+        end if;
+      elsif (wr /= "0000")and(adr(8) = '1')and(a_ent < g_entries) then
+        if (adr(0) = '0') then
+          tb_cfg(a_ent) <= set_lanes(tb_cfg(a_ent), idata, wr);
+        else
+          v_per         := set_lanes(x"0000" & tb_per(a_ent), idata, wr);
+          tb_per(a_ent) <= v_per(15 downto 0);
+        end if;
+      end if;
+    end if;
+  end process tb_proc;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  sh_proc:
+  process(clk)
+  begin
+    if rising_edge(clk) then
+      if (sh_wr = '1') then
+        sh_sts(sh_wadr) <= sh_wsts;
+        if (sh_wr_dat = '1') then
+          sh_dat(sh_wadr) <= sh_wdat;
+        end if;
+      end if;
+    end if;
+  end process sh_proc;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  time_proc:
+  process(clk)
+  begin
+    if rising_edge(clk) then
+      if (s_rst = '1') then
+        ms_cnt <= 0;
+        now    <= (others => '0');
+      elsif (ms_cnt = c_ms - 1) then
+        ms_cnt <= 0;
+        now    <= now + 1;
+      else
+        ms_cnt <= ms_cnt + 1;
+      end if;
+    end if;
+  end process time_proc;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  state_proc:
+  process(clk)
+    variable v_mcmd : std_logic_vector(10 downto 0);
+  begin
+    if rising_edge(clk) then
+      if (s_rst = '1') then
+        state     <= s_idle;
+        idx       <= 0;
+        cfg_q     <= (others => '0');
+        bus_q     <= (others => '0');
+        phase     <= 0;
+        bcnt      <= 0;
+        status    <= mrsp_done;
+        rx_data   <= (others => '0');
+        busy_y    <= '0';
+        pl_req_y  <= '0';
+        sh_wr     <= '0';
+        sh_wr_dat <= '0';
+        sh_wadr   <= 0;
+        sh_wdat   <= (others => '0');
+        sh_wsts   <= (others => '0');
+        mcmd_wr   <= '0';
+        mcmd_id   <= "000";
+        mcmd_data <= "00000000";
+      else
+        -- Defaults:
+        mcmd_wr   <= '0';
+        sh_wr     <= '0';
+
+        -- FSM:
+        case state is
+          -------------- 's_idle' state ------------------------
+          when s_idle    =>
+            busy_y    <= '0';
+            if (en_reg = '1') then
+              state     <= s_check;
+            end if;
+          -------------- 's_idle' state ------------------------
+
+          -------------- 's_check' state -----------------------
+          -- Entry is latched, table writes do not affect a running poll
+          when s_check   =>
+            cfg_q     <= tb_cfg(idx);
+            phase     <= 0;
+            bcnt      <= 0;
+            status    <= mrsp_done;
+            rx_data   <= (others => '0');
+            if (en_reg = '0') then
+              state     <= s_idle;
+            elsif (tb_cfg(idx)(31) = '1') and (now - unsigned(tb_last(idx)) >= unsigned(tb_per(idx))) then
+              busy_y    <= '1';
+              if (to_integer(unsigned(tb_cfg(idx)(27 downto 24))) < g_bus_num) then
+                state     <= s_request;
+                pl_req_y  <= '1';
+              else
+                state     <= s_store;
+                status    <= mrsp_error;
+              end if;
+            else
+              if (idx = g_entries - 1) then
+                idx       <= 0;
+              else
+                idx       <= idx + 1;
+              end if;
+            end if;
+          -------------- 's_check' state -----------------------
+
+          -------------- 's_request' state ---------------------
+          when s_request =>
+            if (pl_gnt = '1') then
+              state     <= s_issue;
+              bus_q     <= bus_id;
+            elsif (en_reg = '0') then
+              state     <= s_idle;
+              pl_req_y  <= '0';
+            end if;
+          -------------- 's_request' state ---------------------
+
+          -------------- 's_issue' state -----------------------
+          when s_issue   =>
+            v_mcmd    := get_mcmd(cfg_q, bus_q, phase, bcnt = to_integer(unsigned(cfg_q(1 downto 0))));
+            if (pl_gnt = '0') then
+              state     <= s_store;
+              status    <= mrsp_error;
+            else
+              state     <= s_active;
+              mcmd_wr   <= '1';
+              mcmd_id   <= v_mcmd(10 downto 8);
+              mcmd_data <= v_mcmd( 7 downto 0);
+            end if;
+          -------------- 's_issue' state -----------------------
+
+          -------------- 's_active' state ----------------------
+          when s_active  =>
+            if (pl_gnt = '0') then
+              state     <= s_store;
+              status    <= mrsp_error;
+            elsif (mrsp_wr = '1') then
+              if (phase = 8) then
+                -- Bus restored:
+                state     <= s_store;
+              else
+                case mrsp_id is
+                  when mrsp_nak      =>
+                    -- Release bus with Stop:
+                    state     <= s_issue;
+                    phase     <= 7;
+                    status    <= mrsp_nak;
+                  when mrsp_arb_lost | mrsp_error =>
+                    state     <= s_issue;
+                    phase     <= 8;
+                    status    <= mrsp_id;
+                  when others        =>
+                    if (mrsp_id = mrsp_byte) then
+                      case bcnt is
+                        when 0      => rx_data( 7 downto  0) <= mrsp_data;
+                        when 1      => rx_data(15 downto  8) <= mrsp_data;
+                        when 2      => rx_data(23 downto 16) <= mrsp_data;
+                        when others => rx_data(31 downto 24) <= mrsp_data;
+                      end case;
+                    end if;
+                    state     <= s_issue;
+                    if (phase = 6) and (bcnt /= to_integer(unsigned(cfg_q(1 downto 0)))) then
+                      bcnt      <= bcnt + 1;
+                    else
+                      phase     <= phase + 1;
+                    end if;
+                end case;
+              end if;
+            end if;
+          -------------- 's_active' state ----------------------
+
+          -------------- 's_store' state -----------------------
+          when s_store   =>
+            state            <= s_check;
+            busy_y           <= '0';
+            pl_req_y         <= '0';
+            tb_last(idx)     <= std_logic_vector(now);
+            sh_wr            <= '1';
+            sh_wadr          <= idx;
+            sh_wdat          <= rx_data;
+            sh_wsts          <= (others => '0');
+            sh_wsts(31)      <= '1';
+            sh_wsts(18 downto 16) <= status;
+            sh_wsts(15 downto  0) <= std_logic_vector(now);
+            if (status = mrsp_done) then
+              sh_wr_dat        <= '1';
+            else
+              sh_wr_dat        <= '0';
+            end if;
+            if (idx = g_entries - 1) then
+              idx              <= 0;
+            else
+              idx              <= idx + 1;
+            end if;
+          -------------- 's_store' state -----------------------
+        end case;
+      end if;
+    end if;
+  end process state_proc;
+  ------------------------------------------------------------------------------
+
+end architecture rtl;
+--==============================================================================
@@ -62,6 +62,11 @@
 --                                R/W
 --                            "00000000"
 --
+--            With FIFOs (g_fifo_depth > 0) a write pushes the TX FIFO, a read
+--            pops the RX FIFO. Commands with parameter (Write, Set Bus, Wait)
+--            pop their parameter from the TX FIFO. An empty FIFO returns the
+--            last written/received byte, as without FIFOs.
+--
 --   Command register:
 --            7     6     5     4     3     2     1     0
 --         +-----+-----+-----+-----+-----+-----+-----+-----+
@@ -75,6 +80,16 @@
 --            AL  - Arbitration Lost
 --            ERR - Error
 --
+--            With FIFOs a Write command sends all bytes of the TX FIFO, a Read
+--            command receives RCNT bytes into the RX FIFO. Only the last byte
+--            is read with the requested acknowledge, the others with ACK.
+--            The command completes after the last byte or on the first
+--            not-acknowledge/error. Unsent bytes stay in the TX FIFO, TX Level
+--            gives their number, they have to be cleared with TXC.
+--
+--            Command Code "111" (Message, only with FIFOs) runs a complete I2C
+--            message: Start, slave address, data bytes and Stop, see MADR.
+--
 --
 --   Status register of FSM states:
 --            7     6     5     4     3     2     1     0
@@ -83,17 +98,282 @@
 --         +-----+-----+-----+-----+-----+-----+-----+-----+
 --                    RO                      RO 
 --                  "0000"                  "0000"
+--
+--
+--   FIFO levels (only with g_fifo_depth > 0):
+--            7     6     5     4     3     2     1     0
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--   0x04  |                   TX Level                    |
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--   0x05  |                   RX Level                    |
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--                                RO
+--
+--   FIFO status:
+--            7     6     5     4     3     2     1     0
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--   0x06  | BST | '0' | RXT | TXT | RXF | RXE | TXF | TXE |
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--           RO          RO    RO    RO    RO    RO    RO
+--
+--            TXE - TX FIFO empty
+--            TXF - TX FIFO full
+--            RXE - RX FIFO empty
+--            RXF - RX FIFO full
+--            TXT - TX Level <= TX Threshold during Write command or Message write
+--            RXT - RX Level >= RX Threshold, RX FIFO not empty
+--            BST - Write/Read/Message command in progress
+--
+--   FIFO depth:
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--   0x07  |                 g_fifo_depth                  |
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--                                RO
+--
+--   FIFO thresholds and read count:
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--   0x08  |                 TX Threshold                  |
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--   0x09  |                 RX Threshold                  |
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--   0x0A  |               Read Count (RCNT)               |
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--                                R/W
+--                             "00000000"
+--
+--   FIFO control:
+--            7     6     5     4     3     2     1     0
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--   0x0B  | RXC | TXC | '0' | '0' |RXFIE|TXEIE|RXTIE|TXTIE|
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--           WO    WO                R/W   R/W   R/W   R/W
+--
+--            xxxIE - Interrupt on the FIFO status bit, level sensitive,
+--                    requires IE
+--            TXC   - Clear TX FIFO
+--            RXC   - Clear RX FIFO
+--
+--   Message (only with g_fifo_depth > 0):
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--   0x0C  |             Slave Address             | R/W |  MADR
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--   0x0D  |                    Length                     |  MLEN
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--   0x0E  |       Write Length before Repeated Start      |  MRSW
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--                                R/W
+--                             "00000000"
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--   0x0F  |            Transferred Data Bytes             |  MCNT
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--                                RO
+--
+--            R/W = '0': Start, address + W, MLEN bytes from TX FIFO, Stop
+--            R/W = '1': Start, address + R, MLEN bytes into RX FIFO, Stop
+--            R/W = '1' and MRSW > 0: Start, address + W, MRSW bytes from
+--                  TX FIFO, Repeated Start, address + R, MLEN bytes into RX
+--                  FIFO, Stop
+--
+--            The last read byte is not acknowledged. The message waits with
+--            held bus for an empty TX FIFO or a full RX FIFO, longer messages
+--            are served with the threshold interrupts. On not-acknowledge the
+--            Stop is sent and the command completes with NAK, on arbitration
+--            lost/error immediately. Only one interrupt at the end.
+--            MCNT counts the written (including a not-acknowledged) and read
+--            data bytes of the last message.
+--
+--   Timing select:
+--            7     6     5     4     3     2     1     0
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--   0x10  | DEF | '0' | '0' | HS  |        Bus ID         |  TSEL
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--           WO               R/W             R/W
+--                            '0'            "0000"
+--
+--            Bus ID - Bus whose timing is accessed at 0x14..0x23
+--            HS     - Access High-speed mode timing instead, used by all
+--                     buses after the master code
+--            DEF    - Reload the selected timing with the values of the
+--                     'g_f_scl_x' ('g_f_scl_hs') generics
+--
+--   High-speed mode control:
+--            7     6     5     4     3     2     1     0
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--   0x11  | HSE | HS  | '0' | '0' | '0' |   Master code   |  HSCR
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--           R/W   RO                           R/W
+--           '0'   '0'                         "000"
+--
+--            HSE    - Every Start from 'Idle' (and Repeated Start outside
+--                     High-speed mode) sends the master code '00001XXX' in
+--                     the timing of the bus, ignores its acknowledge and
+--                     continues with a Repeated Start in High-speed mode.
+--                     The Start command completes after the Repeated Start.
+--                     Arbitration lost during the master code is reported
+--                     for the Start command.
+--            HS     - High-speed mode active, left with the Stop condition.
+--                     While active the current-source pull-up output of
+--                     'SCL' is driven when the master releases 'SCL'.
+--
+--   Timing of selected bus (16 bit, low byte first, in 'clk' cycles minus one):
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--   0x14  |            'SCL' period (prescaler)           |  TSCL
+--   0x16  |           'SCL' high time t_{HIGH}            |  THIGH
+--   0x18  |   Set-up time for repeated Start t_{SU;STA}   |  TSUSTA
+--   0x1A  |    Hold time (repeated) Start t_{HD;STA}      |  THDSTA
+--   0x1C  |          Data set-up time t_{SU;DAT}          |  TSUDAT
+--   0x1E  |      Set-up time for Stop t_{SU;STO}          |  TSUSTO
+--   0x20  |             Bus free time t_{BUF}             |  TBUF
+--   0x22  |           Data valid time t_{VD;DAT}          |  TVDDAT
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--                                R/W
+--                             'g_f_scl_x'
+--
+--            The timing is used by the bit level FSM whenever the bus is
+--            selected, t_{BUF} by the bus monitor of the bus. The 'SCL' low
+--            time is t_{SU;DAT} plus t_{VD;DAT}. Up to 100 kHz the generics
+--            select Standard mode timing, up to 400 kHz Fast mode, up to
+--            1 MHz Fast-mode Plus and above High-speed mode timing. Change
+--            the timing only while the bus is not captured. Buses beyond
+--            'g_bus_num' read the reset value and ignore writes.
+--
+--   Interrupt mask:
+--            7     6     5     4     3     2     1     0
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--   0x24  | '0' | '0' | END |FIFO | ERR | AL  | NAK | DON |  IMSK
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--                       R/W   R/W   R/W   R/W   R/W   R/W
+--                       '0'   '1'   '1'   '1'   '1'   '1'
+--
+--            DON  - Command completed with Done
+--            NAK  - Command completed with not-acknowledge
+--            AL   - Command completed with Arbitration Lost
+--            ERR  - Command completed with Error
+--            FIFO - FIFO interrupts enabled in FIFO control, level sensitive
+--            END  - Stop or Message command completed with Done
+--
+--            The causes require IE. NAK, AL and ERR raise the interrupt
+--            immediately, DON and END are counted by the coalescing below.
+--            The reset value interrupts on every command, as without mask.
+--
+--   Interrupt coalescing:
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--   0x25  |            Event Count (ICNT)                 |  ICNT
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--   0x26  |        Timeout (ITIM, 16 bit, low byte first) |  ITIM
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--                                R/W
+--                             "00000000"
+--
+--            The interrupt is raised with the ICNT-th counted DON/END
+--            command, or ITIM 'clk' cycles after the first counted command
+--            if fewer followed. ICNT 0 or 1 raise it with every command,
+--            ITIM 0 disables the timeout. Pending events are dropped when
+--            IE is cleared.
+--
+--   Performance counter control:
+--            7     6     5     4     3     2     1     0
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--   0x28  | '0' | '0' | '0' | '0' | '0' | '0' | CLR |SNAP |  PCR
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--                                               WO    WO
+--
+--            SNAP - Copy the counters into 0x2C..0x3F
+--            CLR  - Clear the counters
+--
+--   Performance counters (32 bit, little-endian, snapshot of SNAP):
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--   0x2C  |           Commands written to CMDR            |  PCMD
+--   0x30  |     'clk' cycles from CMDR write to response  |  PLAT
+--   0x34  |  'clk' cycles waiting for released 'SCL' high |  PSTR
+--   0x38  | 'clk' cycles bus captured, command completed  |  PTRN
+--   0x3C  |  'clk' cycles bus busy and not captured       |  PFBY
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--                                RO
+--                          "00000000000..."
+--
+--            The counters run while E is set and wrap around. PSTR counts
+--            the bit level FSM waiting for 'SCL' high after releasing it,
+--            clock stretching of slaves plus rise time. PTRN counts the
+--            software turnaround with held bus, PFBY another master on the
+--            selected bus and the bus free time after the own Stop.
+--
+--   Bus trace control:
+--            7     6     5     4     3     2     1     0
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--   0x40  | CLR | '0' | '0' | '0' |WRAP | TRG | FRZ | EN  |  TCR
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--           WO                      RO    RO    R/W   R/W
+--                                   '0'   '0'   '0'   '0'
+--
+--            EN   - Record events
+--            FRZ  - Frozen, set by the trigger or by writing '1', writing
+--                   '0' continues recording and rearms the trigger
+--            TRG  - Trigger event recorded
+--            WRAP - Trace RAM overwritten at least once
+--            CLR  - Empty the trace RAM, clears FRZ, TRG and WRAP
+--
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--   0x41  |     Entries after trigger event (TPOST)       |  TPOST
+--   0x42  |   Trigger event mask (TTRG, 16 bit, low byte) |  TTRG
+--   0x44  |  Next write index (TPTR, 16 bit, low byte)    |  TPTR   RO
+--   0x46  |      Stretch threshold in 'clk' cycles        |  TSTR
+--   0x47  |       Timestamp prescaler minus one           |  TPRE
+--   0x48  |     Read index (TIDX, 16 bit, low byte)       |  TIDX
+--   0x4A  |      log2 of trace RAM depth, 'g_trace_depth' |  TDEP   RO
+--   0x4C  |       Entry at TIDX (32 bit, low byte)        |  TDAT   RO
+--         +-----+-----+-----+-----+-----+-----+-----+-----+
+--                                R/W
+--                             "00000000"
+--
+--            Entry: 31..28 event, 27..20 argument, 19..0 timestamp. The
+--            timestamp counts TPRE+1 'clk' cycles since the previous
+--            entry and saturates at 0xFFFFF.
+--
+--            Event                       Argument
+--            0x0 Start                   -
+--            0x1 Repeated Start          -
+--            0x2 Stop                    -
+--            0x3 Byte written, ACK       Byte
+--            0x4 Byte written, NAK       Byte
+--            0x5 Byte read, ACK sent     Byte
+--            0x6 Byte read, NAK sent     Byte
+--            0x7 Arbitration lost        Command code
+--            0x8 Error                   Command code
+--            0x9 Bus switched            Bus ID
+--            0xA Clock stretch begin     Bit level FSM state
+--            0xB Clock stretch end       -
+--
+--            Bus events are recorded at the response of the byte command.
+--            A clock stretch begins when the bit level FSM waited TSTR
+--            cycles for released 'SCL' high (TSTR 0: no stretch events).
+--            The entry of an event with set TTRG bit sets TRG, TPOST
+--            further entries later FRZ is set. Reading the byte lane 3 of
+--            TDAT increments TIDX, TDAT follows TIDX one cycle later. The
+--            oldest entry is at TPTR if WRAP is set, else at 0. The trace
+--            RAM and its registers are kept while E is cleared.
 --------------------------------------------------------------------------------
 
 
 library ieee;
 use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
 
 use work.iicmb_pkg.all;
 
 
 --==============================================================================
 entity regblock is
+  generic
+  (
+    ------------------------------------
+    g_bus_num     : positive range 1 to 16 := 1;                  -- Number of separate I2C buses
+    g_fifo_depth  : natural range 0 to 255 := 0;                  -- Depth of TX/RX FIFOs (0: no FIFOs)
+    g_trace_depth : natural range 0 to 12  := 0;                  -- log2 of bus trace RAM entries (0: no bus trace)
+    g_tp          : tp_type_array(0 to 15) := get_tp(100000.0, (others => 100.0)); -- Reset timing of I2C buses
+    g_tp_hs       : tp_type                := get_tp(100000.0, 3400.0)             -- Reset timing of High-speed mode
+    ------------------------------------
+  );
   port
   (
     ------------------------------------
@@ -101,6 +381,7 @@ entity regblock is
     s_rst       : in    std_logic;                                -- Synchronous reset (active high)
     ------------------------------------
     ------------------------------------
+    adr         : in    std_logic_vector( 4 downto 0) := "00000"; -- Word address
     wr          : in    std_logic_vector( 3 downto 0);            -- Write (active high)
     rd          : in    std_logic_vector( 3 downto 0);            -- Read (active high)
     idata       : in    std_logic_vector(31 downto 0);            -- Data from System Bus
@@ -117,6 +398,11 @@ entity regblock is
     bit_state   : in    std_logic_vector( 3 downto 0);            -- State of bit level FSM
     byte_state  : in    std_logic_vector( 3 downto 0);            -- State of byte level FSM
     disable     :   out std_logic;                                -- Disable controller (used as synchronous reset)
+    tp          :   out tp_type_array(0 to 15);                   -- Timing of I2C buses
+    tp_hs       :   out tp_type;                                  -- Timing of High-speed mode
+    hs_en       :   out std_logic;                                -- Start enters High-speed mode
+    hs_code     :   out std_logic_vector( 2 downto 0);            -- Master code of High-speed mode
+    hs          : in    std_logic;                                -- High-speed mode status
     ------------------------------------
     ------------------------------------
     -- 'Generic Interface' signals:
@@ -137,9 +423,51 @@ end entity regblock;
 --==============================================================================
 architecture rtl of regblock is
 
+  ------------------------------------------------------------------------------
+  function get_fifo_size(a : natural) return positive is
+  begin
+    if (a = 0) then
+      return 1;
+    else
+      return a;
+    end if;
+  end function get_fifo_size;
+  ------------------------------------------------------------------------------
+
+  constant c_fifo_en       : boolean  := (g_fifo_depth > 0);
+  constant c_fifo_size     : positive := get_fifo_size(g_fifo_depth);
+  constant c_trc_en        : boolean  := (g_trace_depth > 0);
+  constant c_trc_bits      : positive := get_fifo_size(g_trace_depth);
+
+  type fifo_type is array (0 to c_fifo_size - 1) of std_logic_vector(7 downto 0);
+  type trc_ram_type is array (0 to 2**c_trc_bits - 1) of std_logic_vector(31 downto 0);
+
+  -- Next step of a message:
+  type msg_state_type is (ms_start, ms_adr, ms_write, ms_rstart, ms_radr, ms_read, ms_stop);
+
+  ------------------------------------------------------------------------------
+  function inc_ptr(a : integer) return integer is
+  begin
+    if (a = c_fifo_size - 1) then
+      return 0;
+    else
+      return a + 1;
+    end if;
+  end function inc_ptr;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  -- Commands which take their parameter from 'Data' register:
+  function has_param(a : std_logic_vector(2 downto 0)) return boolean is
+  begin
+    return (a = mcmd_write)or(a = mcmd_set_bus)or(a = mcmd_wait);
+  end function has_param;
+  ------------------------------------------------------------------------------
+
   signal irq_y             : std_logic                    := '0';
   signal mcmd_wr_y         : std_logic                    := '0';
   signal mcmd_id_y         : std_logic_vector(2 downto 0) := mcmd_set_bus;
+  signal mcmd_data_y       : std_logic_vector(7 downto 0) := "00000000";
   signal e_reg             : std_logic                    := '0';
   signal ie_reg            : std_logic                    := '0';
   signal tx_data_reg       : std_logic_vector(7 downto 0) := "00000000";
@@ -151,27 +479,357 @@ architecture rtl of regblock is
   signal cmd_code_reg      : std_logic_vector(2 downto 0) := "000";
   signal command_completed : std_logic;
 
+  signal wr_csr            : std_logic_vector(3 downto 0);
+  signal wr_fcr            : std_logic_vector(3 downto 0);
+  signal rd_csr            : std_logic_vector(3 downto 0);
+  signal odata_csr         : std_logic_vector(31 downto 0);
+  signal odata_fifo        : std_logic_vector(31 downto 0);
+  signal odata_fcr         : std_logic_vector(31 downto 0);
+  signal odata_mcmd        : std_logic_vector(31 downto 0);
+  signal wr_mcmd           : std_logic_vector(3 downto 0);
+  signal wr_tsel           : std_logic_vector(3 downto 0);
+  signal wr_tscl           : std_logic_vector(3 downto 0);
+  signal wr_tsusta         : std_logic_vector(3 downto 0);
+  signal wr_tsudat         : std_logic_vector(3 downto 0);
+  signal wr_tbuf           : std_logic_vector(3 downto 0);
+  signal odata_tsel        : std_logic_vector(31 downto 0);
+  signal odata_tscl        : std_logic_vector(31 downto 0);
+  signal odata_tsusta      : std_logic_vector(31 downto 0);
+  signal odata_tsudat      : std_logic_vector(31 downto 0);
+  signal odata_tbuf        : std_logic_vector(31 downto 0);
+  signal wr_imsk           : std_logic_vector(3 downto 0);
+  signal odata_imsk        : std_logic_vector(31 downto 0);
+
+  signal wr_pcr            : std_logic_vector(3 downto 0);
+  signal odata_pcmd        : std_logic_vector(31 downto 0);
+  signal odata_plat        : std_logic_vector(31 downto 0);
+  signal odata_pstr        : std_logic_vector(31 downto 0);
+  signal odata_ptrn        : std_logic_vector(31 downto 0);
+  signal odata_pfby        : std_logic_vector(31 downto 0);
+  signal wr_tcr            : std_logic_vector(3 downto 0);
+  signal wr_tstr           : std_logic_vector(3 downto 0);
+  signal wr_tidx           : std_logic_vector(3 downto 0);
+  signal rd_tdat           : std_logic_vector(3 downto 0);
+  signal odata_tcr         : std_logic_vector(31 downto 0);
+  signal odata_tstr        : std_logic_vector(31 downto 0);
+  signal odata_tidx        : std_logic_vector(31 downto 0);
+  signal odata_tdat        : std_logic_vector(31 downto 0);
+
+  -- Interrupt control:
+  signal imsk_reg          : std_logic_vector( 5 downto 0) := "011111";
+  signal icnt_reg          : std_logic_vector( 7 downto 0) := "00000000";
+  signal itim_reg          : std_logic_vector(15 downto 0) := (others => '0');
+  signal irq_cnt           : integer range 0 to 255       := 0;
+  signal irq_tim           : integer range 0 to 65535     := 0;
+  signal irq_cause         : std_logic_vector( 5 downto 0);
+  signal irq_imm           : std_logic;
+  signal irq_evt           : std_logic;
+
+  -- Performance counters, live and snapshot:
+  signal pcmd_cnt          : unsigned(31 downto 0)        := (others => '0');
+  signal plat_cnt          : unsigned(31 downto 0)        := (others => '0');
+  signal pstr_cnt          : unsigned(31 downto 0)        := (others => '0');
+  signal ptrn_cnt          : unsigned(31 downto 0)        := (others => '0');
+  signal pfby_cnt          : unsigned(31 downto 0)        := (others => '0');
+  signal pcmd_reg          : unsigned(31 downto 0)        := (others => '0');
+  signal plat_reg          : unsigned(31 downto 0)        := (others => '0');
+  signal pstr_reg          : unsigned(31 downto 0)        := (others => '0');
+  signal ptrn_reg          : unsigned(31 downto 0)        := (others => '0');
+  signal pfby_reg          : unsigned(31 downto 0)        := (others => '0');
+  signal scl_wait          : std_logic;
+
+  -- Bus trace:
+  signal trc_ram           : trc_ram_type;
+  signal ten_reg           : std_logic                    := '0';
+  signal tfrz_reg          : std_logic                    := '0';
+  signal ttrg_flag         : std_logic                    := '0';
+  signal twrap_reg         : std_logic                    := '0';
+  signal tpost_reg         : std_logic_vector( 7 downto 0) := "00000000";
+  signal ttrg_reg          : std_logic_vector(15 downto 0) := (others => '0');
+  signal tstr_reg          : std_logic_vector( 7 downto 0) := "00000000";
+  signal tpre_reg          : std_logic_vector( 7 downto 0) := "00000000";
+  signal tidx_reg          : unsigned(15 downto 0)        := (others => '0');
+  signal trc_wptr          : unsigned(c_trc_bits - 1 downto 0) := (others => '0');
+  signal trc_post          : integer range 0 to 255       := 0;
+  signal trc_rdata         : std_logic_vector(31 downto 0) := (others => '0');
+  signal trc_raddr         : unsigned(c_trc_bits - 1 downto 0);
+  signal trc_tim           : unsigned(19 downto 0)        := (others => '0');
+  signal trc_pre           : unsigned( 7 downto 0)        := (others => '0');
+  signal trc_cmd           : std_logic_vector( 2 downto 0) := mcmd_wait;
+  signal trc_data          : std_logic_vector( 7 downto 0) := "00000000";
+  signal trc_cap           : std_logic                    := '0';
+  signal trc_str_cnt       : integer range 0 to 255       := 0;
+  signal trc_str           : std_logic                    := '0';
+  signal trc_str_state     : std_logic_vector( 3 downto 0) := "0000";
+  signal trc_strb_pend     : std_logic                    := '0';
+  signal trc_stre_pend     : std_logic                    := '0';
+  signal trc_evt           : std_logic;
+  signal trc_code          : std_logic_vector( 3 downto 0);
+  signal trc_arg           : std_logic_vector( 7 downto 0);
+  signal trc_sel_b         : std_logic;
+  signal trc_sel_e         : std_logic;
+
+  -- Timing of I2C buses:
+  signal tp_reg            : tp_type_array(0 to 15)       := g_tp;
+  signal tp_hs_reg         : tp_type                      := g_tp_hs;
+  signal tsel_reg          : integer range 0 to 15        := 0;
+  signal tsel_hs_reg       : std_logic                    := '0';
+  signal tp_sel            : tp_type;
+  signal hse_reg           : std_logic                    := '0';
+  signal hs_code_reg       : std_logic_vector( 2 downto 0) := "000";
+
+  -- FIFOs:
+  signal tx_fifo           : fifo_type                    := (others => (others => '0'));
+  signal tx_wptr           : integer range 0 to c_fifo_size - 1 := 0;
+  signal tx_rptr           : integer range 0 to c_fifo_size - 1 := 0;
+  signal tx_level          : integer range 0 to g_fifo_depth    := 0;
+  signal tx_push           : std_logic;
+  signal tx_pop            : std_logic;
+  signal tx_clr            : std_logic;
+  signal rx_fifo           : fifo_type                    := (others => (others => '0'));
+  signal rx_wptr           : integer range 0 to c_fifo_size - 1 := 0;
+  signal rx_rptr           : integer range 0 to c_fifo_size - 1 := 0;
+  signal rx_level          : integer range 0 to g_fifo_depth    := 0;
+  signal rx_push           : std_logic;
+  signal rx_pop            : std_logic;
+  signal rx_clr            : std_logic;
+  signal tx_thr_reg        : std_logic_vector(7 downto 0) := "00000000";
+  signal rx_thr_reg        : std_logic_vector(7 downto 0) := "00000000";
+  signal rcnt_reg          : std_logic_vector(7 downto 0) := "00000000";
+  signal fie_reg           : std_logic_vector(3 downto 0) := "0000";
+  signal fifo_status       : std_logic_vector(7 downto 0);
+  signal fifo_irq          : std_logic;
+
+  -- Write/Read command with several bytes:
+  signal burst             : std_logic                    := '0';
+  signal burst_id          : std_logic_vector(2 downto 0) := mcmd_write;
+  signal burst_cnt         : integer range 0 to 255       := 0;
+  signal rd_pend           : std_logic                    := '0';
+  signal burst_next        : std_logic;
+  signal rsp_final         : std_logic;
+  signal rsp_id            : std_logic_vector(2 downto 0);
+
+  -- Message command:
+  signal madr_reg          : std_logic_vector(7 downto 0) := "00000000";
+  signal mlen_reg          : std_logic_vector(7 downto 0) := "00000000";
+  signal mrsw_reg          : std_logic_vector(7 downto 0) := "00000000";
+  signal msg               : std_logic                    := '0';
+  signal msg_busy          : std_logic                    := '0';
+  signal msg_state         : msg_state_type               := ms_start;
+  signal msg_adr_rd        : std_logic                    := '0';
+  signal msg_nak           : std_logic                    := '0';
+  signal msg_wcnt          : integer range 0 to 255       := 0;
+  signal msg_rcnt          : integer range 0 to 255       := 0;
+  signal msg_cnt           : integer range 0 to 255       := 0;
+  signal msg_go            : std_logic;
+  signal msg_id            : std_logic_vector(2 downto 0);
+  signal msg_adr_sel       : std_logic;
+  signal msg_last          : std_logic;
+  signal msg_next          : std_logic;
+
+  -- Byte command to issue:
+  signal cmd_new           : std_logic;
+  signal issue             : std_logic;
+  signal issue_id          : std_logic_vector(2 downto 0);
+  signal issue_data        : std_logic_vector(7 downto 0);
+  signal issue_bypass      : std_logic;
+
 begin
 
   disable             <= not(e_reg);
 
-  odata(31 downto 28) <= byte_state;
-  odata(27 downto 24) <= bit_state;
+  ------------------------------------------------------------------------------
+  -- Register word select
+  wr_csr    <= wr when (adr = "00000") else "0000";
+  wr_fcr    <= wr when (adr = "00010") else "0000";
+  wr_mcmd   <= wr when (adr = "00011") else "0000";
+  wr_tsel   <= wr when (adr = "00100") else "0000";
+  wr_tscl   <= wr when (adr = "00101") else "0000";
+  wr_tsusta <= wr when (adr = "00110") else "0000";
+  wr_tsudat <= wr when (adr = "00111") else "0000";
+  wr_tbuf   <= wr when (adr = "01000") else "0000";
+  wr_imsk   <= wr when (adr = "01001") else "0000";
+  wr_pcr    <= wr when (adr = "01010") else "0000";
+  wr_tcr    <= wr when (adr = "10000") else "0000";
+  wr_tstr   <= wr when (adr = "10001") else "0000";
+  wr_tidx   <= wr when (adr = "10010") else "0000";
+  rd_tdat   <= rd when (adr = "10011") else "0000";
+  rd_csr    <= rd when (adr = "00000") else "0000";
+
+  odata <= odata_csr when (adr = "00000") else
+           odata_fifo when (adr = "00001") and c_fifo_en else
+           odata_fcr when (adr = "00010") and c_fifo_en else
+           odata_mcmd when (adr = "00011") and c_fifo_en else
+           odata_tsel when (adr = "00100") else
+           odata_tscl when (adr = "00101") else
+           odata_tsusta when (adr = "00110") else
+           odata_tsudat when (adr = "00111") else
+           odata_tbuf when (adr = "01000") else
+           odata_imsk when (adr = "01001") else
+           odata_pcmd when (adr = "01011") else
+           odata_plat when (adr = "01100") else
+           odata_pstr when (adr = "01101") else
+           odata_ptrn when (adr = "01110") else
+           odata_pfby when (adr = "01111") else
+           odata_tcr when (adr = "10000") and c_trc_en else
+           odata_tstr when (adr = "10001") and c_trc_en else
+           odata_tidx when (adr = "10010") else
+           odata_tdat when (adr = "10011") and c_trc_en else
+           (others => '0');
+  ------------------------------------------------------------------------------
+
+  odata_csr(31 downto 28) <= byte_state;
+  odata_csr(27 downto 24) <= bit_state;
   --
-  odata(23)           <= don_reg;
-  odata(22)           <= nak_reg;
-  odata(21)           <= al_reg;
-  odata(20)           <= err_reg;
-  odata(19)           <= '0';
-  odata(18 downto 16) <= cmd_code_reg;
+  odata_csr(23)           <= don_reg;
+  odata_csr(22)           <= nak_reg;
+  odata_csr(21)           <= al_reg;
+  odata_csr(20)           <= err_reg;
+  odata_csr(19)           <= '0';
+  odata_csr(18 downto 16) <= cmd_code_reg;
   --
-  odata(15 downto  8) <= rx_data_reg;
+  odata_csr(15 downto  8) <= rx_fifo(rx_rptr) when (rx_level /= 0) else rx_data_reg;
   --
-  odata( 7)           <= e_reg;
-  odata( 6)           <= ie_reg;
-  odata( 5)           <= busy;
-  odata( 4)           <= captured;
-  odata( 3 downto  0) <= bus_id;
+  odata_csr( 7)           <= e_reg;
+  odata_csr( 6)           <= ie_reg;
+  odata_csr( 5)           <= busy;
+  odata_csr( 4)           <= captured;
+  odata_csr( 3 downto  0) <= bus_id;
+
+  odata_fifo(31 downto 24) <= std_logic_vector(to_unsigned(g_fifo_depth, 8));
+  odata_fifo(23 downto 16) <= fifo_status;
+  odata_fifo(15 downto  8) <= std_logic_vector(to_unsigned(rx_level, 8));
+  odata_fifo( 7 downto  0) <= std_logic_vector(to_unsigned(tx_level, 8));
+
+  odata_fcr(31 downto 28) <= "0000";
+  odata_fcr(27 downto 24) <= fie_reg;
+  odata_fcr(23 downto 16) <= rcnt_reg;
+  odata_fcr(15 downto  8) <= rx_thr_reg;
+  odata_fcr( 7 downto  0) <= tx_thr_reg;
+
+  odata_mcmd(31 downto 24) <= std_logic_vector(to_unsigned(msg_cnt, 8));
+  odata_mcmd(23 downto 16) <= mrsw_reg;
+  odata_mcmd(15 downto  8) <= mlen_reg;
+  odata_mcmd( 7 downto  0) <= madr_reg;
+
+  tp_sel                <= tp_hs_reg when (tsel_hs_reg = '1') else tp_reg(tsel_reg);
+
+  odata_tsel(31 downto 16) <= (others => '0');
+  odata_tsel(15)           <= hse_reg;
+  odata_tsel(14)           <= hs;
+  odata_tsel(13 downto 11) <= (others => '0');
+  odata_tsel(10 downto  8) <= hs_code_reg;
+  odata_tsel( 7 downto  5) <= (others => '0');
+  odata_tsel( 4)           <= tsel_hs_reg;
+  odata_tsel( 3 downto  0) <= std_logic_vector(to_unsigned(tsel_reg, 4));
+
+  odata_tscl(31 downto 16) <= std_logic_vector(tp_sel.high);
+  odata_tscl(15 downto  0) <= std_logic_vector(tp_sel.scl);
+
+  odata_tsusta(31 downto 16) <= std_logic_vector(tp_sel.hd_sta);
+  odata_tsusta(15 downto  0) <= std_logic_vector(tp_sel.su_sta);
+
+  odata_tsudat(31 downto 16) <= std_logic_vector(tp_sel.su_sto);
+  odata_tsudat(15 downto  0) <= std_logic_vector(tp_sel.su_dat);
+
+  odata_tbuf(31 downto 16) <= std_logic_vector(tp_sel.vd_dat);
+  odata_tbuf(15 downto  0) <= std_logic_vector(tp_sel.buf);
+
+  odata_imsk(31 downto 16) <= itim_reg;
+  odata_imsk(15 downto  8) <= icnt_reg;
+  odata_imsk( 7 downto  6) <= "00";
+  odata_imsk( 5 downto  0) <= imsk_reg;
+
+  odata_pcmd              <= std_logic_vector(pcmd_reg);
+  odata_plat              <= std_logic_vector(plat_reg);
+  odata_pstr              <= std_logic_vector(pstr_reg);
+  odata_ptrn              <= std_logic_vector(ptrn_reg);
+  odata_pfby              <= std_logic_vector(pfby_reg);
+
+  odata_tcr(31 downto 16) <= ttrg_reg;
+  odata_tcr(15 downto  8) <= tpost_reg;
+  odata_tcr( 7 downto  4) <= "0000";
+  odata_tcr( 3)          <= twrap_reg;
+  odata_tcr( 2)          <= ttrg_flag;
+  odata_tcr( 1)          <= tfrz_reg;
+  odata_tcr( 0)          <= ten_reg;
+
+  odata_tstr(31 downto 24) <= tpre_reg;
+  odata_tstr(23 downto 16) <= tstr_reg;
+  odata_tstr(15 downto  0) <= std_logic_vector(resize(trc_wptr, 16));
+
+  odata_tidx(31 downto 24) <= "00000000";
+  odata_tidx(23 downto 16) <= std_logic_vector(to_unsigned(g_trace_depth, 8));
+  odata_tidx(15 downto  0) <= std_logic_vector(tidx_reg);
+
+  odata_tdat              <= trc_rdata;
+
+  tp                    <= tp_reg;
+  tp_hs                 <= tp_hs_reg;
+  hs_en                 <= hse_reg;
+  hs_code               <= hs_code_reg;
+
+  ------------------------------------------------------------------------------
+  -- Timing registers, kept while controller is disabled
+  tp_proc:
+  process(clk)
+    variable v_sel : integer range 0 to 15;
+    variable v_tp  : tp_type;
+    variable v_wr  : boolean;
+  begin
+    if rising_edge(clk) then
+      if (s_rst = '1') then
+        tp_reg      <= g_tp;
+        tp_hs_reg   <= g_tp_hs;
+        tsel_reg    <= 0;
+        tsel_hs_reg <= '0';
+        hse_reg     <= '0';
+        hs_code_reg <= "000";
+      else
+        if (wr_tsel(0) = '1') then
+          v_sel       := to_integer(unsigned(idata(3 downto 0)));
+          tsel_reg    <= v_sel;
+          tsel_hs_reg <= idata(4);
+          if (idata(7) = '1')and(idata(4) = '1') then
+            tp_hs_reg <= g_tp_hs;
+          elsif (idata(7) = '1')and(v_sel < g_bus_num) then
+            tp_reg(v_sel) <= g_tp(v_sel);
+          end if;
+        end if;
+        if (wr_tsel(1) = '1') then
+          hse_reg     <= idata(15);
+          hs_code_reg <= idata(10 downto 8);
+        end if;
+        -- Byte lanes of selected timing:
+        v_tp := tp_sel;
+        v_wr := (wr_tscl /= "0000")or(wr_tsusta /= "0000")or(wr_tsudat /= "0000")or(wr_tbuf /= "0000");
+        if (wr_tscl(0) = '1') then v_tp.scl(    7 downto 0) := unsigned(idata( 7 downto  0)); end if;
+        if (wr_tscl(1) = '1') then v_tp.scl(   15 downto 8) := unsigned(idata(15 downto  8)); end if;
+        if (wr_tscl(2) = '1') then v_tp.high(   7 downto 0) := unsigned(idata(23 downto 16)); end if;
+        if (wr_tscl(3) = '1') then v_tp.high(  15 downto 8) := unsigned(idata(31 downto 24)); end if;
+        if (wr_tsusta(0) = '1') then v_tp.su_sta( 7 downto 0) := unsigned(idata( 7 downto  0)); end if;
+        if (wr_tsusta(1) = '1') then v_tp.su_sta(15 downto 8) := unsigned(idata(15 downto  8)); end if;
+        if (wr_tsusta(2) = '1') then v_tp.hd_sta( 7 downto 0) := unsigned(idata(23 downto 16)); end if;
+        if (wr_tsusta(3) = '1') then v_tp.hd_sta(15 downto 8) := unsigned(idata(31 downto 24)); end if;
+        if (wr_tsudat(0) = '1') then v_tp.su_dat( 7 downto 0) := unsigned(idata( 7 downto  0)); end if;
+        if (wr_tsudat(1) = '1') then v_tp.su_dat(15 downto 8) := unsigned(idata(15 downto  8)); end if;
+        if (wr_tsudat(2) = '1') then v_tp.su_sto( 7 downto 0) := unsigned(idata(23 downto 16)); end if;
+        if (wr_tsudat(3) = '1') then v_tp.su_sto(15 downto 8) := unsigned(idata(31 downto 24)); end if;
+        if (wr_tbuf(0) = '1') then v_tp.buf(    7 downto 0) := unsigned(idata( 7 downto  0)); end if;
+        if (wr_tbuf(1) = '1') then v_tp.buf(   15 downto 8) := unsigned(idata(15 downto  8)); end if;
+        if (wr_tbuf(2) = '1') then v_tp.vd_dat( 7 downto 0) := unsigned(idata(23 downto 16)); end if;
+        if (wr_tbuf(3) = '1') then v_tp.vd_dat(15 downto 8) := unsigned(idata(31 downto 24)); end if;
+        if v_wr then
+          if (tsel_hs_reg = '1') then
+            tp_hs_reg <= v_tp;
+          elsif (tsel_reg < g_bus_num) then
+            tp_reg(tsel_reg) <= v_tp;
+          end if;
+        end if;
+      end if;
+    end if;
+  end process tp_proc;
+  ------------------------------------------------------------------------------
 
   ------------------------------------------------------------------------------
   process(clk)
@@ -181,7 +839,7 @@ begin
         e_reg        <= '0';
         ie_reg       <= '0';
       else
-        if (wr(0) = '1') then
+        if (wr_csr(0) = '1') then
           e_reg  <= idata(7);
           ie_reg <= idata(6);
         end if;
@@ -195,9 +853,9 @@ begin
   begin
     if rising_edge(clk) then
       if (s_rst = '1') then
-        tx_data_reg  <= "00000000";
+        tx_data_reg <= "00000000";
       else
-        if (wr(1) = '1') then
+        if (wr_csr(1) = '1') then
           tx_data_reg <= idata(15 downto 8);
         end if;
       end if;
@@ -214,7 +872,7 @@ begin
       if (s_rst = '1')or(e_reg = '0') then
         cmd_code_reg <= "000";
       else
-        if (wr(2) = '1') then
+        if (wr_csr(2) = '1') then
           if (command_completed = '1') then
             cmd_code_reg <= idata(18 downto 16);
           end if;
@@ -236,18 +894,19 @@ begin
         err_reg     <= '0';
         rx_data_reg <= "00000000";
       else
-        if (wr(2) = '1') then
+        if (wr_csr(2) = '1') then
           don_reg <= '0';
           nak_reg <= '0';
           al_reg  <= '0';
           err_reg <= '0';
         end if;
-        if (mrsp_wr = '1') then
-          case (mrsp_id) is
+        if (mrsp_wr = '1')and(mrsp_id = mrsp_byte) then
+          rx_data_reg <= mrsp_data;
+        end if;
+        if (rsp_final = '1') then
+          case (rsp_id) is
             when mrsp_done     => don_reg <= '1';
-            when mrsp_byte     =>
-              don_reg     <= '1';
-              rx_data_reg <= mrsp_data;
+            when mrsp_byte     => don_reg <= '1';
             when mrsp_nak      => nak_reg <= '1';
             when mrsp_arb_lost => al_reg  <= '1';
             when others        => err_reg <= '1';
@@ -258,29 +917,654 @@ begin
   end process;
   ------------------------------------------------------------------------------
 
+  ------------------------------------------------------------------------------
+  -- Interrupt control register
+  process(clk)
+  begin
+    if rising_edge(clk) then
+      if (s_rst = '1') then
+        imsk_reg <= "011111";
+        icnt_reg <= "00000000";
+        itim_reg <= (others => '0');
+      else
+        if (wr_imsk(0) = '1') then
+          imsk_reg <= idata(5 downto 0);
+        end if;
+        if (wr_imsk(1) = '1') then
+          icnt_reg <= idata(15 downto 8);
+        end if;
+        if (wr_imsk(2) = '1') then
+          itim_reg( 7 downto 0) <= idata(23 downto 16);
+        end if;
+        if (wr_imsk(3) = '1') then
+          itim_reg(15 downto 8) <= idata(31 downto 24);
+        end if;
+      end if;
+    end if;
+  end process;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  -- Interrupt causes of the completed command, as IMSK
+  irq_cause(0) <= '1' when (rsp_id = mrsp_done)or(rsp_id = mrsp_byte) else '0';
+  irq_cause(1) <= '1' when (rsp_id = mrsp_nak) else '0';
+  irq_cause(2) <= '1' when (rsp_id = mrsp_arb_lost) else '0';
+  irq_cause(3) <= not(irq_cause(0) or irq_cause(1) or irq_cause(2));
+  irq_cause(4) <= '0';  -- FIFO interrupts are level sensitive
+  irq_cause(5) <= irq_cause(0) when (cmd_code_reg = mcmd_stop)or(cmd_code_reg = mcmd_msg) else '0';
+
+  -- Errors immediately, done counted:
+  irq_imm <= rsp_final when ((irq_cause(3 downto 1) and imsk_reg(3 downto 1)) /= "000") else '0';
+  irq_evt <= rsp_final and ((irq_cause(0) and imsk_reg(0)) or (irq_cause(5) and imsk_reg(5)));
+  ------------------------------------------------------------------------------
+
   ------------------------------------------------------------------------------
   -- Interrupt request
   process(clk)
   begin
     if rising_edge(clk) then
-      if (s_rst = '1')or(e_reg = '0') then
-        irq_y <= '0';
+      if (s_rst = '1')or(e_reg = '0')or(ie_reg = '0') then
+        irq_y   <= '0';
+        irq_cnt <= 0;
+        irq_tim <= 0;
       else
-        if (rd(2) = '1') then
+        if (rd_csr(2) = '1') then
           irq_y <= '0';
         end if;
-        if (mrsp_wr = '1') then
-          irq_y <= '1';
+        if (irq_cnt /= 0)and(irq_tim /= 65535) then
+          irq_tim <= irq_tim + 1;
         end if;
-        if (ie_reg = '0') then
-          irq_y <= '0';
+        if (irq_imm = '1')or
+           ((irq_evt = '1')and(irq_cnt + 1 >= to_integer(unsigned(icnt_reg))))or
+           ((irq_cnt /= 0)and(itim_reg /= x"0000")and(irq_tim + 1 >= to_integer(unsigned(itim_reg)))) then
+          irq_y   <= '1';
+          irq_cnt <= 0;
+          irq_tim <= 0;
+        elsif (irq_evt = '1') then
+          irq_cnt <= irq_cnt + 1;
         end if;
       end if;
     end if;
   end process;
   ------------------------------------------------------------------------------
 
-  irq <= irq_y;
+  irq <= irq_y or (ie_reg and imsk_reg(4) and fifo_irq);
+
+  ------------------------------------------------------------------------------
+  -- Performance counters
+  -- Bit level FSM released 'SCL' and waits for high: 'Read/Write B', 'Stop B',
+  -- 'Repeated Start B'
+  scl_wait <= '1' when (bit_state = "0101")or(bit_state = "1010")or(bit_state = "1101") else '0';
+
+  perf_proc:
+  process(clk)
+  begin
+    if rising_edge(clk) then
+      if (s_rst = '1')or((wr_pcr(0) = '1')and(idata(1) = '1')) then
+        pcmd_cnt <= (others => '0');
+        plat_cnt <= (others => '0');
+        pstr_cnt <= (others => '0');
+        ptrn_cnt <= (others => '0');
+        pfby_cnt <= (others => '0');
+      elsif (e_reg = '1') then
+        if (cmd_new = '1') then
+          pcmd_cnt <= pcmd_cnt + 1;
+        end if;
+        if (command_completed = '0') then
+          plat_cnt <= plat_cnt + 1;
+        end if;
+        if (scl_wait = '1') then
+          pstr_cnt <= pstr_cnt + 1;
+        end if;
+        if (command_completed = '1')and(captured = '1') then
+          ptrn_cnt <= ptrn_cnt + 1;
+        end if;
+        if (busy = '1')and(captured = '0') then
+          pfby_cnt <= pfby_cnt + 1;
+        end if;
+      end if;
+      if (s_rst = '1') then
+        pcmd_reg <= (others => '0');
+        plat_reg <= (others => '0');
+        pstr_reg <= (others => '0');
+        ptrn_reg <= (others => '0');
+        pfby_reg <= (others => '0');
+      elsif (wr_pcr(0) = '1')and(idata(0) = '1') then
+        pcmd_reg <= pcmd_cnt;
+        plat_reg <= plat_cnt;
+        pstr_reg <= pstr_cnt;
+        ptrn_reg <= ptrn_cnt;
+        pfby_reg <= pfby_cnt;
+      end if;
+    end if;
+  end process perf_proc;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  -- Bus trace event of the byte response, else pending clock stretch event
+  trc_ev_proc:
+  process(mrsp_wr, mrsp_id, mrsp_data, trc_cmd, trc_data, trc_cap, trc_strb_pend, trc_stre_pend, trc_str_state)
+  begin
+    trc_evt   <= '0';
+    trc_code  <= "0000";
+    trc_arg   <= trc_data;
+    trc_sel_b <= '0';
+    trc_sel_e <= '0';
+    if (mrsp_wr = '1') then
+      case mrsp_id is
+        when mrsp_done     =>
+          if (trc_cmd = mcmd_start) then
+            trc_evt  <= '1';
+            trc_code <= "000" & trc_cap;
+            trc_arg  <= "00000000";
+          elsif (trc_cmd = mcmd_stop) then
+            trc_evt  <= '1';
+            trc_code <= "0010";
+            trc_arg  <= "00000000";
+          elsif (trc_cmd = mcmd_write) then
+            trc_evt  <= '1';
+            trc_code <= "0011";
+          elsif (trc_cmd = mcmd_set_bus) then
+            trc_evt  <= '1';
+            trc_code <= "1001";
+          end if;
+        when mrsp_nak      =>
+          trc_evt  <= '1';
+          trc_code <= "0100";
+        when mrsp_arb_lost =>
+          trc_evt  <= '1';
+          trc_code <= "0111";
+          trc_arg  <= "00000" & trc_cmd;
+        when mrsp_error    =>
+          trc_evt  <= '1';
+          trc_code <= "1000";
+          trc_arg  <= "00000" & trc_cmd;
+        when others        =>
+          trc_evt  <= '1';
+          trc_arg  <= mrsp_data;
+          if (trc_cmd = mcmd_read_nak) then
+            trc_code <= "0110";
+          else
+            trc_code <= "0101";
+          end if;
+      end case;
+    elsif (trc_strb_pend = '1') then
+      trc_evt   <= '1';
+      trc_code  <= "1010";
+      trc_arg   <= "0000" & trc_str_state;
+      trc_sel_b <= '1';
+    elsif (trc_stre_pend = '1') then
+      trc_evt   <= '1';
+      trc_code  <= "1011";
+      trc_arg   <= "00000000";
+      trc_sel_e <= '1';
+    end if;
+  end process trc_ev_proc;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  -- Bus trace read address, next entry with last byte of TDAT for back-to-back reads
+  trc_raddr <= tidx_reg(c_trc_bits - 1 downto 0) + 1 when (rd_tdat(3) = '1') else tidx_reg(c_trc_bits - 1 downto 0);
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  -- Bus trace RAM and registers, kept while controller is disabled
+  trc_proc:
+  process(clk)
+  begin
+    if rising_edge(clk) then
+      trc_rdata <= trc_ram(to_integer(trc_raddr));
+      if (s_rst = '1') then
+        ten_reg       <= '0';
+        tfrz_reg      <= '0';
+        ttrg_flag     <= '0';
+        twrap_reg     <= '0';
+        tpost_reg     <= "00000000";
+        ttrg_reg      <= (others => '0');
+        tstr_reg      <= "00000000";
+        tpre_reg      <= "00000000";
+        tidx_reg      <= (others => '0');
+        trc_wptr      <= (others => '0');
+        trc_post      <= 0;
+        trc_tim       <= (others => '0');
+        trc_pre       <= (others => '0');
+        trc_cmd       <= mcmd_wait;
+        trc_data      <= "00000000";
+        trc_cap       <= '0';
+        trc_str_cnt   <= 0;
+        trc_str       <= '0';
+        trc_strb_pend <= '0';
+        trc_stre_pend <= '0';
+      elsif c_trc_en then
+        -- Command of the next response
+        if (mcmd_wr_y = '1') then
+          trc_cmd  <= mcmd_id_y;
+          trc_data <= mcmd_data_y;
+          trc_cap  <= captured;
+        end if;
+        -- Clock stretch
+        if (scl_wait = '1') then
+          if (trc_str_cnt /= 255) then
+            trc_str_cnt <= trc_str_cnt + 1;
+          end if;
+          if (trc_str = '0')and(tstr_reg /= "00000000")and(trc_str_cnt + 1 = to_integer(unsigned(tstr_reg))) then
+            trc_str       <= '1';
+            trc_str_state <= bit_state;
+            trc_strb_pend <= '1';
+          end if;
+        else
+          trc_str_cnt <= 0;
+          if (trc_str = '1') then
+            trc_str       <= '0';
+            trc_stre_pend <= '1';
+          end if;
+        end if;
+        if (trc_sel_b = '1') then
+          trc_strb_pend <= '0';
+        end if;
+        if (trc_sel_e = '1') then
+          trc_stre_pend <= '0';
+        end if;
+        -- Timestamp since previous entry
+        if (trc_pre = unsigned(tpre_reg)) then
+          trc_pre <= (others => '0');
+          if (trc_tim /= x"FFFFF") then
+            trc_tim <= trc_tim + 1;
+          end if;
+        else
+          trc_pre <= trc_pre + 1;
+        end if;
+        -- Entry
+        if (trc_evt = '1')and(ten_reg = '1')and(tfrz_reg = '0') then
+          trc_ram(to_integer(trc_wptr)) <= trc_code & trc_arg & std_logic_vector(trc_tim);
+          trc_wptr <= trc_wptr + 1;
+          if (trc_wptr = 2**c_trc_bits - 1) then
+            twrap_reg <= '1';
+          end if;
+          trc_tim  <= (others => '0');
+          trc_pre  <= (others => '0');
+          if (ttrg_flag = '0') then
+            if (ttrg_reg(to_integer(unsigned(trc_code))) = '1') then
+              ttrg_flag <= '1';
+              trc_post  <= to_integer(unsigned(tpost_reg));
+              if (tpost_reg = "00000000") then
+                tfrz_reg <= '1';
+              end if;
+            end if;
+          elsif (trc_post /= 0) then
+            trc_post <= trc_post - 1;
+            if (trc_post = 1) then
+              tfrz_reg <= '1';
+            end if;
+          end if;
+        end if;
+        -- Register access
+        if (wr_tcr(0) = '1') then
+          ten_reg  <= idata(0);
+          tfrz_reg <= idata(1);
+          if (idata(1) = '0') then
+            ttrg_flag <= '0';
+          end if;
+          if (idata(7) = '1') then
+            tfrz_reg  <= '0';
+            ttrg_flag <= '0';
+            twrap_reg <= '0';
+            trc_wptr  <= (others => '0');
+            trc_tim   <= (others => '0');
+          end if;
+        end if;
+        if (wr_tcr(1) = '1') then
+          tpost_reg <= idata(15 downto  8);
+        end if;
+        if (wr_tcr(2) = '1') then
+          ttrg_reg( 7 downto 0) <= idata(23 downto 16);
+        end if;
+        if (wr_tcr(3) = '1') then
+          ttrg_reg(15 downto 8) <= idata(31 downto 24);
+        end if;
+        if (wr_tstr(2) = '1') then
+          tstr_reg <= idata(23 downto 16);
+        end if;
+        if (wr_tstr(3) = '1') then
+          tpre_reg <= idata(31 downto 24);
+        end if;
+        if (wr_tidx(0) = '1') then
+          tidx_reg( 7 downto 0) <= unsigned(idata( 7 downto 0));
+        end if;
+        if (wr_tidx(1) = '1') then
+          tidx_reg(15 downto 8) <= unsigned(idata(15 downto 8));
+        end if;
+        if (rd_tdat(3) = '1') then
+          tidx_reg <= tidx_reg + 1;
+        end if;
+      end if;
+    end if;
+  end process trc_proc;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  -- Burst: response continues Write/Read command, no status update
+  burst_next <= '1' when (burst = '1')and(mrsp_wr = '1')and
+                         (((burst_id  = mcmd_write)and(mrsp_id = mrsp_done)and(tx_level /= 0))or
+                          ((burst_id /= mcmd_write)and(mrsp_id = mrsp_byte)and(burst_cnt /= 0))) else '0';
+  rsp_final  <= mrsp_wr and not(burst_next) and not(msg_next);
+  -- Message reports not-acknowledge after Stop:
+  rsp_id     <= mrsp_nak when (msg = '1')and(msg_state = ms_stop)and(msg_nak = '1') else mrsp_id;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  -- Next byte command: new command from CMDR, step of a message or continuation of a burst
+  cmd_new <= wr_csr(2) and command_completed;
+
+  issue_proc:
+  process(cmd_new, idata, rcnt_reg, msg_go, msg_id, burst_next, burst_id, burst_cnt, rd_pend, rx_level)
+  begin
+    issue    <= '0';
+    issue_id <= idata(18 downto 16);
+    if (cmd_new = '1') then
+      issue    <= '1';
+      if c_fifo_en and (idata(18 downto 16) = mcmd_msg) then
+        issue    <= '0';  -- first step of message follows
+      end if;
+      if c_fifo_en and ((idata(18 downto 16) = mcmd_read_ack)or(idata(18 downto 16) = mcmd_read_nak))and
+         (unsigned(rcnt_reg) > 1) then
+        issue_id <= mcmd_read_ack;
+      end if;
+    elsif (msg_go = '1') then
+      issue    <= '1';
+      issue_id <= msg_id;
+    elsif (burst_next = '1')and(burst_id = mcmd_write) then
+      issue    <= '1';
+      issue_id <= mcmd_write;
+    elsif ((burst_next = '1')and(rx_level < g_fifo_depth - 1))or
+          ((rd_pend = '1')and(rx_level < g_fifo_depth)) then
+      issue    <= '1';
+      if (burst_cnt = 1) then
+        issue_id <= burst_id;
+      else
+        issue_id <= mcmd_read_ack;
+      end if;
+    end if;
+  end process issue_proc;
+
+  -- Parameter: TX FIFO, or 'Data' register written in the same cycle, or last written
+  issue_data   <= madr_reg(7 downto 1) & '1'        when (msg_adr_sel = '1')and(msg_state = ms_radr) else
+                  madr_reg(7 downto 1) & msg_adr_rd when (msg_adr_sel = '1') else
+                  tx_fifo(tx_rptr)                  when (tx_level /= 0) else
+                  idata(15 downto 8)                when (wr_csr(1) = '1') else
+                  tx_data_reg;
+  issue_bypass <= '1' when (issue = '1')and has_param(issue_id)and(msg_adr_sel = '0')and(tx_level = 0)and(wr_csr(1) = '1') else '0';
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  -- Burst state
+  burst_proc:
+  process(clk)
+  begin
+    if rising_edge(clk) then
+      if (s_rst = '1')or(e_reg = '0') then
+        burst     <= '0';
+        burst_id  <= mcmd_write;
+        burst_cnt <= 0;
+        rd_pend   <= '0';
+      else
+        if (cmd_new = '1') then
+          burst     <= '0';
+          burst_id  <= idata(18 downto 16);
+          burst_cnt <= 0;
+          if c_fifo_en then
+            if (idata(18 downto 16) = mcmd_write) then
+              burst     <= '1';
+            elsif ((idata(18 downto 16) = mcmd_read_ack)or(idata(18 downto 16) = mcmd_read_nak))and
+                  (unsigned(rcnt_reg) > 1) then
+              burst     <= '1';
+              burst_cnt <= to_integer(unsigned(rcnt_reg)) - 1;
+            end if;
+          end if;
+        else
+          if (burst_next = '1')and(burst_id /= mcmd_write)and(issue = '0') then
+            rd_pend   <= '1';   -- wait for space in RX FIFO
+          end if;
+          if (burst = '1')and(issue = '1')and(burst_id /= mcmd_write) then
+            rd_pend   <= '0';
+            burst_cnt <= burst_cnt - 1;
+          end if;
+          if (rsp_final = '1') then
+            burst     <= '0';
+          end if;
+        end if;
+      end if;
+    end if;
+  end process burst_proc;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  -- Message: next byte command, issued if no command is outstanding and
+  -- FIFO has data/space
+  msg_go      <= '1' when (msg = '1')and(msg_busy = '0')and
+                          ((msg_state /= ms_write)or(tx_level /= 0))and
+                          ((msg_state /= ms_read)or(rx_level < g_fifo_depth)) else '0';
+  msg_adr_sel <= '1' when (msg_go = '1')and((msg_state = ms_adr)or(msg_state = ms_radr)) else '0';
+
+  msg_id      <= mcmd_start    when (msg_state = ms_start)or(msg_state = ms_rstart) else
+                 mcmd_write    when (msg_state = ms_adr)or(msg_state = ms_write)or(msg_state = ms_radr) else
+                 mcmd_read_nak when (msg_state = ms_read)and(msg_rcnt = 1) else
+                 mcmd_read_ack when (msg_state = ms_read) else
+                 mcmd_stop;
+
+  -- Response closes the message:
+  msg_last    <= '1' when (msg_state = ms_stop)or(mrsp_id = mrsp_arb_lost)or(mrsp_id = mrsp_error) else '0';
+  msg_next    <= msg and mrsp_wr and not(msg_last);
+
+  msg_proc:
+  process(clk)
+  begin
+    if rising_edge(clk) then
+      if (s_rst = '1')or(e_reg = '0') then
+        msg        <= '0';
+        msg_busy   <= '0';
+        msg_state  <= ms_start;
+        msg_adr_rd <= '0';
+        msg_nak    <= '0';
+        msg_wcnt   <= 0;
+        msg_rcnt   <= 0;
+        msg_cnt    <= 0;
+      else
+        if c_fifo_en and (cmd_new = '1')and(idata(18 downto 16) = mcmd_msg) then
+          msg        <= '1';
+          msg_busy   <= '0';
+          msg_state  <= ms_start;
+          msg_nak    <= '0';
+          msg_cnt    <= 0;
+          if (madr_reg(0) = '0') then
+            msg_adr_rd <= '0';
+            msg_wcnt   <= to_integer(unsigned(mlen_reg));
+            msg_rcnt   <= 0;
+          elsif (mrsw_reg = "00000000") then
+            msg_adr_rd <= '1';
+            msg_wcnt   <= 0;
+            msg_rcnt   <= to_integer(unsigned(mlen_reg));
+          else
+            msg_adr_rd <= '0';
+            msg_wcnt   <= to_integer(unsigned(mrsw_reg));
+            msg_rcnt   <= to_integer(unsigned(mlen_reg));
+          end if;
+        elsif (msg = '1') then
+          if (msg_go = '1') then
+            msg_busy <= '1';
+          end if;
+          if (mrsp_wr = '1') then
+            msg_busy <= '0';
+            if (msg_last = '1') then
+              msg <= '0';
+            else
+              case msg_state is
+                when ms_start  =>
+                  msg_state <= ms_adr;
+                when ms_adr | ms_radr =>
+                  if (mrsp_id = mrsp_nak) then
+                    msg_nak   <= '1';
+                    msg_state <= ms_stop;
+                  elsif (msg_wcnt /= 0) then
+                    msg_state <= ms_write;
+                  elsif (msg_rcnt /= 0)and((msg_state = ms_radr)or(msg_adr_rd = '1')) then
+                    msg_state <= ms_read;
+                  else
+                    msg_state <= ms_stop;
+                  end if;
+                when ms_write  =>
+                  msg_cnt  <= msg_cnt + 1;
+                  msg_wcnt <= msg_wcnt - 1;
+                  if (mrsp_id = mrsp_nak) then
+                    msg_nak   <= '1';
+                    msg_state <= ms_stop;
+                  elsif (msg_wcnt = 1) then
+                    if (msg_rcnt /= 0) then
+                      msg_state <= ms_rstart;
+                    else
+                      msg_state <= ms_stop;
+                    end if;
+                  end if;
+                when ms_rstart =>
+                  msg_state <= ms_radr;
+                when ms_read   =>
+                  msg_cnt  <= msg_cnt + 1;
+                  msg_rcnt <= msg_rcnt - 1;
+                  if (msg_rcnt = 1) then
+                    msg_state <= ms_stop;
+                  end if;
+                when others    =>
+                  null;
+              end case;
+            end if;
+          end if;
+        end if;
+      end if;
+    end if;
+  end process msg_proc;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  -- FIFO and message control registers
+  process(clk)
+  begin
+    if rising_edge(clk) then
+      if (s_rst = '1') then
+        tx_thr_reg <= "00000000";
+        rx_thr_reg <= "00000000";
+        rcnt_reg   <= "00000000";
+        fie_reg    <= "0000";
+        madr_reg   <= "00000000";
+        mlen_reg   <= "00000000";
+        mrsw_reg   <= "00000000";
+      elsif c_fifo_en then
+        if (wr_fcr(0) = '1') then
+          tx_thr_reg <= idata( 7 downto  0);
+        end if;
+        if (wr_fcr(1) = '1') then
+          rx_thr_reg <= idata(15 downto  8);
+        end if;
+        if (wr_fcr(2) = '1') then
+          rcnt_reg   <= idata(23 downto 16);
+        end if;
+        if (wr_fcr(3) = '1') then
+          fie_reg    <= idata(27 downto 24);
+        end if;
+        if (wr_mcmd(0) = '1') then
+          madr_reg   <= idata( 7 downto  0);
+        end if;
+        if (wr_mcmd(1) = '1') then
+          mlen_reg   <= idata(15 downto  8);
+        end if;
+        if (wr_mcmd(2) = '1') then
+          mrsw_reg   <= idata(23 downto 16);
+        end if;
+      end if;
+    end if;
+  end process;
+  ------------------------------------------------------------------------------
+
+  tx_push <= wr_csr(1) and not(issue_bypass) when c_fifo_en else '0';
+  tx_pop  <= '1' when c_fifo_en and (issue = '1')and has_param(issue_id)and(msg_adr_sel = '0')and(tx_level /= 0) else '0';
+  tx_clr  <= '1' when (wr_fcr(3) = '1')and(idata(30) = '1') else '0';
+  rx_push <= '1' when c_fifo_en and (mrsp_wr = '1')and(mrsp_id = mrsp_byte) else '0';
+  rx_pop  <= '1' when c_fifo_en and (rd_csr(1) = '1')and(rx_level /= 0) else '0';
+  rx_clr  <= '1' when (wr_fcr(3) = '1')and(idata(31) = '1') else '0';
+
+  ------------------------------------------------------------------------------
+  -- TX FIFO
+  tx_fifo_proc:
+  process(clk)
+  begin
+    if rising_edge(clk) then
+      if (s_rst = '1')or(e_reg = '0')or(tx_clr = '1') then
+        tx_wptr  <= 0;
+        tx_rptr  <= 0;
+        tx_level <= 0;
+      elsif c_fifo_en then
+        if (tx_push = '1')and((tx_level < g_fifo_depth)or(tx_pop = '1')) then
+          tx_fifo(tx_wptr) <= idata(15 downto 8);
+          tx_wptr          <= inc_ptr(tx_wptr);
+          if (tx_pop = '0') then
+            tx_level <= tx_level + 1;
+          end if;
+        elsif (tx_pop = '1') then
+          tx_level <= tx_level - 1;
+        end if;
+        if (tx_pop = '1') then
+          tx_rptr  <= inc_ptr(tx_rptr);
+        end if;
+      end if;
+    end if;
+  end process tx_fifo_proc;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  -- RX FIFO, bytes received into full FIFO are only kept in 'rx_data_reg'
+  rx_fifo_proc:
+  process(clk)
+  begin
+    if rising_edge(clk) then
+      if (s_rst = '1')or(e_reg = '0')or(rx_clr = '1') then
+        rx_wptr  <= 0;
+        rx_rptr  <= 0;
+        rx_level <= 0;
+      elsif c_fifo_en then
+        if (rx_push = '1')and((rx_level < g_fifo_depth)or(rx_pop = '1')) then
+          rx_fifo(rx_wptr) <= mrsp_data;
+          rx_wptr          <= inc_ptr(rx_wptr);
+          if (rx_pop = '0') then
+            rx_level <= rx_level + 1;
+          end if;
+        elsif (rx_pop = '1') then
+          rx_level <= rx_level - 1;
+        end if;
+        if (rx_pop = '1') then
+          rx_rptr  <= inc_ptr(rx_rptr);
+        end if;
+      end if;
+    end if;
+  end process rx_fifo_proc;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  -- FIFO status and interrupt
+  fifo_status(0) <= '1' when (tx_level = 0) else '0';
+  fifo_status(1) <= '1' when (tx_level = g_fifo_depth) else '0';
+  fifo_status(2) <= '1' when (rx_level = 0) else '0';
+  fifo_status(3) <= '1' when (rx_level = g_fifo_depth) else '0';
+  fifo_status(4) <= '1' when (((burst = '1')and(burst_id = mcmd_write))or((msg = '1')and(msg_wcnt /= 0)))and
+                             (tx_level <= to_integer(unsigned(tx_thr_reg))) else '0';
+  fifo_status(5) <= '1' when (rx_level /= 0)and(rx_level >= to_integer(unsigned(rx_thr_reg))) else '0';
+  fifo_status(6) <= '0';
+  fifo_status(7) <= burst or msg;
+
+  fifo_irq <= '1' when c_fifo_en and (e_reg = '1')and
+                       (((fie_reg(0) = '1')and(fifo_status(4) = '1'))or
+                        ((fie_reg(1) = '1')and(fifo_status(5) = '1'))or
+                        ((fie_reg(2) = '1')and(fifo_status(0) = '1'))or
+                        ((fie_reg(3) = '1')and(fifo_status(3) = '1'))) else '0';
+  ------------------------------------------------------------------------------
 
   ------------------------------------------------------------------------------
   -- Generating a byte command
@@ -289,14 +1573,14 @@ begin
   begin
     if rising_edge(clk) then
       if (s_rst = '1')or(e_reg = '0') then
-        mcmd_wr_y <= '0';
-        mcmd_id_y <= mcmd_wait;
+        mcmd_wr_y   <= '0';
+        mcmd_id_y   <= mcmd_wait;
+        mcmd_data_y <= "00000000";
       else
-        if (wr(2) = '1')and(command_completed = '1') then
-          mcmd_wr_y <= '1';
-          mcmd_id_y <= idata(18 downto 16);
-        else
-          mcmd_wr_y <= '0';
+        mcmd_wr_y <= issue;
+        if (issue = '1') then
+          mcmd_id_y   <= issue_id;
+          mcmd_data_y <= issue_data;
         end if;
       end if;
     end if;
@@ -305,8 +1589,7 @@ begin
 
   mcmd_wr   <= mcmd_wr_y;
   mcmd_id   <= mcmd_id_y;
-  mcmd_data <= tx_data_reg;
+  mcmd_data <= mcmd_data_y;
 
 end architecture rtl;
 --==============================================================================
-
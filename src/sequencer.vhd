@@ -39,15 +39,28 @@
 
 library ieee;
 use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
 
 use work.iicmb_pkg.all;
 
 
+--==============================================================================
+-- The command sequence runs from a program memory of 'c_steps' words (see
+-- 'scmd_encode'), initialized with 'g_cmd' and writable at runtime through
+-- 'pm_wr'. Execution starts at word 0 and ends with the first END command or
+-- after the last word. READ_BYTE and WRITE_READ store the received byte and
+-- every command its response in the result memory, read through 'rs_adr'.
+-- WRITE_BURST writes the data address and 1 to 256 bytes under one Start/Stop,
+-- the bytes are packed 4 per word into the program memory words following it.
+-- A not acknowledged byte stops its transfer and the sequence continues with
+-- the next command, 'cs_status' then reports Write Not Acknowledged.
+-- Arbitration Lost and Error abort the sequence.
 --==============================================================================
 entity sequencer is
   generic
   (
-    g_cmd       :       seq_cmd_type_array := c_empty_array   -- Sequence of commands (supported: WAIT, SET_BUS and WRITE_BYTE)
+    g_cmd       :       seq_cmd_type_array := c_empty_array;  -- Sequence of commands (supported: WAIT, SET_BUS, WRITE_BYTE, READ_BYTE, WRITE_READ, WRITE_BURST, DATA and END)
+    g_steps     :       natural range 0 to 256 := 0           -- Depth of program memory (at least g_cmd'length)
   );
   port
   (
@@ -59,6 +72,19 @@ entity sequencer is
     cs_start    : in    std_logic;                            -- Start executing command sequence
     cs_busy     :   out std_logic;                            -- Command sequence is being executed
     cs_status   :   out std_logic_vector(2 downto 0);         -- Execution status
+    cs_step     :   out std_logic_vector(7 downto 0);         -- Command being executed or last executed
+    ------------------------------------
+    ------------------------------------
+    -- Program memory:
+    pm_wr       : in    std_logic                     := '0'; -- Write command (active high, ignored while busy)
+    pm_adr      : in    std_logic_vector( 7 downto 0) := (others => '0'); -- Step of command
+    pm_data     : in    std_logic_vector(31 downto 0) := (others => '0'); -- Command, see 'scmd_encode'
+    ------------------------------------
+    ------------------------------------
+    -- Result memory, one 'clk' cycle latency:
+    rs_adr      : in    std_logic_vector( 7 downto 0) := (others => '0'); -- Step of result
+    rs_status   :   out std_logic_vector( 2 downto 0);        -- Response of step
+    rs_data     :   out std_logic_vector( 7 downto 0);        -- Received byte of step
     ------------------------------------
     ------------------------------------
     -- Status:
@@ -85,119 +111,354 @@ end entity sequencer;
 --==============================================================================
 architecture rtl of sequencer is
 
-  type cmd_type_array is array (natural range <>) of std_logic_vector(10 downto 0);
+  ------------------------------------------------------------------------------
+  function get_steps(a : natural; b : natural) return positive is
+  begin
+    if (a > b) then
+      return a;
+    end if;
+    return b;
+  end function get_steps;
+  ------------------------------------------------------------------------------
+
+  constant c_steps   : positive := get_steps(g_steps, g_cmd'length);
+
+  type pm_type is array (0 to c_steps - 1) of std_logic_vector(31 downto 0);
+  type rs_type is array (0 to c_steps - 1) of std_logic_vector(10 downto 0);
 
   ------------------------------------------------------------------------------
-  function get_cmd_seq_length(a : seq_cmd_type_array) return natural is
-    variable v_ret : natural := 0;
+  function get_pm(a : seq_cmd_type_array) return pm_type is
+    variable v_ret : pm_type;
   begin
-    for i in a'range loop
-      case a(i).id is
-        when seq_wait       => v_ret := v_ret + 1;
-        when seq_set_bus    => v_ret := v_ret + 1;
-        when seq_write_byte => v_ret := v_ret + 5;
-      end case;
+    for i in v_ret'range loop
+      if (i < a'length) then
+        v_ret(i) := scmd_encode(a(a'low + i));
+      else
+        v_ret(i) := scmd_encode(scmd_end);
+      end if;
     end loop;
     return v_ret;
-  end function get_cmd_seq_length;
+  end function get_pm;
   ------------------------------------------------------------------------------
 
   ------------------------------------------------------------------------------
-  function get_cmd_seq(a : seq_cmd_type_array) return cmd_type_array is
-    variable v_ret : cmd_type_array(0 to (get_cmd_seq_length(a) - 1));
-    variable j : integer;
+  -- Last byte level command of a program memory word
+  function get_last(a : std_logic_vector(31 downto 0)) return natural is
   begin
-    j := 0;
-    for i in a'range loop
-      case a(i).id is
-        when seq_wait       =>
-          v_ret(j) := mcmd_wait & a(i).data;
-          j := j + 1;
-        when seq_set_bus    =>
-          v_ret(j) := mcmd_set_bus & a(i).data;
-          j := j + 1;
-        when seq_write_byte =>
-          v_ret(j + 0) := mcmd_start & x"00";
-          v_ret(j + 1) := mcmd_write & a(i).saddr & "0";
-          v_ret(j + 2) := mcmd_write & a(i).daddr;
-          v_ret(j + 3) := mcmd_write & a(i).data;
-          v_ret(j + 4) := mcmd_stop  & x"00";
-          j := j + 5;
-      end case;
-    end loop;
+    case a(31 downto 28) is
+      when sop_write_byte  => return 4;  -- Start, slave address, data address, data, Stop
+      when sop_read_byte   => return 3;  -- Start, slave address, data, Stop
+      when sop_write_read  => return 6;  -- Start, slave address, data address, Start, slave address, data, Stop
+      when sop_write_burst => return 4;  -- Start, slave address, data address, data (repeated), Stop
+      when others          => return 0;  -- Wait, Set Bus
+    end case;
+  end function get_last;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  -- Byte level command 'p' of a program memory word (ID & data)
+  function get_mcmd(a : std_logic_vector(31 downto 0); p : natural) return std_logic_vector is
+    variable v_sa_wr : std_logic_vector( 7 downto 0);
+    variable v_sa_rd : std_logic_vector( 7 downto 0);
+    variable v_ret   : std_logic_vector(10 downto 0);
+  begin
+    v_sa_wr := a(22 downto 16) & '0';
+    v_sa_rd := a(22 downto 16) & '1';
+    v_ret   := mcmd_stop & x"00";
+    case a(31 downto 28) is
+      when sop_wait        =>
+        v_ret := mcmd_wait & a(7 downto 0);
+      when sop_set_bus     =>
+        v_ret := mcmd_set_bus & a(7 downto 0);
+      when sop_write_byte  =>
+        case p is
+          when 0      => v_ret := mcmd_start & x"00";
+          when 1      => v_ret := mcmd_write & v_sa_wr;
+          when 2      => v_ret := mcmd_write & a(15 downto 8);
+          when 3      => v_ret := mcmd_write & a( 7 downto 0);
+          when others => null;
+        end case;
+      when sop_read_byte   =>
+        case p is
+          when 0      => v_ret := mcmd_start & x"00";
+          when 1      => v_ret := mcmd_write & v_sa_rd;
+          when 2      => v_ret := mcmd_read_nak & x"00";
+          when others => null;
+        end case;
+      when sop_write_read  =>
+        case p is
+          when 0      => v_ret := mcmd_start & x"00";
+          when 1      => v_ret := mcmd_write & v_sa_wr;
+          when 2      => v_ret := mcmd_write & a(15 downto 8);
+          when 3      => v_ret := mcmd_start & x"00";
+          when 4      => v_ret := mcmd_write & v_sa_rd;
+          when 5      => v_ret := mcmd_read_nak & x"00";
+          when others => null;
+        end case;
+      when sop_write_burst =>
+        case p is
+          when 0      => v_ret := mcmd_start & x"00";
+          when 1      => v_ret := mcmd_write & v_sa_wr;
+          when 2      => v_ret := mcmd_write & a(15 downto 8);
+          when 3      => v_ret := mcmd_write & x"00";  -- Data byte, see 'get_byte'
+          when others => null;
+        end case;
+      when others          =>
+        null;
+    end case;
     return v_ret;
-  end function get_cmd_seq;
+  end function get_mcmd;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  -- Byte 'i' of a packed burst data word
+  function get_byte(a : std_logic_vector(31 downto 0); i : natural) return std_logic_vector is
+  begin
+    case i is
+      when 0      => return a( 7 downto  0);
+      when 1      => return a(15 downto  8);
+      when 2      => return a(23 downto 16);
+      when others => return a(31 downto 24);
+    end case;
+  end function get_byte;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  -- Number of program memory words of a command
+  function get_words(a : std_logic_vector(31 downto 0)) return positive is
+  begin
+    if (a(31 downto 28) = sop_write_burst) then
+      return 1 + (to_integer(unsigned(a(7 downto 0))) + 4) / 4;
+    end if;
+    return 1;
+  end function get_words;
   ------------------------------------------------------------------------------
 
   ------------------------------------------------------------------------------
-  -- Sequence of commands to execute:
-  constant cmd_seq   : cmd_type_array := get_cmd_seq(g_cmd);
+  -- Program and result memory:
+  signal   pm        : pm_type                           := get_pm(g_cmd);
+  signal   pm_q      : std_logic_vector(31 downto 0)     := (others => '0');
+  signal   pm_radr   : integer range 0 to c_steps - 1    := 0;
+  signal   rs        : rs_type                           := (others => (others => '0'));
+  signal   rs_wr     : std_logic                         := '0';
+  signal   rs_wadr   : integer range 0 to c_steps - 1    := 0;
+  signal   rs_wdata  : std_logic_vector(10 downto 0)     := (others => '0');
   ------------------------------------------------------------------------------
 
-  type state_type is (s_idle, s_active);
+  type state_type is (s_idle, s_fetch, s_load, s_issue, s_active);
   signal   state     : state_type                        := s_idle;
-  signal   cmd_cnt   : integer range 0 to cmd_seq'length := 0;
+  signal   step      : integer range 0 to c_steps - 1    := 0;
+  signal   phase     : integer range 0 to 6              := 0;
+  signal   cmd       : std_logic_vector(31 downto 0)     := (others => '0');
+  signal   bdata     : std_logic_vector(31 downto 0)     := (others => '0');
+  signal   bbyte     : integer range 0 to 3              := 0;
+  signal   bcnt      : integer range 0 to 256            := 0;
+  signal   step_nak  : std_logic                         := '0';
+  signal   seq_nak   : std_logic                         := '0';
+  signal   rx_data   : std_logic_vector( 7 downto 0)     := (others => '0');
+  signal   busy_y    : std_logic                         := '0';
 
 begin
 
+  cs_busy <= busy_y;
+  cs_step <= std_logic_vector(to_unsigned(step, 8));
+
+  ------------------------------------------------------------------------------
+  pm_proc:
+  process(clk)
+  begin
+    if rising_edge(clk) then
+      if (pm_wr = '1') and (busy_y = '0') and (to_integer(unsigned(pm_adr)) < c_steps) then
+        pm(to_integer(unsigned(pm_adr))) <= pm_data;
+      end if;
+      pm_q <= pm(pm_radr);
+    end if;
+  end process pm_proc;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  rs_proc:
+  process(clk)
+  begin
+    if rising_edge(clk) then
+      if (rs_wr = '1') then
+        rs(rs_wadr) <= rs_wdata;
+      end if;
+      if (to_integer(unsigned(rs_adr)) < c_steps) then
+        rs_status <= rs(to_integer(unsigned(rs_adr)))(10 downto 8);
+        rs_data   <= rs(to_integer(unsigned(rs_adr)))( 7 downto 0);
+      else
+        rs_status <= mrsp_done;
+        rs_data   <= (others => '0');
+      end if;
+    end if;
+  end process rs_proc;
+  ------------------------------------------------------------------------------
+
   ------------------------------------------------------------------------------
   state_proc:
   process(clk)
+    variable v_mcmd : std_logic_vector(10 downto 0);
+    variable v_next : natural;
   begin
     if rising_edge(clk) then
       if (s_rst = '1') then
         state     <= s_idle;
-        cmd_cnt   <= 0;
-        cs_busy   <= '0';
+        step      <= 0;
+        phase     <= 0;
+        cmd       <= (others => '0');
+        bdata     <= (others => '0');
+        bbyte     <= 0;
+        bcnt      <= 0;
+        pm_radr   <= 0;
+        step_nak  <= '0';
+        seq_nak   <= '0';
+        rx_data   <= (others => '0');
+        busy_y    <= '0';
         cs_status <= mrsp_done;
+        rs_wr     <= '0';
+        rs_wadr   <= 0;
+        rs_wdata  <= (others => '0');
         mcmd_wr   <= '0';
         mcmd_id   <= "000";
         mcmd_data <= "00000000";
       else
         -- Defaults:
         mcmd_wr   <= '0';
+        rs_wr     <= '0';
 
         -- FSM:
         case state is
           -------------- 's_idle' state ------------------------
           when s_idle   =>
-            cs_busy   <= '0';
+            busy_y    <= '0';
             if (cs_start = '1') then
-              if (cmd_cnt = cmd_seq'length) then
-                cs_status <= mrsp_done;
-                cmd_cnt   <= 0;
+              state     <= s_fetch;
+              step      <= 0;
+              phase     <= 0;
+              pm_radr   <= 0;
+              step_nak  <= '0';
+              seq_nak   <= '0';
+              rx_data   <= (others => '0');
+              busy_y    <= '1';
+            end if;
+          -------------- 's_idle' state ------------------------
+
+          -------------- 's_fetch' state -----------------------
+          -- Program memory word of 'pm_radr' valid in next cycle
+          when s_fetch  =>
+            state     <= s_load;
+          -------------- 's_fetch' state -----------------------
+
+          -------------- 's_load' state ------------------------
+          when s_load   =>
+            state     <= s_issue;
+            if (phase = 0) then
+              cmd       <= pm_q;
+            else
+              bdata     <= pm_q;
+            end if;
+          -------------- 's_load' state ------------------------
+
+          -------------- 's_issue' state -----------------------
+          when s_issue  =>
+            if (cmd(31 downto 28) = sop_wait)       or (cmd(31 downto 28) = sop_set_bus)   or
+               (cmd(31 downto 28) = sop_write_byte) or (cmd(31 downto 28) = sop_read_byte) or
+               (cmd(31 downto 28) = sop_write_read) or (cmd(31 downto 28) = sop_write_burst) then
+              v_mcmd    := get_mcmd(cmd, phase);
+              if (cmd(31 downto 28) = sop_write_burst) and (phase = 3) then
+                v_mcmd(7 downto 0) := get_byte(bdata, bbyte);
+              end if;
+              state     <= s_active;
+              mcmd_wr   <= '1';
+              mcmd_id   <= v_mcmd(10 downto 8);
+              mcmd_data <= v_mcmd( 7 downto 0);
+            else
+              -- End of sequence:
+              state     <= s_idle;
+              busy_y    <= '0';
+              if (seq_nak = '1') then
+                cs_status <= mrsp_nak;
               else
-                state     <= s_active;
-                cmd_cnt   <= cmd_cnt + 1;
-                cs_busy   <= '1';
-                mcmd_wr   <= '1';
-                mcmd_id   <= cmd_seq(cmd_cnt)(10 downto 8);
-                mcmd_data <= cmd_seq(cmd_cnt)( 7 downto 0);
+                cs_status <= mrsp_done;
               end if;
             end if;
-          -------------- 's_idle' state ------------------------
+          -------------- 's_issue' state -----------------------
 
           -------------- 's_active' state ----------------------
           when s_active =>
-            cs_busy   <= '1';
             if (mrsp_wr = '1') then
               case mrsp_id is
-                when mrsp_nak | mrsp_arb_lost | mrsp_error =>
+                when mrsp_nak      =>
+                  -- Release bus with Stop, continue with next command:
+                  state     <= s_issue;
+                  phase     <= get_last(cmd);
+                  step_nak  <= '1';
+                  seq_nak   <= '1';
+                when mrsp_arb_lost | mrsp_error =>
                   state     <= s_idle;
-                  cmd_cnt   <= 0;
-                  cs_busy   <= '0';
+                  busy_y    <= '0';
                   cs_status <= mrsp_id;
+                  rs_wr     <= '1';
+                  rs_wadr   <= step;
+                  rs_wdata  <= mrsp_id & rx_data;
                 when others        =>
-                  if (cmd_cnt = cmd_seq'length) then
-                    state     <= s_idle;
-                    cmd_cnt   <= 0;
-                    cs_busy   <= '0';
-                    cs_status <= mrsp_done;
+                  if (mrsp_id = mrsp_byte) then
+                    rx_data   <= mrsp_data;
+                  end if;
+                  if (cmd(31 downto 28) = sop_write_burst) and (phase = 2) then
+                    -- Fetch first burst data word:
+                    state     <= s_fetch;
+                    phase     <= 3;
+                    bbyte     <= 0;
+                    bcnt      <= to_integer(unsigned(cmd(7 downto 0))) + 1;
+                    if (pm_radr /= c_steps - 1) then
+                      pm_radr   <= pm_radr + 1;
+                    end if;
+                  elsif (cmd(31 downto 28) = sop_write_burst) and (phase = 3) and (bcnt /= 1) then
+                    -- Next burst data byte:
+                    bcnt      <= bcnt - 1;
+                    if (bbyte = 3) then
+                      state     <= s_fetch;
+                      bbyte     <= 0;
+                      if (pm_radr /= c_steps - 1) then
+                        pm_radr   <= pm_radr + 1;
+                      end if;
+                    else
+                      state     <= s_issue;
+                      bbyte     <= bbyte + 1;
+                    end if;
+                  elsif (phase /= get_last(cmd)) then
+                    state     <= s_issue;
+                    phase     <= phase + 1;
                   else
-                    cmd_cnt   <= cmd_cnt + 1;
-                    mcmd_wr   <= '1';
-                    mcmd_id   <= cmd_seq(cmd_cnt)(10 downto 8);
-                    mcmd_data <= cmd_seq(cmd_cnt)( 7 downto 0);
+                    -- Command completed:
+                    rs_wr     <= '1';
+                    rs_wadr   <= step;
+                    if (step_nak = '1') then
+                      rs_wdata  <= mrsp_nak & rx_data;
+                    elsif (mrsp_id = mrsp_byte) then
+                      rs_wdata  <= mrsp_done & mrsp_data;
+                    else
+                      rs_wdata  <= mrsp_done & rx_data;
+                    end if;
+                    phase     <= 0;
+                    step_nak  <= '0';
+                    rx_data   <= (others => '0');
+                    v_next    := step + get_words(cmd);
+                    if (v_next > c_steps - 1) then
+                      state     <= s_idle;
+                      busy_y    <= '0';
+                      if (seq_nak = '1') then
+                        cs_status <= mrsp_nak;
+                      else
+                        cs_status <= mrsp_done;
+                      end if;
+                    else
+                      state     <= s_fetch;
+                      step      <= v_next;
+                      pm_radr   <= v_next;
+                    end if;
                   end if;
               end case;
             end if;
@@ -54,13 +54,14 @@ entity wishbone is
     cyc_i       : in    std_logic;                              -- Valid bus cycle indication
     stb_i       : in    std_logic;                              -- Slave selection
     ack_o       :   out std_logic;                              -- Acknowledge output
-    adr_i       : in    std_logic_vector( 1 downto 0);          -- Low bits of Wishbone address
+    adr_i       : in    std_logic_vector( 6 downto 0);          -- Low bits of Wishbone address
     we_i        : in    std_logic;                              -- Write enable
     dat_i       : in    std_logic_vector( 7 downto 0);          -- Data input
     dat_o       :   out std_logic_vector( 7 downto 0);          -- Data output
     ------------------------------------
     ------------------------------------
     -- Regblock interface:
+    adr         :   out std_logic_vector( 4 downto 0);          -- Word address
     wr          :   out std_logic_vector( 3 downto 0);          -- Write (active high)
     rd          :   out std_logic_vector( 3 downto 0);          -- Read (active high)
     idata       :   out std_logic_vector(31 downto 0);          -- Data from System Bus
@@ -99,14 +100,15 @@ begin
   end process ack_o_proc;
   ------------------------------------------------------------------------------
 
-  wr(0) <= stb_i and cyc_i and     we_i  and not(ack_o_y) when (adr_i = "00") else '0';
-  wr(1) <= stb_i and cyc_i and     we_i  and not(ack_o_y) when (adr_i = "01") else '0';
-  wr(2) <= stb_i and cyc_i and     we_i  and not(ack_o_y) when (adr_i = "10") else '0';
-  wr(3) <= stb_i and cyc_i and     we_i  and not(ack_o_y) when (adr_i = "11") else '0';
-  rd(0) <= stb_i and cyc_i and not(we_i) and not(ack_o_y) when (adr_i = "00") else '0';
-  rd(1) <= stb_i and cyc_i and not(we_i) and not(ack_o_y) when (adr_i = "01") else '0';
-  rd(2) <= stb_i and cyc_i and not(we_i) and not(ack_o_y) when (adr_i = "10") else '0';
-  rd(3) <= stb_i and cyc_i and not(we_i) and not(ack_o_y) when (adr_i = "11") else '0';
+  wr(0) <= stb_i and cyc_i and     we_i  and not(ack_o_y) when (adr_i(1 downto 0) = "00") else '0';
+  wr(1) <= stb_i and cyc_i and     we_i  and not(ack_o_y) when (adr_i(1 downto 0) = "01") else '0';
+  wr(2) <= stb_i and cyc_i and     we_i  and not(ack_o_y) when (adr_i(1 downto 0) = "10") else '0';
+  wr(3) <= stb_i and cyc_i and     we_i  and not(ack_o_y) when (adr_i(1 downto 0) = "11") else '0';
+  rd(0) <= stb_i and cyc_i and not(we_i) and not(ack_o_y) when (adr_i(1 downto 0) = "00") else '0';
+  rd(1) <= stb_i and cyc_i and not(we_i) and not(ack_o_y) when (adr_i(1 downto 0) = "01") else '0';
+  rd(2) <= stb_i and cyc_i and not(we_i) and not(ack_o_y) when (adr_i(1 downto 0) = "10") else '0';
+  rd(3) <= stb_i and cyc_i and not(we_i) and not(ack_o_y) when (adr_i(1 downto 0) = "11") else '0';
+  adr   <= adr_i(6 downto 2);
   idata <= dat_i & dat_i & dat_i & dat_i;
 
   ------------------------------------------------------------------------------
@@ -117,7 +119,7 @@ begin
       if (rst_i = '1') then
         dat_o_y <= (others => '0');
       else
-        case (adr_i) is
+        case (adr_i(1 downto 0)) is
           when "00"   => dat_o_y <= odata( 7 downto  0);
           when "01"   => dat_o_y <= odata(15 downto  8);
           when "10"   => dat_o_y <= odata(23 downto 16);
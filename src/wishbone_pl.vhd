@@ -0,0 +1,117 @@
+
+--==============================================================================
+--                                                                             |
+--    Project: IIC Multiple Bus Controller (IICMB)                             |
+--                                                                             |
+--    Module:  Wishbone B4 pipelined slave interface (32-bit).                 |
+--    Version:                                                                 |
+--             1.0,   October 16, 2026                                         |
+--                                                                             |
+--    Author:  IICMB contributors                                              |
+--                                                                             |
+--==============================================================================
+--==============================================================================
+-- Copyright (c) 2016, Sergey Shuvalkin                                        |
+-- All rights reserved.                                                        |
+--                                                                             |
+-- Redistribution and use in source and binary forms, with or without          |
+-- modification, are permitted provided that the following conditions are met: |
+--                                                                             |
+-- 1. Redistributions of source code must retain the above copyright notice,   |
+--    this list of conditions and the following disclaimer.                    |
+-- 2. Redistributions in binary form must reproduce the above copyright        |
+--    notice, this list of conditions and the following disclaimer in the      |
+--    documentation and/or other materials provided with the distribution.     |
+--                                                                             |
+-- THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" |
+-- AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE   |
+-- IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE  |
+-- ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE    |
+-- LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR         |
+-- CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF        |
+-- SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS    |
+-- INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN     |
+-- CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)     |
+-- ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE  |
+-- POSSIBILITY OF SUCH DAMAGE.                                                 |
+--==============================================================================
+
+
+library ieee;
+use ieee.std_logic_1164.all;
+
+
+--==============================================================================
+-- Every cycle with 'stb_i' is accepted ('stall_o' is always low) and
+-- acknowledged in the next cycle with the read data, so back-to-back
+-- accesses run at one access per clock. 'sel_i' selects the byte lanes.
+--==============================================================================
+entity wishbone_pl is
+  port
+  (
+    ------------------------------------
+    clk_i       : in    std_logic;                              -- Clock input
+    rst_i       : in    std_logic;                              -- Synchronous reset (active high)
+    ------------------------------------
+    ------------------------------------
+    -- Wishbone slave interface:
+    cyc_i       : in    std_logic;                              -- Valid bus cycle indication
+    stb_i       : in    std_logic;                              -- Slave selection
+    stall_o     :   out std_logic;                              -- Pipeline stall
+    ack_o       :   out std_logic;                              -- Acknowledge output
+    adr_i       : in    std_logic_vector( 6 downto 0);          -- Low bits of Wishbone address (bits 1..0 unused)
+    sel_i       : in    std_logic_vector( 3 downto 0);          -- Byte select
+    we_i        : in    std_logic;                              -- Write enable
+    dat_i       : in    std_logic_vector(31 downto 0);          -- Data input
+    dat_o       :   out std_logic_vector(31 downto 0);          -- Data output
+    ------------------------------------
+    ------------------------------------
+    -- Regblock interface:
+    adr         :   out std_logic_vector( 4 downto 0);          -- Word address
+    wr          :   out std_logic_vector( 3 downto 0);          -- Write (active high)
+    rd          :   out std_logic_vector( 3 downto 0);          -- Read (active high)
+    idata       :   out std_logic_vector(31 downto 0);          -- Data from System Bus
+    odata       : in    std_logic_vector(31 downto 0)           -- Data to System Bus
+    ------------------------------------
+  );
+end entity wishbone_pl;
+--==============================================================================
+
+--==============================================================================
+architecture rtl of wishbone_pl is
+
+  signal req          : std_logic;
+  signal ack_o_y      : std_logic                     := '0';
+  signal dat_o_y      : std_logic_vector(31 downto 0) := (others => '0');
+
+begin
+
+  stall_o <= '0';
+  ack_o   <= ack_o_y;
+  dat_o   <= dat_o_y;
+
+  req     <= stb_i and cyc_i;
+
+  wr      <= sel_i when (req = '1')and(we_i = '1') else "0000";
+  rd      <= sel_i when (req = '1')and(we_i = '0') else "0000";
+  adr     <= adr_i(6 downto 2);
+  idata   <= dat_i;
+
+  ------------------------------------------------------------------------------
+  ack_o_proc:
+  process(clk_i)
+  begin
+    if rising_edge(clk_i) then
+      if (rst_i = '1') then
+        ack_o_y <= '0';
+        dat_o_y <= (others => '0');
+      else
+        ack_o_y <= req;
+        dat_o_y <= odata;
+      end if;
+    end if;
+  end process ack_o_proc;
+  ------------------------------------------------------------------------------
+
+end architecture rtl;
+--==============================================================================
@@ -0,0 +1,169 @@
+--==============================================================================
+--                                                                             |
+--    Project: IIC Multiple Bus Controller (IICMB)                             |
+--                                                                             |
+--    Module:  Behavioral I2C slave model with 16 bytes of memory.             |
+--    Version:                                                                 |
+--             1.0,   October 17, 2026                                         |
+--                                                                             |
+--    Author:  IICMB contributors                                              |
+--                                                                             |
+--==============================================================================
+--==============================================================================
+-- Copyright (c) 2016, Sergey Shuvalkin                                        |
+-- All rights reserved.                                                        |
+--                                                                             |
+-- Redistribution and use in source and binary forms, with or without          |
+-- modification, are permitted provided that the following conditions are met: |
+--                                                                             |
+-- 1. Redistributions of source code must retain the above copyright notice,   |
+--    this list of conditions and the following disclaimer.                    |
+-- 2. Redistributions in binary form must reproduce the above copyright        |
+--    notice, this list of conditions and the following disclaimer in the      |
+--    documentation and/or other materials provided with the distribution.     |
+--                                                                             |
+-- THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" |
+-- AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE   |
+-- IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE  |
+-- ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE    |
+-- LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR         |
+-- CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF        |
+-- SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS    |
+-- INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN     |
+-- CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)     |
+-- ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE  |
+-- POSSIBILITY OF SUCH DAMAGE.                                                 |
+--==============================================================================
+
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+
+--==============================================================================
+-- Acknowledges its address and every written byte. The first written byte
+-- sets the memory address, further bytes are stored, read bytes are returned
+-- from the memory address, both increment it. 'SCL' is never stretched.
+--==============================================================================
+entity i2c_slave_mdl is
+  generic
+  (
+    g_adr     :       std_logic_vector(6 downto 0) := "0100000" -- Slave address
+  );
+  port
+  (
+    scl       : in    std_logic;
+    sda       : inout std_logic := 'Z'
+  );
+end entity i2c_slave_mdl;
+--==============================================================================
+
+--==============================================================================
+architecture beh of i2c_slave_mdl is
+
+  type state_type is (s_idle, s_adr, s_adr_ack, s_wr, s_wr_ack, s_rd, s_rd_ack);
+  type mem_type   is array (0 to 15) of std_logic_vector(7 downto 0);
+
+  function drive(a : std_logic) return std_logic is
+  begin
+    if (a = '0') then
+      return '0';
+    else
+      return 'Z';
+    end if;
+  end function drive;
+
+begin
+
+  ------------------------------------------------------------------------------
+  slave_proc:
+  process(scl, sda)
+    variable state   : state_type := s_idle;
+    variable cnt     : natural range 0 to 8 := 0;
+    variable sreg    : std_logic_vector(7 downto 0) := (others => '0');
+    variable rnw     : std_logic := '0';
+    variable ptr     : natural range 0 to 15 := 0;
+    variable ptr_set : boolean := false;
+    variable mem     : mem_type := (others => (others => '0'));
+  begin
+    if (scl'event)and(to_x01(scl) = '1') then
+      -- Sample on rising 'SCL':
+      case state is
+        when s_adr | s_wr =>
+          sreg  := sreg(6 downto 0) & to_x01(sda);
+          cnt   := cnt + 1;
+        when s_rd_ack =>
+          if (to_x01(sda) = '1') then
+            state := s_idle; -- Not acknowledged, wait for Stop
+          end if;
+        when others =>
+          null;
+      end case;
+    elsif (scl'event)and(to_x01(scl) = '0') then
+      -- Drive on falling 'SCL':
+      case state is
+        when s_adr =>
+          if (cnt = 8) then
+            if (sreg(7 downto 1) = g_adr) then
+              state := s_adr_ack;
+              rnw   := sreg(0);
+              sda   <= '0';
+            else
+              state := s_idle;
+            end if;
+          end if;
+        when s_adr_ack | s_rd_ack =>
+          if (state = s_rd_ack)or(rnw = '1') then
+            state := s_rd;
+            sreg  := mem(ptr);
+            ptr   := (ptr + 1) mod 16;
+            cnt   := 1;
+            sda   <= drive(sreg(7));
+          else
+            state   := s_wr;
+            cnt     := 0;
+            ptr_set := false;
+            sda     <= 'Z';
+          end if;
+        when s_wr =>
+          if (cnt = 8) then
+            if (ptr_set) then
+              mem(ptr) := sreg;
+              ptr      := (ptr + 1) mod 16;
+            else
+              ptr      := to_integer(unsigned(sreg(3 downto 0)));
+              ptr_set  := true;
+            end if;
+            state := s_wr_ack;
+            sda   <= '0';
+          end if;
+        when s_wr_ack =>
+          state := s_wr;
+          cnt   := 0;
+          sda   <= 'Z';
+        when s_rd =>
+          if (cnt = 8) then
+            state := s_rd_ack;
+            sda   <= 'Z';
+          else
+            sda   <= drive(sreg(7 - cnt));
+            cnt   := cnt + 1;
+          end if;
+        when others =>
+          null;
+      end case;
+    elsif (sda'event)and(to_x01(scl) = '1') then
+      -- Start or Stop condition:
+      cnt   := 0;
+      if (to_x01(sda) = '0') then
+        state := s_adr;
+      else
+        state := s_idle;
+      end if;
+    end if;
+  end process slave_proc;
+  ------------------------------------------------------------------------------
+
+end architecture beh;
+--==============================================================================
@@ -0,0 +1,361 @@
+--==============================================================================
+--                                                                             |
+--    Project: IIC Multiple Bus Controller (IICMB)                             |
+--                                                                             |
+--    Module:  Testbench for AXI4-Lite slave of 'iicmb_m_axi'.                 |
+--    Version:                                                                 |
+--             1.0,   October 17, 2026                                         |
+--                                                                             |
+--    Author:  IICMB contributors                                              |
+--                                                                             |
+--==============================================================================
+--==============================================================================
+-- Copyright (c) 2016, Sergey Shuvalkin                                        |
+-- All rights reserved.                                                        |
+--                                                                             |
+-- Redistribution and use in source and binary forms, with or without          |
+-- modification, are permitted provided that the following conditions are met: |
+--                                                                             |
+-- 1. Redistributions of source code must retain the above copyright notice,   |
+--    this list of conditions and the following disclaimer.                    |
+-- 2. Redistributions in binary form must reproduce the above copyright        |
+--    notice, this list of conditions and the following disclaimer in the      |
+--    documentation and/or other materials provided with the distribution.     |
+--                                                                             |
+-- THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" |
+-- AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE   |
+-- IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE  |
+-- ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE    |
+-- LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR         |
+-- CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF        |
+-- SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS    |
+-- INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN     |
+-- CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)     |
+-- ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE  |
+-- POSSIBILITY OF SUCH DAMAGE.                                                 |
+--==============================================================================
+
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+library iicmb;
+use iicmb.iicmb_pkg.all;
+
+use work.test.all;
+
+
+--==============================================================================
+entity iicmb_m_axi_tb is
+end entity iicmb_m_axi_tb;
+--==============================================================================
+
+--==============================================================================
+architecture beh of iicmb_m_axi_tb is
+
+  constant c_f_clk   : real      := 100000.0; -- in kHz
+  constant c_p_clk   : time      := integer(1000000000.0/c_f_clk) * 1 ps;
+
+  constant c_bus_num : positive  := 1;
+
+  ------------------------------------------------------------------------------
+  component iicmb_m_axi is
+    generic
+    (
+      g_bus_num     :       positive range 1 to 16 := 1;
+      g_engines     :       positive range 1 to 16 := 1;
+      g_fifo_depth  :       natural range 0 to 255 := 0;
+      g_trace_depth :       natural range 0 to 12  := 0;
+      g_poll_depth  :       natural range 0 to 127 := 0;
+      g_f_clk       :       real                   := 100000.0;
+      g_f_scl_0     :       real                   :=    100.0;
+      g_f_scl_1     :       real                   :=    100.0;
+      g_f_scl_2     :       real                   :=    100.0;
+      g_f_scl_3     :       real                   :=    100.0;
+      g_f_scl_4     :       real                   :=    100.0;
+      g_f_scl_5     :       real                   :=    100.0;
+      g_f_scl_6     :       real                   :=    100.0;
+      g_f_scl_7     :       real                   :=    100.0;
+      g_f_scl_8     :       real                   :=    100.0;
+      g_f_scl_9     :       real                   :=    100.0;
+      g_f_scl_a     :       real                   :=    100.0;
+      g_f_scl_b     :       real                   :=    100.0;
+      g_f_scl_c     :       real                   :=    100.0;
+      g_f_scl_d     :       real                   :=    100.0;
+      g_f_scl_e     :       real                   :=    100.0;
+      g_f_scl_f     :       real                   :=    100.0;
+      g_f_scl_hs    :       real                   :=   3400.0
+    );
+    port
+    (
+      aclk          : in    std_logic;
+      aresetn       : in    std_logic;
+      s_axi_awvalid : in    std_logic;
+      s_axi_awready :   out std_logic;
+      s_axi_awaddr  : in    std_logic_vector(11 downto 0);
+      s_axi_wvalid  : in    std_logic;
+      s_axi_wready  :   out std_logic;
+      s_axi_wdata   : in    std_logic_vector(31 downto 0);
+      s_axi_wstrb   : in    std_logic_vector( 3 downto 0);
+      s_axi_bvalid  :   out std_logic;
+      s_axi_bready  : in    std_logic;
+      s_axi_bresp   :   out std_logic_vector( 1 downto 0);
+      s_axi_arvalid : in    std_logic;
+      s_axi_arready :   out std_logic;
+      s_axi_araddr  : in    std_logic_vector(11 downto 0);
+      s_axi_rvalid  :   out std_logic;
+      s_axi_rready  : in    std_logic;
+      s_axi_rdata   :   out std_logic_vector(31 downto 0);
+      s_axi_rresp   :   out std_logic_vector( 1 downto 0);
+      irq           :   out std_logic;
+      irq_eng       :   out std_logic_vector(0 to g_engines - 1);
+      scl_i         : in    std_logic_vector(0 to g_bus_num - 1);
+      sda_i         : in    std_logic_vector(0 to g_bus_num - 1);
+      scl_o         :   out std_logic_vector(0 to g_bus_num - 1);
+      sda_o         :   out std_logic_vector(0 to g_bus_num - 1);
+      scl_pu_o      :   out std_logic_vector(0 to g_bus_num - 1)
+    );
+  end component iicmb_m_axi;
+  ------------------------------------------------------------------------------
+
+  signal   aclk        : std_logic := '0';
+  signal   aresetn     : std_logic := '0';
+
+  signal   awvalid     : std_logic := '0';
+  signal   awready     : std_logic;
+  signal   awaddr      : std_logic_vector(11 downto 0) := (others => '0');
+  signal   wvalid      : std_logic := '0';
+  signal   wready      : std_logic;
+  signal   wdata       : std_logic_vector(31 downto 0) := (others => '0');
+  signal   wstrb       : std_logic_vector( 3 downto 0) := (others => '0');
+  signal   bvalid      : std_logic;
+  signal   bready      : std_logic := '1';
+  signal   bresp       : std_logic_vector( 1 downto 0);
+  signal   arvalid     : std_logic := '0';
+  signal   arready     : std_logic;
+  signal   araddr      : std_logic_vector(11 downto 0) := (others => '0');
+  signal   rvalid      : std_logic;
+  signal   rready      : std_logic := '1';
+  signal   rdata       : std_logic_vector(31 downto 0);
+  signal   rresp       : std_logic_vector( 1 downto 0);
+  signal   irq         : std_logic;
+  signal   irq_eng     : std_logic_vector(0 to 0);
+
+  signal   b_cnt       : natural := 0;
+
+  signal   scl_o       : std_logic_vector(0 to c_bus_num - 1);
+  signal   sda_o       : std_logic_vector(0 to c_bus_num - 1);
+  signal   scl_pu_o    : std_logic_vector(0 to c_bus_num - 1);
+  signal   bus_idle    : std_logic_vector(0 to c_bus_num - 1) := (others => '1');
+
+begin
+
+  aclk <= not(aclk) after c_p_clk / 2;
+  aresetn <= '0', '1' after 113 ns;
+
+  ------------------------------------------------------------------------------
+  process
+    ----------------------------------------------------------------------------
+    procedure axi_aw(a : in natural) is
+    begin
+      awvalid <= '1';
+      awaddr  <= std_logic_vector(to_unsigned(a, 12));
+      loop
+        wait until rising_edge(aclk);
+        exit when (awready = '1');
+      end loop;
+      awvalid <= '0';
+    end procedure axi_aw;
+    ----------------------------------------------------------------------------
+    ----------------------------------------------------------------------------
+    procedure axi_w(d : in std_logic_vector(31 downto 0); s : in std_logic_vector(3 downto 0)) is
+    begin
+      wvalid  <= '1';
+      wdata   <= d;
+      wstrb   <= s;
+      loop
+        wait until rising_edge(aclk);
+        exit when (wready = '1');
+      end loop;
+      wvalid  <= '0';
+    end procedure axi_w;
+    ----------------------------------------------------------------------------
+    ----------------------------------------------------------------------------
+    procedure axi_read(a : in natural; d : in std_logic_vector(31 downto 0)) is
+    begin
+      arvalid <= '1';
+      araddr  <= std_logic_vector(to_unsigned(a, 12));
+      loop
+        wait until rising_edge(aclk);
+        exit when (arready = '1');
+      end loop;
+      arvalid <= '0';
+      loop
+        wait until rising_edge(aclk);
+        exit when (rvalid = '1')and(rready = '1');
+      end loop;
+      print_string("Read 0x" & to_string(std_logic_vector(to_unsigned(a, 12)), "X", 3) & ": 0x" & to_string(rdata, "X", 8) & newline);
+      assert (rdata = d) report "Wrong read data" severity error;
+    end procedure axi_read;
+    ----------------------------------------------------------------------------
+    ----------------------------------------------------------------------------
+    procedure clk_wait(n : in natural) is
+    begin
+      for i in 1 to n loop
+        wait until rising_edge(aclk);
+      end loop;
+    end procedure clk_wait;
+    ----------------------------------------------------------------------------
+  begin
+    wait until (aresetn = '1');
+    wait until rising_edge(aclk);
+
+    -- Write address before write data, in separate cycles:
+    axi_aw(16#14#);
+    clk_wait(2);
+    assert (b_cnt = 0) report "Write without write data" severity error;
+    axi_w(x"01234567", "1111");
+    clk_wait(2);
+    assert (b_cnt = 1) report "No write response" severity error;
+    axi_read(16#14#, x"01234567");
+
+    -- Write data before write address, byte lanes 0 and 2 only:
+    axi_w(x"A1B2C3D4", "0101");
+    clk_wait(2);
+    assert (b_cnt = 1) report "Write without write address" severity error;
+    axi_aw(16#14#);
+    clk_wait(2);
+    assert (b_cnt = 2) report "No write response" severity error;
+    axi_read(16#14#, x"01B245D4");
+
+    -- Write address and data in the same cycle, byte lanes 1 and 3 only:
+    axi_aw(16#18#);
+    axi_w(x"00000000", "1111");
+    awvalid <= '1';
+    awaddr  <= std_logic_vector(to_unsigned(16#18#, 12));
+    wvalid  <= '1';
+    wdata   <= x"89ABCDEF";
+    wstrb   <= "1010";
+    wait until rising_edge(aclk);
+    assert (awready = '1')and(wready = '1') report "Write not accepted" severity error;
+    awvalid <= '0';
+    wvalid  <= '0';
+    clk_wait(2);
+    assert (b_cnt = 4) report "No write response" severity error;
+    axi_read(16#18#, x"8900CD00");
+
+    -- Overlapping reads, one per clock:
+    arvalid <= '1';
+    araddr  <= std_logic_vector(to_unsigned(16#14#, 12));
+    wait until rising_edge(aclk);
+    assert (arready = '1') report "Read 0 not accepted" severity error;
+    araddr  <= std_logic_vector(to_unsigned(16#18#, 12));
+    wait until rising_edge(aclk);
+    assert (arready = '1') report "Read 1 not accepted" severity error;
+    assert (rvalid = '1')and(rdata = x"01B245D4") report "Wrong data of read 0" severity error;
+    araddr  <= std_logic_vector(to_unsigned(16#14#, 12));
+    wait until rising_edge(aclk);
+    assert (arready = '1') report "Read 2 not accepted" severity error;
+    assert (rvalid = '1')and(rdata = x"8900CD00") report "Wrong data of read 1" severity error;
+    arvalid <= '0';
+    wait until rising_edge(aclk);
+    assert (rvalid = '1')and(rdata = x"01B245D4") report "Wrong data of read 2" severity error;
+    wait until rising_edge(aclk);
+    assert (rvalid = '0') report "Read data without read" severity error;
+
+    -- Read data not taken, the next read waits:
+    rready  <= '0';
+    arvalid <= '1';
+    araddr  <= std_logic_vector(to_unsigned(16#14#, 12));
+    wait until rising_edge(aclk);
+    assert (arready = '1') report "Read 0 not accepted" severity error;
+    araddr  <= std_logic_vector(to_unsigned(16#18#, 12));
+    clk_wait(2);
+    assert (arready = '0') report "Read accepted with read data pending" severity error;
+    assert (rvalid = '1')and(rdata = x"01B245D4") report "Read data not held" severity error;
+    rready  <= '1';
+    wait until rising_edge(aclk);
+    assert (arready = '1') report "Read 1 not accepted" severity error;
+    arvalid <= '0';
+    wait until rising_edge(aclk);
+    assert (rvalid = '1')and(rdata = x"8900CD00") report "Wrong data of read 1" severity error;
+
+    -- Write and read in the same cycle, the write goes first:
+    awvalid <= '1';
+    awaddr  <= std_logic_vector(to_unsigned(16#1C#, 12));
+    wvalid  <= '1';
+    wdata   <= x"76543210";
+    wstrb   <= "1111";
+    arvalid <= '1';
+    araddr  <= std_logic_vector(to_unsigned(16#1C#, 12));
+    wait until rising_edge(aclk);
+    assert (arready = '0') report "Read not delayed by write" severity error;
+    awvalid <= '0';
+    wvalid  <= '0';
+    wait until rising_edge(aclk);
+    assert (arready = '1') report "Read not accepted after write" severity error;
+    arvalid <= '0';
+    wait until rising_edge(aclk);
+    assert (rvalid = '1')and(rdata = x"76543210") report "Read did not return written data" severity error;
+    clk_wait(2);
+    assert (b_cnt = 5) report "No write response" severity error;
+
+    print_string("Test done" & newline);
+    wait;
+  end process;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  -- Count write responses:
+  process(aclk)
+  begin
+    if rising_edge(aclk) then
+      if (bvalid = '1')and(bready = '1') then
+        assert (bresp = "00") report "Write response not OKAY" severity error;
+        b_cnt <= b_cnt + 1;
+      end if;
+    end if;
+  end process;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  dut : iicmb_m_axi
+    generic map
+    (
+      g_bus_num     => c_bus_num,
+      g_f_clk       => c_f_clk
+    )
+    port map
+    (
+      aclk          => aclk,
+      aresetn       => aresetn,
+      s_axi_awvalid => awvalid,
+      s_axi_awready => awready,
+      s_axi_awaddr  => awaddr,
+      s_axi_wvalid  => wvalid,
+      s_axi_wready  => wready,
+      s_axi_wdata   => wdata,
+      s_axi_wstrb   => wstrb,
+      s_axi_bvalid  => bvalid,
+      s_axi_bready  => bready,
+      s_axi_bresp   => bresp,
+      s_axi_arvalid => arvalid,
+      s_axi_arready => arready,
+      s_axi_araddr  => araddr,
+      s_axi_rvalid  => rvalid,
+      s_axi_rready  => rready,
+      s_axi_rdata   => rdata,
+      s_axi_rresp   => rresp,
+      irq           => irq,
+      irq_eng       => irq_eng,
+      scl_i         => bus_idle,
+      sda_i         => bus_idle,
+      scl_o         => scl_o,
+      sda_o         => sda_o,
+      scl_pu_o      => scl_pu_o
+    );
+  ------------------------------------------------------------------------------
+
+end architecture beh;
+--==============================================================================
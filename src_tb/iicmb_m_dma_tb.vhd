@@ -0,0 +1,417 @@
+--==============================================================================
+--                                                                             |
+--    Project: IIC Multiple Bus Controller (IICMB)                             |
+--                                                                             |
+--    Module:  Testbench for DMA descriptor chains of 'iicmb_m_wb'.            |
+--    Version:                                                                 |
+--             1.0,   October 17, 2026                                         |
+--                                                                             |
+--    Author:  IICMB contributors                                              |
+--                                                                             |
+--==============================================================================
+--==============================================================================
+-- Copyright (c) 2016, Sergey Shuvalkin                                        |
+-- All rights reserved.                                                        |
+--                                                                             |
+-- Redistribution and use in source and binary forms, with or without          |
+-- modification, are permitted provided that the following conditions are met: |
+--                                                                             |
+-- 1. Redistributions of source code must retain the above copyright notice,   |
+--    this list of conditions and the following disclaimer.                    |
+-- 2. Redistributions in binary form must reproduce the above copyright        |
+--    notice, this list of conditions and the following disclaimer in the      |
+--    documentation and/or other materials provided with the distribution.     |
+--                                                                             |
+-- THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" |
+-- AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE   |
+-- IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE  |
+-- ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE    |
+-- LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR         |
+-- CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF        |
+-- SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS    |
+-- INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN     |
+-- CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)     |
+-- ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE  |
+-- POSSIBILITY OF SUCH DAMAGE.                                                 |
+--==============================================================================
+
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+library iicmb;
+use iicmb.iicmb_pkg.all;
+
+use work.test.all;
+
+
+--==============================================================================
+entity iicmb_m_dma_tb is
+end entity iicmb_m_dma_tb;
+--==============================================================================
+
+--==============================================================================
+architecture beh of iicmb_m_dma_tb is
+
+  constant c_f_clk   : real      := 100000.0; -- in kHz
+  constant c_f_scl_0 : real      :=    400.0; -- in kHz
+  constant c_p_clk   : time      := integer(1000000000.0/c_f_clk) * 1 ps;
+
+  constant c_bus_num : positive  := 1;
+
+  ------------------------------------------------------------------------------
+  component iicmb_m_wb is
+    generic
+    (
+      g_bus_num     :       positive range 1 to 16 := 1;
+      g_engines     :       positive range 1 to 16 := 1;
+      g_fifo_depth  :       natural range 0 to 255 := 0;
+      g_trace_depth :       natural range 0 to 12  := 0;
+      g_poll_depth  :       natural range 0 to 127 := 0;
+      g_dma         :       boolean                := false;
+      g_pipelined   :       boolean                := false;
+      g_f_clk       :       real                   := 100000.0;
+      g_f_scl_0     :       real                   :=    100.0;
+      g_f_scl_1     :       real                   :=    100.0;
+      g_f_scl_2     :       real                   :=    100.0;
+      g_f_scl_3     :       real                   :=    100.0;
+      g_f_scl_4     :       real                   :=    100.0;
+      g_f_scl_5     :       real                   :=    100.0;
+      g_f_scl_6     :       real                   :=    100.0;
+      g_f_scl_7     :       real                   :=    100.0;
+      g_f_scl_8     :       real                   :=    100.0;
+      g_f_scl_9     :       real                   :=    100.0;
+      g_f_scl_a     :       real                   :=    100.0;
+      g_f_scl_b     :       real                   :=    100.0;
+      g_f_scl_c     :       real                   :=    100.0;
+      g_f_scl_d     :       real                   :=    100.0;
+      g_f_scl_e     :       real                   :=    100.0;
+      g_f_scl_f     :       real                   :=    100.0;
+      g_f_scl_hs    :       real                   :=   3400.0
+    );
+    port
+    (
+      clk_i         : in    std_logic;
+      rst_i         : in    std_logic;
+      cyc_i         : in    std_logic;
+      stb_i         : in    std_logic;
+      ack_o         :   out std_logic;
+      stall_o       :   out std_logic;
+      adr_i         : in    std_logic_vector(6 downto 0);
+      adr_eng_i     : in    std_logic_vector(3 downto 0) := "0000";
+      adr_pl_i      : in    std_logic                    := '0';
+      we_i          : in    std_logic;
+      dat_i         : in    std_logic_vector(7 downto 0) := (others => '0');
+      dat_o         :   out std_logic_vector(7 downto 0);
+      sel_i         : in    std_logic_vector( 3 downto 0) := "1111";
+      dat32_i       : in    std_logic_vector(31 downto 0) := (others => '0');
+      dat32_o       :   out std_logic_vector(31 downto 0);
+      irq           :   out std_logic;
+      irq_eng       :   out std_logic_vector(0 to g_engines - 1);
+      irq_dma       :   out std_logic;
+      m_cyc_o       :   out std_logic;
+      m_stb_o       :   out std_logic;
+      m_we_o        :   out std_logic;
+      m_sel_o       :   out std_logic_vector( 3 downto 0);
+      m_adr_o       :   out std_logic_vector(31 downto 0);
+      m_dat_o       :   out std_logic_vector(31 downto 0);
+      m_dat_i       : in    std_logic_vector(31 downto 0) := (others => '0');
+      m_ack_i       : in    std_logic                     := '0';
+      scl_i         : in    std_logic_vector(0 to g_bus_num - 1);
+      sda_i         : in    std_logic_vector(0 to g_bus_num - 1);
+      scl_o         :   out std_logic_vector(0 to g_bus_num - 1);
+      sda_o         :   out std_logic_vector(0 to g_bus_num - 1);
+      scl_pu_o      :   out std_logic_vector(0 to g_bus_num - 1)
+    );
+  end component iicmb_m_wb;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  component i2c_slave_mdl is
+    generic
+    (
+      g_adr     :       std_logic_vector(6 downto 0) := "0100000"
+    );
+    port
+    (
+      scl       : in    std_logic;
+      sda       : inout std_logic := 'Z'
+    );
+  end component i2c_slave_mdl;
+  ------------------------------------------------------------------------------
+
+  -- System memory of the DMA, 256 words:
+  type mem_type is array (0 to 255) of std_logic_vector(31 downto 0);
+
+  function get_mem_init return mem_type is
+    variable v_mem : mem_type := (others => (others => '0'));
+  begin
+    -- TX data of descriptor #0 at 0x100: memory address 0x00 and 4 bytes
+    v_mem(16#40#) := x"33221100";
+    v_mem(16#41#) := x"00000044";
+    -- TX data of descriptor #1 at 0x110: memory address 0x00
+    v_mem(16#44#) := x"00000000";
+    -- RX data of descriptor #1 at 0x180, the last byte is not written
+    v_mem(16#60#) := x"EEEEEEEE";
+    -- Descriptor #1 at 0x200: write 1 byte, read 3 bytes, end of chain
+    v_mem(16#80#) := x"00010343";
+    v_mem(16#81#) := x"00000110";
+    v_mem(16#82#) := x"00000180";
+    v_mem(16#83#) := x"00000000";
+    -- TX data of descriptor #2 at 0x120: memory address 0x04 and 4 bytes
+    v_mem(16#48#) := x"77665504";
+    v_mem(16#49#) := x"00000088";
+    -- RX data of descriptor #3 at 0x1C0, the last 3 bytes are not written
+    v_mem(16#70#) := x"EEEEEEEE";
+    v_mem(16#71#) := x"EEEEEEEE";
+    v_mem(16#72#) := x"EEEEEEEE";
+    -- Descriptor #3 at 0x210: write 1 byte, read 9 bytes, end of chain
+    v_mem(16#84#) := x"00010943";
+    v_mem(16#85#) := x"00000110";
+    v_mem(16#86#) := x"000001C0";
+    v_mem(16#87#) := x"00000000";
+    return v_mem;
+  end function get_mem_init;
+
+  signal   clk         : std_logic := '0';
+  signal   s_rst       : std_logic := '1';
+
+  signal   cyc         : std_logic := '0';
+  signal   stb         : std_logic := '0';
+  signal   ack         : std_logic;
+  signal   stall       : std_logic;
+  signal   adr         : std_logic_vector( 6 downto 0) := (others => '0');
+  signal   we          : std_logic := '0';
+  signal   sel         : std_logic_vector( 3 downto 0) := (others => '0');
+  signal   dat_w       : std_logic_vector(31 downto 0) := (others => '0');
+  signal   dat_r       : std_logic_vector(31 downto 0);
+  signal   irq         : std_logic;
+  signal   irq_eng     : std_logic_vector(0 to 0);
+  signal   irq_dma     : std_logic;
+
+  signal   m_cyc       : std_logic;
+  signal   m_stb       : std_logic;
+  signal   m_we        : std_logic;
+  signal   m_sel       : std_logic_vector( 3 downto 0);
+  signal   m_adr       : std_logic_vector(31 downto 0);
+  signal   m_dat_w     : std_logic_vector(31 downto 0);
+  signal   m_dat_r     : std_logic_vector(31 downto 0) := (others => '0');
+  signal   m_ack       : std_logic := '0';
+  signal   mem         : mem_type := get_mem_init;
+
+  signal   scl_o       : std_logic_vector(0 to c_bus_num - 1);
+  signal   sda_o       : std_logic_vector(0 to c_bus_num - 1);
+  signal   scl_pu_o    : std_logic_vector(0 to c_bus_num - 1);
+  signal   scl         : std_logic_vector(0 to c_bus_num - 1);
+  signal   sda         : std_logic_vector(0 to c_bus_num - 1);
+
+begin
+
+  clk <= not(clk) after c_p_clk / 2;
+  s_rst <= '1', '0' after 113 ns;
+
+  ------------------------------------------------------------------------------
+  process
+    variable v_data : std_logic_vector(31 downto 0);
+    ----------------------------------------------------------------------------
+    procedure wb_write(a : in natural; d : in std_logic_vector(31 downto 0); s : in std_logic_vector(3 downto 0)) is
+    begin
+      cyc   <= '1';
+      stb   <= '1';
+      we    <= '1';
+      adr   <= std_logic_vector(to_unsigned(a, 7));
+      sel   <= s;
+      dat_w <= d;
+      wait until rising_edge(clk);
+      stb   <= '0';
+      we    <= '0';
+      wait until rising_edge(clk);
+      assert (ack = '1') report "Write not acknowledged" severity error;
+      cyc   <= '0';
+    end procedure wb_write;
+    ----------------------------------------------------------------------------
+    ----------------------------------------------------------------------------
+    procedure wb_read(a : in natural; d : out std_logic_vector(31 downto 0)) is
+    begin
+      cyc   <= '1';
+      stb   <= '1';
+      we    <= '0';
+      adr   <= std_logic_vector(to_unsigned(a, 7));
+      sel   <= "1111";
+      wait until rising_edge(clk);
+      stb   <= '0';
+      wait until rising_edge(clk);
+      assert (ack = '1') report "Read not acknowledged" severity error;
+      d     := dat_r;
+      cyc   <= '0';
+    end procedure wb_read;
+    ----------------------------------------------------------------------------
+  begin
+    wait until (s_rst = '0');
+    wait until rising_edge(clk);
+
+    -- Enable engine #0:
+    wb_write(16#00#, x"00000080", "0001");
+
+    -- Descriptor #0 in registers: write memory address and 4 bytes
+    wb_write(16#60#, x"00000100", "1111"); -- DSRC
+    wb_write(16#64#, x"00000000", "1111"); -- DDST
+    wb_write(16#68#, x"00000200", "1111"); -- DNXT
+    wb_write(16#6C#, x"00000542", "1111"); -- DMSG
+    wb_write(16#70#, x"00000003", "0001"); -- DCSR: GO, IE
+    wb_read(16#70#, v_data);
+    assert (v_data(0) = '1') report "DMA not busy" severity error;
+
+    wait until (irq_dma = '1') for 2 ms;
+    assert (irq_dma = '1') report "No interrupt at end of chain" severity error;
+    wait until rising_edge(clk);
+
+    wb_read(16#70#, v_data);
+    print_string("DCSR: 0x" & to_string(v_data, "X", 8) & newline);
+    assert (v_data(0) = '0') report "DMA still busy" severity error;
+    assert (v_data(2) = '1') report "DONE not set" severity error;
+    assert (v_data(10 downto 8) = mrsp_done) report "Chain not completed with Done" severity error;
+    wb_read(16#68#, v_data);
+    assert (v_data = x"00000000") report "Descriptor #1 not fetched" severity error;
+    wb_read(16#64#, v_data);
+    assert (v_data = x"00000184") report "Wrong RX address after chain" severity error;
+
+    -- RX data of descriptor #1, read back from the slave written by #0:
+    print_string("RX data: 0x" & to_string(mem(16#60#), "X", 8) & newline);
+    assert (mem(16#60#) = x"EE332211") report "Wrong RX data" severity error;
+
+    -- Clear DONE:
+    wb_write(16#70#, x"00000004", "0001");
+    wait until rising_edge(clk);
+    assert (irq_dma = '0') report "Interrupt not cleared" severity error;
+
+    -- Descriptor #2 in registers: write memory address 0x04 and 4 bytes
+    wb_write(16#60#, x"00000120", "1111"); -- DSRC
+    wb_write(16#64#, x"00000000", "1111"); -- DDST
+    wb_write(16#68#, x"00000210", "1111"); -- DNXT
+    wb_write(16#6C#, x"00000542", "1111"); -- DMSG
+    wb_write(16#70#, x"00000003", "0001"); -- DCSR: GO, IE
+
+    wait until (irq_dma = '1') for 2 ms;
+    assert (irq_dma = '1') report "No interrupt at end of second chain" severity error;
+    wait until rising_edge(clk);
+
+    -- Read of descriptor #3 is longer than the RX FIFO, all bytes up to the
+    -- last partial word reach memory:
+    wb_read(16#70#, v_data);
+    print_string("DCSR: 0x" & to_string(v_data, "X", 8) & newline);
+    assert (v_data(0) = '0') report "DMA still busy" severity error;
+    assert (v_data(10 downto 8) = mrsp_done) report "Second chain not completed with Done" severity error;
+    wb_read(16#64#, v_data);
+    assert (v_data = x"000001CC") report "Wrong RX address after second chain" severity error;
+    print_string("RX data: 0x" & to_string(mem(16#70#), "X", 8) & " 0x" & to_string(mem(16#71#), "X", 8) & " 0x" & to_string(mem(16#72#), "X", 8) & newline);
+    assert (mem(16#70#) = x"44332211") report "Wrong RX data, word #0" severity error;
+    assert (mem(16#71#) = x"88776655") report "Wrong RX data, word #1" severity error;
+    assert (mem(16#72#) = x"EEEEEE00") report "Wrong RX data, last word" severity error;
+
+    wb_write(16#70#, x"00000004", "0001");
+
+    print_string("Test done" & newline);
+    wait;
+  end process;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  -- System memory, acknowledge in the cycle after the request:
+  mem_proc:
+  process(clk)
+  begin
+    if rising_edge(clk) then
+      m_ack <= '0';
+      if (m_cyc = '1')and(m_stb = '1')and(m_ack = '0') then
+        m_ack   <= '1';
+        m_dat_r <= mem(to_integer(unsigned(m_adr(9 downto 2))));
+      end if;
+      if (m_cyc = '1')and(m_stb = '1')and(m_ack = '1')and(m_we = '1') then
+        for i in 0 to 3 loop
+          if (m_sel(i) = '1') then
+            mem(to_integer(unsigned(m_adr(9 downto 2))))(8*i + 7 downto 8*i) <= m_dat_w(8*i + 7 downto 8*i);
+          end if;
+        end loop;
+      end if;
+    end if;
+  end process mem_proc;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  dut : iicmb_m_wb
+    generic map
+    (
+      g_bus_num     => c_bus_num,
+      g_engines     => 1,
+      g_fifo_depth  => 4,
+      g_dma         => true,
+      g_pipelined   => true,
+      g_f_clk       => c_f_clk,
+      g_f_scl_0     => c_f_scl_0
+    )
+    port map
+    (
+      clk_i         => clk,
+      rst_i         => s_rst,
+      cyc_i         => cyc,
+      stb_i         => stb,
+      ack_o         => ack,
+      stall_o       => stall,
+      adr_i         => adr,
+      we_i          => we,
+      dat_o         => open,
+      sel_i         => sel,
+      dat32_i       => dat_w,
+      dat32_o       => dat_r,
+      irq           => irq,
+      irq_eng       => irq_eng,
+      irq_dma       => irq_dma,
+      m_cyc_o       => m_cyc,
+      m_stb_o       => m_stb,
+      m_we_o        => m_we,
+      m_sel_o       => m_sel,
+      m_adr_o       => m_adr,
+      m_dat_o       => m_dat_w,
+      m_dat_i       => m_dat_r,
+      m_ack_i       => m_ack,
+      scl_i         => scl,
+      sda_i         => sda,
+      scl_o         => scl_o,
+      sda_o         => sda_o,
+      scl_pu_o      => scl_pu_o
+    );
+  ------------------------------------------------------------------------------
+
+  --****************************************************************************
+  bus_gen:
+  for i in 0 to c_bus_num - 1 generate
+    signal scl_w : std_logic;
+    signal sda_w : std_logic;
+  begin
+    scl_w <= '0' when (scl_o(i) = '0') else 'Z';
+    sda_w <= '0' when (sda_o(i) = '0') else 'Z';
+    scl_w <= 'H'; -- Pull up
+    sda_w <= 'H'; -- Pull up
+
+    scl(i) <= to_x01(scl_w);
+    sda(i) <= to_x01(sda_w);
+
+    ----------------------------------------------------------------------------
+    i2c_slave_mdl_inst0 : i2c_slave_mdl
+      generic map
+      (
+        g_adr     => "0100001"
+      )
+      port map
+      (
+        scl       => scl_w,
+        sda       => sda_w
+      );
+    ----------------------------------------------------------------------------
+  end generate bus_gen;
+  --****************************************************************************
+
+end architecture beh;
+--==============================================================================
@@ -65,6 +65,7 @@ architecture beh of iicmb_m_sq_tb is
   constant c_p_clk   : time      := integer(1000000000.0/c_f_clk) * 1 ps; -- Period of 'clk' in ps.
 
   constant c_bus_num : positive  := 4;
+  constant c_steps   : positive  := 16;
 
   ------------------------------------------------------------------------------
   component iicmb_m_sq is
@@ -88,7 +89,8 @@ architecture beh of iicmb_m_sq_tb is
       g_f_scl_d     :       real                   :=    100.0;
       g_f_scl_e     :       real                   :=    100.0;
       g_f_scl_f     :       real                   :=    100.0;
-      g_cmd         :       seq_cmd_type_array     := c_empty_array
+      g_cmd         :       seq_cmd_type_array     := c_empty_array;
+      g_steps       :       natural range 0 to 256 := 0
     );
     port
     (
@@ -97,6 +99,13 @@ architecture beh of iicmb_m_sq_tb is
       cs_start      : in    std_logic;
       cs_busy       :   out std_logic;
       cs_status     :   out std_logic_vector(2 downto 0);
+      cs_step       :   out std_logic_vector(7 downto 0);
+      pm_wr         : in    std_logic                     := '0';
+      pm_adr        : in    std_logic_vector( 7 downto 0) := (others => '0');
+      pm_data       : in    std_logic_vector(31 downto 0) := (others => '0');
+      rs_adr        : in    std_logic_vector( 7 downto 0) := (others => '0');
+      rs_status     :   out std_logic_vector( 2 downto 0);
+      rs_data       :   out std_logic_vector( 7 downto 0);
       scl_i         : in    std_logic_vector(0 to g_bus_num - 1);
       sda_i         : in    std_logic_vector(0 to g_bus_num - 1);
       scl_o         :   out std_logic_vector(0 to g_bus_num - 1);
@@ -149,6 +158,13 @@ architecture beh of iicmb_m_sq_tb is
   signal   cs_start    : std_logic := '0';
   signal   cs_busy     : std_logic;
   signal   cs_status   : std_logic_vector(2 downto 0);
+  signal   cs_step     : std_logic_vector(7 downto 0);
+  signal   pm_wr       : std_logic := '0';
+  signal   pm_adr      : std_logic_vector( 7 downto 0) := (others => '0');
+  signal   pm_data     : std_logic_vector(31 downto 0) := (others => '0');
+  signal   rs_adr      : std_logic_vector( 7 downto 0) := (others => '0');
+  signal   rs_status   : std_logic_vector( 2 downto 0);
+  signal   rs_data     : std_logic_vector( 7 downto 0);
 
   signal   clk         : std_logic := '0';
   signal   s_rst       : std_logic := '1';
@@ -167,21 +183,112 @@ architecture beh of iicmb_m_sq_tb is
   signal   sda_nquant  : bit_vector(0 to c_bus_num - 1) := (others => '1');
   signal   irq         : std_logic;
 
+  -- Bus monitor:
+  type integer_vector is array (natural range <>) of integer;
+  signal   stops       : integer_vector(0 to c_bus_num - 1) := (others => 0);
+  type byte_log  is array (0 to 31) of std_logic_vector(8 downto 0); -- Byte & not acknowledged
+  type log_array is array (natural range <>) of byte_log;
+  signal   bytes       : log_array(0 to c_bus_num - 1);
+
 begin
 
   clk <= not(clk) after c_p_clk / 2;
   s_rst <= '1', '0' after 113 ns;
 
   ------------------------------------------------------------------------------
-  -- Generate signal to launch the sequencer
+  -- Sequencer control and checks:
   process
+    ----------------------------------------------------------------------------
+    procedure seq_run(status : in std_logic_vector(2 downto 0)) is
+    begin
+      wait until rising_edge(clk);
+      cs_start <= '1';
+      wait until rising_edge(clk);
+      cs_start <= '0';
+      wait until cs_busy = '0';
+      print_string("Sequence done, status: " & to_string(cs_status, "X", 1) & newline);
+      assert (cs_status = status) report "Unexpected sequence status" severity error;
+    end procedure seq_run;
+    ----------------------------------------------------------------------------
+    ----------------------------------------------------------------------------
+    procedure rs_check(step : in natural; status : in std_logic_vector(2 downto 0); data : in std_logic_vector(7 downto 0)) is
+    begin
+      wait until rising_edge(clk);
+      rs_adr   <= std_logic_vector(to_unsigned(step, 8));
+      wait until rising_edge(clk);
+      wait until rising_edge(clk);
+      print_string("Result " & integer'image(step) & ": " & to_string(rs_status, "X", 1) & " : 0x" & to_string(rs_data, "X", 2) & newline);
+      assert (rs_status = status) report "Unexpected result status" severity error;
+      assert (rs_data = data) report "Unexpected result data" severity error;
+    end procedure rs_check;
+    ----------------------------------------------------------------------------
+    ----------------------------------------------------------------------------
+    procedure pm_load(step : in natural; cmd : in seq_cmd_type) is
+    begin
+      wait until rising_edge(clk);
+      pm_wr    <= '1';
+      pm_adr   <= std_logic_vector(to_unsigned(step, 8));
+      pm_data  <= scmd_encode(cmd);
+      wait until rising_edge(clk);
+      pm_wr    <= '0';
+    end procedure pm_load;
+    ----------------------------------------------------------------------------
   begin
     cs_start <= '0';
     wait for 2000 ns;
-    wait until rising_edge(clk);
-    cs_start <= '1';
-    wait until rising_edge(clk);
-    cs_start <= '0';
+
+    -- Program of 'g_cmd', step 7 is not acknowledged:
+    seq_run(mrsp_nak);
+    rs_check( 2, mrsp_done, x"00");
+    rs_check( 5, mrsp_done, x"4A");
+    rs_check( 6, mrsp_done, x"67");
+    rs_check( 7, mrsp_nak,  x"00");
+    rs_check( 8, mrsp_done, x"00");
+    rs_check(10, mrsp_done, x"59");
+    -- Every transfer on bus #1 ended with Stop, also the not acknowledged one:
+    assert (stops(1) = 5) report "Missing Stop on bus #1" severity error;
+    assert (stops(2) = 2) report "Missing Stop on bus #2" severity error;
+
+    -- Program reloaded at runtime:
+    pm_load(0, scmd_set_bus(3));
+    pm_load(1, scmd_write_byte("0100011", x"01", x"C3"));
+    pm_load(2, scmd_write_read("0100011", x"01"));
+    pm_load(3, scmd_end);
+    seq_run(mrsp_done);
+    rs_check( 1, mrsp_done, x"00");
+    rs_check( 2, mrsp_done, x"C3");
+    assert (stops(1) = 5) report "Unexpected transfer on bus #1" severity error;
+    assert (stops(3) = 2) report "Missing Stop on bus #3" severity error;
+
+    -- Bursts of packed data words, the not acknowledged one skips its data:
+    pm_load(0, scmd_set_bus(0));
+    pm_load(1, scmd_write_burst("0100000", x"00", 6));
+    pm_load(2, scmd_data(x"11", x"22", x"33", x"44"));
+    pm_load(3, scmd_data(x"55", x"66"));
+    pm_load(4, scmd_write_burst("0100111", x"00", 5));
+    pm_load(5, scmd_data(x"A1", x"A2", x"A3", x"A4"));
+    pm_load(6, scmd_data(x"A5"));
+    pm_load(7, scmd_write_read("0100000", x"01"));
+    pm_load(8, scmd_end);
+    seq_run(mrsp_nak);
+    rs_check( 1, mrsp_done, x"00");
+    rs_check( 4, mrsp_nak,  x"00");
+    rs_check( 7, mrsp_done, x"22");
+    assert (stops(0) = 3) report "Missing Stop on bus #0" severity error;
+    -- Bytes received on bus #0 (slave address, data address, burst data):
+    assert (bytes(0)( 0) = x"40" & '0') report "Burst: wrong slave address" severity error;
+    assert (bytes(0)( 1) = x"00" & '0') report "Burst: wrong data address" severity error;
+    assert (bytes(0)( 2) = x"11" & '0') report "Burst: wrong byte 0" severity error;
+    assert (bytes(0)( 3) = x"22" & '0') report "Burst: wrong byte 1" severity error;
+    assert (bytes(0)( 4) = x"33" & '0') report "Burst: wrong byte 2" severity error;
+    assert (bytes(0)( 5) = x"44" & '0') report "Burst: wrong byte 3" severity error;
+    assert (bytes(0)( 6) = x"55" & '0') report "Burst: wrong byte 4" severity error;
+    assert (bytes(0)( 7) = x"66" & '0') report "Burst: wrong byte 5" severity error;
+    assert (bytes(0)( 8) = x"4E" & '1') report "Burst: slave address not NAKed" severity error;
+    assert (bytes(0)( 9) = x"40" & '0') report "Burst: data words not skipped" severity error;
+    assert (bytes(0)(10) = x"01" & '0') report "Burst: data words not skipped" severity error;
+
+    print_string("Test done" & newline);
     wait;
   end process;
   ------------------------------------------------------------------------------
@@ -203,10 +310,15 @@ begin
           scmd_write_byte("0100001", x"00", x"4A"), -- Write byte
           scmd_write_byte("0100001", x"01", x"67"), -- Write byte
           scmd_wait(1),                             -- Wait for 1 ms
+          scmd_write_read("0100001", x"00"),        -- Read byte of address 0x00
+          scmd_read_byte("0100001"),                -- Read byte of next address
+          scmd_write_byte("0100101", x"00", x"11"), -- No such slave, not acknowledged
           scmd_set_bus(2),                          -- Select bus #2
           scmd_write_byte("0100010", x"02", x"59"), -- Write byte
-          scmd_write_byte("0100010", x"03", x"AB")  -- Write byte
-        )
+          scmd_write_read("0100010", x"02"),        -- Read byte back
+          scmd_end
+        ),
+      g_steps     => c_steps
     )
     port map
     (
@@ -215,6 +327,13 @@ begin
       cs_start    => cs_start,
       cs_busy     => cs_busy,
       cs_status   => cs_status,
+      cs_step     => cs_step,
+      pm_wr       => pm_wr,
+      pm_adr      => pm_adr,
+      pm_data     => pm_data,
+      rs_adr      => rs_adr,
+      rs_status   => rs_status,
+      rs_data     => rs_data,
       scl_i       => to_stdlogicvector(scl_quant),
       sda_i       => to_stdlogicvector(sda_quant),
       scl_o       => scl_o,
@@ -274,6 +393,41 @@ begin
         sda     => sda(i)
       );
     ----------------------------------------------------------------------------
+
+    ----------------------------------------------------------------------------
+    -- Counts Stop conditions and logs the first 32 bytes with acknowledge
+    mon_proc:
+    process
+      variable v_scl   : bit     := '1';
+      variable v_sda   : bit     := '1';
+      variable v_stops : natural := 0;
+      variable v_bits  : natural := 0;
+      variable v_sr    : std_logic_vector(8 downto 0) := (others => '0');
+      variable v_n     : natural := 0;
+    begin
+      wait on scl_nquant(i), sda_nquant(i);
+      if (scl_nquant(i) = '1') and (v_scl = '1') and (sda_nquant(i) /= v_sda) then
+        -- Start or Stop:
+        v_bits := 0;
+        if (sda_nquant(i) = '1') then
+          v_stops  := v_stops + 1;
+          stops(i) <= v_stops;
+        end if;
+      elsif (scl_nquant(i) = '1') and (v_scl = '0') then
+        v_sr   := v_sr(7 downto 0) & to_stdulogic(sda_nquant(i));
+        v_bits := v_bits + 1;
+        if (v_bits = 9) then
+          v_bits := 0;
+          if (v_n < 32) then
+            bytes(i)(v_n) <= v_sr;
+            v_n           := v_n + 1;
+          end if;
+        end if;
+      end if;
+      v_scl := scl_nquant(i);
+      v_sda := sda_nquant(i);
+    end process mon_proc;
+    ----------------------------------------------------------------------------
   end generate bus_gen;
   --****************************************************************************
 
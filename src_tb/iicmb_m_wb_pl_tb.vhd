@@ -0,0 +1,268 @@
+--==============================================================================
+--                                                                             |
+--    Project: IIC Multiple Bus Controller (IICMB)                             |
+--                                                                             |
+--    Module:  Testbench for pipelined Wishbone slave of 'iicmb_m_wb'.         |
+--    Version:                                                                 |
+--             1.0,   October 17, 2026                                         |
+--                                                                             |
+--    Author:  IICMB contributors                                              |
+--                                                                             |
+--==============================================================================
+--==============================================================================
+-- Copyright (c) 2016, Sergey Shuvalkin                                        |
+-- All rights reserved.                                                        |
+--                                                                             |
+-- Redistribution and use in source and binary forms, with or without          |
+-- modification, are permitted provided that the following conditions are met: |
+--                                                                             |
+-- 1. Redistributions of source code must retain the above copyright notice,   |
+--    this list of conditions and the following disclaimer.                    |
+-- 2. Redistributions in binary form must reproduce the above copyright        |
+--    notice, this list of conditions and the following disclaimer in the      |
+--    documentation and/or other materials provided with the distribution.     |
+--                                                                             |
+-- THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" |
+-- AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE   |
+-- IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE  |
+-- ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE    |
+-- LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR         |
+-- CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF        |
+-- SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS    |
+-- INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN     |
+-- CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)     |
+-- ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE  |
+-- POSSIBILITY OF SUCH DAMAGE.                                                 |
+--==============================================================================
+
+
+library ieee;
+use ieee.std_logic_1164.all;
+use ieee.numeric_std.all;
+
+library iicmb;
+use iicmb.iicmb_pkg.all;
+
+use work.test.all;
+
+
+--==============================================================================
+entity iicmb_m_wb_pl_tb is
+end entity iicmb_m_wb_pl_tb;
+--==============================================================================
+
+--==============================================================================
+architecture beh of iicmb_m_wb_pl_tb is
+
+  constant c_f_clk   : real      := 100000.0; -- in kHz
+  constant c_p_clk   : time      := integer(1000000000.0/c_f_clk) * 1 ps;
+
+  constant c_bus_num : positive  := 1;
+
+  ------------------------------------------------------------------------------
+  component iicmb_m_wb is
+    generic
+    (
+      g_bus_num     :       positive range 1 to 16 := 1;
+      g_engines     :       positive range 1 to 16 := 1;
+      g_fifo_depth  :       natural range 0 to 255 := 0;
+      g_trace_depth :       natural range 0 to 12  := 0;
+      g_poll_depth  :       natural range 0 to 127 := 0;
+      g_dma         :       boolean                := false;
+      g_pipelined   :       boolean                := false;
+      g_f_clk       :       real                   := 100000.0;
+      g_f_scl_0     :       real                   :=    100.0;
+      g_f_scl_1     :       real                   :=    100.0;
+      g_f_scl_2     :       real                   :=    100.0;
+      g_f_scl_3     :       real                   :=    100.0;
+      g_f_scl_4     :       real                   :=    100.0;
+      g_f_scl_5     :       real                   :=    100.0;
+      g_f_scl_6     :       real                   :=    100.0;
+      g_f_scl_7     :       real                   :=    100.0;
+      g_f_scl_8     :       real                   :=    100.0;
+      g_f_scl_9     :       real                   :=    100.0;
+      g_f_scl_a     :       real                   :=    100.0;
+      g_f_scl_b     :       real                   :=    100.0;
+      g_f_scl_c     :       real                   :=    100.0;
+      g_f_scl_d     :       real                   :=    100.0;
+      g_f_scl_e     :       real                   :=    100.0;
+      g_f_scl_f     :       real                   :=    100.0;
+      g_f_scl_hs    :       real                   :=   3400.0
+    );
+    port
+    (
+      clk_i         : in    std_logic;
+      rst_i         : in    std_logic;
+      cyc_i         : in    std_logic;
+      stb_i         : in    std_logic;
+      ack_o         :   out std_logic;
+      stall_o       :   out std_logic;
+      adr_i         : in    std_logic_vector(6 downto 0);
+      adr_eng_i     : in    std_logic_vector(3 downto 0) := "0000";
+      adr_pl_i      : in    std_logic                    := '0';
+      we_i          : in    std_logic;
+      dat_i         : in    std_logic_vector(7 downto 0) := (others => '0');
+      dat_o         :   out std_logic_vector(7 downto 0);
+      sel_i         : in    std_logic_vector( 3 downto 0) := "1111";
+      dat32_i       : in    std_logic_vector(31 downto 0) := (others => '0');
+      dat32_o       :   out std_logic_vector(31 downto 0);
+      irq           :   out std_logic;
+      irq_eng       :   out std_logic_vector(0 to g_engines - 1);
+      irq_dma       :   out std_logic;
+      m_cyc_o       :   out std_logic;
+      m_stb_o       :   out std_logic;
+      m_we_o        :   out std_logic;
+      m_sel_o       :   out std_logic_vector( 3 downto 0);
+      m_adr_o       :   out std_logic_vector(31 downto 0);
+      m_dat_o       :   out std_logic_vector(31 downto 0);
+      m_dat_i       : in    std_logic_vector(31 downto 0) := (others => '0');
+      m_ack_i       : in    std_logic                     := '0';
+      scl_i         : in    std_logic_vector(0 to g_bus_num - 1);
+      sda_i         : in    std_logic_vector(0 to g_bus_num - 1);
+      scl_o         :   out std_logic_vector(0 to g_bus_num - 1);
+      sda_o         :   out std_logic_vector(0 to g_bus_num - 1);
+      scl_pu_o      :   out std_logic_vector(0 to g_bus_num - 1)
+    );
+  end component iicmb_m_wb;
+  ------------------------------------------------------------------------------
+
+  type word_array is array (natural range <>) of std_logic_vector(31 downto 0);
+
+  -- Timing registers of bus #0 at 0x14..0x23:
+  constant c_data    : word_array(0 to 3) := (x"01234567", x"89ABCDEF", x"76543210", x"FEDCBA98");
+
+  signal   clk         : std_logic := '0';
+  signal   s_rst       : std_logic := '1';
+
+  signal   cyc         : std_logic := '0';
+  signal   stb         : std_logic := '0';
+  signal   ack         : std_logic;
+  signal   stall       : std_logic;
+  signal   adr         : std_logic_vector( 6 downto 0) := (others => '0');
+  signal   we          : std_logic := '0';
+  signal   sel         : std_logic_vector( 3 downto 0) := (others => '0');
+  signal   dat_w       : std_logic_vector(31 downto 0) := (others => '0');
+  signal   dat_r       : std_logic_vector(31 downto 0);
+  signal   irq         : std_logic;
+  signal   irq_eng     : std_logic_vector(0 to 0);
+
+  signal   scl_o       : std_logic_vector(0 to c_bus_num - 1);
+  signal   sda_o       : std_logic_vector(0 to c_bus_num - 1);
+  signal   scl_pu_o    : std_logic_vector(0 to c_bus_num - 1);
+  signal   bus_idle    : std_logic_vector(0 to c_bus_num - 1) := (others => '1');
+
+begin
+
+  clk <= not(clk) after c_p_clk / 2;
+  s_rst <= '1', '0' after 113 ns;
+
+  ------------------------------------------------------------------------------
+  process
+    ----------------------------------------------------------------------------
+    -- Back-to-back accesses of consecutive words starting at byte address
+    -- 'a', one per clock. Each access has to be acknowledged in the next
+    -- cycle, reads with data 'd'.
+    procedure wb_pipe(w : in std_logic; a : in natural; d : in word_array) is
+    begin
+      cyc   <= '1';
+      we    <= w;
+      sel   <= "1111";
+      for i in 0 to d'length loop
+        if (i < d'length) then
+          stb   <= '1';
+          adr   <= std_logic_vector(to_unsigned(a + 4*i, 7));
+          dat_w <= d(d'low + i);
+        else
+          stb   <= '0';
+        end if;
+        wait until rising_edge(clk);
+        assert (stall = '0') report "Pipeline stalled" severity error;
+        if (i = 0) then
+          assert (ack = '0') report "Acknowledge without access" severity error;
+        else
+          assert (ack = '1') report "Access " & integer'image(i - 1) & " not acknowledged in next cycle" severity error;
+          if (w = '0') then
+            print_string("Read 0x" & to_string(std_logic_vector(to_unsigned(a + 4*(i - 1), 7)), "X", 2) & ": 0x" & to_string(dat_r, "X", 8) & newline);
+            assert (dat_r = d(d'low + i - 1)) report "Wrong read data of access " & integer'image(i - 1) severity error;
+          end if;
+        end if;
+      end loop;
+      cyc   <= '0';
+      we    <= '0';
+    end procedure wb_pipe;
+    ----------------------------------------------------------------------------
+  begin
+    wait until (s_rst = '0');
+    wait until rising_edge(clk);
+
+    -- Back-to-back writes, then back-to-back reads:
+    wb_pipe('1', 16#14#, c_data);
+    wb_pipe('0', 16#14#, c_data);
+
+    -- Write of byte lanes 0 and 2, read back in the next cycle:
+    cyc   <= '1';
+    stb   <= '1';
+    we    <= '1';
+    sel   <= "0101";
+    adr   <= std_logic_vector(to_unsigned(16#14#, 7));
+    dat_w <= x"A1B2C3D4";
+    wait until rising_edge(clk);
+    we    <= '0';
+    sel   <= "1111";
+    wait until rising_edge(clk);
+    assert (ack = '1') report "Write not acknowledged in next cycle" severity error;
+    stb   <= '0';
+    wait until rising_edge(clk);
+    assert (ack = '1') report "Read not acknowledged in next cycle" severity error;
+    print_string("Read 0x14: 0x" & to_string(dat_r, "X", 8) & newline);
+    assert (dat_r = x"01B245D4") report "Wrong byte lanes written" severity error;
+    cyc   <= '0';
+    wait until rising_edge(clk);
+    assert (ack = '0') report "Acknowledge without access" severity error;
+
+    print_string("Test done" & newline);
+    wait;
+  end process;
+  ------------------------------------------------------------------------------
+
+  ------------------------------------------------------------------------------
+  dut : iicmb_m_wb
+    generic map
+    (
+      g_bus_num     => c_bus_num,
+      g_pipelined   => true,
+      g_f_clk       => c_f_clk
+    )
+    port map
+    (
+      clk_i         => clk,
+      rst_i         => s_rst,
+      cyc_i         => cyc,
+      stb_i         => stb,
+      ack_o         => ack,
+      stall_o       => stall,
+      adr_i         => adr,
+      we_i          => we,
+      dat_o         => open,
+      sel_i         => sel,
+      dat32_i       => dat_w,
+      dat32_o       => dat_r,
+      irq           => irq,
+      irq_eng       => irq_eng,
+      irq_dma       => open,
+      m_cyc_o       => open,
+      m_stb_o       => open,
+      m_we_o        => open,
+      m_sel_o       => open,
+      m_adr_o       => open,
+      m_dat_o       => open,
+      scl_i         => bus_idle,
+      sda_i         => bus_idle,
+      scl_o         => scl_o,
+      sda_o         => sda_o,
+      scl_pu_o      => scl_pu_o
+    );
+  ------------------------------------------------------------------------------
+
+end architecture beh;
+--==============================================================================
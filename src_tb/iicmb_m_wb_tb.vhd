@@ -96,7 +96,7 @@ architecture beh of iicmb_m_wb_tb is
       cyc_i       : in    std_logic;
       stb_i       : in    std_logic;
       ack_o       :   out std_logic;
-      adr_i       : in    std_logic_vector(1 downto 0);
+      adr_i       : in    std_logic_vector(6 downto 0);
       we_i        : in    std_logic;
       dat_i       : in    std_logic_vector(7 downto 0);
       dat_o       :   out std_logic_vector(7 downto 0);
@@ -155,7 +155,7 @@ architecture beh of iicmb_m_wb_tb is
   signal   cyc_i         : std_logic := '0';
   signal   stb_i         : std_logic := '0';
   signal   ack_o         : std_logic;
-  signal   adr_i         : std_logic_vector(1 downto 0) := "00";
+  signal   adr_i         : std_logic_vector(6 downto 0) := "0000000";
   signal   we_i          : std_logic := '0';
   signal   dat_i         : std_logic_vector(7 downto 0) := "00000000";
   signal   dat_o         : std_logic_vector(7 downto 0);
@@ -196,7 +196,7 @@ begin
     begin
       cyc_i   <= '1';
       stb_i   <= '1';
-      adr_i   <= addr;
+      adr_i   <= "00000" & addr;
       we_i    <= '1';
       dat_i   <= data;
       wait until rising_edge(clk_i)and(ack_o = '1');
@@ -210,7 +210,7 @@ begin
     begin
       cyc_i   <= '1';
       stb_i   <= '1';
-      adr_i   <= addr;
+      adr_i   <= "00000" & addr;
       we_i    <= '0';
       wait until rising_edge(clk_i)and(ack_o = '1');
       data    := dat_o;